@@ -10,6 +10,9 @@
 
 #include "adios2_c_engine.h"
 
+#include <cstdlib> // malloc
+#include <cstring> // strcpy
+
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosFunctions.h" //GetDataType<T>
 #include "adios2_c_internal.h"
@@ -265,6 +268,67 @@ adios2_error adios2_steps(size_t *steps, const adios2_engine *engine)
     }
 }
 
+adios2_error adios2_engine_get_metrics(char ***names, double **values, size_t *size,
+                                       const adios2_engine *engine)
+{
+    try
+    {
+        adios2::helper::CheckForNullptr(engine,
+                                        "for adios2_engine, in call to adios2_engine_get_metrics");
+
+        const adios2::core::Engine *engineCpp =
+            reinterpret_cast<const adios2::core::Engine *>(engine);
+
+        const std::map<std::string, double> metrics = engineCpp->GetMetrics();
+        *size = metrics.size();
+        *names = (char **)malloc(*size * sizeof(char *));
+        *values = (double *)malloc(*size * sizeof(double));
+
+        size_t cnt = 0;
+        for (const auto &metric : metrics)
+        {
+            (*names)[cnt] = (char *)malloc((metric.first.length() + 1) * sizeof(char));
+            strcpy((*names)[cnt], metric.first.c_str());
+            (*values)[cnt] = metric.second;
+            cnt++;
+        }
+        return adios2_error_none;
+    }
+    catch (...)
+    {
+        return static_cast<adios2_error>(
+            adios2::helper::ExceptionToError("adios2_engine_get_metrics"));
+    }
+}
+
+adios2_error adios2_engine_get_metric(double *value, int *found, const char *name,
+                                      const adios2_engine *engine)
+{
+    try
+    {
+        adios2::helper::CheckForNullptr(engine,
+                                        "for adios2_engine, in call to adios2_engine_get_metric");
+        adios2::helper::CheckForNullptr(name, "for name, in call to adios2_engine_get_metric");
+
+        const adios2::core::Engine *engineCpp =
+            reinterpret_cast<const adios2::core::Engine *>(engine);
+
+        const std::map<std::string, double> metrics = engineCpp->GetMetrics();
+        auto it = metrics.find(name);
+        *found = it != metrics.end();
+        if (*found)
+        {
+            *value = it->second;
+        }
+        return adios2_error_none;
+    }
+    catch (...)
+    {
+        return static_cast<adios2_error>(
+            adios2::helper::ExceptionToError("adios2_engine_get_metric"));
+    }
+}
+
 adios2_error adios2_put(adios2_engine *engine, adios2_variable *variable, const void *data,
                         const adios2_mode mode)
 {
@@ -91,6 +91,31 @@ adios2_error adios2_between_step_pairs(size_t *between_step_pairs, const adios2_
  */
 adios2_error adios2_steps(size_t *steps, const adios2_engine *engine);
 
+/**
+ * Live performance counters of the engine in this process, e.g. bytes
+ * written, time in metadata and data, queue depths. Times are in
+ * microseconds (names ending in _mus), sizes in bytes. Not collective.
+ * @param names output, malloc'ed array of malloc'ed counter names, the caller
+ * frees each name and the array
+ * @param values output, malloc'ed array of values, the caller frees it
+ * @param size output number of counters, 0 if the engine keeps none
+ * @param engine input handler
+ * @return adios2_error 0: success, see enum adios2_error for errors
+ */
+adios2_error adios2_engine_get_metrics(char ***names, double **values, size_t *size,
+                                       const adios2_engine *engine);
+
+/**
+ * Value of a single performance counter, see adios2_engine_get_metrics
+ * @param value output, unchanged if not found
+ * @param found output 1 if the engine has a counter of this name, 0 otherwise
+ * @param name input counter name
+ * @param engine input handler
+ * @return adios2_error 0: success, see enum adios2_error for errors
+ */
+adios2_error adios2_engine_get_metric(double *value, int *found, const char *name,
+                                      const adios2_engine *engine);
+
 //***************** PUT *****************
 /**
  * Put data associated with a Variable in an engine, used for engines with
@@ -849,13 +849,14 @@ char **adios2_available_variables(adios2_io *io, size_t *size)
     try
     {
         adios2::helper::CheckForNullptr(io, "for adios2_io, in call to adios2_available_variables");
+        // only names are returned, skip formatting the variables' info
         std::map<std::string, std::map<std::string, std::string>> varInfo =
-            reinterpret_cast<adios2::core::IO *>(io)->GetAvailableVariables();
+            reinterpret_cast<adios2::core::IO *>(io)->GetAvailableVariables({"name"});
         *size = varInfo.size();
         char **names = (char **)malloc(*size * sizeof(char *));
 
         size_t cnt = 0;
-        for (auto var : varInfo)
+        for (const auto &var : varInfo)
         {
             size_t len = var.first.length();
             names[cnt] = (char *)malloc((len + 1) * sizeof(char));
@@ -129,6 +129,12 @@ size_t Engine::Steps() const
     return m_Engine->Steps();
 }
 
+std::map<std::string, double> Engine::GetMetrics() const
+{
+    helper::CheckForNullptr(m_Engine, "in call to Engine::GetMetrics");
+    return m_Engine->GetMetrics();
+}
+
 Engine::Engine(core::Engine *engine) : m_Engine(engine) {}
 
 void Engine::Put(VariableNT &variable, const void *data, const Mode launch)
@@ -501,6 +501,15 @@ public:
      */
     size_t Steps() const;
 
+    /**
+     * Live performance counters of this process, e.g. bytes written, time in
+     * metadata and data, latency percentiles of EndStep, queue depths and
+     * compression ratios. Keys are engine specific, times are in
+     * microseconds (suffix _mus) and sizes in bytes. Not collective.
+     * @return counter name to value, empty if the engine keeps no counters
+     */
+    std::map<std::string, double> GetMetrics() const;
+
     /**
      * @brief Promise that no more definitions or changes to defined variables
      * will occur. Useful information if called before the first EndStep() of an
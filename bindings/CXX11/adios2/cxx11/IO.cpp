@@ -128,6 +128,19 @@ std::map<std::string, Params> IO::AvailableVariables(bool namesOnly)
     }
 }
 
+Params IO::AvailableVariableInfo(const std::string &name)
+{
+    helper::CheckForNullptr(m_IO, "for variable name " + name +
+                                      ", in call to IO::AvailableVariableInfo");
+    return m_IO->GetAvailableVariableInfo(m_IO->GetVariableHandle(name));
+}
+
+size_t IO::VariableHandle(const std::string &name) const
+{
+    helper::CheckForNullptr(m_IO, "for variable name " + name + ", in call to IO::VariableHandle");
+    return m_IO->GetVariableHandle(name);
+}
+
 std::map<std::string, Params> IO::AvailableAttributes(const std::string &variableName,
                                                       const std::string separator,
                                                       const bool fullNameKeys)
@@ -258,7 +271,8 @@ IO::IO(core::IO *io) : m_IO(io) {}
     template Variable<T> IO::DefineVariable(const std::string &, const Dims &, const Dims &,       \
                                             const Dims &, const bool);                             \
                                                                                                    \
-    template Variable<T> IO::InquireVariable<T>(const std::string &);
+    template Variable<T> IO::InquireVariable<T>(const std::string &);                              \
+    template Variable<T> IO::InquireVariable<T>(const size_t);
 
 ADIOS2_FOREACH_TYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -178,6 +178,22 @@ public:
     template <class T>
     Variable<T> InquireVariable(const std::string &name);
 
+    /**
+     * Interned handle of a variable for repeated lookups without hashing its
+     * name, valid until the variable is removed
+     * @param name unique variable identifier within IO object
+     * @return handle, adios2::MaxSizeT if the variable is not defined
+     */
+    size_t VariableHandle(const std::string &name) const;
+
+    /**
+     * Retrieve a Variable object by a handle from VariableHandle
+     * @param handle of the variable
+     * @return as InquireVariable by name
+     */
+    template <class T>
+    Variable<T> InquireVariable(const size_t handle);
+
     /**
      * @brief Returns the type of an existing variable as an string
      * @param name input variable name
@@ -329,6 +345,15 @@ public:
      */
     std::map<std::string, Params> AvailableVariables(bool namesOnly = false);
 
+    /**
+     * Information of one variable as in AvailableVariables, formatted on
+     * demand. Together with AvailableVariables(true) only the variables that
+     * are looked at are formatted.
+     * @param name unique variable identifier within IO object
+     * @return Params of the variable, empty if it is not available
+     */
+    Params AvailableVariableInfo(const std::string &name);
+
     /**
      * Returns a map with available attributes information associated to a
      * particular variableName
@@ -33,6 +33,13 @@ Variable<T> IO::InquireVariable(const std::string &name)
     return Variable<T>(m_IO->InquireVariable<typename TypeInfo<T>::IOType>(name));
 }
 
+template <class T>
+Variable<T> IO::InquireVariable(const size_t handle)
+{
+    helper::CheckForNullptr(m_IO, "in call to IO::InquireVariable");
+    return Variable<T>(m_IO->InquireVariable<typename TypeInfo<T>::IOType>(handle));
+}
+
 template <class T>
 Attribute<T> IO::DefineAttribute(const std::string &name, const T *data, const size_t size,
                                  const std::string &variableName, const std::string separator,
@@ -251,6 +251,12 @@ size_t Engine::Steps() const
     return m_Engine->Steps();
 }
 
+std::map<std::string, double> Engine::GetMetrics() const
+{
+    helper::CheckForNullptr(m_Engine, "for engine, in call to Engine::GetMetrics");
+    return m_Engine->GetMetrics();
+}
+
 void Engine::LockWriterDefinitions() const
 {
     helper::CheckForNullptr(m_Engine, "in call to Engine::LockWriterDefinitions");
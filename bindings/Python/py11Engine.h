@@ -81,6 +81,7 @@ public:
     std::string Name() const;
     std::string Type() const;
     size_t Steps() const;
+    std::map<std::string, double> GetMetrics() const;
     void LockWriterDefinitions() const;
     void LockReaderSelections() const;
 
@@ -488,6 +488,8 @@ PYBIND11_MODULE(ADIOS2_PYTHON_MODULE_NAME, m)
 
         .def("Steps", &adios2::py11::Engine::Steps)
 
+        .def("GetMetrics", &adios2::py11::Engine::GetMetrics)
+
         .def("LockWriterDefinitions", &adios2::py11::Engine::LockWriterDefinitions)
 
         .def("LockReaderSelections", &adios2::py11::Engine::LockReaderSelections)
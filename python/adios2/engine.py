@@ -46,6 +46,16 @@ class Engine:
         """Returns the current step"""
         return self.impl.CurrentStep()
 
+    def metrics(self):
+        """
+        Returns live performance counters of this process
+
+        Returns:
+            dict of counter name to value, times are in microseconds (names
+            ending in _mus) and sizes in bytes
+        """
+        return self.impl.GetMetrics()
+
     def begin_step(self, *args, **kwargs):
         """Start step"""
         return self.impl.BeginStep(*args, **kwargs)
@@ -643,6 +643,48 @@ constexpr char doshuffle_bitshuffle[] = "BLOSC_BITSHUFFLE";
 
 #endif
 
+// PACK PARAMETERS, built in
+constexpr char LosslessPack[] = "pack";
+namespace pack
+{
+
+namespace key
+{
+constexpr char predict[] = "predict";
+}
+
+namespace value
+{
+constexpr char predict_auto[] = "auto";
+constexpr char predict_xor[] = "xor";
+constexpr char predict_sub[] = "sub";
+constexpr char predict_none[] = "none";
+} // end namespace value
+
+} // end namespace pack
+
+// AUTO PARAMETERS, built in
+constexpr char AutoSelect[] = "auto";
+namespace autoselect
+{
+
+namespace key
+{
+constexpr char candidates[] = "candidates";
+constexpr char objective[] = "objective";
+constexpr char min_ratio[] = "min_ratio";
+constexpr char bandwidth[] = "bandwidth";
+constexpr char sample_bytes[] = "sample_bytes";
+}
+
+namespace value
+{
+constexpr char objective_ratio[] = "ratio";
+constexpr char objective_time[] = "time";
+} // end namespace value
+
+} // end namespace autoselect
+
 } // end namespace ops
 
 } // end namespace adios2
@@ -108,6 +108,8 @@ bool Engine::BetweenStepPairs() const { return m_BetweenStepPairs; }
 
 void Engine::LockReaderSelections() noexcept { m_ReaderSelectionsLocked = true; }
 
+std::map<std::string, double> Engine::GetMetrics() const { return {}; }
+
 size_t Engine::DebugGetDataBufferSize() const
 {
     ThrowUp("DebugGetDataBufferSize");
@@ -462,6 +462,14 @@ public:
      */
     void LockReaderSelections() noexcept;
 
+    /**
+     * Live performance counters of this process, e.g. bytes written, time
+     * in metadata and data, queue depths. Keys are engine specific, times are
+     * in microseconds (suffix _mus) and sizes in bytes. Not collective.
+     * @return empty for engines that keep no counters
+     */
+    virtual std::map<std::string, double> GetMetrics() const;
+
     /* for adios2 internal testing */
     virtual size_t DebugGetDataBufferSize() const;
 
@@ -11,6 +11,7 @@
 #include "IO.h"
 #include "IO.tcc"
 
+#include <algorithm>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -343,6 +344,9 @@ bool IO::RemoveVariable(const std::string &name) noexcept
     // variable exists
     if (itVariable != m_Variables.end())
     {
+        const size_t handle = itVariable->second->m_Handle;
+        m_VariableHandles[handle] = nullptr;
+        m_FreeVariableHandles.push_back(handle);
         m_Variables.erase(itVariable);
         isRemoved = true;
     }
@@ -353,6 +357,8 @@ void IO::RemoveAllVariables() noexcept
 {
     PERFSTUBS_SCOPED_TIMER("IO::RemoveAllVariables");
     m_Variables.clear();
+    m_VariableHandles.clear();
+    m_FreeVariableHandles.clear();
 }
 
 bool IO::RemoveAttribute(const std::string &name) noexcept
@@ -390,19 +396,31 @@ std::map<std::string, Params> IO::GetAvailableVariables(const std::set<std::stri
 {
     PERFSTUBS_SCOPED_TIMER("IO::GetAvailableVariables");
 
+    // keys input are case insensitive, lower them once for all variables
+    const std::set<std::string> keysLC = helper::LowerCase(keys);
+    const bool namesOnly = (keys.size() == 1 && keysLC.count("name") == 1);
+
     std::map<std::string, Params> variablesInfo;
-    for (const auto &variablePair : m_Variables)
+    for (auto itVariable = m_Variables.cbegin(); itVariable != m_Variables.cend(); ++itVariable)
     {
-        const std::string variableName = variablePair.first;
-        const DataType type = InquireVariableType(variableName);
+        // reuse the iterator, avoids hashing the name again per variable
+        const DataType type = InquireVariableType(itVariable);
 
-        if (type == DataType::Struct)
+        if (type == DataType::None || type == DataType::Struct)
+        {
+        }
+        else if (namesOnly)
         {
+            // no need to format variable info if only names are requested
+            variablesInfo.emplace(itVariable->first, Params());
         }
 #define declare_template_instantiation(T)                                                          \
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        variablesInfo[variableName] = GetVariableInfo<T>(variableName, keys);                      \
+        variablesInfo.emplace(                                                                     \
+            itVariable->first,                                                                     \
+            GetVariableInfo<T>(*static_cast<Variable<T> *>(itVariable->second.get()), keys,        \
+                               keysLC));                                                           \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -411,6 +429,115 @@ std::map<std::string, Params> IO::GetAvailableVariables(const std::set<std::stri
     return variablesInfo;
 }
 
+Params IO::GetAvailableVariableInfo(const size_t handle, const std::set<std::string> &keys)
+{
+    PERFSTUBS_SCOPED_TIMER("IO::GetAvailableVariableInfo");
+    VariableBase *variable = GetVariable(handle);
+    if (!variable)
+    {
+        return Params();
+    }
+    const DataType type = variable->m_Type;
+    if (type == DataType::Struct ||
+        (m_ReadStreaming && !variable->IsValidStep(m_EngineStep + 1)))
+    {
+        return Params();
+    }
+#define declare_template_instantiation(T)                                                          \
+    else if (type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        return GetVariableInfo<T>(*static_cast<Variable<T> *>(variable), keys,                     \
+                                  helper::LowerCase(keys));                                        \
+    }
+    ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+    return Params();
+}
+
+IO::LazyAvailableVariables::LazyAvailableVariables(IO &io, const std::set<std::string> &keys)
+: m_IO(io), m_Keys(keys)
+{
+    m_Variables.reserve(io.m_Variables.size());
+    for (auto itVariable = io.m_Variables.cbegin(); itVariable != io.m_Variables.cend();
+         ++itVariable)
+    {
+        const DataType type = io.InquireVariableType(itVariable);
+        if (type != DataType::None && type != DataType::Struct)
+        {
+            m_Variables.push_back(itVariable->second.get());
+        }
+    }
+    std::sort(m_Variables.begin(), m_Variables.end(),
+              [](const VariableBase *a, const VariableBase *b) { return a->m_Name < b->m_Name; });
+    m_Infos.resize(m_Variables.size());
+}
+
+size_t IO::LazyAvailableVariables::Size() const noexcept { return m_Variables.size(); }
+
+const std::string &IO::LazyAvailableVariables::Name(const size_t i) const noexcept
+{
+    return m_Variables[i]->m_Name;
+}
+
+size_t IO::LazyAvailableVariables::Handle(const size_t i) const noexcept
+{
+    return m_Variables[i]->m_Handle;
+}
+
+const Params &IO::LazyAvailableVariables::Info(const size_t i)
+{
+    if (!m_Infos[i])
+    {
+        m_Infos[i].reset(
+            new Params(m_IO.GetAvailableVariableInfo(m_Variables[i]->m_Handle, m_Keys)));
+    }
+    return *m_Infos[i];
+}
+
+const Params *IO::LazyAvailableVariables::Find(const std::string &name)
+{
+    auto it = std::lower_bound(
+        m_Variables.begin(), m_Variables.end(), name,
+        [](const VariableBase *a, const std::string &n) { return a->m_Name < n; });
+    if (it == m_Variables.end() || (*it)->m_Name != name)
+    {
+        return nullptr;
+    }
+    return &Info(static_cast<size_t>(it - m_Variables.begin()));
+}
+
+IO::LazyAvailableVariables IO::GetAvailableVariablesLazy(const std::set<std::string> &keys)
+{
+    PERFSTUBS_SCOPED_TIMER("IO::GetAvailableVariablesLazy");
+    return LazyAvailableVariables(*this, keys);
+}
+
+size_t IO::GetVariableHandle(const std::string &name) const noexcept
+{
+    auto itVariable = m_Variables.find(name);
+    return itVariable == m_Variables.end() ? MaxSizeT : itVariable->second->m_Handle;
+}
+
+VariableBase *IO::GetVariable(const size_t handle) const noexcept
+{
+    return handle < m_VariableHandles.size() ? m_VariableHandles[handle] : nullptr;
+}
+
+void IO::AddVariableHandle(VariableBase &variable)
+{
+    if (m_FreeVariableHandles.empty())
+    {
+        variable.m_Handle = m_VariableHandles.size();
+        m_VariableHandles.push_back(&variable);
+    }
+    else
+    {
+        variable.m_Handle = m_FreeVariableHandles.back();
+        m_FreeVariableHandles.pop_back();
+        m_VariableHandles[variable.m_Handle] = &variable;
+    }
+}
+
 std::map<std::string, Params> IO::GetAvailableAttributes(const std::string &variableName,
                                                          const std::string separator,
                                                          const bool fullNameKeys) noexcept
@@ -958,6 +1085,7 @@ VariableStruct &IO::DefineStructVariable(const std::string &name, StructDefiniti
                                       name, def, shape, start, count, constantDims)));
 
     VariableStruct &variable = static_cast<VariableStruct &>(*itVariablePair.first->second);
+    AddVariableHandle(variable);
 
     // check IO placeholder for variable operations
     auto itOperations = m_VarOpsPlaceholder.find(name);
@@ -1052,7 +1180,8 @@ VariableStruct *IO::InquireStructVariable(const std::string &name, const StructD
 #define define_template_instantiation(T)                                                           \
     template Variable<T> &IO::DefineVariable<T>(const std::string &, const Dims &, const Dims &,   \
                                                 const Dims &, const bool);                         \
-    template Variable<T> *IO::InquireVariable<T>(const std::string &) noexcept;
+    template Variable<T> *IO::InquireVariable<T>(const std::string &) noexcept;                    \
+    template Variable<T> *IO::InquireVariable<T>(const size_t) noexcept;
 
 ADIOS2_FOREACH_STDTYPE_1ARG(define_template_instantiation)
 #undef define_template_instatiation
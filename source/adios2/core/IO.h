@@ -272,6 +272,58 @@ public:
     std::map<std::string, Params>
     GetAvailableVariables(const std::set<std::string> &keys = std::set<std::string>()) noexcept;
 
+    /**
+     * @brief Info of one variable as in GetAvailableVariables, formatted on
+     * demand
+     * @param handle from GetVariableHandle
+     * @param keys as in GetAvailableVariables
+     * @return info, empty if the variable is not available
+     */
+    Params GetAvailableVariableInfo(const size_t handle,
+                                    const std::set<std::string> &keys = std::set<std::string>());
+
+    /**
+     * AvailableVariables built lazily: construction only collects the
+     * interned names, the info of a variable is formatted on its first
+     * access. Valid until variables are defined or removed or the step
+     * changes.
+     */
+    class LazyAvailableVariables
+    {
+    public:
+        LazyAvailableVariables(IO &io, const std::set<std::string> &keys);
+
+        size_t Size() const noexcept;
+        /** i-th name, in the (sorted) order of GetAvailableVariables */
+        const std::string &Name(const size_t i) const noexcept;
+        /** handle of the i-th variable, see GetVariableHandle */
+        size_t Handle(const size_t i) const noexcept;
+        const Params &Info(const size_t i);
+        /** info of a variable by name, nullptr if it is not available */
+        const Params *Find(const std::string &name);
+
+    private:
+        IO &m_IO;
+        const std::set<std::string> m_Keys;
+        std::vector<VariableBase *> m_Variables;
+        std::vector<std::unique_ptr<Params>> m_Infos;
+    };
+
+    LazyAvailableVariables
+    GetAvailableVariablesLazy(const std::set<std::string> &keys = std::set<std::string>());
+
+    /**
+     * @brief Interned handle of a variable, an index that stays valid until
+     * the variable is removed (it may be reused after that). Repeated lookups
+     * by handle do not hash the name.
+     * @param name of the variable
+     * @return handle, MaxSizeT if the variable is not defined
+     */
+    size_t GetVariableHandle(const std::string &name) const noexcept;
+
+    /** @return variable of a handle, nullptr if it was removed */
+    VariableBase *GetVariable(const size_t handle) const noexcept;
+
     /**
      * @brief Gets an existing variable of primitive type by name
      * @param name of variable to be retrieved
@@ -281,6 +333,10 @@ public:
     template <class T>
     Variable<T> *InquireVariable(const std::string &name) noexcept;
 
+    /** InquireVariable by a handle from GetVariableHandle */
+    template <class T>
+    Variable<T> *InquireVariable(const size_t handle) noexcept;
+
     VariableStruct *InquireStructVariable(const std::string &name) noexcept;
 
     VariableStruct *InquireStructVariable(const std::string &name, const StructDefinition &def,
@@ -510,6 +566,11 @@ private:
     adios2::IOMode m_IOMode = adios2::IOMode::Independent;
 
     VarMap m_Variables;
+    /** m_Variables by handle, nullptr for removed ones */
+    std::vector<VariableBase *> m_VariableHandles;
+    /** handles of removed variables, reused first */
+    std::vector<size_t> m_FreeVariableHandles;
+    void AddVariableHandle(VariableBase &variable);
 #ifdef ADIOS2_HAVE_DERIVED_VARIABLE
     VarMap m_VariablesDerived;
 #endif
@@ -527,8 +588,19 @@ private:
     template <class T>
     bool IsAvailableStep(const size_t step, const unsigned int variableIndex) noexcept;
 
+    /** InquireVariable checks of a found variable */
+    template <class T>
+    Variable<T> *InquireFoundVariable(VariableBase *variableBase) noexcept;
+
+    /**
+     * Formats the info of a single variable
+     * @param variable input variable
+     * @param keys requested info keys, as passed by the user
+     * @param keysLC lower-cased keys, computed once by the caller
+     */
     template <class T>
-    Params GetVariableInfo(const std::string &variableName, const std::set<std::string> &keys);
+    Params GetVariableInfo(Variable<T> &variable, const std::set<std::string> &keys,
+                           const std::set<std::string> &keysLC);
 };
 
 } // end namespace core
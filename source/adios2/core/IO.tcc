@@ -50,6 +50,7 @@ Variable<T> &IO::DefineVariable(const std::string &name, const Dims &shape, cons
                                                         name, shape, start, count, constantDims)));
 
     Variable<T> &variable = static_cast<Variable<T> &>(*itVariablePair.first->second);
+    AddVariableHandle(variable);
 
     // check IO placeholder for variable operations
     auto itOperations = m_VarOpsPlaceholder.find(name);
@@ -85,21 +86,14 @@ Variable<T> *IO::InquireVariable(const std::string &name) noexcept
     {
         return nullptr;
     }
+    return InquireFoundVariable<T>(itVariable->second.get());
+}
 
-    if (itVariable->second->m_Type != helper::GetDataType<T>())
-    {
-        return nullptr;
-    }
-
-    Variable<T> *variable = static_cast<Variable<T> *>(itVariable->second.get());
-    if (m_ReadStreaming)
-    {
-        if (!variable->IsValidStep(m_EngineStep + 1))
-        {
-            return nullptr;
-        }
-    }
-    return variable;
+template <class T>
+Variable<T> *IO::InquireVariable(const size_t handle) noexcept
+{
+    PERFSTUBS_SCOPED_TIMER("IO::InquireVariable");
+    return InquireFoundVariable<T>(GetVariable(handle));
 }
 
 template <class T>
@@ -249,19 +243,29 @@ Attribute<T> *IO::InquireAttribute(const std::string &name, const std::string &v
 // PRIVATE
 
 template <class T>
-Params IO::GetVariableInfo(const std::string &variableName, const std::set<std::string> &keys)
+Variable<T> *IO::InquireFoundVariable(VariableBase *variableBase) noexcept
 {
-    Params info;
-    // keys input are case insensitive
-    const std::set<std::string> keysLC = helper::LowerCase(keys);
+    if (!variableBase || variableBase->m_Type != helper::GetDataType<T>())
+    {
+        return nullptr;
+    }
 
-    // return empty map if only "name" key is requested
-    if (keys.size() == 1 && keysLC.count("name") == 1)
+    Variable<T> *variable = static_cast<Variable<T> *>(variableBase);
+    if (m_ReadStreaming)
     {
-        return info;
+        if (!variable->IsValidStep(m_EngineStep + 1))
+        {
+            return nullptr;
+        }
     }
+    return variable;
+}
 
-    Variable<T> &variable = *InquireVariable<T>(variableName);
+template <class T>
+Params IO::GetVariableInfo(Variable<T> &variable, const std::set<std::string> &keys,
+                           const std::set<std::string> &keysLC)
+{
+    Params info;
 
     if (keys.empty() || keysLC.count("type") == 1)
     {
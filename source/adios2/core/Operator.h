@@ -37,10 +37,15 @@ public:
         COMPRESS_SZ = 6,
         COMPRESS_ZFP = 7,
         COMPRESS_MGARDPLUS = 8,
+        COMPRESS_PACK = 9,
         REFACTOR_MDR = 41,
         CALLBACK_SIGNATURE1 = 51,
         CALLBACK_SIGNATURE2 = 52,
         PLUGIN_INTERFACE = 53,
+        OPERATOR_CHAIN = 60,
+        PRECONDITION_DELTA = 61,
+        PRECONDITION_SHUFFLE = 62,
+        OPERATOR_AUTO = 63,
         COMPRESS_NULL = 127,
     };
 
@@ -51,6 +51,9 @@ public:
      *  VariableStruct -> from constructor sizeof(struct) */
     const size_t m_ElementSize;
 
+    /** interned handle in the IO that defined it, see IO::GetVariableHandle */
+    size_t m_Handle = MaxSizeT;
+
     /* User requested memory space */
     MemorySpace m_MemSpace = MemorySpace::Detect;
 #if defined(ADIOS2_HAVE_KOKKOS) || defined(ADIOS2_HAVE_GPU_SUPPORT)
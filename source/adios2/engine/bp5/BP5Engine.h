@@ -152,6 +152,7 @@ public:
     MACRO(NumAggregators, UInt, unsigned int, 0)                                                   \
     MACRO(AggregatorRatio, UInt, unsigned int, 0)                                                  \
     MACRO(NumSubFiles, UInt, unsigned int, 0)                                                      \
+    MACRO(MetadataAggregationFanout, UInt, unsigned int, 0)                                        \
     MACRO(StripeSize, UInt, unsigned int, 4096)                                                    \
     MACRO(DirectIO, Bool, bool, false)                                                             \
     MACRO(DirectIOAlignOffset, UInt, unsigned int, 512)                                            \
@@ -159,10 +160,19 @@ public:
     MACRO(AggregationType, AggregationType, int, (int)AggregationType::TwoLevelShm)                \
     MACRO(AsyncOpen, Bool, bool, true)                                                             \
     MACRO(AsyncWrite, AsyncWrite, int, (int)AsyncWrite::Sync)                                      \
+    MACRO(AsyncMetadataWrite, Bool, bool, false)                                                   \
+    MACRO(AsyncWriteQueueDepth, UInt, unsigned int, 1)                                             \
+    MACRO(AsyncWriteQueueMaxSize, SizeBytes, size_t, 0)                                            \
+    MACRO(FlushStepsCount, UInt, unsigned int, 1)                                                  \
+    MACRO(FlushStepsSize, SizeBytes, size_t, 0)                                                    \
     MACRO(GrowthFactor, Float, float, DefaultBufferGrowthFactor)                                   \
     MACRO(InitialBufferSize, SizeBytes, size_t, DefaultInitialBufferSize)                          \
     MACRO(MinDeferredSize, SizeBytes, size_t, DefaultMinDeferredSize)                              \
+    MACRO(ZeroCopyPuts, Bool, bool, false)                                                         \
     MACRO(BufferChunkSize, SizeBytes, size_t, DefaultBufferChunkSize)                              \
+    MACRO(BufferHugePages, String, std::string, "")                                                \
+    MACRO(BufferNumaPolicy, String, std::string, "")                                               \
+    MACRO(BufferPoolSize, SizeBytes, size_t, 0)                                                    \
     MACRO(MaxShmSize, SizeBytes, size_t, DefaultMaxShmSize)                                        \
     MACRO(BufferVType, BufferVType, int, (int)BufferVType::ChunkVType)                             \
     MACRO(AppendAfterSteps, Int, int, INT_MAX)                                                     \
@@ -171,10 +181,15 @@ public:
     MACRO(StatsLevel, UInt, unsigned int, 1)                                                       \
     MACRO(StatsBlockSize, SizeBytes, size_t, DefaultStatsBlockSize)                                \
     MACRO(Threads, UInt, unsigned int, 0)                                                          \
+    MACRO(OperatorThreads, UInt, unsigned int, 0)                                                  \
     MACRO(UseOneTimeAttributes, Bool, bool, true)                                                  \
     MACRO(FlattenSteps, Bool, bool, false)                                                         \
     MACRO(IgnoreFlattenSteps, Bool, bool, false)                                                   \
     MACRO(RemoteDataPath, String, std::string, "")                                                 \
+    MACRO(ProfileTraceEvents, UInt, unsigned int, 0)                                               \
+    MACRO(BlockCacheSize, SizeBytes, size_t, 0)                                                    \
+    MACRO(BlockCacheSpillDir, String, std::string, "")                                             \
+    MACRO(BlockCacheSpillSize, SizeBytes, size_t, 0)                                               \
     MACRO(MaxOpenFilesAtOnce, UInt, unsigned int, UINT_MAX)
 
     struct BP5Params
@@ -18,6 +18,7 @@
 
 #include <chrono>
 #include <cstdio>
+#include <cstring>
 #include <errno.h>
 #include <iostream>
 #include <mutex>
@@ -202,21 +203,9 @@ void BP5Reader::EndStep()
     PerformGets();
 }
 
-std::pair<double, double> BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
-                                              const size_t maxOpenFiles, const size_t WriterRank,
-                                              const size_t Timestep, const size_t StartOffset,
-                                              const size_t Length, char *Destination)
+void BP5Reader::OpenSubfile(adios2::transportman::TransportMan &FileManager,
+                            const size_t maxOpenFiles, const size_t SubfileNum)
 {
-    /*
-     * Warning: this function is called by multiple threads
-     */
-    size_t FlushCount = m_MetadataIndexTable[Timestep][2];
-    size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
-    size_t SubfileNum =
-        static_cast<size_t>(m_WriterMap[m_WriterMapIndex[Timestep]].RankToSubfile[WriterRank]);
-
-    // check if subfile is already opened
-    TP startSubfile = NOW();
     if (FileManager.m_Transports.count(SubfileNum) == 0)
     {
         const std::string subFileName =
@@ -235,13 +224,17 @@ std::pair<double, double> BP5Reader::ReadData(adios2::transportman::TransportMan
             FileManager.SetParameters(transportParameters, -1);
         }
     }
-    TP endSubfile = NOW();
-    double timeSubfile = DURATION(startSubfile, endSubfile);
+}
+
+size_t BP5Reader::DataPosition(const size_t WriterRank, const size_t Timestep,
+                               const size_t StartOffset)
+{
+    size_t FlushCount = m_MetadataIndexTable[Timestep][2];
+    size_t DataPosPos = m_MetadataIndexTable[Timestep][3];
 
     /* Each block is in exactly one flush. The StartOffset was calculated
        as if all the flushes were in a single contiguous block in file.
     */
-    TP startRead = NOW();
     size_t InfoStartPos = DataPosPos + (WriterRank * (2 * FlushCount + 1) * sizeof(uint64_t));
     size_t SumDataSize = 0; // count in contiguous space
     for (size_t flush = 0; flush < FlushCount; flush++)
@@ -254,25 +247,106 @@ std::pair<double, double> BP5Reader::ReadData(adios2::transportman::TransportMan
         if (StartOffset < SumDataSize + ThisDataSize)
         {
             // discount offsets of skipped flushes
-            size_t Offset = StartOffset - SumDataSize;
-            FileManager.ReadFile(Destination, Length, ThisDataPos + Offset, SubfileNum);
-            TP endRead = NOW();
-            double timeRead = DURATION(startRead, endRead);
-            return std::make_pair(timeSubfile, timeRead);
+            return ThisDataPos + StartOffset - SumDataSize;
         }
         SumDataSize += ThisDataSize;
     }
 
     size_t ThisDataPos = helper::ReadValue<uint64_t>(m_MetadataIndex.m_Buffer, InfoStartPos,
                                                      m_Minifooter.IsLittleEndian);
-    size_t Offset = StartOffset - SumDataSize;
-    FileManager.ReadFile(Destination, Length, ThisDataPos + Offset, SubfileNum);
+    return ThisDataPos + StartOffset - SumDataSize;
+}
 
+std::pair<double, double> BP5Reader::ReadData(adios2::transportman::TransportMan &FileManager,
+                                              const size_t maxOpenFiles, const size_t WriterRank,
+                                              const size_t Timestep, const size_t StartOffset,
+                                              const size_t Length, char *Destination)
+{
+    /*
+     * Warning: this function is called by multiple threads
+     */
+    size_t SubfileNum =
+        static_cast<size_t>(m_WriterMap[m_WriterMapIndex[Timestep]].RankToSubfile[WriterRank]);
+
+    // check if subfile is already opened
+    TP startSubfile = NOW();
+    OpenSubfile(FileManager, maxOpenFiles, SubfileNum);
+    TP endSubfile = NOW();
+    double timeSubfile = DURATION(startSubfile, endSubfile);
+
+    TP startRead = NOW();
+    FileManager.ReadFile(Destination, Length, DataPosition(WriterRank, Timestep, StartOffset),
+                         SubfileNum);
     TP endRead = NOW();
     double timeRead = DURATION(startRead, endRead);
     return std::make_pair(timeSubfile, timeRead);
 }
 
+void BP5Reader::ReadAndFinalizeGets(
+    std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests, const size_t maxReadSize,
+    const size_t maxOpenFiles)
+{
+    // bounds of one ReadFileV, requests without destination need a buffer each
+    constexpr size_t maxBatchRequests = 256;
+    const size_t maxBatchBytes = std::max(maxReadSize, static_cast<size_t>(16 * 1024 * 1024));
+
+    auto lf_Subfile = [&](const format::BP5Deserializer::ReadRequest &Req) -> size_t {
+        return static_cast<size_t>(
+            m_WriterMap[m_WriterMapIndex[Req.Timestep]].RankToSubfile[Req.WriterRank]);
+    };
+    std::stable_sort(ReadRequests.begin(), ReadRequests.end(),
+                     [&](const format::BP5Deserializer::ReadRequest &r1,
+                         const format::BP5Deserializer::ReadRequest &r2) -> bool {
+                         return lf_Subfile(r1) < lf_Subfile(r2);
+                     });
+
+    std::vector<char> buf;
+    std::vector<Transport::ReadRange> ranges;
+    size_t begin = 0;
+    while (begin < ReadRequests.size())
+    {
+        const size_t SubfileNum = lf_Subfile(ReadRequests[begin]);
+        size_t end = begin;
+        size_t bufSize = 0;
+        while (end < ReadRequests.size() && end - begin < maxBatchRequests &&
+               lf_Subfile(ReadRequests[end]) == SubfileNum)
+        {
+            if (!ReadRequests[end].DestinationAddr)
+            {
+                if (end > begin && bufSize + ReadRequests[end].ReadLength > maxBatchBytes)
+                {
+                    break;
+                }
+                bufSize += ReadRequests[end].ReadLength;
+            }
+            ++end;
+        }
+
+        buf.resize(bufSize);
+        ranges.clear();
+        size_t bufPos = 0;
+        for (size_t i = begin; i < end; ++i)
+        {
+            auto &Req = ReadRequests[i];
+            if (!Req.DestinationAddr)
+            {
+                Req.DestinationAddr = buf.data() + bufPos;
+                bufPos += Req.ReadLength;
+            }
+            m_JSONProfiler.AddBytes("dataread", Req.ReadLength);
+            ranges.push_back({Req.DestinationAddr, Req.ReadLength,
+                              DataPosition(Req.WriterRank, Req.Timestep, Req.StartOffset)});
+        }
+        OpenSubfile(m_DataFileManager, maxOpenFiles, SubfileNum);
+        m_DataFileManager.ReadFileV(ranges.data(), ranges.size(), SubfileNum);
+        for (size_t i = begin; i < end; ++i)
+        {
+            m_BP5Deserializer->FinalizeGet(ReadRequests[i], false);
+        }
+        begin = end;
+    }
+}
+
 void BP5Reader::PerformGets()
 {
     // if dataIsRemote is true and m_Remote is not true, this is our first time through
@@ -328,6 +402,7 @@ void BP5Reader::PerformGets()
         }
     }
 
+    m_JSONProfiler.Start(profiling::ProfilerTimer::PG);
     if (m_Remote)
     {
         PerformRemoteGets();
@@ -342,6 +417,7 @@ void BP5Reader::PerformGets()
         std::vector<adios2::format::BP5Deserializer::ReadRequest> empty;
         m_BP5Deserializer->FinalizeGets(empty);
     }
+    m_JSONProfiler.Stop(profiling::ProfilerTimer::PG);
 }
 
 void BP5Reader::PerformRemoteGets()
@@ -377,7 +453,7 @@ void BP5Reader::PerformLocalGets()
     }
     // TP start = NOW();
     PERFSTUBS_SCOPED_TIMER("BP5Reader::PerformGets");
-    m_JSONProfiler.Start("DataRead");
+    m_JSONProfiler.Start(profiling::ProfilerTimer::DataRead);
     size_t maxReadSize;
 
     // TP startGenerate = NOW();
@@ -424,6 +500,12 @@ void BP5Reader::PerformLocalGets()
             {
                 Req.DestinationAddr = buf.data();
             }
+            if (m_BlockCache)
+            {
+                ReadAndFinalizeGet(fileManagers[FileManagerID], maxOpenFiles, Req);
+                ++nReads;
+                continue;
+            }
             std::pair<double, double> t =
                 ReadData(fileManagers[FileManagerID], maxOpenFiles, Req.WriterRank, Req.Timestep,
                          Req.StartOffset, Req.ReadLength, Req.DestinationAddr);
@@ -483,20 +565,25 @@ void BP5Reader::PerformLocalGets()
     {
         size_t maxOpenFiles =
             helper::SetWithinLimit((size_t)m_Parameters.MaxOpenFilesAtOnce, (size_t)1, MaxSizeT);
-        std::vector<char> buf(maxReadSize);
-        for (auto &Req : ReadRequests)
+        if (!m_BlockCache)
         {
-            if (!Req.DestinationAddr)
+            ReadAndFinalizeGets(ReadRequests, maxReadSize, maxOpenFiles);
+        }
+        else
+        {
+            std::vector<char> buf(maxReadSize);
+            for (auto &Req : ReadRequests)
             {
-                Req.DestinationAddr = buf.data();
+                if (!Req.DestinationAddr)
+                {
+                    Req.DestinationAddr = buf.data();
+                }
+                m_JSONProfiler.AddBytes("dataread", Req.ReadLength);
+                ReadAndFinalizeGet(m_DataFileManager, maxOpenFiles, Req);
             }
-            m_JSONProfiler.AddBytes("dataread", Req.ReadLength);
-            ReadData(m_DataFileManager, maxOpenFiles, Req.WriterRank, Req.Timestep, Req.StartOffset,
-                     Req.ReadLength, Req.DestinationAddr);
-            m_BP5Deserializer->FinalizeGet(Req, false);
         }
     }
-    m_JSONProfiler.Stop("DataRead");
+    m_JSONProfiler.Stop(profiling::ProfilerTimer::DataRead);
     /*TP end = NOW();
     double t1 = DURATION(start, end);
     double t2 = DURATION(startRead, end);
@@ -505,6 +592,55 @@ void BP5Reader::PerformLocalGets()
               << ", nRequests = " << nRequest << std::endl;*/
 }
 
+void BP5Reader::ReadAndFinalizeGet(adios2::transportman::TransportMan &FileManager,
+                                   const size_t maxOpenFiles,
+                                   format::BP5Deserializer::ReadRequest &Req)
+{
+    /*
+     * Warning: this function is called by multiple threads
+     */
+    using format::BP5BlockCache;
+    if (Req.DecompressedCacheable)
+    {
+        const BP5BlockCache::Key key{Req.Timestep, Req.WriterRank, Req.BlockOffset,
+                                     BP5BlockCache::Kind::Decompressed};
+        BP5BlockCache::Block block = m_BlockCache->Get(key);
+        if (!block)
+        {
+            ReadData(FileManager, maxOpenFiles, Req.WriterRank, Req.Timestep, Req.StartOffset,
+                     Req.ReadLength, Req.DestinationAddr);
+            std::vector<char> decompressed;
+            m_BP5Deserializer->DecompressBlock(Req, decompressed);
+            block = m_BlockCache->Put(key, std::move(decompressed));
+        }
+        m_BP5Deserializer->FinalizeGet(Req, false, block->data());
+        return;
+    }
+
+    if (!m_BlockCache->Fits(Req.BlockLength))
+    {
+        ReadData(FileManager, maxOpenFiles, Req.WriterRank, Req.Timestep, Req.StartOffset,
+                 Req.ReadLength, Req.DestinationAddr);
+        m_BP5Deserializer->FinalizeGet(Req, false);
+        return;
+    }
+
+    // read the whole block so that other selections of it are hits later
+    const BP5BlockCache::Key key{Req.Timestep, Req.WriterRank, Req.BlockOffset,
+                                 BP5BlockCache::Kind::Raw};
+    BP5BlockCache::Block block = m_BlockCache->Get(key);
+    if (!block)
+    {
+        std::vector<char> data(Req.BlockLength);
+        ReadData(FileManager, maxOpenFiles, Req.WriterRank, Req.Timestep, Req.BlockOffset,
+                 Req.BlockLength, data.data());
+        block = m_BlockCache->Put(key, std::move(data));
+    }
+    std::memcpy(Req.DestinationAddr, block->data() + (Req.StartOffset - Req.BlockOffset),
+                Req.ReadLength);
+    m_BP5Deserializer->FinalizeGet(Req, false);
+}
+
 // PRIVATE
 void BP5Reader::Init()
 {
@@ -550,6 +686,13 @@ void BP5Reader::Init()
 void BP5Reader::InitParameters()
 {
     ParseParams(m_IO, m_Parameters);
+    m_JSONProfiler.EnableTrace(m_Parameters.ProfileTraceEvents);
+    if (m_Parameters.BlockCacheSize > 0)
+    {
+        m_BlockCache.reset(new format::BP5BlockCache(m_Parameters.BlockCacheSize,
+                                                     m_Parameters.BlockCacheSpillDir,
+                                                     m_Parameters.BlockCacheSpillSize));
+    }
     if (m_Parameters.OpenTimeoutSecs < 0.0f)
     {
         if (m_OpenMode == Mode::ReadRandomAccess)
@@ -885,7 +1028,7 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
 
             if (actualFileSize >= expectedMinFileSize)
             {
-                m_JSONProfiler.Start("MetaDataRead");
+                m_JSONProfiler.Start(profiling::ProfilerTimer::MetaDataRead);
                 m_Metadata.Resize(fileFilteredSize, "allocating metadata buffer, "
                                                     "in call to BP5Reader Open");
                 size_t mempos = 0;
@@ -896,7 +1039,7 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
                     mempos += p.second;
                 }
                 m_MDFileAlreadyReadSize = expectedMinFileSize;
-                m_JSONProfiler.Stop("MetaDataRead");
+                m_JSONProfiler.Stop(profiling::ProfilerTimer::MetaDataRead);
             }
             else
             {
@@ -922,7 +1065,7 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
             if (metametadataFileSize > m_MetaMetaDataFileAlreadyReadSize)
             {
                 const size_t newMMDSize = metametadataFileSize - m_MetaMetaDataFileAlreadyReadSize;
-                m_JSONProfiler.Start("MetaMetaDataRead");
+                m_JSONProfiler.Start(profiling::ProfilerTimer::MetaMetaDataRead);
                 m_JSONProfiler.AddBytes("metametadataread", newMMDSize);
                 m_MetaMetadata.Resize(metametadataFileSize, "(re)allocating meta-meta-data buffer, "
                                                             "in call to BP5Reader Open");
@@ -930,7 +1073,7 @@ void BP5Reader::UpdateBuffer(const TimePoint &timeoutInstant, const Seconds &pol
                                                        m_MetaMetaDataFileAlreadyReadSize,
                                                    newMMDSize, m_MetaMetaDataFileAlreadyReadSize);
                 m_MetaMetaDataFileAlreadyReadSize += newMMDSize;
-                m_JSONProfiler.Stop("MetaMetaDataRead");
+                m_JSONProfiler.Stop(profiling::ProfilerTimer::MetaMetaDataRead);
             }
         }
 
@@ -1362,6 +1505,12 @@ void BP5Reader::FlushProfiler()
 
     const std::vector<char> profilingJSON(m_JSONProfiler.AggregateProfilingJSON(LineJSON));
 
+    std::vector<char> traceJSON;
+    if (m_JSONProfiler.TraceEnabled())
+    {
+        traceJSON = m_JSONProfiler.AggregateProfilingJSON(m_JSONProfiler.GetRankTraceJSON());
+    }
+
     if (m_RankMPI == 0)
     {
         std::string profileFileName;
@@ -1380,6 +1529,17 @@ void BP5Reader::FlushProfiler()
             profilingJSONStream.Open(profileFileName, Mode::Write);
             profilingJSONStream.Write(profilingJSON.data(), profilingJSON.size());
             profilingJSONStream.Close();
+
+            if (!traceJSON.empty())
+            {
+                const std::string traceFileName =
+                    "/tmp/" + bpBaseName + "_" + PIDstr.str() + "_profiling_trace.json";
+                transport::FileFStream traceJSONStream(m_Comm);
+                (void)remove(traceFileName.c_str());
+                traceJSONStream.Open(traceFileName, Mode::Write);
+                traceJSONStream.Write(traceJSON.data(), traceJSON.size());
+                traceJSONStream.Close();
+            }
         }
         catch (...)
         { // do nothing
@@ -1387,6 +1547,55 @@ void BP5Reader::FlushProfiler()
     }
 }
 
+std::map<std::string, double> BP5Reader::GetMetrics() const
+{
+    std::map<std::string, double> metrics;
+    metrics["steps"] = static_cast<double>(m_StepsCount);
+    m_JSONProfiler.AddMetrics(metrics, "performgets", profiling::ProfilerTimer::PG);
+
+    metrics["data_mus"] =
+        m_JSONProfiler.GetTimer(profiling::ProfilerTimer::DataRead).ProcessTimeMicros();
+    metrics["metadata_mus"] =
+        m_JSONProfiler.GetTimer(profiling::ProfilerTimer::MetaDataRead).ProcessTimeMicros() +
+        m_JSONProfiler.GetTimer(profiling::ProfilerTimer::MetaMetaDataRead).ProcessTimeMicros();
+    metrics["data_bytes_read"] = static_cast<double>(m_JSONProfiler.GetBytes("dataread"));
+    metrics["metadata_bytes_read"] =
+        static_cast<double>(m_JSONProfiler.GetBytes("metadataread") +
+                            m_JSONProfiler.GetBytes("metametadataread"));
+
+    // subfiles closed to stay under MaxOpenFilesAtOnce are not counted
+    m_DataFileManager.AddMetrics(metrics, "data_file_");
+    for (const auto &fm : fileManagers)
+    {
+        fm.AddMetrics(metrics, "data_file_");
+    }
+    m_MDFileManager.AddMetrics(metrics, "metadata_file_");
+    m_MDIndexFileManager.AddMetrics(metrics, "metadata_file_");
+    m_FileMetaMetadataManager.AddMetrics(metrics, "metadata_file_");
+
+    if (m_BlockCache)
+    {
+        metrics["block_cache_hits"] = static_cast<double>(m_BlockCache->Hits());
+        metrics["block_cache_misses"] = static_cast<double>(m_BlockCache->Misses());
+        metrics["block_cache_spill_hits"] = static_cast<double>(m_BlockCache->SpillHits());
+        metrics["block_cache_bytes"] = static_cast<double>(m_BlockCache->CachedBytes());
+        metrics["block_cache_spilled_bytes"] = static_cast<double>(m_BlockCache->SpilledBytes());
+    }
+
+    for (const std::string prefix : {"data_file_", "metadata_file_", "block_"})
+    {
+        auto hits = metrics.find(prefix + "cache_hits");
+        auto misses = metrics.find(prefix + "cache_misses");
+        if (hits != metrics.end() && misses != metrics.end() &&
+            hits->second + misses->second > 0)
+        {
+            metrics[prefix + "cache_hit_rate"] =
+                hits->second / (hits->second + misses->second);
+        }
+    }
+    return metrics;
+}
+
 size_t BP5Reader::DoSteps() const
 {
     if (m_FlattenSteps)
@@ -15,6 +15,7 @@
 #include "adios2/engine/bp5/BP5Engine.h"
 #include "adios2/helper/adiosComm.h"
 #include "adios2/helper/adiosRangeFilter.h"
+#include "adios2/toolkit/format/bp5/BP5BlockCache.h"
 #include "adios2/toolkit/format/bp5/BP5Deserializer.h"
 #include "adios2/toolkit/format/buffer/heap/BufferMalloc.h"
 #include "adios2/toolkit/remote/Remote.h"
@@ -60,6 +61,8 @@ public:
     std::string VariableExprStr(const VariableBase &Var);
     void SetFlattenMode(bool flatten) { m_FlattenSteps = flatten; };
 
+    std::map<std::string, double> GetMetrics() const final;
+
 private:
     format::BP5Deserializer *m_BP5Deserializer = nullptr;
     /* transport manager for metadata file */
@@ -237,6 +240,32 @@ private:
                                        const size_t Timestep, const size_t StartOffset,
                                        const size_t Length, char *Destination);
 
+    /** Opens subfile SubfileNum in FileManager unless it is open already */
+    void OpenSubfile(adios2::transportman::TransportMan &FileManager, const size_t maxOpenFiles,
+                     const size_t SubfileNum);
+
+    /** Position in its subfile of StartOffset in the data of WriterRank in Timestep */
+    size_t DataPosition(const size_t WriterRank, const size_t Timestep, const size_t StartOffset);
+
+    /**
+     * ReadData and FinalizeGet of requests without threads, those of one
+     * subfile are read with one ReadFileV so that transports can fetch them
+     * together
+     */
+    void ReadAndFinalizeGets(std::vector<format::BP5Deserializer::ReadRequest> &ReadRequests,
+                             const size_t maxReadSize, const size_t maxOpenFiles);
+
+    /** blocks of earlier PerformGets, nullptr unless BlockCacheSize is set */
+    std::unique_ptr<format::BP5BlockCache> m_BlockCache;
+
+    /**
+     * ReadData and FinalizeGet of one request, going through m_BlockCache
+     * for whole blocks of data or of operator output
+     */
+    void ReadAndFinalizeGet(adios2::transportman::TransportMan &FileManager,
+                            const size_t maxOpenFiles,
+                            format::BP5Deserializer::ReadRequest &Req);
+
     struct WriterMapStruct
     {
         uint32_t WriterCount = 0;
@@ -87,29 +87,33 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
 
     if (m_Parameters.AsyncWrite)
     {
-        m_AsyncWriteLock.lock();
-        m_flagRush = true;
-        m_AsyncWriteLock.unlock();
         TimePoint wait_start = Now();
-        if (m_WriteFuture.valid())
+        const size_t nInFlight = AsyncWriteStepsInFlight();
+        size_t maxInFlight = m_Parameters.AsyncWriteQueueDepth - 1;
+        if (nInFlight > 0 && nInFlight <= maxInFlight && m_Parameters.AsyncWriteQueueMaxSize > 0)
         {
-            m_Profiler.Start("BS_WaitOnAsync");
-            m_WriteFuture.get();
-            m_Comm.Barrier();
-            AsyncWriteDataCleanup();
+            // everyone waits for the oldest step if anyone is over the limit
+            int over = (m_AsyncWriteQueueBytes > m_Parameters.AsyncWriteQueueMaxSize);
+            int anyOver = 0;
+            m_Comm.Allreduce(&over, &anyOver, 1, helper::Comm::Op::Max);
+            if (anyOver)
+            {
+                maxInFlight = nInFlight - 1;
+            }
+        }
+        if (nInFlight > maxInFlight)
+        {
+            m_Profiler.Start(profiling::ProfilerTimer::BS_WaitOnAsync);
+            DrainAsyncWrites(maxInFlight);
             Seconds wait = Now() - wait_start;
-            if (m_Comm.Rank() == 0)
+            if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
             {
-                WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
-                if (m_Parameters.verbose > 0)
-                {
-                    std::cout << "BeginStep, wait on async write was = " << wait.count()
-                              << " time since EndStep was = " << m_LastTimeBetweenSteps.count()
-                              << " expect next one to be = " << m_ExpectedTimeBetweenSteps.count()
-                              << std::endl;
-                }
+                std::cout << "BeginStep, wait on async write was = " << wait.count()
+                          << " time since EndStep was = " << m_LastTimeBetweenSteps.count()
+                          << " expect next one to be = " << m_ExpectedTimeBetweenSteps.count()
+                          << std::endl;
             }
-            m_Profiler.Stop("BS_WaitOnAsync");
+            m_Profiler.Stop(profiling::ProfilerTimer::BS_WaitOnAsync);
         }
     }
 
@@ -117,13 +121,13 @@ StepStatus BP5Writer::BeginStep(StepMode mode, const float timeoutSeconds)
     {
         m_BP5Serializer.InitStep(new MallocV(
             "BP5Writer", false, m_BP5Serializer.m_BufferAlign, m_BP5Serializer.m_BufferBlockSize,
-            m_Parameters.InitialBufferSize, m_Parameters.GrowthFactor));
+            m_Parameters.InitialBufferSize, m_Parameters.GrowthFactor, m_BufferAllocator));
     }
     else
     {
-        m_BP5Serializer.InitStep(new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
-                                            m_BP5Serializer.m_BufferBlockSize,
-                                            m_Parameters.BufferChunkSize));
+        m_BP5Serializer.InitStep(new ChunkV(
+            "BP5Writer", false, m_BP5Serializer.m_BufferAlign, m_BP5Serializer.m_BufferBlockSize,
+            m_Parameters.BufferChunkSize, m_BufferAllocator));
     }
     m_ThisTimestepDataSize = 0;
 
@@ -137,9 +141,16 @@ size_t BP5Writer::CurrentStep() const { return m_WriterStep; }
 void BP5Writer::PerformPuts()
 {
     PERFSTUBS_SCOPED_TIMER("BP5Writer::PerformPuts");
-    m_Profiler.Start("PP");
-    m_BP5Serializer.PerformPuts(m_Parameters.AsyncWrite || m_Parameters.DirectIO);
-    m_Profiler.Stop("PP");
+    m_Profiler.Start(profiling::ProfilerTimer::PP);
+    if (m_Parameters.ZeroCopyPuts)
+    {
+        // buffers are valid until EndStep, which adds them to the step buffer
+        m_Profiler.Stop(profiling::ProfilerTimer::PP);
+        return;
+    }
+    m_BP5Serializer.PerformPuts(m_Parameters.AsyncWrite || m_Parameters.DirectIO ||
+                                HoldsSteps());
+    m_Profiler.Stop(profiling::ProfilerTimer::PP);
     return;
 }
 
@@ -205,7 +216,7 @@ uint64_t BP5Writer::WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks
     return MetaDataSize;
 }
 
-void BP5Writer::AsyncWriteDataCleanup()
+void BP5Writer::AsyncWriteDataCleanup(AsyncWriteInfo *info)
 {
     if (m_Parameters.AsyncWrite)
     {
@@ -213,10 +224,10 @@ void BP5Writer::AsyncWriteDataCleanup()
         {
         case (int)AggregationType::EveryoneWrites:
         case (int)AggregationType::EveryoneWritesSerial:
-            AsyncWriteDataCleanup_EveryoneWrites();
+            AsyncWriteDataCleanup_EveryoneWrites(info);
             break;
         case (int)AggregationType::TwoLevelShm:
-            AsyncWriteDataCleanup_TwoLevelShm();
+            AsyncWriteDataCleanup_TwoLevelShm(info);
             break;
         default:
             break;
@@ -224,10 +235,122 @@ void BP5Writer::AsyncWriteDataCleanup()
     }
 }
 
+size_t BP5Writer::AsyncWriteStepsInFlight() const noexcept
+{
+    // entries of the current step (from FlushData) are not counted
+    size_t nSteps = 0;
+    int64_t lastStep = -1;
+    for (const auto &entry : m_AsyncWriteQueue)
+    {
+        if (entry.step < m_WriterStep && entry.step != lastStep)
+        {
+            ++nSteps;
+            lastStep = entry.step;
+        }
+    }
+    return nSteps;
+}
+
+void BP5Writer::DrainAsyncWrites(const size_t MaxStepsInFlight)
+{
+    m_AsyncWriteLock.lock();
+    m_flagRush = true;
+    m_AsyncWriteLock.unlock();
+
+    size_t nSteps = AsyncWriteStepsInFlight();
+    std::vector<AsyncWriteInfo *> completed;
+    while (nSteps > MaxStepsInFlight)
+    {
+        const int64_t step = m_AsyncWriteQueue.front().step;
+        while (!m_AsyncWriteQueue.empty() && m_AsyncWriteQueue.front().step == step)
+        {
+            AsyncWriteQueueEntry &entry = m_AsyncWriteQueue.front();
+            entry.future.get();
+            m_AsyncWriteQueueBytes -= entry.size;
+            completed.push_back(entry.info);
+            m_AsyncWriteQueue.pop_front();
+        }
+        // all data of this step is on disk everywhere before its index record
+        m_Comm.Barrier();
+        for (auto info : completed)
+        {
+            AsyncWriteDataCleanup(info);
+        }
+        completed.clear();
+        if (m_Comm.Rank() == 0)
+        {
+            WaitForMetadataWrite();
+            WritePendingIndexEntry();
+        }
+        --nSteps;
+    }
+}
+
+void BP5Writer::WritePendingIndexEntry(const std::vector<uint64_t> &BatchStart)
+{
+    PendingIndexEntry &entry = m_PendingIndexEntries.front();
+    m_WriterDataPos = std::move(entry.WriterDataPos);
+    FlushPosSizeInfo = std::move(entry.FlushPosSizeInfo);
+    for (size_t i = 0; i < BatchStart.size(); ++i)
+    {
+        m_WriterDataPos[i] += BatchStart[i];
+    }
+    WriteMetadataFileIndex(entry.MetaDataPos, entry.MetaDataSize);
+    m_PendingIndexEntries.pop_front();
+}
+
+bool BP5Writer::HoldsSteps() const noexcept
+{
+    return m_Parameters.FlushStepsCount > 1 || m_Parameters.FlushStepsSize > 0;
+}
+
+void BP5Writer::WriteHeldSteps()
+{
+    if (m_HeldSteps.empty())
+    {
+        return;
+    }
+
+    // one buffer referencing the data of all held steps, without padding
+    // between them so that the step offsets of EndStep hold in the file
+    format::BufferV *Batch =
+        new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
+                   m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize,
+                   m_BufferAllocator);
+    for (auto Data : m_HeldSteps)
+    {
+        for (const auto &iov : Data->DataVec())
+        {
+            Batch->AddToVec(iov.iov_len, iov.iov_base, 1, false);
+        }
+    }
+    // WriteData will free Batch
+    WriteData(Batch);
+    for (auto Data : m_HeldSteps)
+    {
+        delete Data;
+    }
+    m_HeldSteps.clear();
+    m_HeldBytes = 0;
+
+    // the gather also makes sure all data is written before the index records
+    std::vector<uint64_t> BatchStart = m_Comm.GatherValues(m_StartDataPos, 0);
+    if (m_Comm.Rank() == 0)
+    {
+        WaitForMetadataWrite();
+        while (!m_PendingIndexEntries.empty())
+        {
+            WritePendingIndexEntry(BatchStart);
+        }
+        m_FileMetadataIndexManager.FlushFiles();
+    }
+}
+
 void BP5Writer::WriteData(format::BufferV *Data)
 {
     if (m_Parameters.AsyncWrite)
     {
+        const uint64_t size = Data->Size();
         switch (m_Parameters.AggregationType)
         {
         case (int)AggregationType::EveryoneWrites:
@@ -245,6 +368,10 @@ void BP5Writer::WriteData(format::BufferV *Data)
                                                      std::to_string(m_Parameters.AggregationType) +
                                                      "is not supported in BP5");
         }
+        // Data belongs to the async thread from here
+        m_AsyncWriteQueue.push_back({m_WriteFuture.share(), m_AsyncWriteInfo, m_WriterStep, size});
+        m_AsyncWriteQueueBytes += size;
+        m_AsyncWriteInfo = nullptr;
     }
     else
     {
@@ -279,8 +406,10 @@ void BP5Writer::WriteData_EveryoneWrites(format::BufferV *Data, bool SerializedW
 
     if (a->m_Comm.Rank() > 0)
     {
+        m_Profiler.Start(profiling::ProfilerTimer::AggWait);
         a->m_Comm.Recv(&m_DataPos, 1, a->m_Comm.Rank() - 1, 0,
                        "Chain token in BP5Writer::WriteData");
+        m_Profiler.Stop(profiling::ProfilerTimer::AggWait);
     }
 
     // align to PAGE_SIZE
@@ -511,7 +640,7 @@ void BP5Writer::ComputeDerivedVariables()
     auto const &m_VariablesDerived = m_IO.GetDerivedVariables();
     auto const &m_Variables = m_IO.GetVariables();
     // parse all derived variables
-    m_Profiler.Start("DeriveVars");
+    m_Profiler.Start(profiling::ProfilerTimer::DeriveVars);
     for (auto it = m_VariablesDerived.begin(); it != m_VariablesDerived.end(); it++)
     {
         // identify the variables used in the derived variable
@@ -564,7 +693,7 @@ void BP5Writer::ComputeDerivedVariables()
             free(std::get<0>(derivedBlock));
         }
     }
-    m_Profiler.Stop("DeriveVars");
+    m_Profiler.Stop(profiling::ProfilerTimer::DeriveVars);
 }
 #endif
 
@@ -575,38 +704,51 @@ void BP5Writer::EndStep()
 #endif
     m_BetweenStepPairs = false;
     PERFSTUBS_SCOPED_TIMER("BP5Writer::EndStep");
-    m_Profiler.Start("ES");
+    m_Profiler.Start(profiling::ProfilerTimer::ES);
 
-    m_Profiler.Start("ES_close");
+    m_Profiler.Start(profiling::ProfilerTimer::ES_close);
     MarshalAttributes();
 
     // true: advances step
-    auto TSInfo = m_BP5Serializer.CloseTimestep((int)m_WriterStep,
-                                                m_Parameters.AsyncWrite || m_Parameters.DirectIO);
+    auto TSInfo = m_BP5Serializer.CloseTimestep(
+        (int)m_WriterStep, m_Parameters.AsyncWrite || m_Parameters.DirectIO || HoldsSteps());
 
     /* TSInfo includes NewMetaMetaBlocks, the MetaEncodeBuffer, the
      * AttributeEncodeBuffer and the data encode Vector */
 
     m_ThisTimestepDataSize += TSInfo.DataBuffer->Size();
-    m_Profiler.Stop("ES_close");
+    m_DataBufferHighWater = std::max<uint64_t>(m_DataBufferHighWater, TSInfo.DataBuffer->Size());
+    m_Profiler.Stop(profiling::ProfilerTimer::ES_close);
 
-    m_Profiler.Start("ES_AWD");
+    m_Profiler.Start(profiling::ProfilerTimer::ES_AWD);
     // TSInfo destructor would delete the DataBuffer so we need to save it
     // for async IO and let the writer free it up when not needed anymore
     m_AsyncWriteLock.lock();
     m_flagRush = false;
     m_AsyncWriteLock.unlock();
 
-    // WriteData will free TSInfo.DataBuffer
-    WriteData(TSInfo.DataBuffer);
+    if (HoldsSteps())
+    {
+        // written later together with the next steps, the index records
+        // get the batch's start position added to m_StartDataPos
+        m_StartDataPos = m_HeldBytes;
+        m_HeldBytes += TSInfo.DataBuffer->Size();
+        m_HeldSteps.push_back(TSInfo.DataBuffer);
+    }
+    else
+    {
+        // WriteData will free TSInfo.DataBuffer
+        WriteData(TSInfo.DataBuffer);
+    }
     TSInfo.DataBuffer = NULL;
 
-    m_Profiler.Stop("ES_AWD");
+    m_Profiler.Stop(profiling::ProfilerTimer::ES_AWD);
 
     /*
-     * Two-step metadata aggregation
+     * Two-step metadata aggregation, or a k-ary tree if
+     * MetadataAggregationFanout is set
      */
-    m_Profiler.Start("ES_meta1");
+    m_Profiler.Start(profiling::ProfilerTimer::ES_meta1);
     std::vector<char> MetaBuffer;
     core::iovec m{TSInfo.MetaEncodeBuffer->Data(), TSInfo.MetaEncodeBuffer->m_FixedSize};
     core::iovec a{nullptr, 0};
@@ -617,95 +759,114 @@ void BP5Writer::EndStep()
     MetaBuffer = m_BP5Serializer.CopyMetadataToContiguous(
         TSInfo.NewMetaMetaBlocks, {m}, {a}, {m_ThisTimestepDataSize}, {m_StartDataPos});
 
-    if (m_Aggregator->m_Comm.Size() > 1)
-    { // level 1
-        m_Profiler.Start("ES_meta1_gather");
-        size_t LocalSize = MetaBuffer.size();
-        std::vector<size_t> RecvCounts = m_Aggregator->m_Comm.GatherValues(LocalSize, 0);
-        std::vector<char> RecvBuffer;
-        if (m_Aggregator->m_Comm.Rank() == 0)
-        {
-            uint64_t TotalSize = 0;
-            for (auto &n : RecvCounts)
-                TotalSize += n;
-            RecvBuffer.resize(TotalSize);
-            /*std::cout << "MD Lvl-1: rank " << m_Comm.Rank() << " gather "
-                      << TotalSize << " bytes from aggregator group"
-                      << std::endl;*/
-        }
-        m_Aggregator->m_Comm.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
-                                           RecvCounts.size(), RecvBuffer.data(), 0);
-        m_Profiler.Stop("ES_meta1_gather");
-        if (m_Aggregator->m_Comm.Rank() == 0)
+    if (m_Parameters.MetadataAggregationFanout > 1)
+    {
+        AggregateMetadataTree(MetaBuffer);
+        m_Profiler.Stop(profiling::ProfilerTimer::ES_meta1);
+        m_Profiler.Start(profiling::ProfilerTimer::ES_meta2);
+        if (m_Comm.Rank() == 0)
         {
-            std::vector<format::BP5Base::MetaMetaInfoBlock> UniqueMetaMetaBlocks;
-            std::vector<uint64_t> DataSizes;
-            std::vector<uint64_t> WriterDataPositions;
-            std::vector<core::iovec> AttributeBlocks;
-            auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
-                RecvBuffer, RecvCounts, UniqueMetaMetaBlocks, AttributeBlocks, DataSizes,
-                WriterDataPositions);
-
-            MetaBuffer.clear();
-            MetaBuffer = m_BP5Serializer.CopyMetadataToContiguous(
-                UniqueMetaMetaBlocks, Metadata, AttributeBlocks, DataSizes, WriterDataPositions);
-        }
-    } // level 1
-    m_Profiler.Stop("ES_meta1");
-    m_Profiler.Start("ES_meta2");
-    // level 2
-    if (m_Aggregator->m_Comm.Rank() == 0)
-    {
-        std::vector<char> RecvBuffer;
-        std::vector<char> *buf;
-        std::vector<size_t> RecvCounts;
-        size_t LocalSize = MetaBuffer.size();
-        if (m_CommAggregators.Size() > 1)
-        {
-            m_Profiler.Start("ES_meta2_gather");
-            RecvCounts = m_CommAggregators.GatherValues(LocalSize, 0);
-            if (m_CommAggregators.Rank() == 0)
+            SubmitAggregatedMetadata(MetaBuffer, {MetaBuffer.size()});
+        }
+    }
+    else
+    {
+        if (m_Aggregator->m_Comm.Size() > 1)
+        { // level 1
+            m_Profiler.Start(profiling::ProfilerTimer::ES_meta1_gather);
+            size_t LocalSize = MetaBuffer.size();
+            std::vector<size_t> RecvCounts = m_Aggregator->m_Comm.GatherValues(LocalSize, 0);
+            std::vector<char> RecvBuffer;
+            if (m_Aggregator->m_Comm.Rank() == 0)
             {
                 uint64_t TotalSize = 0;
                 for (auto &n : RecvCounts)
                     TotalSize += n;
                 RecvBuffer.resize(TotalSize);
-                /*std::cout << "MD Lvl-2: rank " << m_Comm.Rank() << " gather "
+                /*std::cout << "MD Lvl-1: rank " << m_Comm.Rank() << " gather "
                           << TotalSize << " bytes from aggregator group"
                           << std::endl;*/
             }
-
-            m_CommAggregators.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
-                                            RecvCounts.size(), RecvBuffer.data(), 0);
-            buf = &RecvBuffer;
-            m_Profiler.Stop("ES_meta2_gather");
-        }
-        else
+            m_Aggregator->m_Comm.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
+                                               RecvCounts.size(), RecvBuffer.data(), 0);
+            m_Profiler.Stop(profiling::ProfilerTimer::ES_meta1_gather);
+            if (m_Aggregator->m_Comm.Rank() == 0)
+            {
+                std::vector<format::BP5Base::MetaMetaInfoBlock> UniqueMetaMetaBlocks;
+                std::vector<uint64_t> DataSizes;
+                std::vector<uint64_t> WriterDataPositions;
+                std::vector<core::iovec> AttributeBlocks;
+                auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
+                    RecvBuffer, RecvCounts, UniqueMetaMetaBlocks, AttributeBlocks, DataSizes,
+                    WriterDataPositions);
+
+                MetaBuffer.clear();
+                MetaBuffer = m_BP5Serializer.CopyMetadataToContiguous(
+                    UniqueMetaMetaBlocks, Metadata, AttributeBlocks, DataSizes,
+                    WriterDataPositions);
+            }
+        } // level 1
+        m_Profiler.Stop(profiling::ProfilerTimer::ES_meta1);
+        m_Profiler.Start(profiling::ProfilerTimer::ES_meta2);
+        // level 2
+        if (m_Aggregator->m_Comm.Rank() == 0)
         {
-            buf = &MetaBuffer;
-            RecvCounts.push_back(LocalSize);
-        }
+            std::vector<char> RecvBuffer;
+            std::vector<char> *buf;
+            std::vector<size_t> RecvCounts;
+            size_t LocalSize = MetaBuffer.size();
+            if (m_CommAggregators.Size() > 1)
+            {
+                m_Profiler.Start(profiling::ProfilerTimer::ES_meta2_gather);
+                RecvCounts = m_CommAggregators.GatherValues(LocalSize, 0);
+                if (m_CommAggregators.Rank() == 0)
+                {
+                    uint64_t TotalSize = 0;
+                    for (auto &n : RecvCounts)
+                        TotalSize += n;
+                    RecvBuffer.resize(TotalSize);
+                    /*std::cout << "MD Lvl-2: rank " << m_Comm.Rank() << " gather "
+                              << TotalSize << " bytes from aggregator group"
+                              << std::endl;*/
+                }
 
-        if (m_CommAggregators.Rank() == 0)
-        {
-            std::vector<format::BP5Base::MetaMetaInfoBlock> UniqueMetaMetaBlocks;
-            std::vector<uint64_t> DataSizes;
-            std::vector<core::iovec> AttributeBlocks;
-            m_WriterDataPos.resize(0);
-            auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
-                *buf, RecvCounts, UniqueMetaMetaBlocks, AttributeBlocks, DataSizes,
-                m_WriterDataPos);
-            assert(m_WriterDataPos.size() == static_cast<size_t>(m_Comm.Size()));
-            WriteMetaMetadata(UniqueMetaMetaBlocks);
-            m_LatestMetaDataPos = m_MetaDataPos;
-            m_LatestMetaDataSize = WriteMetadata(Metadata, AttributeBlocks);
-            if (!m_Parameters.AsyncWrite)
+                m_CommAggregators.GathervArrays(MetaBuffer.data(), LocalSize, RecvCounts.data(),
+                                                RecvCounts.size(), RecvBuffer.data(), 0);
+                buf = &RecvBuffer;
+                m_Profiler.Stop(profiling::ProfilerTimer::ES_meta2_gather);
+            }
+            else
+            {
+                buf = &MetaBuffer;
+                RecvCounts.push_back(LocalSize);
+            }
+
+            if (m_CommAggregators.Rank() == 0)
             {
-                WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
+                SubmitAggregatedMetadata(*buf, RecvCounts);
             }
+        } // level 2
+    }
+    m_Profiler.Stop(profiling::ProfilerTimer::ES_meta2);
+
+    if (HoldsSteps())
+    {
+        bool writeSteps = m_HeldSteps.size() >= m_Parameters.FlushStepsCount;
+        if (!writeSteps && m_Parameters.FlushStepsSize > 0)
+        {
+            // everyone writes if anyone is over the limit
+            int over = (m_HeldBytes >= m_Parameters.FlushStepsSize);
+            int anyOver = 0;
+            m_Comm.Allreduce(&over, &anyOver, 1, helper::Comm::Op::Max);
+            writeSteps = anyOver;
+        }
+        if (writeSteps)
+        {
+            m_Profiler.Start(profiling::ProfilerTimer::ES_AWD);
+            WriteHeldSteps();
+            m_Profiler.Stop(profiling::ProfilerTimer::ES_AWD);
         }
-    } // level 2
-    m_Profiler.Stop("ES_meta2");
+    }
 
     if (m_Parameters.AsyncWrite)
     {
@@ -719,12 +880,20 @@ void BP5Writer::EndStep()
             m_AsyncWriteLock.unlock();
         }
     }
-    m_FileMetadataIndexManager.FlushFiles();
-    m_FileMetadataManager.FlushFiles();
-    m_FileMetaMetadataManager.FlushFiles();
-    m_FileDataManager.FlushFiles();
+    if (!m_Parameters.AsyncMetadataWrite)
+    {
+        // with async metadata, the background thread owns the metadata files
+        m_FileMetadataIndexManager.FlushFiles();
+        m_FileMetadataManager.FlushFiles();
+        m_FileMetaMetadataManager.FlushFiles();
+    }
+    if (!m_Parameters.AsyncWrite)
+    {
+        // async threads own the data files until they complete
+        m_FileDataManager.FlushFiles();
+    }
 
-    m_Profiler.Stop("ES");
+    m_Profiler.Stop(profiling::ProfilerTimer::ES);
     m_WriterStep++;
     m_EndStepEnd = Now();
     if (!m_RankMPI)
@@ -735,6 +904,132 @@ void BP5Writer::EndStep()
      std::cout << "END STEP ended at: " << ts2.count() << std::endl;*/
 }
 
+void BP5Writer::AggregateMetadataTree(std::vector<char> &MetaBuffer)
+{
+    /*
+     * k-ary tree over m_Comm. At the level with stride s, rank r that is a
+     * multiple of k*s receives the buffers of ranks r+s, r+2s, ...,
+     * r+(k-1)s, each covering s consecutive ranks, appends them to its own
+     * in rank order and merges them, dropping duplicate metametadata.
+     * Rank 0 ends up with the metadata of all ranks in rank order.
+     */
+    const int rank = m_Comm.Rank();
+    const int size = m_Comm.Size();
+    const int k = static_cast<int>(m_Parameters.MetadataAggregationFanout);
+    const int tag = 0;
+    for (int stride = 1; stride < size; stride *= k)
+    {
+        const int group = stride * k;
+        if (rank % group)
+        {
+            // this rank is a child on this level, send and be done
+            const int parent = rank - rank % group;
+            const size_t LocalSize = MetaBuffer.size();
+            m_Comm.Send(&LocalSize, 1, parent, tag, "BP5 metadata tree size");
+            m_Comm.Send(MetaBuffer.data(), LocalSize, parent, tag, "BP5 metadata tree data");
+            MetaBuffer.clear();
+            return;
+        }
+
+        std::vector<int> Children;
+        std::vector<size_t> RecvCounts = {MetaBuffer.size()};
+        for (int c = rank + stride; c < rank + group && c < size; c += stride)
+        {
+            size_t ChildSize = 0;
+            m_Comm.Recv(&ChildSize, 1, c, tag, "BP5 metadata tree size");
+            Children.push_back(c);
+            RecvCounts.push_back(ChildSize);
+        }
+        if (Children.empty())
+        {
+            continue;
+        }
+
+        m_Profiler.Start(profiling::ProfilerTimer::ES_meta1_gather);
+        uint64_t TotalSize = 0;
+        for (auto &n : RecvCounts)
+            TotalSize += n;
+        std::vector<char> RecvBuffer(TotalSize);
+        std::memcpy(RecvBuffer.data(), MetaBuffer.data(), MetaBuffer.size());
+        std::vector<helper::Comm::Req> Requests;
+        size_t Position = MetaBuffer.size();
+        for (size_t i = 0; i < Children.size(); ++i)
+        {
+            Requests.push_back(m_Comm.Irecv(RecvBuffer.data() + Position, RecvCounts[i + 1],
+                                            Children[i], tag, "BP5 metadata tree data"));
+            Position += RecvCounts[i + 1];
+        }
+        for (auto &req : Requests)
+        {
+            req.Wait();
+        }
+        m_Profiler.Stop(profiling::ProfilerTimer::ES_meta1_gather);
+
+        std::vector<format::BP5Base::MetaMetaInfoBlock> UniqueMetaMetaBlocks;
+        std::vector<uint64_t> DataSizes;
+        std::vector<uint64_t> WriterDataPositions;
+        std::vector<core::iovec> AttributeBlocks;
+        auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
+            RecvBuffer, RecvCounts, UniqueMetaMetaBlocks, AttributeBlocks, DataSizes,
+            WriterDataPositions);
+        MetaBuffer = m_BP5Serializer.CopyMetadataToContiguous(
+            UniqueMetaMetaBlocks, Metadata, AttributeBlocks, DataSizes, WriterDataPositions);
+    }
+}
+
+void BP5Writer::WriteAggregatedMetadata(std::vector<char> &Buffer,
+                                        const std::vector<size_t> &Counts)
+{
+    std::vector<format::BP5Base::MetaMetaInfoBlock> UniqueMetaMetaBlocks;
+    std::vector<uint64_t> DataSizes;
+    std::vector<core::iovec> AttributeBlocks;
+    m_WriterDataPos.resize(0);
+    auto Metadata = m_BP5Serializer.BreakoutContiguousMetadata(
+        Buffer, Counts, UniqueMetaMetaBlocks, AttributeBlocks, DataSizes, m_WriterDataPos);
+    assert(m_WriterDataPos.size() == static_cast<size_t>(m_Comm.Size()));
+    WriteMetaMetadata(UniqueMetaMetaBlocks);
+    const uint64_t MetaDataPos = m_MetaDataPos;
+    const uint64_t MetaDataSize = WriteMetadata(Metadata, AttributeBlocks);
+    if (m_Parameters.AsyncWrite || HoldsSteps())
+    {
+        // index record is written when the step's data is written
+        m_PendingIndexEntries.push_back(
+            {MetaDataPos, MetaDataSize, m_WriterDataPos, std::move(FlushPosSizeInfo)});
+        FlushPosSizeInfo.clear();
+    }
+    else
+    {
+        WriteMetadataFileIndex(MetaDataPos, MetaDataSize);
+    }
+}
+
+void BP5Writer::SubmitAggregatedMetadata(std::vector<char> &Buffer,
+                                         const std::vector<size_t> &Counts)
+{
+    if (!m_Parameters.AsyncMetadataWrite)
+    {
+        WriteAggregatedMetadata(Buffer, Counts);
+        return;
+    }
+    // one step in flight: keeps md.0 and md.idx in step order
+    WaitForMetadataWrite();
+    m_AsyncMetadataBuffer = std::move(Buffer);
+    m_MetadataWriteFuture = std::async(std::launch::async, [this, Counts]() {
+        WriteAggregatedMetadata(m_AsyncMetadataBuffer, Counts);
+        m_FileMetadataIndexManager.FlushFiles();
+    });
+}
+
+void BP5Writer::WaitForMetadataWrite()
+{
+    if (m_MetadataWriteFuture.valid())
+    {
+        m_Profiler.Start(profiling::ProfilerTimer::WaitOnAsyncMetadata);
+        m_MetadataWriteFuture.get();
+        m_Profiler.Stop(profiling::ProfilerTimer::WaitOnAsyncMetadata);
+    }
+}
+
 // PRIVATE
 void BP5Writer::Init()
 {
@@ -754,6 +1049,7 @@ MinVarInfo *BP5Writer::WriterMinBlocksInfo(const core::VariableBase &Var)
 void BP5Writer::InitParameters()
 {
     ParseParams(m_IO, m_Parameters);
+    m_Profiler.EnableTrace(m_Parameters.ProfileTraceEvents);
     m_WriteToBB = !(m_Parameters.BurstBufferPath.empty());
     m_DrainBB = m_WriteToBB && m_Parameters.BurstBufferDrain;
 
@@ -804,7 +1100,39 @@ void BP5Writer::InitParameters()
         }
     }
 
+    if (m_Parameters.AsyncWriteQueueDepth == 0)
+    {
+        m_Parameters.AsyncWriteQueueDepth = 1;
+    }
+    if (m_Parameters.AggregationType == (int)AggregationType::TwoLevelShm)
+    {
+        // aggregators have a single shared memory segment, one step at a time
+        m_Parameters.AsyncWriteQueueDepth = 1;
+    }
+
+    if (m_Parameters.FlushStepsCount == 0 ||
+        (m_Parameters.FlushStepsCount == 1 && m_Parameters.FlushStepsSize > 0))
+    {
+        // only the size limit, if any, decides when held steps are written
+        m_Parameters.FlushStepsCount = m_Parameters.FlushStepsSize > 0 ? UINT_MAX : 1;
+    }
+    if (HoldsSteps() && m_Parameters.AsyncWrite)
+    {
+        helper::Throw<std::invalid_argument>("Engine", "BP5Writer", "InitParameters",
+                                             "FlushStepsCount and FlushStepsSize cannot be "
+                                             "combined with AsyncWrite");
+    }
+
+    if (!m_Parameters.BufferHugePages.empty() || !m_Parameters.BufferNumaPolicy.empty() ||
+        m_Parameters.BufferPoolSize > 0)
+    {
+        m_BufferAllocator = std::make_shared<format::BufferAllocator>(
+            m_Parameters.BufferHugePages, m_Parameters.BufferNumaPolicy,
+            m_Parameters.BufferPoolSize);
+    }
+
     m_BP5Serializer.m_StatsLevel = m_Parameters.StatsLevel;
+    m_BP5Serializer.m_OperatorThreads = m_Parameters.OperatorThreads;
 }
 
 uint64_t BP5Writer::CountStepsInMetadataIndex(format::BufferSTL &bufferSTL)
@@ -1122,7 +1450,7 @@ void BP5Writer::InitTransports()
     }
 
     /* Create the directories either on target or burst buffer if used */
-    //    m_BP4Serializer.m_Profiler.Start("mkdir");
+    //    m_BP4Serializer.m_Profiler.Start(profiling::ProfilerTimer::mkdir);
 
     if (m_Comm.Rank() == 0)
     {
@@ -1503,20 +1831,26 @@ void BP5Writer::ExitComputationBlock() noexcept
 
 void BP5Writer::FlushData(const bool isFinal)
 {
+    if (m_Parameters.AsyncWrite)
+    {
+        // index records of previous steps must not include this step's flushes
+        DrainAsyncWrites(0);
+    }
     BufferV *DataBuf;
     if (m_Parameters.BufferVType == (int)BufferVType::MallocVType)
     {
         DataBuf = m_BP5Serializer.ReinitStepData(
             new MallocV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
                         m_BP5Serializer.m_BufferBlockSize, m_Parameters.InitialBufferSize,
-                        m_Parameters.GrowthFactor),
+                        m_Parameters.GrowthFactor, m_BufferAllocator),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
     else
     {
         DataBuf = m_BP5Serializer.ReinitStepData(
             new ChunkV("BP5Writer", false, m_BP5Serializer.m_BufferAlign,
-                       m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize),
+                       m_BP5Serializer.m_BufferBlockSize, m_Parameters.BufferChunkSize,
+                       m_BufferAllocator),
             m_Parameters.AsyncWrite || m_Parameters.DirectIO);
     }
 
@@ -1542,18 +1876,31 @@ void BP5Writer::FlushData(const bool isFinal)
         m_Comm.GatherArrays(tmp, 2, RecvBuffer.data(), 0);
         if (m_Comm.Rank() == 0)
         {
+            // the metadata thread consumes FlushPosSizeInfo in WriteMetadataFileIndex
+            WaitForMetadataWrite();
             FlushPosSizeInfo.push_back(RecvBuffer);
         }
     }
 }
 
-void BP5Writer::Flush(const int transportIndex) {}
+void BP5Writer::Flush(const int transportIndex)
+{
+    if (HoldsSteps() && !m_BetweenStepPairs)
+    {
+        WriteHeldSteps();
+    }
+}
 
 void BP5Writer::PerformDataWrite()
 {
-    m_Profiler.Start("PDW");
+    if (HoldsSteps())
+    {
+        // the step's data stays in the buffer until its batch is written
+        return;
+    }
+    m_Profiler.Start(profiling::ProfilerTimer::PDW);
     FlushData(false);
-    m_Profiler.Stop("PDW");
+    m_Profiler.Stop(profiling::ProfilerTimer::PDW);
 }
 
 void BP5Writer::DestructorClose(bool Verbose) noexcept
@@ -1564,6 +1911,10 @@ void BP5Writer::DestructorClose(bool Verbose) noexcept
                   << std::endl;
         std::cerr << "This may result in corrupt output." << std::endl;
     }
+    if (m_MetadataWriteFuture.valid())
+    {
+        m_MetadataWriteFuture.wait();
+    }
     // close metadata index file
     UpdateActiveFlag(false);
     m_IsOpen = false;
@@ -1576,6 +1927,10 @@ BP5Writer::~BP5Writer()
         DestructorClose(m_FailVerbose);
     }
     m_IsOpen = false;
+    for (auto Data : m_HeldSteps)
+    {
+        delete Data;
+    }
 }
 
 void BP5Writer::DoClose(const int transportIndex)
@@ -1592,53 +1947,48 @@ void BP5Writer::DoClose(const int transportIndex)
         EndStep();
     }
 
-    TimePoint wait_start = Now();
-    Seconds wait(0.0);
-    if (m_WriteFuture.valid())
+    if (HoldsSteps())
     {
-        m_Profiler.Start("DC_WaitOnAsync1");
-        m_AsyncWriteLock.lock();
-        m_flagRush = true;
-        m_AsyncWriteLock.unlock();
-        m_WriteFuture.get();
-        wait += Now() - wait_start;
-        m_Profiler.Stop("DC_WaitOnAsync1");
-    }
-
-    m_FileDataManager.CloseFiles(transportIndex);
-    // Delete files from temporary storage if draining was on
-
-    if (m_Comm.Rank() == 0)
-    {
-        // close metadata file
-        m_FileMetadataManager.CloseFiles();
-
-        // close metametadata file
-        m_FileMetaMetadataManager.CloseFiles();
+        WriteHeldSteps();
     }
 
     if (m_Parameters.AsyncWrite)
     {
-        // wait until all process' writing thread completes
-        m_Profiler.Start("DC_WaitOnAsync2");
-        wait_start = Now();
-        m_Comm.Barrier();
-        AsyncWriteDataCleanup();
-        wait += Now() - wait_start;
+        // wait until all process' writing threads complete
+        m_Profiler.Start(profiling::ProfilerTimer::DC_WaitOnAsync1);
+        TimePoint wait_start = Now();
+        DrainAsyncWrites(0);
+        Seconds wait = Now() - wait_start;
         if (m_Comm.Rank() == 0 && m_Parameters.verbose > 0)
         {
             std::cout << "Close waited " << wait.count() << " seconds on async threads"
                       << std::endl;
         }
-        m_Profiler.Stop("DC_WaitOnAsync2");
+        m_Profiler.Stop(profiling::ProfilerTimer::DC_WaitOnAsync1);
     }
 
-    if (m_Comm.Rank() == 0)
+    if (m_Parameters.AggregationType == (int)AggregationType::TwoLevelShm)
     {
-        if (m_Parameters.AsyncWrite)
+        // the segment kept across steps with BufferPoolSize
+        auto a = dynamic_cast<aggregator::MPIShmChain *>(m_Aggregator);
+        if (a && a->m_Comm.Size() > 1)
         {
-            WriteMetadataFileIndex(m_LatestMetaDataPos, m_LatestMetaDataSize);
+            a->DestroyShm();
         }
+    }
+
+    m_FileDataManager.CloseFiles(transportIndex);
+    // Delete files from temporary storage if draining was on
+
+    if (m_Comm.Rank() == 0)
+    {
+        WaitForMetadataWrite();
+        // close metadata file
+        m_FileMetadataManager.CloseFiles();
+
+        // close metametadata file
+        m_FileMetaMetadataManager.CloseFiles();
+
         // close metadata index file
         UpdateActiveFlag(false);
         m_FileMetadataIndexManager.CloseFiles();
@@ -1717,6 +2067,22 @@ void BP5Writer::FlushProfiler()
             profilingJSONStream.Close();
         }
     }
+
+    if (m_Profiler.TraceEnabled())
+    {
+        const std::vector<char> traceJSON(
+            m_Profiler.AggregateProfilingJSON(m_Profiler.GetRankTraceJSON()));
+        if (m_RankMPI == 0)
+        {
+            const std::string traceFileName =
+                fileTransportIdx > -1 ? m_Name + "/profiling_trace.json"
+                                      : m_Name + "_profiling_trace.json";
+            transport::FileFStream traceJSONStream(m_Comm);
+            traceJSONStream.Open(traceFileName, Mode::Write);
+            traceJSONStream.Write(traceJSON.data(), traceJSON.size());
+            traceJSONStream.Close();
+        }
+    }
 }
 
 size_t BP5Writer::DebugGetDataBufferSize() const
@@ -1724,6 +2090,55 @@ size_t BP5Writer::DebugGetDataBufferSize() const
     return m_BP5Serializer.DebugGetDataBufferSize();
 }
 
+std::map<std::string, double> BP5Writer::GetMetrics() const
+{
+    std::map<std::string, double> metrics;
+    auto lf_Micros = [&](const profiling::ProfilerTimer timer) -> double {
+        return m_Profiler.GetTimer(timer).ProcessTimeMicros();
+    };
+
+    metrics["steps"] = static_cast<double>(m_WriterStep);
+    m_Profiler.AddMetrics(metrics, "endstep", profiling::ProfilerTimer::ES);
+    m_Profiler.AddMetrics(metrics, "performputs", profiling::ProfilerTimer::PP);
+
+    // EndStep split in data and metadata handling
+    metrics["data_mus"] = lf_Micros(profiling::ProfilerTimer::ES_AWD) +
+                          lf_Micros(profiling::ProfilerTimer::PDW);
+    metrics["metadata_mus"] = lf_Micros(profiling::ProfilerTimer::ES_meta1) +
+                              lf_Micros(profiling::ProfilerTimer::ES_meta2);
+    metrics["aggregator_wait_mus"] = lf_Micros(profiling::ProfilerTimer::AggWait);
+    metrics["async_wait_mus"] = lf_Micros(profiling::ProfilerTimer::BS_WaitOnAsync) +
+                                lf_Micros(profiling::ProfilerTimer::DC_WaitOnAsync1) +
+                                lf_Micros(profiling::ProfilerTimer::DC_WaitOnAsync2) +
+                                lf_Micros(profiling::ProfilerTimer::WaitOnAsync) +
+                                lf_Micros(profiling::ProfilerTimer::WaitOnAsyncMetadata);
+
+    metrics["buffer_high_water_bytes"] = static_cast<double>(m_DataBufferHighWater);
+    metrics["async_queue_depth"] = static_cast<double>(AsyncWriteStepsInFlight());
+    metrics["async_queue_bytes"] = static_cast<double>(m_AsyncWriteQueueBytes);
+    metrics["held_steps"] = static_cast<double>(m_HeldSteps.size());
+    metrics["held_bytes"] = static_cast<double>(m_HeldBytes);
+    metrics["buffer_pool_bytes"] =
+        m_BufferAllocator ? static_cast<double>(m_BufferAllocator->PoolBytes()) : 0.0;
+    metrics["operator_wait_mus"] = m_BP5Serializer.m_OperatorWaitMicros;
+    metrics["operator_pending_blocks"] = static_cast<double>(m_BP5Serializer.PendingOperations());
+
+    m_FileDataManager.AddMetrics(metrics, "data_file_");
+    m_FileMetadataManager.AddMetrics(metrics, "metadata_file_");
+    m_FileMetaMetadataManager.AddMetrics(metrics, "metadata_file_");
+    m_FileMetadataIndexManager.AddMetrics(metrics, "metadata_file_");
+
+    for (const auto &op : m_BP5Serializer.m_OperatorBytes)
+    {
+        const std::string prefix = "operator_" + op.first + "_";
+        metrics[prefix + "bytes_in"] = static_cast<double>(op.second.In);
+        metrics[prefix + "bytes_out"] = static_cast<double>(op.second.Out);
+        metrics[prefix + "ratio"] =
+            op.second.Out ? static_cast<double>(op.second.In) / op.second.Out : 0.0;
+    }
+    return metrics;
+}
+
 void BP5Writer::PutCommon(VariableBase &variable, const void *values, bool sync)
 {
     if (!m_BetweenStepPairs)
@@ -1735,6 +2150,9 @@ void BP5Writer::PutCommon(VariableBase &variable, const void *values, bool sync)
     auto memSpace = variable.GetMemorySpace(values);
     if (memSpace != MemorySpace::Host)
         sync = true;
+    else if (m_Parameters.ZeroCopyPuts)
+        // the application keeps all buffers unchanged until EndStep
+        sync = false;
 
     size_t *Shape = NULL;
     size_t *Start = NULL;
@@ -1767,7 +2185,7 @@ void BP5Writer::PutCommon(VariableBase &variable, const void *values, bool sync)
         ObjSize = helper::GetDataTypeSize(variable.m_Type);
     }
 
-    if (!sync)
+    if (!sync && !m_Parameters.ZeroCopyPuts)
     {
         /* If arrays is small, force copying to internal buffer to aggregate
          * small writes */
@@ -19,11 +19,14 @@
 #include "adios2/toolkit/aggregator/mpi/MPIShmChain.h"
 #include "adios2/toolkit/burstbuffer/FileDrainerSingleThread.h"
 #include "adios2/toolkit/format/bp5/BP5Serializer.h"
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 #include "adios2/toolkit/shm/Spinlock.h"
 #include "adios2/toolkit/shm/TokenChain.h"
 #include "adios2/toolkit/transportman/TransportMan.h"
 
+#include <deque>
+
 namespace adios2
 {
 namespace core
@@ -54,6 +57,8 @@ public:
 
     size_t DebugGetDataBufferSize() const final;
 
+    std::map<std::string, double> GetMetrics() const final;
+
 private:
     /** Single object controlling BP buffering */
     format::BP5Serializer m_BP5Serializer;
@@ -168,6 +173,20 @@ private:
 
     void WriteMetadataFileIndex(uint64_t MetaDataPos, uint64_t MetaDataSize);
 
+    /** Aggregate metadata to rank 0 through a k-ary tree over m_Comm,
+     *  k = MetadataAggregationFanout. Merges metametadata at every level. */
+    void AggregateMetadataTree(std::vector<char> &MetaBuffer);
+
+    /** Write the aggregated metadata of all writers, on rank 0 */
+    void WriteAggregatedMetadata(std::vector<char> &Buffer, const std::vector<size_t> &Counts);
+
+    /** Calls WriteAggregatedMetadata, on a background thread if
+     *  AsyncMetadataWrite is set. Takes over the content of Buffer. */
+    void SubmitAggregatedMetadata(std::vector<char> &Buffer, const std::vector<size_t> &Counts);
+
+    /** Wait for the previous step's asynchronous metadata write, on rank 0 */
+    void WaitForMetadataWrite();
+
     uint64_t WriteMetadata(const std::vector<core::iovec> &MetaDataBlocks,
                            const std::vector<core::iovec> &AttributeBlocks);
 
@@ -228,6 +247,9 @@ private:
      */
     uint64_t m_ThisTimestepDataSize = 0;
 
+    /* Largest data buffer handed to WriteData, for GetMetrics */
+    uint64_t m_DataBufferHighWater = 0;
+
     /** rank 0 collects m_StartDataPos in this vector for writing it
      *  to the index file
      */
@@ -259,9 +281,37 @@ private:
 
     /* Async write's future */
     std::future<int> m_WriteFuture;
-    // variables to delay writing to index file
-    uint64_t m_LatestMetaDataPos;
-    uint64_t m_LatestMetaDataSize;
+    /* Async metadata write's future and the buffer it is writing from */
+    std::future<void> m_MetadataWriteFuture;
+    std::vector<char> m_AsyncMetadataBuffer;
+    // rank 0: steps whose index record is delayed until their data is
+    // written, by an async write or with the next batch of held steps
+    struct PendingIndexEntry
+    {
+        uint64_t MetaDataPos;
+        uint64_t MetaDataSize;
+        /* the members are overwritten by later steps, each entry keeps its own */
+        std::vector<uint64_t> WriterDataPos;
+        std::vector<std::vector<size_t>> FlushPosSizeInfo;
+    };
+    std::deque<PendingIndexEntry> m_PendingIndexEntries;
+    /* Writes the index record of the oldest pending entry, adding
+       BatchStart (if not empty) to the data positions of the writers */
+    void WritePendingIndexEntry(const std::vector<uint64_t> &BatchStart = {});
+
+    /* Data buffers of completed steps not written yet, oldest first, with
+       FlushStepsCount > 1 or FlushStepsSize. Their data is contiguous in
+       the file, m_HeldBytes is where the next step's data starts */
+    std::vector<format::BufferV *> m_HeldSteps;
+    uint64_t m_HeldBytes = 0;
+    bool HoldsSteps() const noexcept;
+
+    /* Memory of the data buffers with BufferHugePages, BufferNumaPolicy or
+       BufferPoolSize, plain malloc without it */
+    std::shared_ptr<format::BufferAllocator> m_BufferAllocator;
+    /* Collective. Write the data of all held steps at once, then their
+       index records on rank 0 */
+    void WriteHeldSteps();
     Seconds m_LastTimeBetweenSteps = Seconds(0.0);
     Seconds m_TotalTimeBetweenSteps = Seconds(0.0);
     Seconds m_AvgTimeBetweenSteps = Seconds(0.0);
@@ -309,9 +359,30 @@ private:
         std::vector<ComputationBlockInfo> *currentComputationBlocks; // extended by main thread
         size_t *currentComputationBlockID;                           // increased by main thread
         shm::Spinlock *lock; // race condition over currentComp* variables
+        std::shared_future<int> previousWrite; // wait for this before writing
     };
 
     AsyncWriteInfo *m_AsyncWriteInfo;
+
+    /* Async writes in flight, oldest first. At most AsyncWriteQueueDepth
+       steps are queued, they are written one after the other by their
+       threads, each waiting on the previous one */
+    struct AsyncWriteQueueEntry
+    {
+        std::shared_future<int> future;
+        AsyncWriteInfo *info;
+        int64_t step;
+        uint64_t size;
+    };
+    std::deque<AsyncWriteQueueEntry> m_AsyncWriteQueue;
+    uint64_t m_AsyncWriteQueueBytes = 0;
+
+    /* Number of completed steps with writes still in the queue */
+    size_t AsyncWriteStepsInFlight() const noexcept;
+
+    /* Collective. Wait for the oldest queued steps until at most
+       MaxStepsInFlight remain, writing their index records on rank 0 */
+    void DrainAsyncWrites(const size_t MaxStepsInFlight);
     /* lock to handle race condition over the following currentComp* variables
          m_InComputationBlock / AsyncWriteInfo::inComputationBlock
          m_ComputationBlockID / AsyncWriteInfo::currentComputationBlockID
@@ -342,9 +413,9 @@ private:
     };
     static ComputationStatus IsInComputationBlock(AsyncWriteInfo *info, size_t &compBlockIdx);
 
-    void AsyncWriteDataCleanup();
-    void AsyncWriteDataCleanup_EveryoneWrites();
-    void AsyncWriteDataCleanup_TwoLevelShm();
+    void AsyncWriteDataCleanup(AsyncWriteInfo *info);
+    void AsyncWriteDataCleanup_EveryoneWrites(AsyncWriteInfo *info);
+    void AsyncWriteDataCleanup_TwoLevelShm(AsyncWriteInfo *info);
 };
 
 } // end namespace engine
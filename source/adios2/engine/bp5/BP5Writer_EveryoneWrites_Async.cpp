@@ -190,6 +190,10 @@ void BP5Writer::AsyncWriteOwnData(AsyncWriteInfo *info, std::vector<core::iovec>
 
 int BP5Writer::AsyncWriteThread_EveryoneWrites(AsyncWriteInfo *info)
 {
+    if (info->previousWrite.valid())
+    {
+        info->previousWrite.wait();
+    }
     if (info->tokenChain)
     {
         if (info->rank_chain > 0)
@@ -300,6 +304,10 @@ void BP5Writer::WriteData_EveryoneWrites_Async(format::BufferV *Data, bool Seria
         m_AsyncWriteInfo->currentComputationBlockID = nullptr;
     }
 
+    if (!m_AsyncWriteQueue.empty())
+    {
+        m_AsyncWriteInfo->previousWrite = m_AsyncWriteQueue.back().future;
+    }
     m_WriteFuture =
         std::async(std::launch::async, AsyncWriteThread_EveryoneWrites, m_AsyncWriteInfo);
 
@@ -323,14 +331,13 @@ void BP5Writer::WriteData_EveryoneWrites_Async(format::BufferV *Data, bool Seria
     }
 }
 
-void BP5Writer::AsyncWriteDataCleanup_EveryoneWrites()
+void BP5Writer::AsyncWriteDataCleanup_EveryoneWrites(AsyncWriteInfo *info)
 {
-    if (m_AsyncWriteInfo->tokenChain)
+    if (info->tokenChain)
     {
-        delete m_AsyncWriteInfo->tokenChain;
+        delete info->tokenChain;
     }
-    delete m_AsyncWriteInfo;
-    m_AsyncWriteInfo = nullptr;
+    delete info;
 }
 
 } // end namespace engine
@@ -62,7 +62,8 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
         {
             alignment_size = m_Parameters.DirectIOAlignOffset;
         }
-        a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize, alignment_size);
+        a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize, alignment_size,
+                     m_BufferAllocator.get());
     }
 
     shm::TokenChain<uint64_t> tokenChain(&a->m_Comm);
@@ -126,7 +127,9 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
     {
         // non-aggregators fill shared buffer in marching order
         // they also receive their starting offset this way
+        m_Profiler.Start(profiling::ProfilerTimer::AggWait);
         m_StartDataPos = tokenChain.RecvToken();
+        m_Profiler.Stop(profiling::ProfilerTimer::AggWait);
 
         /*std::cout << "Rank " << m_Comm.Rank()
                   << " non-aggregator recv token to fill shm = "
@@ -138,8 +141,9 @@ void BP5Writer::WriteData_TwoLevelShm(format::BufferV *Data)
         tokenChain.SendToken(nextWriterPos);
     }
 
-    if (a->m_Comm.Size() > 1)
+    if (a->m_Comm.Size() > 1 && m_Parameters.BufferPoolSize == 0)
     {
+        // with a pool the segment is reused by the next step if large enough
         a->DestroyShm();
     }
 }
@@ -192,7 +196,9 @@ void BP5Writer::SendDataToAggregator(format::BufferV *Data)
     while (block < nBlocks)
     {
         // potentially blocking call waiting on Aggregator
+        m_Profiler.Start(profiling::ProfilerTimer::AggWait);
         aggregator::MPIShmChain::ShmDataBuffer *b = a->LockProducerBuffer();
+        m_Profiler.Stop(profiling::ProfilerTimer::AggWait);
         // b->max_size: how much we can copy
         // b->actual_size: how much we actually copy
         b->actual_size = 0;
@@ -257,7 +263,9 @@ void BP5Writer::WriteOthersData(size_t TotalSize)
     while (wrote < TotalSize)
     {
         // potentially blocking call waiting on some non-aggr process
+        m_Profiler.Start(profiling::ProfilerTimer::AggWait);
         aggregator::MPIShmChain::ShmDataBuffer *b = a->LockConsumerBuffer();
+        m_Profiler.Stop(profiling::ProfilerTimer::AggWait);
 
         /*std::cout << "Rank " << m_Comm.Rank()
                   << " write from shm, data_size = " << b->actual_size
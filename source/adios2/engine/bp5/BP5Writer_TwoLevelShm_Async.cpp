@@ -134,6 +134,10 @@ int BP5Writer::AsyncWriteThread_TwoLevelShm(AsyncWriteInfo *info)
 {
     /* DO NOT use MPI in this separate thread, including destroying
        shm segments explicitely (a->DestroyShm) or implicitely (tokenChain) */
+    if (info->previousWrite.valid())
+    {
+        info->previousWrite.wait();
+    }
     Seconds ts = Now() - info->tstart;
     // std::cout << "ASYNC rank " << info->rank_global
     //          << " starts at: " << ts.count() << std::endl;
@@ -197,7 +201,8 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
         {
             alignment_size = m_Parameters.DirectIOAlignOffset;
         }
-        a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize, alignment_size);
+        a->CreateShm(static_cast<size_t>(maxSize), m_Parameters.MaxShmSize, alignment_size,
+                     m_BufferAllocator.get());
     }
 
     if (a->m_IsAggregator)
@@ -316,6 +321,10 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
         m_AsyncWriteInfo->currentComputationBlockID = nullptr;
     }
 
+    if (!m_AsyncWriteQueue.empty())
+    {
+        m_AsyncWriteInfo->previousWrite = m_AsyncWriteQueue.back().future;
+    }
     m_WriteFuture = std::async(std::launch::async, AsyncWriteThread_TwoLevelShm, m_AsyncWriteInfo);
 
     /* At this point it is prohibited in the main thread
@@ -325,17 +334,16 @@ void BP5Writer::WriteData_TwoLevelShm_Async(format::BufferV *Data)
     */
 }
 
-void BP5Writer::AsyncWriteDataCleanup_TwoLevelShm()
+void BP5Writer::AsyncWriteDataCleanup_TwoLevelShm(AsyncWriteInfo *info)
 {
     aggregator::MPIShmChain *a =
-        dynamic_cast<aggregator::MPIShmChain *>(m_AsyncWriteInfo->aggregator);
+        dynamic_cast<aggregator::MPIShmChain *>(info->aggregator);
     if (a->m_Comm.Size() > 1)
     {
         a->DestroyShm();
     }
-    delete m_AsyncWriteInfo->tokenChain;
-    delete m_AsyncWriteInfo;
-    m_AsyncWriteInfo = nullptr;
+    delete info->tokenChain;
+    delete info;
 }
 
 } // end namespace engine
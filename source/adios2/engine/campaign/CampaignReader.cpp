@@ -314,17 +314,17 @@ void CampaignReader::InitTransports()
         m_IOs.push_back(&io);
         m_Engines.push_back(&e);
 
-        auto vmap = io.GetAvailableVariables();
+        auto vmap = io.GetAvailableVariablesLazy();
         auto amap = io.GetAvailableAttributes();
         VarInternalInfo internalInfo(nullptr, m_IOs.size() - 1, m_Engines.size() - 1);
 
-        for (auto &vr : vmap)
+        for (size_t i = 0; i < vmap.Size(); ++i)
         {
-            auto vname = vr.first;
+            const size_t handle = vmap.Handle(i);
             std::string fname = ds.name;
-            std::string newname = fname + "/" + vname;
+            std::string newname = fname + "/" + vmap.Name(i);
 
-            const DataType type = io.InquireVariableType(vname);
+            const DataType type = io.GetVariable(handle)->m_Type;
 
             if (type == DataType::Struct)
             {
@@ -332,7 +332,7 @@ void CampaignReader::InitTransports()
 #define declare_type(T)                                                                            \
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        Variable<T> *vi = io.InquireVariable<T>(vname);                                            \
+        Variable<T> *vi = io.InquireVariable<T>(handle);                                           \
         Variable<T> v = DuplicateVariable(vi, m_IO, newname, internalInfo);                        \
     }
 
@@ -61,6 +61,10 @@ private:
     template <class T>
     void DoPutSyncCommon(Variable<T> &variable, const T *values);
 
+    /** queues the block when H5DeferredPuts is on, written at PerformPuts */
+    template <class T>
+    void DoPutDeferredCommon(Variable<T> &variable, const T *values);
+
     void DoClose(const int transportIndex = -1) final;
 
     /**
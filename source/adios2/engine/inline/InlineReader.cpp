@@ -43,6 +43,8 @@ InlineReader::~InlineReader()
     {
         DestructorClose(m_FailVerbose);
     }
+    // a writer waiting in Close does not wait for steps nobody reads
+    InlineStepQueue::Detach(m_Queue, false);
     m_IsOpen = false;
 }
 
@@ -81,6 +83,20 @@ StepStatus InlineReader::BeginStep(const StepMode mode, const float timeoutSecon
                                           "InlineReader::BeginStep was called but the "
                                           "reader is already inside a step");
     }
+    if (m_Threaded)
+    {
+        bool endOfStream;
+        m_Step = m_Queue->Front(timeoutSeconds, endOfStream);
+        if (!m_Step)
+        {
+            return endOfStream ? StepStatus::EndOfStream : StepStatus::NotReady;
+        }
+        m_CurrentStep = m_Step->Step;
+        InstallStep();
+        m_InsideStep = true;
+        return StepStatus::OK;
+    }
+
     // Reader should be on step that writer just completed
     auto writer = GetWriter();
     if (writer->IsInsideStep())
@@ -120,6 +136,10 @@ size_t InlineReader::CurrentStep() const
     // Reader should be on same step as writer
     // added here since it's not really necessary to use beginstep/endstep for
     // this engine's reader so this ensures we do report the correct step
+    if (m_Threaded)
+    {
+        return m_CurrentStep;
+    }
     const auto writer = GetWriter();
     return writer->CurrentStep();
 }
@@ -142,9 +162,48 @@ void InlineReader::EndStep()
     {
         SetDeferredVariablePointers();
     }
+    if (m_Threaded)
+    {
+        // the writer may reuse the slot, and the buffers, from now on
+        m_Queue->Pop();
+        m_Step = nullptr;
+    }
     m_InsideStep = false;
 }
 
+void InlineReader::InstallStep()
+{
+    for (const auto &pair : m_IO.GetVariables())
+    {
+        const DataType type = pair.second->m_Type;
+        if (type == DataType::Struct)
+        {
+        }
+#define declare_type(T)                                                                            \
+    else if (type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        static_cast<Variable<T> &>(*pair.second).m_BlocksInfo.clear();                             \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+
+    for (size_t i = 0; i < m_Step->NBlocks; ++i)
+    {
+        const InlineBlock &block = m_Step->Blocks[i];
+        if (block.Type == DataType::Struct)
+        {
+        }
+#define declare_type(T)                                                                            \
+    else if (block.Type == helper::GetDataType<T>())                                               \
+    {                                                                                              \
+        InstallBlock<T>(block);                                                                    \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+}
+
 bool InlineReader::IsInsideStep() const { return m_InsideStep; }
 
 // PRIVATE
@@ -200,6 +259,10 @@ void InlineReader::Init()
 {
     InitParameters();
     InitTransports();
+    if (m_Threaded)
+    {
+        m_Queue = InlineStepQueue::Attach(m_Name, false);
+    }
 }
 
 void InlineReader::InitParameters()
@@ -220,6 +283,11 @@ void InlineReader::InitParameters()
                                                      "integer in the range [0,5], in call to "
                                                      "Open or Engine constructor");
         }
+        else if (key == "threaded")
+        {
+            value = helper::LowerCase(value);
+            m_Threaded = (value == "true" || value == "on" || value == "yes");
+        }
     }
 }
 
@@ -235,6 +303,10 @@ void InlineReader::DoClose(const int transportIndex)
     {
         std::cout << "Inline Reader " << m_ReaderRank << " Close(" << m_Name << ")\n";
     }
+    if (m_Threaded)
+    {
+        InlineStepQueue::Detach(m_Queue, false);
+    }
 }
 
 void InlineReader::SetDeferredVariablePointers()
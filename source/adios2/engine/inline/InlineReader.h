@@ -18,6 +18,8 @@
 #include "adios2/helper/adiosComm.h"
 #include "adios2/helper/adiosFunctions.h"
 
+#include "InlineStepQueue.h"
+
 namespace adios2
 {
 namespace core
@@ -67,6 +69,11 @@ private:
     bool m_InsideStep = false;
     std::vector<std::string> m_DeferredVariables;
 
+    // Threaded mode: steps come from a writer on another thread
+    bool m_Threaded = false;
+    std::shared_ptr<InlineStepQueue> m_Queue;
+    const InlineStep *m_Step = nullptr; // the step being read
+
     void Init() final; ///< called from constructor, gets the selected Inline
                        /// transport method from settings
     void InitParameters() final;
@@ -105,6 +112,12 @@ private:
 #undef declare_type
 
     void SetDeferredVariablePointers();
+
+    /** makes the blocks of m_Step those of the variables in this IO */
+    void InstallStep();
+
+    template <class T>
+    void InstallBlock(const InlineBlock &block);
 };
 
 } // end namespace engine
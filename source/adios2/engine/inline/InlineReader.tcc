@@ -14,6 +14,7 @@
 #include "InlineReader.h"
 #include "InlineWriter.h"
 
+#include <cstring>
 #include <iostream>
 
 namespace adios2
@@ -103,6 +104,52 @@ inline typename Variable<T>::BPInfo *InlineReader::GetBlockDeferredCommon(Variab
     return &variable.m_BlocksInfo[variable.m_BlockID];
 }
 
+template <class T>
+T *GetInlineValue(const InlineBlock &block, T &value)
+{
+    std::memcpy(&value, block.Value.data(), sizeof(T));
+    return reinterpret_cast<T *>(const_cast<char *>(block.Value.data()));
+}
+
+template <>
+inline std::string *GetInlineValue(const InlineBlock &block, std::string &value)
+{
+    value = block.String;
+    return const_cast<std::string *>(&block.String);
+}
+
+template <class T>
+void InlineReader::InstallBlock(const InlineBlock &block)
+{
+    Variable<T> *variable = m_IO.InquireVariable<T>(block.Name);
+    if (!variable)
+    {
+        variable = &m_IO.DefineVariable<T>(block.Name, block.Shape, block.Start, block.Count);
+    }
+    variable->m_Shape = block.Shape;
+
+    typename Variable<T>::BPInfo info;
+    info.Shape = block.Shape;
+    info.Start = block.Start;
+    info.Count = block.Count;
+    info.MemoryStart = block.MemoryStart;
+    info.MemoryCount = block.MemoryCount;
+    info.BlockID = variable->m_BlocksInfo.size();
+    info.Step = m_CurrentStep;
+    info.StepsStart = m_CurrentStep;
+    info.StepsCount = 1;
+    info.IsValue = block.IsValue;
+    if (block.IsValue)
+    {
+        info.Data = GetInlineValue(block, info.Value);
+    }
+    else
+    {
+        info.Data = static_cast<T *>(const_cast<void *>(block.Data));
+    }
+    variable->m_BlocksInfo.push_back(info);
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
@@ -0,0 +1,222 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineStepQueue.cpp
+ */
+
+#include "InlineStepQueue.h"
+
+#include "adios2/helper/adiosLog.h"
+
+#include <algorithm>
+#include <chrono>
+#include <map>
+#include <mutex>
+#include <thread>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+namespace
+{
+
+std::mutex RegistryMutex;
+std::map<std::string, std::weak_ptr<InlineStepQueue>> Registry;
+
+/** polls ready() until it holds or timeoutSeconds (< 0: forever) pass */
+template <class F>
+bool WaitFor(F ready, const float timeoutSeconds)
+{
+    const auto start = std::chrono::steady_clock::now();
+    std::chrono::microseconds sleep(0);
+    while (!ready())
+    {
+        if (timeoutSeconds >= 0.0f &&
+            std::chrono::duration<float>(std::chrono::steady_clock::now() - start).count() >=
+                timeoutSeconds)
+        {
+            return false;
+        }
+        if (sleep.count() == 0)
+        {
+            std::this_thread::yield();
+            sleep = std::chrono::microseconds(1);
+        }
+        else
+        {
+            std::this_thread::sleep_for(sleep);
+            sleep = std::min(2 * sleep, std::chrono::microseconds(1000));
+        }
+    }
+    return true;
+}
+}
+
+InlineBlock &InlineStep::NextBlock()
+{
+    if (NBlocks == Blocks.size())
+    {
+        Blocks.emplace_back();
+    }
+    InlineBlock &block = Blocks[NBlocks++];
+    block.Data = nullptr;
+    block.IsValue = false;
+    block.Value.clear();
+    block.String.clear();
+    return block;
+}
+
+char *InlineStep::NextCopy(const size_t size)
+{
+    if (NCopies == Copies.size())
+    {
+        Copies.emplace_back();
+    }
+    std::vector<char> &copy = Copies[NCopies++];
+    if (copy.size() < size)
+    {
+        copy.resize(size);
+    }
+    return copy.data();
+}
+
+void InlineStep::Clear()
+{
+    NBlocks = 0;
+    NCopies = 0;
+}
+
+std::shared_ptr<InlineStepQueue> InlineStepQueue::Attach(const std::string &name,
+                                                         const bool writer)
+{
+    std::lock_guard<std::mutex> lock(RegistryMutex);
+    std::shared_ptr<InlineStepQueue> queue = Registry[name].lock();
+    if (!queue || (writer ? queue->m_WriterAttached : queue->m_ReaderAttached))
+    {
+        queue = std::make_shared<InlineStepQueue>();
+        queue->m_Name = name;
+        Registry[name] = queue;
+    }
+    (writer ? queue->m_WriterAttached : queue->m_ReaderAttached) = true;
+    return queue;
+}
+
+void InlineStepQueue::Detach(std::shared_ptr<InlineStepQueue> &queue, const bool writer)
+{
+    if (!queue)
+    {
+        return;
+    }
+    if (writer)
+    {
+        queue->m_WriterClosed.store(true, std::memory_order_release);
+    }
+    else
+    {
+        queue->CloseReader();
+    }
+    const std::string name = queue->m_Name;
+    std::lock_guard<std::mutex> lock(RegistryMutex);
+    queue.reset();
+    auto it = Registry.find(name);
+    if (it != Registry.end() && it->second.expired())
+    {
+        Registry.erase(it);
+    }
+}
+
+void InlineStepQueue::SetCapacity(const size_t capacity)
+{
+    if (capacity == 0)
+    {
+        helper::Throw<std::invalid_argument>("Engine", "InlineStepQueue", "SetCapacity",
+                                             "QueueDepth must be at least 1");
+    }
+    m_Slots.resize(capacity);
+}
+
+InlineStep *InlineStepQueue::Reserve(const float timeoutSeconds)
+{
+    const size_t head = m_Head.load(std::memory_order_relaxed);
+    const bool free = WaitFor(
+        [&]() {
+            return head - m_Tail.load(std::memory_order_acquire) < m_Slots.size() ||
+                   m_ReaderClosed.load(std::memory_order_acquire);
+        },
+        timeoutSeconds);
+    if (!free)
+    {
+        return nullptr;
+    }
+    InlineStep *step = &m_Slots[head % m_Slots.size()];
+    step->Clear();
+    return step;
+}
+
+void InlineStepQueue::Push()
+{
+    if (!m_ReaderClosed.load(std::memory_order_acquire))
+    {
+        m_Head.store(m_Head.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+    }
+}
+
+bool InlineStepQueue::CloseWriter(const float timeoutSeconds)
+{
+    m_WriterClosed.store(true, std::memory_order_release);
+    {
+        std::lock_guard<std::mutex> lock(RegistryMutex);
+        if (!m_ReaderAttached)
+        {
+            // a reader opening later must not see steps whose buffers are gone
+            auto it = Registry.find(m_Name);
+            if (it != Registry.end() && it->second.lock().get() == this)
+            {
+                Registry.erase(it);
+            }
+            return true;
+        }
+    }
+    const size_t head = m_Head.load(std::memory_order_relaxed);
+    return WaitFor(
+        [&]() {
+            return m_Tail.load(std::memory_order_acquire) == head ||
+                   m_ReaderClosed.load(std::memory_order_acquire);
+        },
+        timeoutSeconds);
+}
+
+InlineStep *InlineStepQueue::Front(const float timeoutSeconds, bool &endOfStream)
+{
+    const size_t tail = m_Tail.load(std::memory_order_relaxed);
+    endOfStream = false;
+    const bool ready = WaitFor(
+        [&]() {
+            // the writer pushes its last step before it closes
+            endOfStream = m_WriterClosed.load(std::memory_order_acquire);
+            return m_Head.load(std::memory_order_acquire) != tail || endOfStream;
+        },
+        timeoutSeconds);
+    if (!ready || m_Head.load(std::memory_order_acquire) == tail)
+    {
+        return nullptr;
+    }
+    endOfStream = false;
+    return &m_Slots[tail % m_Slots.size()];
+}
+
+void InlineStepQueue::Pop()
+{
+    m_Tail.store(m_Tail.load(std::memory_order_relaxed) + 1, std::memory_order_release);
+}
+
+void InlineStepQueue::CloseReader() { m_ReaderClosed.store(true, std::memory_order_release); }
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
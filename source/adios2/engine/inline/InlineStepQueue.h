@@ -0,0 +1,124 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * InlineStepQueue.h
+ * Bounded queue of steps between an inline writer and an inline reader that
+ * run on different threads of the same process
+ */
+
+#ifndef ADIOS2_ENGINE_INLINESTEPQUEUE_H_
+#define ADIOS2_ENGINE_INLINESTEPQUEUE_H_
+
+#include "adios2/common/ADIOSTypes.h"
+
+#include <atomic>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace adios2
+{
+namespace core
+{
+namespace engine
+{
+
+/** One block Put by the writer, without the type */
+struct InlineBlock
+{
+    std::string Name;
+    DataType Type;
+    Dims Shape;
+    Dims Start;
+    Dims Count;
+    Dims MemoryStart;
+    Dims MemoryCount;
+    /** the user's buffer, or a copy owned by the step with CopyOnPut */
+    const void *Data = nullptr;
+    bool IsValue = false;
+    /** single values are always kept, strings in String */
+    std::vector<char> Value;
+    std::string String;
+};
+
+/** Everything the reader sees of one step */
+struct InlineStep
+{
+    size_t Step = 0;
+    std::vector<InlineBlock> Blocks;
+    size_t NBlocks = 0;
+
+    /** copies for CopyOnPut, kept with the slot and reused by later steps */
+    std::vector<std::vector<char>> Copies;
+    size_t NCopies = 0;
+
+    /** a cleared block, reusing the memory of an earlier step's block */
+    InlineBlock &NextBlock();
+    /** a buffer of at least size bytes, valid until the slot is reused */
+    char *NextCopy(const size_t size);
+    void Clear();
+};
+
+/**
+ * Single producer, single consumer ring of InlineStep slots. The writer fills
+ * the slot at the head while the reader works on the one at the tail; neither
+ * takes a lock. Waiting threads back off from yielding to short sleeps.
+ */
+class InlineStepQueue
+{
+public:
+    /**
+     * The queue of the stream name, shared by one writer and one reader.
+     * A new queue is made when the side opening it is already attached.
+     */
+    static std::shared_ptr<InlineStepQueue> Attach(const std::string &name, const bool writer);
+
+    /**
+     * Closes the side if it did not close yet and releases queue. The last
+     * side detaching removes the stream name.
+     */
+    static void Detach(std::shared_ptr<InlineStepQueue> &queue, const bool writer);
+
+    /** writer: number of steps in flight, called before the first step */
+    void SetCapacity(const size_t capacity);
+
+    /** writer: the slot for the next step, nullptr after timeoutSeconds */
+    InlineStep *Reserve(const float timeoutSeconds);
+    /** writer: hands the reserved slot to the reader */
+    void Push();
+    /**
+     * writer: no more steps, wait until the reader has released all of them,
+     * at most timeoutSeconds (< 0: forever). Without a reader attached the
+     * steps are dropped and the stream name is free for a new writer.
+     * @return false if the reader still holds steps
+     */
+    bool CloseWriter(const float timeoutSeconds);
+
+    /**
+     * reader: the oldest step, nullptr if none arrived within timeoutSeconds
+     * or if the writer closed, in which case endOfStream is set
+     */
+    InlineStep *Front(const float timeoutSeconds, bool &endOfStream);
+    /** reader: done with the front step, its slot goes back to the writer */
+    void Pop();
+    /** reader: steps pushed from now on are dropped */
+    void CloseReader();
+
+private:
+    std::string m_Name;
+    std::vector<InlineStep> m_Slots;
+    std::atomic<size_t> m_Head{0};
+    std::atomic<size_t> m_Tail{0};
+    std::atomic<bool> m_WriterClosed{false};
+    std::atomic<bool> m_ReaderClosed{false};
+    // guarded by the registry mutex
+    bool m_WriterAttached = false;
+    bool m_ReaderAttached = false;
+};
+
+} // end namespace engine
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_ENGINE_INLINESTEPQUEUE_H_ */
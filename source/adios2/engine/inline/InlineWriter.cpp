@@ -43,6 +43,8 @@ InlineWriter::~InlineWriter()
     {
         DestructorClose(m_FailVerbose);
     }
+    // the reader sees the end of the stream
+    InlineStepQueue::Detach(m_Queue, true);
     m_IsOpen = false;
 }
 
@@ -89,11 +91,23 @@ StepStatus InlineWriter::BeginStep(StepMode mode, const float timeoutSeconds)
                                           "writer is already inside a step");
     }
 
-    auto reader = GetReader();
-    if (reader && reader->IsInsideStep())
+    if (m_Threaded)
     {
-        m_InsideStep = false;
-        return StepStatus::NotReady;
+        // waits for the reader to release a step when all slots are in use
+        m_Step = m_Queue->Reserve(timeoutSeconds);
+        if (!m_Step)
+        {
+            return StepStatus::NotReady;
+        }
+    }
+    else
+    {
+        auto reader = GetReader();
+        if (reader && reader->IsInsideStep())
+        {
+            m_InsideStep = false;
+            return StepStatus::NotReady;
+        }
     }
     m_InsideStep = true;
     if (m_CurrentStep == static_cast<size_t>(-1))
@@ -119,11 +133,12 @@ StepStatus InlineWriter::BeginStep(StepMode mode, const float timeoutSeconds)
 
 void InlineWriter::ResetVariables()
 {
-    auto availVars = m_IO.GetAvailableVariables();
-    for (auto &varPair : availVars)
+    // names only, the info of the variables is not needed
+    auto availVars = m_IO.GetAvailableVariablesLazy();
+    for (size_t i = 0; i < availVars.Size(); ++i)
     {
-        const auto &name = varPair.first;
-        const DataType type = m_IO.InquireVariableType(name);
+        VariableBase *variableBase = m_IO.GetVariable(availVars.Handle(i));
+        const DataType type = variableBase->m_Type;
 
         if (type == DataType::Struct)
         {
@@ -131,8 +146,7 @@ void InlineWriter::ResetVariables()
 #define declare_type(T)                                                                            \
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        Variable<T> &variable = FindVariable<T>(name, "in call to BeginStep");                     \
-        variable.m_BlocksInfo.clear();                                                             \
+        static_cast<Variable<T> *>(variableBase)->m_BlocksInfo.clear();                            \
     }
         ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
 #undef declare_type
@@ -166,9 +180,34 @@ void InlineWriter::EndStep()
         std::cout << "Inline Writer " << m_WriterRank << " EndStep() Step " << m_CurrentStep
                   << std::endl;
     }
+    if (m_Threaded)
+    {
+        QueueStep();
+    }
     m_InsideStep = false;
 }
 
+void InlineWriter::QueueStep()
+{
+    m_Step->Step = m_CurrentStep;
+    for (const auto &pair : m_IO.GetVariables())
+    {
+        const DataType type = pair.second->m_Type;
+        if (type == DataType::Struct)
+        {
+        }
+#define declare_type(T)                                                                            \
+    else if (type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        QueueBlocks(static_cast<const Variable<T> &>(*pair.second));                               \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+    }
+    m_Queue->Push();
+    m_Step = nullptr;
+}
+
 void InlineWriter::Flush(const int)
 {
     PERFSTUBS_SCOPED_TIMER("InlineWriter::Flush");
@@ -200,6 +239,11 @@ void InlineWriter::Init()
 {
     InitParameters();
     InitTransports();
+    if (m_Threaded)
+    {
+        m_Queue = InlineStepQueue::Attach(m_Name, true);
+        m_Queue->SetCapacity(m_QueueDepth);
+    }
 }
 
 void InlineWriter::InitParameters()
@@ -220,6 +264,24 @@ void InlineWriter::InitParameters()
                                                      "integer in the range [0,5], in call to "
                                                      "Open or Engine constructor");
         }
+        else if (key == "threaded")
+        {
+            value = helper::LowerCase(value);
+            m_Threaded = (value == "true" || value == "on" || value == "yes");
+        }
+        else if (key == "copyonput")
+        {
+            value = helper::LowerCase(value);
+            m_CopyOnPut = (value == "true" || value == "on" || value == "yes");
+        }
+        else if (key == "queuedepth")
+        {
+            m_QueueDepth = helper::StringToSizeT(value, "QueueDepth parameter of Inline engine");
+        }
+        else if (key == "closetimeoutsecs")
+        {
+            m_CloseTimeoutSecs = std::stof(value);
+        }
     }
 }
 
@@ -235,6 +297,20 @@ void InlineWriter::DoClose(const int transportIndex)
     {
         std::cout << "Inline Writer " << m_WriterRank << " Close(" << m_Name << ")\n";
     }
+    if (m_Threaded)
+    {
+        // user buffers have to outlive the steps that point to them, copies
+        // stay with the queue as long as the reader holds it
+        const float timeout = m_CopyOnPut ? 0.0f : m_CloseTimeoutSecs;
+        if (!m_Queue->CloseWriter(timeout) && !m_CopyOnPut)
+        {
+            helper::Log("Engine", "InlineWriter", "DoClose",
+                        "the reader did not release its steps within CloseTimeoutSecs, the "
+                        "buffers Put in them must stay valid until it does",
+                        helper::LogMode::WARNING);
+        }
+        InlineStepQueue::Detach(m_Queue, true);
+    }
     // end of stream
     m_CurrentStep = static_cast<size_t>(-1);
 }
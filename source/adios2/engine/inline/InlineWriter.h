@@ -16,6 +16,8 @@
 #include "adios2/core/Engine.h"
 #include "adios2/helper/adiosComm.h"
 
+#include "InlineStepQueue.h"
+
 namespace adios2
 {
 namespace core
@@ -59,6 +61,14 @@ private:
     bool m_InsideStep = false;
     bool m_ResetVariables = false; // used when PerformPuts is being used
 
+    // Threaded mode: steps go to a reader on another thread through a queue
+    bool m_Threaded = false;
+    bool m_CopyOnPut = false;
+    size_t m_QueueDepth = 2;
+    float m_CloseTimeoutSecs = 60.0f;
+    std::shared_ptr<InlineStepQueue> m_Queue;
+    InlineStep *m_Step = nullptr; // slot of the current step
+
     void Init() final;
     void InitParameters() final;
     void InitTransports() final;
@@ -90,6 +100,12 @@ private:
     void PutDeferredCommon(Variable<T> &variable, const T *data);
 
     void ResetVariables();
+
+    /** adds the blocks of all variables to the step handed to the reader */
+    void QueueStep();
+
+    template <class T>
+    void QueueBlocks(const Variable<T> &variable);
 };
 
 } // end namespace engine
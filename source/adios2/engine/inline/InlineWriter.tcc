@@ -12,6 +12,7 @@
 
 #include "InlineWriter.h"
 
+#include <cstring>
 #include <iostream>
 
 namespace adios2
@@ -56,6 +57,16 @@ void InlineWriter::PutDeferredCommon(Variable<T> &variable, const T *data)
     {
         ResetVariables();
     }
+    if (m_Step && m_CopyOnPut && !variable.m_SingleValue)
+    {
+        // the step owns a copy, the caller may reuse data right away
+        const Dims &count = variable.m_MemoryCount.empty() ? variable.m_Count
+                                                           : variable.m_MemoryCount;
+        const size_t size = helper::GetTotalSize(count, sizeof(T));
+        char *copy = m_Step->NextCopy(size);
+        std::memcpy(copy, data, size);
+        data = reinterpret_cast<const T *>(copy);
+    }
     auto &blockInfo = variable.SetBlockInfo(data, CurrentStep());
     if (variable.m_ShapeID == ShapeID::GlobalValue || variable.m_ShapeID == ShapeID::LocalValue)
     {
@@ -64,6 +75,41 @@ void InlineWriter::PutDeferredCommon(Variable<T> &variable, const T *data)
     }
 }
 
+template <class T>
+void SetInlineValue(InlineBlock &block, const T &value)
+{
+    block.Value.resize(sizeof(T));
+    std::memcpy(block.Value.data(), &value, sizeof(T));
+}
+
+template <>
+inline void SetInlineValue(InlineBlock &block, const std::string &value)
+{
+    block.String = value;
+}
+
+template <class T>
+void InlineWriter::QueueBlocks(const Variable<T> &variable)
+{
+    for (const auto &info : variable.m_BlocksInfo)
+    {
+        InlineBlock &block = m_Step->NextBlock();
+        block.Name = variable.m_Name;
+        block.Type = variable.m_Type;
+        block.Shape = info.Shape;
+        block.Start = info.Start;
+        block.Count = info.Count;
+        block.MemoryStart = info.MemoryStart;
+        block.MemoryCount = info.MemoryCount;
+        block.Data = info.Data;
+        block.IsValue = info.IsValue;
+        if (info.IsValue)
+        {
+            SetInlineValue(block, info.Value);
+        }
+    }
+}
+
 } // end namespace engine
 } // end namespace core
 } // end namespace adios2
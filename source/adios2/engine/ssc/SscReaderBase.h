@@ -72,6 +72,8 @@ protected:
     int m_Verbosity = 0;
     int m_OpenTimeoutSecs = 10;
     bool m_Threading = false;
+    bool m_PersistentWindow = false;
+    int m_RmaChunkSize = 4194304;
 
     IO &m_IO;
 };
@@ -10,6 +10,8 @@
 
 #include "SscReaderGeneric.tcc"
 
+#include <algorithm>
+
 namespace adios2
 {
 namespace core
@@ -45,7 +47,40 @@ void SscReaderGeneric::BeginStepFlexible(StepStatus &status)
         status = StepStatus::EndOfStream;
         return;
     }
-    MPI_Win_create(NULL, 0, 1, MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
+    ExposeWindow();
+}
+
+void SscReaderGeneric::ExposeWindow()
+{
+    if (!m_PersistentWindow)
+    {
+        MPI_Win_create(NULL, 0, 1, MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
+        return;
+    }
+
+    if (!m_WindowCreated)
+    {
+        MPI_Win_create_dynamic(MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
+        MPI_Win_lock_all(0, m_MpiWin);
+        m_WindowCreated = true;
+    }
+
+    // where each writer's buffer is attached this step
+    MPI_Aint address = 0;
+    m_WriterAddresses.resize(m_StreamSize);
+    MPI_Allgather(&address, 1, MPI_AINT, m_WriterAddresses.data(), 1, MPI_AINT, m_StreamComm);
+}
+
+void SscReaderGeneric::ReleaseWindow()
+{
+    if (m_PersistentWindow)
+    {
+        MPI_Barrier(m_StreamComm);
+    }
+    else
+    {
+        MPI_Win_free(&m_MpiWin);
+    }
 }
 
 StepStatus SscReaderGeneric::BeginStep(const StepMode stepMode, const float timeoutSeconds,
@@ -141,7 +176,7 @@ void SscReaderGeneric::EndStepFixed()
 {
     if (m_CurrentStep == 0)
     {
-        MPI_Win_free(&m_MpiWin);
+        ReleaseWindow();
         SyncReadPattern();
     }
     for (const auto &i : m_AllReceivingWriterRanks)
@@ -154,14 +189,14 @@ void SscReaderGeneric::EndStepFixed()
 
 void SscReaderGeneric::EndStepFirstFlexible()
 {
-    MPI_Win_free(&m_MpiWin);
+    ReleaseWindow();
     SyncReadPattern();
     BeginStepFlexible(m_StepStatus);
 }
 
 void SscReaderGeneric::EndStepConsequentFlexible()
 {
-    MPI_Win_free(&m_MpiWin);
+    ReleaseWindow();
     BeginStepFlexible(m_StepStatus);
 }
 
@@ -184,7 +219,7 @@ void SscReaderGeneric::EndStep(const bool readerLocked)
             }
             else
             {
-                MPI_Win_free(&m_MpiWin);
+                ReleaseWindow();
                 SyncReadPattern();
             }
         }
@@ -196,7 +231,7 @@ void SscReaderGeneric::EndStep(const bool readerLocked)
             }
             else
             {
-                MPI_Win_free(&m_MpiWin);
+                ReleaseWindow();
             }
         }
     }
@@ -216,6 +251,7 @@ void SscReaderGeneric::PerformGets()
         m_AllReceivingWriterRanks = ssc::CalculateOverlap(m_GlobalWritePattern, m_LocalReadPattern);
         CalculatePosition(m_GlobalWritePattern, m_AllReceivingWriterRanks);
         size_t newSize = m_AllReceivingWriterRanks.size();
+        bool copied = false;
         if (oldSize != newSize)
         {
             size_t totalDataSize = 0;
@@ -224,77 +260,128 @@ void SscReaderGeneric::PerformGets()
                 totalDataSize += i.second.second;
             }
             m_Buffer.resize(totalDataSize);
-            for (const auto &i : m_AllReceivingWriterRanks)
+            if (m_PersistentWindow)
             {
-                MPI_Win_lock(MPI_LOCK_SHARED, i.first, 0, m_MpiWin);
-                MPI_Get(m_Buffer.data() + i.second.first, static_cast<int>(i.second.second),
-                        MPI_CHAR, i.first, 0, static_cast<int>(i.second.second), MPI_CHAR,
-                        m_MpiWin);
-                MPI_Win_unlock(i.first, m_MpiWin);
+                GetPipelined();
+                copied = true;
+            }
+            else
+            {
+                for (const auto &i : m_AllReceivingWriterRanks)
+                {
+                    MPI_Win_lock(MPI_LOCK_SHARED, i.first, 0, m_MpiWin);
+                    MPI_Get(m_Buffer.data() + i.second.first, static_cast<int>(i.second.second),
+                            MPI_CHAR, i.first, 0, static_cast<int>(i.second.second), MPI_CHAR,
+                            m_MpiWin);
+                    MPI_Win_unlock(i.first, m_MpiWin);
+                }
             }
         }
 
-        for (auto &br : m_LocalReadPattern)
+        if (!copied)
         {
-            if (br.performed)
+            for (const auto &i : m_AllReceivingWriterRanks)
             {
-                continue;
+                CopyBlocks(i.first);
             }
-            for (const auto &i : m_AllReceivingWriterRanks)
+        }
+
+        for (auto &br : m_LocalReadPattern)
+        {
+            br.performed = true;
+        }
+    }
+}
+
+void SscReaderGeneric::GetPipelined()
+{
+    const size_t chunkSize = static_cast<size_t>(std::max(m_RmaChunkSize, 1));
+    std::vector<MPI_Request> requests;
+    std::vector<int> requestRanks;
+    std::unordered_map<int, size_t> pendingChunks;
+    for (const auto &i : m_AllReceivingWriterRanks)
+    {
+        for (size_t offset = 0; offset < i.second.second; offset += chunkSize)
+        {
+            const int count = static_cast<int>(std::min(chunkSize, i.second.second - offset));
+            requests.emplace_back();
+            requestRanks.push_back(i.first);
+            MPI_Rget(m_Buffer.data() + i.second.first + offset, count, MPI_CHAR, i.first,
+                     MPI_Aint_add(m_WriterAddresses[i.first], static_cast<MPI_Aint>(offset)),
+                     count, MPI_CHAR, m_MpiWin, &requests.back());
+            ++pendingChunks[i.first];
+        }
+    }
+
+    // a writer's blocks are copied out as soon as its last chunk is in, while
+    // the chunks of the other writers are still arriving
+    for (size_t done = 0; done < requests.size(); ++done)
+    {
+        int index;
+        MPI_Waitany(static_cast<int>(requests.size()), requests.data(), &index,
+                    MPI_STATUS_IGNORE);
+        const int rank = requestRanks[index];
+        if (--pendingChunks[rank] == 0)
+        {
+            CopyBlocks(rank);
+        }
+    }
+}
+
+void SscReaderGeneric::CopyBlocks(const int writerRank)
+{
+    const auto &v = m_GlobalWritePattern[writerRank];
+    for (auto &br : m_LocalReadPattern)
+    {
+        if (br.performed)
+        {
+            continue;
+        }
+        for (const auto &b : v)
+        {
+            if (b.name == br.name)
             {
-                const auto &v = m_GlobalWritePattern[i.first];
-                for (const auto &b : v)
+                if (b.type == DataType::None)
+                {
+                    helper::Log("Engine", "SscReaderGeneric", "PerformGets", "unknown data type",
+                                m_ReaderRank, m_ReaderRank, 0, m_Verbosity, helper::FATALERROR);
+                }
+                else if (b.type == DataType::String)
+                {
+                    *reinterpret_cast<std::string *>(br.data) =
+                        std::string(b.value.begin(), b.value.end());
+                }
+                else
                 {
-                    if (b.name == br.name)
+                    if (b.shapeId == ShapeID::GlobalArray || b.shapeId == ShapeID::LocalArray)
                     {
-                        if (b.type == DataType::None)
-                        {
-                            helper::Log("Engine", "SscReaderGeneric", "PerformGets",
-                                        "unknown data type", m_ReaderRank, m_ReaderRank, 0,
-                                        m_Verbosity, helper::FATALERROR);
-                        }
-                        else if (b.type == DataType::String)
-                        {
-                            *reinterpret_cast<std::string *>(br.data) =
-                                std::string(b.value.begin(), b.value.end());
-                        }
-                        else
+                        bool empty = false;
+                        for (const auto c : b.count)
                         {
-                            if (b.shapeId == ShapeID::GlobalArray ||
-                                b.shapeId == ShapeID::LocalArray)
+                            if (c == 0)
                             {
-                                bool empty = false;
-                                for (const auto c : b.count)
-                                {
-                                    if (c == 0)
-                                    {
-                                        empty = true;
-                                    }
-                                }
-                                if (empty)
-                                {
-                                    continue;
-                                }
-                                helper::NdCopy(
-                                    m_Buffer.data<char>() + b.bufferStart,
-                                    helper::CoreDims(b.start), helper::CoreDims(b.count), true,
-                                    true, reinterpret_cast<char *>(br.data),
-                                    helper::CoreDims(br.start), helper::CoreDims(br.count), true,
-                                    true, static_cast<int>(b.elementSize),
-                                    helper::CoreDims(b.start), helper::CoreDims(b.count),
-                                    helper::CoreDims(br.memStart), helper::CoreDims(br.memCount));
-                            }
-                            else if (b.shapeId == ShapeID::GlobalValue ||
-                                     b.shapeId == ShapeID::LocalValue)
-                            {
-                                std::memcpy(br.data, m_Buffer.data() + b.bufferStart,
-                                            b.bufferCount);
+                                empty = true;
                             }
                         }
+                        if (empty)
+                        {
+                            continue;
+                        }
+                        helper::NdCopy(m_Buffer.data<char>() + b.bufferStart,
+                                       helper::CoreDims(b.start), helper::CoreDims(b.count), true,
+                                       true, reinterpret_cast<char *>(br.data),
+                                       helper::CoreDims(br.start), helper::CoreDims(br.count),
+                                       true, true, static_cast<int>(b.elementSize),
+                                       helper::CoreDims(b.start), helper::CoreDims(b.count),
+                                       helper::CoreDims(br.memStart),
+                                       helper::CoreDims(br.memCount));
+                    }
+                    else if (b.shapeId == ShapeID::GlobalValue || b.shapeId == ShapeID::LocalValue)
+                    {
+                        std::memcpy(br.data, m_Buffer.data() + b.bufferStart, b.bufferCount);
                     }
                 }
             }
-            br.performed = true;
         }
     }
 }
@@ -401,6 +488,13 @@ void SscReaderGeneric::Close(const int transportIndex)
     {
         BeginStep(StepMode::Read, -1.0, m_ReaderSelectionsLocked);
     }
+
+    if (m_WindowCreated)
+    {
+        MPI_Win_unlock_all(m_MpiWin);
+        MPI_Win_free(&m_MpiWin);
+        m_WindowCreated = false;
+    }
 }
 
 #define declare_type(T)                                                                            \
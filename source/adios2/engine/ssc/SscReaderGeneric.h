@@ -61,6 +61,8 @@ private:
     ssc::BlockVec m_LocalReadPattern;
     ssc::Buffer m_GlobalWritePatternBuffer;
     MPI_Win m_MpiWin;
+    bool m_WindowCreated = false;
+    std::vector<MPI_Aint> m_WriterAddresses;
 
     bool SyncWritePattern();
     void SyncReadPattern();
@@ -69,6 +71,10 @@ private:
     void EndStepFixed();
     void EndStepFirstFlexible();
     void EndStepConsequentFlexible();
+    void ExposeWindow();
+    void ReleaseWindow();
+    void GetPipelined();
+    void CopyBlocks(const int writerRank);
     void CalculatePosition(ssc::BlockVecVec &mapVec, ssc::RankPosMap &allOverlapRanks);
 
     template <typename T>
@@ -28,6 +28,7 @@ SscWriterBase::SscWriterBase(IO &io, const std::string &name, const Mode mode, M
     helper::GetParameter(io.m_Parameters, "Verbose", m_Verbosity);
     helper::GetParameter(io.m_Parameters, "Threading", m_Threading);
     helper::GetParameter(io.m_Parameters, "OpenTimeoutSecs", m_OpenTimeoutSecs);
+    helper::GetParameter(io.m_Parameters, "PersistentWindow", m_PersistentWindow);
 
     int providedMpiMode;
     MPI_Query_thread(&providedMpiMode);
@@ -67,6 +68,11 @@ void SscWriterBase::SyncMpiPattern(MPI_Comm comm)
     int readerMasterStreamRank = -1;
     MPI_Allreduce(&readerMasterStreamRank, &m_ReaderMasterStreamRank, 1, MPI_INT, MPI_MAX,
                   m_StreamComm);
+
+    // both sides have to agree on the window mode, either one can ask for it
+    int persistentWindow = m_PersistentWindow ? 1 : 0;
+    MPI_Allreduce(MPI_IN_PLACE, &persistentWindow, 1, MPI_INT, MPI_MAX, m_StreamComm);
+    m_PersistentWindow = persistentWindow != 0;
 }
 
 }
@@ -61,6 +61,7 @@ protected:
     int m_Verbosity = 0;
     int m_OpenTimeoutSecs = 10;
     bool m_Threading = false;
+    bool m_PersistentWindow = false;
 
     IO &m_IO;
 };
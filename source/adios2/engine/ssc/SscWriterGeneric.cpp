@@ -58,7 +58,7 @@ StepStatus SscWriterGeneric::BeginStep(const StepMode mode, const float timeoutS
         }
         else
         {
-            MPI_Win_free(&m_MpiWin);
+            ReleaseBuffer();
         }
     }
 
@@ -133,9 +133,16 @@ void SscWriterGeneric::Close(const int transportIndex)
     }
     else
     {
-        MPI_Win_free(&m_MpiWin);
+        ReleaseBuffer();
         SyncWritePattern(true);
     }
+
+    if (m_WindowCreated)
+    {
+        MPI_Win_detach(m_MpiWin, m_AttachedBase);
+        MPI_Win_free(&m_MpiWin);
+        m_WindowCreated = false;
+    }
 }
 
 void SscWriterGeneric::PutDeferred(VariableBase &variable, const void *data)
@@ -259,8 +266,8 @@ void SscWriterGeneric::PutDeferred(VariableBase &variable, const void *data)
 void SscWriterGeneric::EndStepFirst()
 {
     SyncWritePattern();
-    MPI_Win_create(m_Buffer.data(), m_Buffer.size(), 1, MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
-    MPI_Win_free(&m_MpiWin);
+    ExposeBuffer();
+    ReleaseBuffer();
     SyncReadPattern();
 }
 
@@ -277,7 +284,53 @@ void SscWriterGeneric::EndStepConsequentFixed()
 void SscWriterGeneric::EndStepConsequentFlexible()
 {
     SyncWritePattern();
-    MPI_Win_create(m_Buffer.data(), m_Buffer.size(), 1, MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
+    ExposeBuffer();
+}
+
+void SscWriterGeneric::ExposeBuffer()
+{
+    if (!m_PersistentWindow)
+    {
+        MPI_Win_create(m_Buffer.data(), m_Buffer.size(), 1, MPI_INFO_NULL, m_StreamComm,
+                       &m_MpiWin);
+        return;
+    }
+
+    if (!m_WindowCreated)
+    {
+        MPI_Win_create_dynamic(MPI_INFO_NULL, m_StreamComm, &m_MpiWin);
+        m_WindowCreated = true;
+    }
+
+    // the buffer only moves when it grows beyond its capacity
+    if (m_Buffer.data() != m_AttachedBase || m_Buffer.size() > m_AttachedSize)
+    {
+        if (m_AttachedBase)
+        {
+            MPI_Win_detach(m_MpiWin, m_AttachedBase);
+        }
+        m_AttachedBase = m_Buffer.data();
+        m_AttachedSize = m_Buffer.size();
+        MPI_Win_attach(m_MpiWin, m_AttachedBase, static_cast<MPI_Aint>(m_AttachedSize));
+    }
+
+    MPI_Aint address;
+    MPI_Get_address(m_AttachedBase, &address);
+    std::vector<MPI_Aint> addresses(m_StreamSize);
+    MPI_Allgather(&address, 1, MPI_AINT, addresses.data(), 1, MPI_AINT, m_StreamComm);
+}
+
+void SscWriterGeneric::ReleaseBuffer()
+{
+    if (m_PersistentWindow)
+    {
+        // readers are done with the buffer once they reach the barrier
+        MPI_Barrier(m_StreamComm);
+    }
+    else
+    {
+        MPI_Win_free(&m_MpiWin);
+    }
 }
 
 void SscWriterGeneric::SyncWritePattern(bool finalStep)
@@ -44,6 +44,9 @@ public:
 
 private:
     MPI_Win m_MpiWin;
+    bool m_WindowCreated = false;
+    void *m_AttachedBase = nullptr;
+    size_t m_AttachedSize = 0;
     std::thread m_EndStepThread;
     ssc::BlockVecVec m_GlobalWritePattern;
     ssc::BlockVecVec m_GlobalReadPattern;
@@ -60,6 +63,8 @@ private:
     void EndStepFirst();
     void EndStepConsequentFixed();
     void EndStepConsequentFlexible();
+    void ExposeBuffer();
+    void ReleaseBuffer();
     void CalculatePosition(ssc::BlockVecVec &writerMapVec, ssc::BlockVecVec &readerMapVec,
                            const int writerRank, ssc::RankPosMap &allOverlapRanks);
 };
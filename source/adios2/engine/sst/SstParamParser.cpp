@@ -247,6 +247,10 @@ void SstParamParser::ParseParams(IO &io, struct _SstParams &Params,
             {
                 parameter = SpecPreloadAuto;
             }
+            else if (method == "learned")
+            {
+                parameter = SpecPreloadLearned;
+            }
             else
             {
                 helper::Throw<std::invalid_argument>(
@@ -12,6 +12,7 @@
 #include "SstParamParser.h"
 #include "SstReader.tcc"
 
+#include <algorithm>
 #include <cstring>
 #include <string>
 
@@ -373,6 +374,7 @@ StepStatus SstReader::BeginStep(StepMode Mode, const float timeout_sec)
         }
 
         m_IO.ResetVariablesStepSelection(true, "in call to SST Reader BeginStep");
+        BP5IssuePrefetch();
     }
     else if (m_WriterMarshalMethod == SstMarshalBP)
     {
@@ -493,6 +495,7 @@ void SstReader::EndStep()
     {
 
         BP5PerformGets();
+        BP5EndPrefetchStep();
     }
     else
     {
@@ -619,7 +622,10 @@ void SstReader::Init()
         }                                                                                          \
         if (m_WriterMarshalMethod == SstMarshalBP5)                                                \
         {                                                                                          \
-            m_BP5Deserializer->QueueGet(variable, data);                                           \
+            if (!BP5PrefetchedGet(variable, data))                                                 \
+            {                                                                                      \
+                m_BP5Deserializer->QueueGet(variable, data);                                       \
+            }                                                                                      \
         }                                                                                          \
     }
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_gets)
@@ -669,8 +675,192 @@ bool SstReader::VariableMinMax(const VariableBase &Var, const size_t Step, MinMa
     return m_BP5Deserializer->VariableMinMax(Var, Step, MinMax);
 }
 
+void SstReader::BP5IssuePrefetch()
+{
+    m_PrefetchIssued.clear();
+    m_PrefetchBuffers.clear();
+    m_PrefetchUsed.clear();
+    if (Params.SpeculativePreloadMode != SpecPreloadLearned || m_PrefetchPattern.empty())
+    {
+        return;
+    }
+
+    // nothing of the application is queued yet, the deserializer only sees
+    // the prefetch until its requests are set aside below
+    const VarMap &variables = m_IO.GetVariables();
+    for (const PrefetchSelection &sel : m_PrefetchPattern)
+    {
+        auto itVariable = variables.find(sel.Name);
+        if (itVariable == variables.end())
+        {
+            continue;
+        }
+        VariableBase &variable = *itVariable->second;
+        if (variable.m_Type != sel.Type || variable.m_ShapeID != ShapeID::GlobalArray ||
+            variable.m_Shape.size() != sel.Start.size())
+        {
+            continue;
+        }
+        bool inside = true;
+        for (size_t i = 0; i < sel.Start.size(); ++i)
+        {
+            inside = inside && sel.Start[i] + sel.Count[i] <= variable.m_Shape[i];
+        }
+        if (!inside)
+        {
+            continue;
+        }
+
+        const SelectionType selectionType = variable.m_SelectionType;
+        const Dims start = variable.m_Start;
+        const Dims count = variable.m_Count;
+        variable.m_SelectionType = SelectionType::BoundingBox;
+        variable.m_Start = sel.Start;
+        variable.m_Count = sel.Count;
+        m_PrefetchBuffers.emplace_back(helper::GetTotalSize(sel.Count) * variable.m_ElementSize);
+        m_BP5Deserializer->QueueGet(variable, m_PrefetchBuffers.back().data());
+        variable.m_SelectionType = selectionType;
+        variable.m_Start = start;
+        variable.m_Count = count;
+        m_PrefetchIssued.push_back(sel);
+        m_PrefetchBytes += m_PrefetchBuffers.back().size();
+    }
+    m_PrefetchUsed.assign(m_PrefetchIssued.size(), false);
+
+    size_t maxReadSize;
+    m_PrefetchReads = m_BP5Deserializer->GenerateReadRequests(true, &maxReadSize);
+    for (const auto &Req : m_PrefetchReads)
+    {
+        void *dp_info = NULL;
+        if (m_CurrentStepMetaData->DP_TimestepInfo)
+        {
+            dp_info = m_CurrentStepMetaData->DP_TimestepInfo[Req.WriterRank];
+        }
+        m_PrefetchHandles.push_back(SstReadRemoteMemory(m_Input, (int)Req.WriterRank,
+                                                        Req.Timestep, Req.StartOffset,
+                                                        Req.ReadLength, Req.DestinationAddr,
+                                                        dp_info));
+    }
+    m_PrefetchRequests = std::move(m_BP5Deserializer->PendingGetRequests);
+    m_BP5Deserializer->PendingGetRequests.clear();
+}
+
+void SstReader::BP5CompletePrefetch()
+{
+    if (!m_PrefetchHandles.empty() || !m_PrefetchReads.empty())
+    {
+        for (const auto &i : m_PrefetchHandles)
+        {
+            if (SstWaitForCompletion(m_Input, i) != SstSuccess)
+            {
+                helper::Throw<std::runtime_error>("Engine", "SstReader", "BP5CompletePrefetch",
+                                                  "Writer failed before returning data");
+            }
+        }
+        m_PrefetchHandles.clear();
+
+        // FinalizeGets places the data by the memory selection the variable
+        // has now, the prefetch buffers are compact
+        std::vector<std::pair<VariableBase *, std::pair<Dims, Dims>>> memorySelections;
+        const VarMap &variables = m_IO.GetVariables();
+        for (const PrefetchSelection &sel : m_PrefetchIssued)
+        {
+            auto itVariable = variables.find(sel.Name);
+            if (itVariable == variables.end() || itVariable->second->m_MemoryStart.empty())
+            {
+                continue;
+            }
+            VariableBase &variable = *itVariable->second;
+            memorySelections.push_back({&variable, {}});
+            std::swap(memorySelections.back().second.first, variable.m_MemoryStart);
+            std::swap(memorySelections.back().second.second, variable.m_MemoryCount);
+        }
+
+        // FinalizeGets looks up the requests the reads were generated from
+        std::vector<format::BP5Deserializer::BP5ArrayRequest> pending;
+        std::swap(pending, m_BP5Deserializer->PendingGetRequests);
+        m_BP5Deserializer->PendingGetRequests = std::move(m_PrefetchRequests);
+        m_BP5Deserializer->FinalizeGets(m_PrefetchReads);
+        m_BP5Deserializer->PendingGetRequests = std::move(pending);
+        for (auto &memorySelection : memorySelections)
+        {
+            std::swap(memorySelection.first->m_MemoryStart, memorySelection.second.first);
+            std::swap(memorySelection.first->m_MemoryCount, memorySelection.second.second);
+        }
+        m_PrefetchRequests.clear();
+        m_PrefetchReads.clear();
+    }
+
+    for (const auto &hit : m_PrefetchHits)
+    {
+        const std::vector<char> &buffer = m_PrefetchBuffers[hit.first];
+        std::memcpy(hit.second, buffer.data(), buffer.size());
+    }
+    m_PrefetchHits.clear();
+}
+
+bool SstReader::BP5PrefetchedGet(VariableBase &variable, void *data)
+{
+    if (Params.SpeculativePreloadMode != SpecPreloadLearned ||
+        variable.m_SelectionType != SelectionType::BoundingBox ||
+        variable.m_ShapeID != ShapeID::GlobalArray || !variable.m_MemoryStart.empty() ||
+        variable.GetMemorySpace(data) != MemorySpace::Host)
+    {
+        // a prefetch buffer holds the selection compact, as it is in the
+        // file, it cannot be copied into a memory selection
+        return false;
+    }
+
+    auto lf_Matches = [&](const PrefetchSelection &sel) {
+        return sel.Name == variable.m_Name && sel.Type == variable.m_Type &&
+               sel.Start == variable.m_Start && sel.Count == variable.m_Count;
+    };
+    if (std::find_if(m_PrefetchRecord.begin(), m_PrefetchRecord.end(), lf_Matches) ==
+        m_PrefetchRecord.end())
+    {
+        m_PrefetchRecord.push_back(
+            {variable.m_Name, variable.m_Type, variable.m_Start, variable.m_Count});
+    }
+
+    auto it = std::find_if(m_PrefetchIssued.begin(), m_PrefetchIssued.end(), lf_Matches);
+    if (it == m_PrefetchIssued.end())
+    {
+        ++m_PrefetchMissCount;
+        return false;
+    }
+    const size_t index = static_cast<size_t>(it - m_PrefetchIssued.begin());
+    m_PrefetchHits.emplace_back(index, data);
+    m_PrefetchUsed[index] = true;
+    ++m_PrefetchHitCount;
+    return true;
+}
+
+void SstReader::BP5EndPrefetchStep()
+{
+    m_PrefetchUnusedCount += std::count(m_PrefetchUsed.begin(), m_PrefetchUsed.end(), false);
+    m_PrefetchPattern = std::move(m_PrefetchRecord);
+    m_PrefetchRecord.clear();
+    m_PrefetchIssued.clear();
+    m_PrefetchBuffers.clear();
+    m_PrefetchUsed.clear();
+}
+
+std::map<std::string, double> SstReader::GetMetrics() const
+{
+    std::map<std::string, double> metrics;
+    if (Params.SpeculativePreloadMode == SpecPreloadLearned)
+    {
+        metrics["prefetch_hits"] = static_cast<double>(m_PrefetchHitCount);
+        metrics["prefetch_misses"] = static_cast<double>(m_PrefetchMissCount);
+        metrics["prefetch_unused"] = static_cast<double>(m_PrefetchUnusedCount);
+        metrics["prefetch_bytes"] = static_cast<double>(m_PrefetchBytes);
+    }
+    return metrics;
+}
+
 void SstReader::BP5PerformGets()
 {
+    BP5CompletePrefetch();
     size_t maxReadSize;
     auto ReadRequests = m_BP5Deserializer->GenerateReadRequests(true, &maxReadSize);
     std::vector<void *> sstReadHandlers;
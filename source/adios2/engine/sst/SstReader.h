@@ -52,6 +52,7 @@ public:
     MinVarInfo *MinBlocksInfo(const VariableBase &, const size_t Step) const;
     bool VarShape(const VariableBase &Var, const size_t Step, Dims &Shape) const;
     bool VariableMinMax(const VariableBase &, const size_t Step, MinMaxStruct &MinMax);
+    std::map<std::string, double> GetMetrics() const final;
 
 private:
     template <class T>
@@ -66,6 +67,43 @@ private:
     void SstBPPerformGets();
     void BP5PerformGets();
     void Init();
+
+    /* --- Used only with BP5 marshaling and SpeculativePreloadMode=Learned --- */
+    /** a bounding box Get of a global array */
+    struct PrefetchSelection
+    {
+        std::string Name;
+        DataType Type;
+        Dims Start;
+        Dims Count;
+    };
+    /** Gets of the current step, the prediction for the next one */
+    std::vector<PrefetchSelection> m_PrefetchRecord;
+    /** Gets of the previous step, prefetched by BeginStep */
+    std::vector<PrefetchSelection> m_PrefetchPattern;
+    /** what BeginStep prefetched, with the data and whether a Get used it */
+    std::vector<PrefetchSelection> m_PrefetchIssued;
+    std::vector<std::vector<char>> m_PrefetchBuffers;
+    std::vector<bool> m_PrefetchUsed;
+    /** reads in flight, kept apart from the application's Gets */
+    std::vector<format::BP5Deserializer::BP5ArrayRequest> m_PrefetchRequests;
+    std::vector<format::BP5Deserializer::ReadRequest> m_PrefetchReads;
+    std::vector<void *> m_PrefetchHandles;
+    /** Gets served from m_PrefetchBuffers, filled by the next PerformGets */
+    std::vector<std::pair<size_t, void *>> m_PrefetchHits;
+    size_t m_PrefetchHitCount = 0;
+    size_t m_PrefetchMissCount = 0;
+    size_t m_PrefetchUnusedCount = 0;
+    size_t m_PrefetchBytes = 0;
+
+    /** issue the reads of m_PrefetchPattern for the current step */
+    void BP5IssuePrefetch();
+    /** wait for the prefetch reads and fill the Gets it serves */
+    void BP5CompletePrefetch();
+    /** record a Get and serve it from the prefetch if possible, not with a memory selection */
+    bool BP5PrefetchedGet(VariableBase &variable, void *data);
+    /** at EndStep, the Gets of this step become the next prediction */
+    void BP5EndPrefetchStep();
     SstStream m_Input;
     SstMarshalMethod m_WriterMarshalMethod;
     int m_WriterIsRowMajor;
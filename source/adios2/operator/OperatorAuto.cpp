@@ -0,0 +1,361 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * OperatorAuto.cpp
+ *
+ * Buffer layout, version 1:
+ *   common header (4 bytes)
+ *   uint8 choice, uint8 candidate index, uint8 element size, uint8 reserved
+ *   uint64 total bytes
+ *   Constant: one element; Stored: the block; Candidate: the buffer of the
+ *   chosen operator, with its own header
+ */
+
+#include "OperatorAuto.h"
+#include "OperatorChain.h"
+#include "OperatorFactory.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <stdexcept>
+
+namespace adios2
+{
+namespace core
+{
+
+namespace
+{
+
+constexpr size_t HeaderSize = 4 + 4 + sizeof(uint64_t);
+// the sample is taken from this many places spread over the block
+constexpr size_t SampleSlices = 4;
+
+bool IsConstant(const char *data, const size_t bytes, const size_t elemSize)
+{
+    if (bytes <= elemSize)
+    {
+        return true;
+    }
+    // compare with the element before, whole blocks of elements at a time
+    size_t done = elemSize;
+    while (done < bytes)
+    {
+        const size_t n = std::min(done, bytes - done);
+        if (std::memcmp(data, data + done, n) != 0)
+        {
+            return false;
+        }
+        done += n;
+    }
+    return true;
+}
+
+/** "pack, delta+shuffle+bzip2" -> {"pack", "delta+shuffle+bzip2"} */
+std::vector<std::string> CandidateNames(const std::string &value)
+{
+    std::vector<std::string> names;
+    std::string name;
+    for (const char c : value + ",")
+    {
+        if (c == ',')
+        {
+            if (!name.empty())
+            {
+                names.push_back(helper::LowerCase(name));
+            }
+            name.clear();
+        }
+        else if (c != ' ')
+        {
+            name += c;
+        }
+    }
+    return names;
+}
+}
+
+OperatorAuto::OperatorAuto(const Params &parameters)
+: Operator("auto", OPERATOR_AUTO, "auto", parameters)
+{
+}
+
+std::shared_ptr<const OperatorAuto::Candidates> OperatorAuto::GetCandidates() const
+{
+    std::lock_guard<std::mutex> lock(m_CandidatesMutex);
+    if (m_Candidates && m_Candidates->Parameters == m_Parameters)
+    {
+        return m_Candidates;
+    }
+
+    std::shared_ptr<Candidates> candidates = std::make_shared<Candidates>();
+    candidates->Parameters = m_Parameters;
+    std::string value = "pack";
+    helper::SetParameterValue("candidates", m_Parameters, value);
+    for (const std::string &name : CandidateNames(value))
+    {
+        std::vector<std::shared_ptr<Operator>> stages;
+        std::string type;
+        for (const char c : name + "+")
+        {
+            if (c != '+')
+            {
+                type += c;
+                continue;
+            }
+            // "zfp.accuracy" goes to the zfp stages as "accuracy"
+            Params params;
+            for (const auto &p : m_Parameters)
+            {
+                if (p.first.size() > type.size() + 1 && p.first[type.size()] == '.' &&
+                    helper::LowerCase(p.first.substr(0, type.size())) == type)
+                {
+                    params[p.first.substr(type.size() + 1)] = p.second;
+                }
+            }
+            if (type == "auto")
+            {
+                helper::Throw<std::invalid_argument>("Operator", "OperatorAuto", "GetCandidates",
+                                                     "auto can not be its own candidate");
+            }
+            stages.push_back(MakeOperator(type, params));
+            type.clear();
+        }
+        candidates->Names.push_back(name);
+        if (stages.size() == 1)
+        {
+            candidates->Operators.push_back(stages.front());
+        }
+        else
+        {
+            candidates->Operators.push_back(std::make_shared<OperatorChain>(stages));
+        }
+    }
+    if (candidates->Operators.size() > 255)
+    {
+        helper::Throw<std::invalid_argument>("Operator", "OperatorAuto", "GetCandidates",
+                                             "at most 255 candidates");
+    }
+    m_Candidates = candidates;
+    return m_Candidates;
+}
+
+size_t OperatorAuto::Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                             const DataType type, char *bufferOut)
+{
+    const uint8_t bufferVersion = 1;
+    const size_t elemSize = helper::GetDataTypeSize(type);
+    const size_t totalBytes = helper::GetTotalSize(blockCount, elemSize);
+    char *out = bufferOut + HeaderSize;
+    Choice choice = Stored;
+    size_t index = 0;
+    size_t outSize = 0;
+
+    if (totalBytes > 0 && IsConstant(dataIn, totalBytes, elemSize))
+    {
+        choice = Constant;
+        std::memcpy(out, dataIn, elemSize);
+        outSize = elemSize;
+    }
+    else if (totalBytes > 0)
+    {
+        std::string objective = "ratio";
+        std::string minRatioValue = "1.1";
+        std::string bandwidthValue = "1000";
+        std::string sampleValue = "65536";
+        helper::SetParameterValue("objective", m_Parameters, objective);
+        helper::SetParameterValue("min_ratio", m_Parameters, minRatioValue);
+        helper::SetParameterValue("bandwidth", m_Parameters, bandwidthValue);
+        helper::SetParameterValue("sample_bytes", m_Parameters, sampleValue);
+        objective = helper::LowerCase(objective);
+        if (objective != "ratio" && objective != "time")
+        {
+            helper::Throw<std::invalid_argument>("Operator", "OperatorAuto", "Operate",
+                                                 "objective must be ratio or time, not " +
+                                                     objective);
+        }
+        const double minRatio = helper::StringTo<double>(minRatioValue, "auto min_ratio");
+        // MB/s the output is written with, to weigh time spent compressing
+        const double bandwidth =
+            1e6 * helper::StringTo<double>(bandwidthValue, "auto bandwidth");
+        const size_t sampleBytes =
+            std::max(helper::StringToSizeT(sampleValue, "auto sample_bytes"),
+                     SampleSlices * elemSize);
+        if (bandwidth <= 0.0)
+        {
+            helper::Throw<std::invalid_argument>("Operator", "OperatorAuto", "Operate",
+                                                 "bandwidth must be positive");
+        }
+
+        // a small block is its own sample and the best output is kept
+        const bool whole = totalBytes <= sampleBytes;
+        std::vector<char> sampleBuffer;
+        const char *sample = dataIn;
+        size_t sampleSize = totalBytes;
+        Dims sampleStart = blockStart;
+        Dims sampleCount = blockCount;
+        if (!whole)
+        {
+            const size_t elems = totalBytes / elemSize;
+            const size_t sliceElems = sampleBytes / SampleSlices / elemSize;
+            sampleBuffer.resize(SampleSlices * sliceElems * elemSize);
+            for (size_t s = 0; s < SampleSlices; ++s)
+            {
+                const size_t first = s * (elems - sliceElems) / (SampleSlices - 1);
+                std::memcpy(sampleBuffer.data() + s * sliceElems * elemSize,
+                            dataIn + first * elemSize, sliceElems * elemSize);
+            }
+            sample = sampleBuffer.data();
+            sampleSize = sampleBuffer.size();
+            sampleStart = {0};
+            sampleCount = {sampleSize / elemSize};
+        }
+
+        // the cost of storing the block as it is
+        double bestCost = (objective == "ratio") ? -1.0 : sampleSize / bandwidth;
+        const std::shared_ptr<const Candidates> candidates = GetCandidates();
+        std::vector<char> trial, best;
+        size_t bestSize = 0;
+        for (size_t i = 0; i < candidates->Operators.size(); ++i)
+        {
+            Operator &op = *candidates->Operators[i];
+            if (!op.IsDataTypeValid(type))
+            {
+                continue;
+            }
+            trial.resize(op.GetEstimatedSize(sampleSize / elemSize, elemSize, sampleCount.size(),
+                                             sampleCount.data()));
+            const auto start = std::chrono::steady_clock::now();
+            const size_t size = op.Operate(sample, sampleStart, sampleCount, type, trial.data());
+            const double seconds =
+                std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+            if (size == 0 || static_cast<double>(sampleSize) / size < minRatio)
+            {
+                continue;
+            }
+            const double cost = (objective == "ratio")
+                                    ? -static_cast<double>(sampleSize) / size
+                                    : seconds + size / bandwidth;
+            if (cost < bestCost)
+            {
+                bestCost = cost;
+                bestSize = size;
+                choice = Candidate;
+                index = i;
+                std::swap(trial, best);
+            }
+        }
+
+        if (choice == Candidate)
+        {
+            if (whole)
+            {
+                outSize = bestSize;
+                std::memcpy(out, best.data(), outSize);
+            }
+            else
+            {
+                Operator &op = *candidates->Operators[index];
+                outSize = op.Operate(dataIn, blockStart, blockCount, type, out);
+                if (outSize == 0 || outSize >= totalBytes)
+                {
+                    // the sample was not representative
+                    choice = Stored;
+                }
+            }
+        }
+    }
+
+    if (choice == Stored)
+    {
+        index = 0;
+        std::memcpy(out, dataIn, totalBytes);
+        outSize = totalBytes;
+    }
+
+    size_t pos = 0;
+    MakeCommonHeader(bufferOut, pos, bufferVersion);
+    PutParameter(bufferOut, pos, static_cast<uint8_t>(choice));
+    PutParameter(bufferOut, pos, static_cast<uint8_t>(index));
+    PutParameter(bufferOut, pos, static_cast<uint8_t>(elemSize));
+    PutParameter(bufferOut, pos, static_cast<uint8_t>(0));
+    PutParameter(bufferOut, pos, static_cast<uint64_t>(totalBytes));
+    return HeaderSize + outSize;
+}
+
+size_t OperatorAuto::InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut)
+{
+    size_t pos = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, pos);
+    pos += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        helper::Throw<std::runtime_error>("Operator", "OperatorAuto", "InverseOperate",
+                                          "invalid auto buffer version");
+    }
+
+    const Choice choice = static_cast<Choice>(GetParameter<uint8_t>(bufferIn, pos));
+    pos += 1; // the candidate index is for information only
+    const size_t elemSize = GetParameter<uint8_t>(bufferIn, pos);
+    pos += 1;
+    const size_t totalBytes = static_cast<size_t>(GetParameter<uint64_t>(bufferIn, pos));
+    const char *data = bufferIn + HeaderSize;
+    const size_t dataSize = sizeIn - HeaderSize;
+
+    switch (choice)
+    {
+    case Constant:
+        if (elemSize == 0 || dataSize < elemSize || totalBytes % elemSize)
+        {
+            break;
+        }
+        if (totalBytes > 0)
+        {
+            std::memcpy(dataOut, data, elemSize);
+        }
+        // double the filled part until the block is full
+        for (size_t done = elemSize; done < totalBytes;)
+        {
+            const size_t n = std::min(done, totalBytes - done);
+            std::memcpy(dataOut + done, dataOut, n);
+            done += n;
+        }
+        return totalBytes;
+    case Stored:
+        if (dataSize < totalBytes)
+        {
+            break;
+        }
+        std::memcpy(dataOut, data, totalBytes);
+        return totalBytes;
+    case Candidate:
+        return Decompress(data, dataSize, dataOut, MemorySpace::Host);
+    }
+    helper::Throw<std::runtime_error>("Operator", "OperatorAuto", "InverseOperate",
+                                      "corrupted auto buffer");
+    return 0;
+}
+
+bool OperatorAuto::IsDataTypeValid(const DataType type) const
+{
+    return type != DataType::String && type != DataType::Struct && type != DataType::None;
+}
+
+size_t OperatorAuto::GetHeaderSize() const { return HeaderSize; }
+
+size_t OperatorAuto::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize,
+                                      const size_t ndims, const size_t *dims) const
+{
+    size_t size = ElemCount * ElemSize;
+    for (const auto &op : GetCandidates()->Operators)
+    {
+        size = std::max(size, op->GetEstimatedSize(ElemCount, ElemSize, ndims, dims));
+    }
+    return HeaderSize + size;
+}
+
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,76 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * OperatorAuto.h : picks an operator for each block. A constant block is
+ * stored as one value, otherwise the candidates are tried on a sample of the
+ * block and the best one for the objective is applied, or none at all. The
+ * choice is recorded in the block's header.
+ */
+
+#ifndef ADIOS2_OPERATOR_OPERATORAUTO_H_
+#define ADIOS2_OPERATOR_OPERATORAUTO_H_
+
+#include "adios2/core/Operator.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adios2
+{
+namespace core
+{
+
+class OperatorAuto : public Operator
+{
+
+public:
+    OperatorAuto(const Params &parameters);
+
+    ~OperatorAuto() = default;
+
+    size_t Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                   const DataType type, char *bufferOut) final;
+
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    size_t GetHeaderSize() const final;
+
+    size_t GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
+                            const size_t *dims) const final;
+
+    /** What Operate stored for a block, the first byte after the common header */
+    enum Choice : uint8_t
+    {
+        Constant = 0,
+        Stored = 1,
+        Candidate = 2
+    };
+
+private:
+    /** the operators named by the "candidates" parameter */
+    struct Candidates
+    {
+        Params Parameters;
+        std::vector<std::string> Names;
+        std::vector<std::shared_ptr<Operator>> Operators;
+    };
+
+    /**
+     * Built from the parameters on first use and again after they change.
+     * Operate may run on another thread than GetEstimatedSize, each keeps
+     * the list it started with.
+     */
+    mutable std::mutex m_CandidatesMutex;
+    mutable std::shared_ptr<const Candidates> m_Candidates;
+
+    std::shared_ptr<const Candidates> GetCandidates() const;
+};
+
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_OPERATORAUTO_H_ */
@@ -0,0 +1,335 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * OperatorChain.cpp
+ *
+ * Buffer layout, version 1:
+ *   common header (4 bytes)
+ *   uint8 number of stages
+ *   per stage: uint8 kind, uint8 carried header size, uint64 output size,
+ *              carried header (kind Typed only)
+ *   output of the last stage that ran
+ * A Typed stage's own header is carried in the chain header because the
+ * next stage only sees the data after it.
+ */
+
+#include "OperatorChain.h"
+#include "OperatorFactory.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace adios2
+{
+namespace core
+{
+
+namespace
+{
+enum StageKind : uint8_t
+{
+    Whole = 0,  // the next stage got the whole output as bytes
+    Typed = 1,  // the next stage got the output after the header, typed
+    Skipped = 2 // Operate returned 0, the next stage got this stage's input
+};
+
+constexpr size_t StageInfoSize = 2 + sizeof(uint64_t);
+
+struct StageInfo
+{
+    StageKind Kind;
+    uint8_t CarriedSize;
+    uint64_t OutSize;
+    const char *Carried;
+};
+}
+
+OperatorChain::ScratchPair::ScratchPair(OperatorChain &chain) : Chain(chain)
+{
+    std::lock_guard<std::mutex> lock(Chain.m_ScratchMutex);
+    for (auto &buffer : Buffers)
+    {
+        if (Chain.m_Scratch.empty())
+        {
+            buffer.reset(new std::vector<char>());
+        }
+        else
+        {
+            buffer = std::move(Chain.m_Scratch.back());
+            Chain.m_Scratch.pop_back();
+        }
+    }
+}
+
+OperatorChain::ScratchPair::~ScratchPair()
+{
+    std::lock_guard<std::mutex> lock(Chain.m_ScratchMutex);
+    for (auto &buffer : Buffers)
+    {
+        Chain.m_Scratch.push_back(std::move(buffer));
+    }
+}
+
+OperatorChain::OperatorChain(const Params &parameters)
+: Operator("chain", OPERATOR_CHAIN, "chain", parameters)
+{
+}
+
+OperatorChain::OperatorChain(const std::vector<std::shared_ptr<Operator>> &stages)
+: Operator("chain", OPERATOR_CHAIN, "chain", {}), m_Stages(stages)
+{
+    if (m_Stages.empty() || m_Stages.size() > 255)
+    {
+        helper::Throw<std::invalid_argument>("Operator", "OperatorChain", "OperatorChain",
+                                             "a chain has 1 to 255 operators");
+    }
+}
+
+std::string OperatorChain::StagesString(const std::vector<std::shared_ptr<Operator>> &stages)
+{
+    std::string s;
+    for (const auto &op : stages)
+    {
+        s += (s.empty() ? "" : "+") + op->m_TypeString;
+    }
+    return s;
+}
+
+bool OperatorChain::PassesTyped(const size_t i) const
+{
+    return i + 1 < m_Stages.size() && m_Stages[i]->m_Category == "precondition";
+}
+
+size_t OperatorChain::ChainHeaderSize() const
+{
+    size_t size = 4 + 1 + m_Stages.size() * StageInfoSize;
+    for (size_t i = 0; i < m_Stages.size(); ++i)
+    {
+        if (PassesTyped(i))
+        {
+            size += m_Stages[i]->GetHeaderSize();
+        }
+    }
+    return size;
+}
+
+size_t OperatorChain::CarriedOffset(const size_t i) const
+{
+    size_t offset = 4 + 1;
+    for (size_t s = 0; s < i; ++s)
+    {
+        offset += StageInfoSize + (PassesTyped(s) ? m_Stages[s]->GetHeaderSize() : 0);
+    }
+    return offset + StageInfoSize;
+}
+
+size_t OperatorChain::Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                              const DataType type, char *bufferOut)
+{
+    const uint8_t bufferVersion = 1;
+    const size_t headerSize = ChainHeaderSize();
+    std::vector<StageInfo> infos(m_Stages.size());
+
+    ScratchPair scratch(*this);
+    // which scratch buffer holds the input, -1 for dataIn
+    int inBuffer = -1;
+    const char *in = dataIn;
+    size_t inSize = helper::GetTotalSize(blockCount, helper::GetDataTypeSize(type));
+    DataType inType = type;
+    Dims inStart = blockStart;
+    Dims inCount = blockCount;
+    bool placed = false;
+
+    for (size_t i = 0; i < m_Stages.size(); ++i)
+    {
+        Operator &op = *m_Stages[i];
+        const bool last = (i + 1 == m_Stages.size());
+        char *out = bufferOut + headerSize;
+        int outBuffer = -1;
+        if (!last)
+        {
+            outBuffer = (inBuffer == 0 ? 1 : 0);
+            std::vector<char> &buffer = *scratch.Buffers[outBuffer];
+            const size_t elemSize = helper::GetDataTypeSize(inType);
+            buffer.resize(op.GetEstimatedSize(inSize / elemSize, elemSize, inCount.size(),
+                                              inCount.data()));
+            out = buffer.data();
+        }
+
+        const size_t outSize = op.Operate(in, inStart, inCount, inType, out);
+        infos[i] = {Skipped, 0, 0, nullptr};
+        if (outSize == 0)
+        {
+            continue;
+        }
+        infos[i].OutSize = outSize;
+        if (PassesTyped(i))
+        {
+            infos[i].Kind = Typed;
+            infos[i].CarriedSize = static_cast<uint8_t>(op.GetHeaderSize());
+            // scratch buffers are reused, keep the header now
+            std::memcpy(bufferOut + CarriedOffset(i), out, infos[i].CarriedSize);
+            in = out + infos[i].CarriedSize;
+            inSize = outSize - infos[i].CarriedSize;
+        }
+        else
+        {
+            infos[i].Kind = Whole;
+            in = out;
+            inSize = outSize;
+            inType = DataType::UInt8;
+            inStart = {0};
+            inCount = {outSize};
+        }
+        inBuffer = outBuffer;
+        placed = last;
+    }
+
+    if (!placed)
+    {
+        // the last stage did not apply, store what it was given
+        std::memcpy(bufferOut + headerSize, in, inSize);
+    }
+
+    size_t pos = 0;
+    MakeCommonHeader(bufferOut, pos, bufferVersion);
+    PutParameter(bufferOut, pos, static_cast<uint8_t>(m_Stages.size()));
+    for (size_t i = 0; i < m_Stages.size(); ++i)
+    {
+        // a skipped Typed stage still reserved room for its header
+        const uint8_t carried =
+            PassesTyped(i) ? static_cast<uint8_t>(m_Stages[i]->GetHeaderSize()) : 0;
+        PutParameter(bufferOut, pos, static_cast<uint8_t>(infos[i].Kind));
+        PutParameter(bufferOut, pos, carried);
+        PutParameter(bufferOut, pos, infos[i].OutSize);
+        pos += carried;
+    }
+    return headerSize + inSize;
+}
+
+size_t OperatorChain::InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut)
+{
+    size_t pos = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, pos);
+    pos += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        helper::Throw<std::runtime_error>("Operator", "OperatorChain", "InverseOperate",
+                                          "invalid chain buffer version");
+    }
+
+    const size_t nStages = GetParameter<uint8_t>(bufferIn, pos);
+    std::vector<StageInfo> infos(nStages);
+    for (auto &info : infos)
+    {
+        info.Kind = static_cast<StageKind>(GetParameter<uint8_t>(bufferIn, pos));
+        info.CarriedSize = GetParameter<uint8_t>(bufferIn, pos);
+        info.OutSize = GetParameter<uint64_t>(bufferIn, pos);
+        info.Carried = bufferIn + pos;
+        pos += info.CarriedSize;
+    }
+    if (pos > sizeIn)
+    {
+        helper::Throw<std::runtime_error>("Operator", "OperatorChain", "InverseOperate",
+                                          "corrupted chain buffer");
+    }
+
+    ScratchPair scratch(*this);
+    // what the stage after the current one was given
+    const char *data = bufferIn + pos;
+    size_t dataSize = sizeIn - pos;
+    // scratch buffer holding data, -1 for bufferIn; when data is the
+    // output of a Typed stage its header is already in front of it
+    int dataBuffer = -1;
+    bool headerInFront = false;
+
+    for (size_t k = nStages; k-- > 0;)
+    {
+        const StageInfo &info = infos[k];
+        if (info.Kind == Skipped)
+        {
+            continue;
+        }
+
+        const char *full = data;
+        size_t fullSize = dataSize;
+        int fullBuffer = dataBuffer;
+        if (info.Kind == Typed)
+        {
+            if (!headerInFront)
+            {
+                fullBuffer = (dataBuffer == 0 ? 1 : 0);
+                std::vector<char> &buffer = *scratch.Buffers[fullBuffer];
+                buffer.resize(info.CarriedSize + dataSize);
+                std::memcpy(buffer.data(), info.Carried, info.CarriedSize);
+                std::memcpy(buffer.data() + info.CarriedSize, data, dataSize);
+            }
+            full = scratch.Buffers[fullBuffer]->data();
+            fullSize = info.CarriedSize + dataSize;
+        }
+
+        size_t j = k;
+        while (j > 0 && infos[j - 1].Kind == Skipped)
+        {
+            --j;
+        }
+        if (j == 0)
+        {
+            return Decompress(full, fullSize, dataOut, MemorySpace::Host);
+        }
+
+        // stage j-1 produced this stage's input
+        const StageInfo &prev = infos[j - 1];
+        const size_t front = (prev.Kind == Typed ? prev.CarriedSize : 0);
+        const int outBuffer = (fullBuffer == 0 ? 1 : 0);
+        std::vector<char> &buffer = *scratch.Buffers[outBuffer];
+        buffer.resize(prev.OutSize);
+        std::memcpy(buffer.data(), prev.Carried, front);
+        dataSize = Decompress(full, fullSize, buffer.data() + front, MemorySpace::Host);
+        data = buffer.data() + front;
+        dataBuffer = outBuffer;
+        headerInFront = (front > 0);
+    }
+
+    // no stage applied
+    std::memcpy(dataOut, data, dataSize);
+    return dataSize;
+}
+
+bool OperatorChain::IsDataTypeValid(const DataType type) const
+{
+    return m_Stages.empty() || m_Stages.front()->IsDataTypeValid(type);
+}
+
+size_t OperatorChain::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize,
+                                       const size_t ndims, const size_t *dims) const
+{
+    size_t elemCount = ElemCount;
+    size_t elemSize = ElemSize;
+    Dims count(dims, dims + ndims);
+    size_t size = ElemCount * ElemSize;
+    for (size_t i = 0; i < m_Stages.size(); ++i)
+    {
+        size_t estimate =
+            m_Stages[i]->GetEstimatedSize(elemCount, elemSize, count.size(), count.data());
+        // a stage that does not apply passes its input on
+        estimate = std::max(estimate, size);
+        if (PassesTyped(i))
+        {
+            size = estimate - m_Stages[i]->GetHeaderSize();
+        }
+        else
+        {
+            size = estimate;
+            elemCount = estimate;
+            elemSize = 1;
+            count = {estimate};
+        }
+    }
+    return ChainHeaderSize() + size;
+}
+
+} // end namespace core
+} // end namespace adios2
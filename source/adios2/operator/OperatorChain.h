@@ -0,0 +1,87 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * OperatorChain.h : runs several operators one after the other, e.g.
+ * delta -> shuffle -> bzip2. The stages are recorded in the chain's header,
+ * so InverseOperate can undo them without knowing the writer's operators.
+ */
+
+#ifndef ADIOS2_OPERATOR_OPERATORCHAIN_H_
+#define ADIOS2_OPERATOR_OPERATORCHAIN_H_
+
+#include "adios2/core/Operator.h"
+
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace adios2
+{
+namespace core
+{
+
+class OperatorChain : public Operator
+{
+
+public:
+    /** reading side, the stages come from the buffer header */
+    OperatorChain(const Params &parameters);
+
+    /**
+     * Writing side. A "precondition" stage that is not the last passes its
+     * output to the next stage with the original type and shape, any other
+     * stage passes it on as a 1D array of bytes.
+     */
+    OperatorChain(const std::vector<std::shared_ptr<Operator>> &stages);
+
+    ~OperatorChain() = default;
+
+    size_t Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                   const DataType type, char *bufferOut) final;
+
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    size_t GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
+                            const size_t *dims) const final;
+
+    const std::vector<std::shared_ptr<Operator>> &Stages() const noexcept { return m_Stages; }
+
+    /** "delta+shuffle+bzip2" */
+    static std::string StagesString(const std::vector<std::shared_ptr<Operator>> &stages);
+
+private:
+    std::vector<std::shared_ptr<Operator>> m_Stages;
+
+    /**
+     * Intermediate results go to scratch buffers that are kept for the next
+     * call. Several threads may run the chain at once, each takes its own.
+     */
+    std::mutex m_ScratchMutex;
+    std::vector<std::unique_ptr<std::vector<char>>> m_Scratch;
+
+    /** two scratch buffers of the pool, given back on destruction */
+    struct ScratchPair
+    {
+        ScratchPair(OperatorChain &chain);
+        ~ScratchPair();
+        OperatorChain &Chain;
+        std::unique_ptr<std::vector<char>> Buffers[2];
+    };
+
+    /** header bytes in front of the last stage's output */
+    size_t ChainHeaderSize() const;
+
+    /** position of stage i's carried header in the chain header */
+    size_t CarriedOffset(const size_t i) const;
+
+    /** true if stage i hands typed data to stage i+1 */
+    bool PassesTyped(const size_t i) const;
+};
+
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_OPERATORCHAIN_H_ */
@@ -9,9 +9,14 @@
  */
 
 #include "OperatorFactory.h"
+#include "OperatorAuto.h"
+#include "OperatorChain.h"
 #include "adios2/helper/adiosFunctions.h"
 #include "adios2/operator/compress/CompressNull.h"
+#include "adios2/operator/compress/CompressPack.h"
 #include "adios2/operator/plugin/PluginOperator.h"
+#include "adios2/operator/precondition/PreconditionDelta.h"
+#include "adios2/operator/precondition/PreconditionShuffle.h"
 #include <numeric>
 
 #ifdef ADIOS2_HAVE_BLOSC2
@@ -70,6 +75,8 @@ std::string OperatorTypeToString(const Operator::OperatorType type)
         return "mgard";
     case Operator::COMPRESS_MGARDPLUS:
         return "mgardplus";
+    case Operator::COMPRESS_PACK:
+        return "pack";
     case Operator::COMPRESS_PNG:
         return "png";
     case Operator::COMPRESS_SIRIUS:
@@ -82,6 +89,14 @@ std::string OperatorTypeToString(const Operator::OperatorType type)
         return "mdr";
     case Operator::PLUGIN_INTERFACE:
         return "plugin";
+    case Operator::OPERATOR_CHAIN:
+        return "chain";
+    case Operator::PRECONDITION_DELTA:
+        return "delta";
+    case Operator::PRECONDITION_SHUFFLE:
+        return "shuffle";
+    case Operator::OPERATOR_AUTO:
+        return "auto";
     default:
         return "null";
     }
@@ -157,6 +172,26 @@ std::shared_ptr<Operator> MakeOperator(const std::string &type, const Params &pa
     {
         ret = std::make_shared<plugin::PluginOperator>(parameters);
     }
+    else if (typeLowerCase == "pack")
+    {
+        ret = std::make_shared<compress::CompressPack>(parameters);
+    }
+    else if (typeLowerCase == "delta")
+    {
+        ret = std::make_shared<precondition::PreconditionDelta>(parameters);
+    }
+    else if (typeLowerCase == "shuffle")
+    {
+        ret = std::make_shared<precondition::PreconditionShuffle>(parameters);
+    }
+    else if (typeLowerCase == "chain")
+    {
+        ret = std::make_shared<OperatorChain>(parameters);
+    }
+    else if (typeLowerCase == "auto")
+    {
+        ret = std::make_shared<OperatorAuto>(parameters);
+    }
     else if (typeLowerCase == "null")
     {
         ret = std::make_shared<compress::CompressNull>(parameters);
@@ -0,0 +1,1118 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressPack.cpp
+ *
+ * Buffer layout, version 2:
+ *   common header (4 bytes)
+ *   uint8 word size, uint8 lanes, uint8 prediction, uint8 reserved
+ *   uint32 chunk size, uint64 total bytes
+ *   per chunk and segment: uint8 coding, uint32 coded size, coded data
+ * The segments of a chunk are its byte planes, the first byte of every
+ * predicted word, then the second byte and so on, and the bytes of a
+ * truncated last word if any. Each is LZ77 or Huffman coded, a repeated byte
+ * or stored as is, whichever is smallest. Version 1 has no Huffman coding
+ * and 64 KiB chunks.
+ */
+
+#include "CompressPack.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <algorithm>
+#include <cstring>
+#include <stdexcept>
+#include <vector>
+
+#ifdef __SSE2__
+#include <emmintrin.h>
+#endif
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+namespace
+{
+
+constexpr size_t HeaderSize = 4 + 4 + sizeof(uint32_t) + sizeof(uint64_t);
+// words per chunk, so a byte plane has 64 KiB and LZ77 offsets fit in 16 bits
+constexpr size_t ChunkWords = 65536;
+constexpr size_t SegmentHeaderSize = 1 + sizeof(uint32_t);
+
+enum Coding : uint8_t
+{
+    Stored = 0,
+    LZ = 1,
+    Repeated = 2,
+    Huffman = 3
+};
+
+enum Prediction : uint8_t
+{
+    None = 0,
+    Xor = 1,
+    Sub = 2
+};
+
+/* prediction and byte planes */
+
+template <class U>
+inline U Load(const char *p, const size_t i)
+{
+    U v;
+    std::memcpy(&v, p + i * sizeof(U), sizeof(U));
+    return v;
+}
+
+/** differences of each word to the one lanes words before */
+template <class U>
+void Predict(const char *in, char *out, const size_t n, const size_t lanes, const Prediction p)
+{
+    for (size_t i = 0; i < n && i < lanes; ++i)
+    {
+        std::memcpy(out + i * sizeof(U), in + i * sizeof(U), sizeof(U));
+    }
+    for (size_t i = lanes; i < n; ++i)
+    {
+        const U v = Load<U>(in, i);
+        const U last = Load<U>(in, i - lanes);
+        const U d = p == Xor ? static_cast<U>(v ^ last) : static_cast<U>(v - last);
+        std::memcpy(out + i * sizeof(U), &d, sizeof(U));
+    }
+}
+
+/** inverse of Predict, in place */
+template <class U>
+void Unpredict(char *data, const size_t n, const size_t lanes, const Prediction p)
+{
+    for (size_t i = lanes; i < n; ++i)
+    {
+        const U d = Load<U>(data, i);
+        const U last = Load<U>(data, i - lanes);
+        const U v = p == Xor ? static_cast<U>(last ^ d) : static_cast<U>(last + d);
+        std::memcpy(data + i * sizeof(U), &v, sizeof(U));
+    }
+}
+
+/** byte planes of words [begin, n), any word size */
+void SplitBytes(const char *in, uint8_t *planes, const size_t begin, const size_t n,
+                const size_t wordSize)
+{
+    for (size_t i = begin; i < n; ++i)
+    {
+        for (size_t b = 0; b < wordSize; ++b)
+        {
+            planes[b * n + i] = static_cast<uint8_t>(in[i * wordSize + b]);
+        }
+    }
+}
+
+void JoinBytes(const uint8_t *planes, char *out, const size_t begin, const size_t n,
+               const size_t wordSize)
+{
+    for (size_t i = begin; i < n; ++i)
+    {
+        for (size_t b = 0; b < wordSize; ++b)
+        {
+            out[i * wordSize + b] = static_cast<char>(planes[b * n + i]);
+        }
+    }
+}
+
+#ifdef __SSE2__
+/*
+ * 16 words of W bytes are W vectors. Moving the even bytes of the vectors in
+ * front of the odd ones sorts the bytes by the lowest bit of their position,
+ * log2(W) such rounds sort them by their position in the word, which gives
+ * one vector per byte plane.
+ */
+template <size_t W>
+inline void Deinterleave(const __m128i *v, __m128i *out)
+{
+    const __m128i low = _mm_set1_epi16(0x00ff);
+    for (size_t j = 0; j < W / 2; ++j)
+    {
+        out[j] = _mm_packus_epi16(_mm_and_si128(v[2 * j], low), _mm_and_si128(v[2 * j + 1], low));
+        out[W / 2 + j] =
+            _mm_packus_epi16(_mm_srli_epi16(v[2 * j], 8), _mm_srli_epi16(v[2 * j + 1], 8));
+    }
+}
+
+template <size_t W>
+inline void Interleave(const __m128i *v, __m128i *out)
+{
+    for (size_t j = 0; j < W / 2; ++j)
+    {
+        out[2 * j] = _mm_unpacklo_epi8(v[j], v[W / 2 + j]);
+        out[2 * j + 1] = _mm_unpackhi_epi8(v[j], v[W / 2 + j]);
+    }
+}
+
+template <size_t W>
+void Shuffle(const char *in, uint8_t *planes, const size_t n)
+{
+    const size_t vectorized = n - n % 16;
+    for (size_t i = 0; i < vectorized; i += 16)
+    {
+        __m128i a[W], b[W];
+        for (size_t k = 0; k < W; ++k)
+        {
+            a[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(in + i * W + 16 * k));
+        }
+        for (size_t r = 1; r < W; r *= 2)
+        {
+            Deinterleave<W>(a, b);
+            std::memcpy(a, b, sizeof(a));
+        }
+        for (size_t k = 0; k < W; ++k)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(planes + k * n + i), a[k]);
+        }
+    }
+    SplitBytes(in, planes, vectorized, n, W);
+}
+
+template <size_t W>
+void Unshuffle(const uint8_t *planes, char *out, const size_t n)
+{
+    const size_t vectorized = n - n % 16;
+    for (size_t i = 0; i < vectorized; i += 16)
+    {
+        __m128i a[W], b[W];
+        for (size_t k = 0; k < W; ++k)
+        {
+            a[k] = _mm_loadu_si128(reinterpret_cast<const __m128i *>(planes + k * n + i));
+        }
+        for (size_t r = 1; r < W; r *= 2)
+        {
+            Interleave<W>(a, b);
+            std::memcpy(a, b, sizeof(a));
+        }
+        for (size_t k = 0; k < W; ++k)
+        {
+            _mm_storeu_si128(reinterpret_cast<__m128i *>(out + i * W + 16 * k), a[k]);
+        }
+    }
+    JoinBytes(planes, out, vectorized, n, W);
+}
+#endif
+
+void Shuffle(const char *in, uint8_t *planes, const size_t n, const size_t wordSize)
+{
+#ifdef __SSE2__
+    switch (wordSize)
+    {
+    case 2:
+        return Shuffle<2>(in, planes, n);
+    case 4:
+        return Shuffle<4>(in, planes, n);
+    case 8:
+        return Shuffle<8>(in, planes, n);
+    }
+#endif
+    SplitBytes(in, planes, 0, n, wordSize);
+}
+
+void Unshuffle(const uint8_t *planes, char *out, const size_t n, const size_t wordSize)
+{
+#ifdef __SSE2__
+    switch (wordSize)
+    {
+    case 2:
+        return Unshuffle<2>(planes, out, n);
+    case 4:
+        return Unshuffle<4>(planes, out, n);
+    case 8:
+        return Unshuffle<8>(planes, out, n);
+    }
+#endif
+    JoinBytes(planes, out, 0, n, wordSize);
+}
+
+/** predicts a chunk into scratch and splits it into byte planes */
+void SplitChunk(const char *in, uint8_t *planes, char *scratch, const size_t bytes,
+                const size_t wordSize, const size_t lanes, const Prediction p)
+{
+    const size_t n = bytes / wordSize;
+    const char *words = in;
+    if (p != None && wordSize <= 8)
+    {
+        if (wordSize == 1)
+            Predict<uint8_t>(in, scratch, n, lanes, p);
+        else if (wordSize == 2)
+            Predict<uint16_t>(in, scratch, n, lanes, p);
+        else if (wordSize == 4)
+            Predict<uint32_t>(in, scratch, n, lanes, p);
+        else
+            Predict<uint64_t>(in, scratch, n, lanes, p);
+        words = scratch;
+    }
+    Shuffle(words, planes, n, wordSize);
+    // bytes of a truncated last word
+    std::memcpy(planes + n * wordSize, in + n * wordSize, bytes - n * wordSize);
+}
+
+void JoinChunk(const uint8_t *planes, char *out, const size_t bytes, const size_t wordSize,
+               const size_t lanes, const Prediction p)
+{
+    const size_t n = bytes / wordSize;
+    Unshuffle(planes, out, n, wordSize);
+    if (p != None && wordSize <= 8)
+    {
+        if (wordSize == 1)
+            Unpredict<uint8_t>(out, n, lanes, p);
+        else if (wordSize == 2)
+            Unpredict<uint16_t>(out, n, lanes, p);
+        else if (wordSize == 4)
+            Unpredict<uint32_t>(out, n, lanes, p);
+        else
+            Unpredict<uint64_t>(out, n, lanes, p);
+    }
+    std::memcpy(out + n * wordSize, planes + n * wordSize, bytes - n * wordSize);
+}
+
+/*
+ * LZ77: sequences of a token (literal count << 4 | match length - 4, 15
+ * meaning more length bytes follow), the literals, a 16 bit offset and the
+ * extra match length bytes. The last sequence has literals only.
+ */
+
+constexpr size_t MinMatch = 4;
+constexpr unsigned HashLog = 13;
+
+inline uint32_t Read32(const uint8_t *p)
+{
+    uint32_t v;
+    std::memcpy(&v, p, sizeof(v));
+    return v;
+}
+
+inline uint32_t Hash(const uint32_t v) { return (v * 2654435761u) >> (32 - HashLog); }
+
+inline uint8_t *PutLength(uint8_t *op, size_t length)
+{
+    for (; length >= 255; length -= 255)
+    {
+        *op++ = 255;
+    }
+    *op++ = static_cast<uint8_t>(length);
+    return op;
+}
+
+/** @return coded size, 0 if it would not fit in capacity */
+size_t Encode(const uint8_t *in, const size_t n, uint8_t *out, const size_t capacity,
+              uint16_t *table)
+{
+    const uint8_t *ip = in;
+    const uint8_t *anchor = in;
+    const uint8_t *const iend = in + n;
+    // leave room to read 4 bytes at the last match start
+    const uint8_t *const mflimit = n > 2 * MinMatch ? iend - 2 * MinMatch : in;
+    uint8_t *op = out;
+    uint8_t *const oend = out + capacity;
+    size_t misses = 0;
+    // give up on data that does not get smaller than capacity in proportion
+    const size_t checkpointStep = 1024;
+    const uint8_t *checkpoint = in + checkpointStep;
+
+    auto lf_Emit = [&](const uint8_t *matchStart, const size_t offset, const size_t length) {
+        const size_t literals = static_cast<size_t>(matchStart - anchor);
+        // token, literals with their length bytes, offset, match length bytes
+        const size_t need = 1 + literals + literals / 255 + 1 + 2 + length / 255 + 1;
+        if (static_cast<size_t>(oend - op) < need)
+        {
+            return false;
+        }
+        const size_t extra = length ? length - MinMatch : 0;
+        uint8_t *token = op++;
+        *token = static_cast<uint8_t>((literals < 15 ? literals : 15) << 4);
+        if (literals >= 15)
+        {
+            op = PutLength(op, literals - 15);
+        }
+        std::memcpy(op, anchor, literals);
+        op += literals;
+        if (length == 0)
+        {
+            return true;
+        }
+        *op++ = static_cast<uint8_t>(offset);
+        *op++ = static_cast<uint8_t>(offset >> 8);
+        *token = static_cast<uint8_t>(*token | (extra < 15 ? extra : 15));
+        if (extra >= 15)
+        {
+            op = PutLength(op, extra - 15);
+        }
+        return true;
+    };
+
+    while (ip < mflimit)
+    {
+        if (ip >= checkpoint)
+        {
+            const size_t consumed = static_cast<size_t>(ip - in);
+            if (static_cast<size_t>(op - out) + static_cast<size_t>(ip - anchor) + consumed / 16 >
+                consumed * capacity / n)
+            {
+                return 0;
+            }
+            checkpoint += checkpointStep;
+        }
+        const uint32_t seq = Read32(ip);
+        const uint32_t h = Hash(seq);
+        const uint8_t *ref = in + table[h];
+        table[h] = static_cast<uint16_t>(ip - in);
+        // the table may hold positions of the previous chunk
+        if (ref >= ip || Read32(ref) != seq)
+        {
+            // skip faster through data that does not match
+            ip += 1 + (misses++ >> 4);
+            continue;
+        }
+        misses = 0;
+
+        const uint8_t *mp = ip + MinMatch;
+        const uint8_t *rp = ref + MinMatch;
+        while (mp + sizeof(uint64_t) <= iend)
+        {
+            uint64_t a, b;
+            std::memcpy(&a, mp, sizeof(a));
+            std::memcpy(&b, rp, sizeof(b));
+            if (a != b)
+            {
+                break;
+            }
+            mp += sizeof(uint64_t);
+            rp += sizeof(uint64_t);
+        }
+        while (mp < iend && *mp == *rp)
+        {
+            ++mp;
+            ++rp;
+        }
+
+        if (!lf_Emit(ip, static_cast<size_t>(ip - ref), static_cast<size_t>(mp - ip)))
+        {
+            return 0;
+        }
+        ip = mp;
+        anchor = ip;
+    }
+
+    ip = iend;
+    if (!lf_Emit(ip, 0, 0))
+    {
+        return 0;
+    }
+    return static_cast<size_t>(op - out);
+}
+
+inline bool GetLength(const uint8_t *&ip, const uint8_t *iend, size_t &length)
+{
+    uint8_t b;
+    do
+    {
+        if (ip >= iend)
+        {
+            return false;
+        }
+        b = *ip++;
+        length += b;
+    } while (b == 255);
+    return true;
+}
+
+/** @return false if the coded data is corrupted */
+bool Decode(const uint8_t *in, const size_t n, uint8_t *out, const size_t outSize)
+{
+    const uint8_t *ip = in;
+    const uint8_t *const iend = in + n;
+    uint8_t *op = out;
+    uint8_t *const oend = out + outSize;
+
+    while (ip < iend)
+    {
+        const uint8_t token = *ip++;
+        size_t literals = token >> 4;
+        if (literals == 15 && !GetLength(ip, iend, literals))
+        {
+            return false;
+        }
+        if (literals > static_cast<size_t>(iend - ip) || literals > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+        std::memcpy(op, ip, literals);
+        ip += literals;
+        op += literals;
+        if (ip == iend)
+        {
+            break;
+        }
+
+        if (iend - ip < 2)
+        {
+            return false;
+        }
+        const size_t offset = ip[0] | static_cast<size_t>(ip[1]) << 8;
+        ip += 2;
+        size_t length = token & 15;
+        if (length == 15 && !GetLength(ip, iend, length))
+        {
+            return false;
+        }
+        length += MinMatch;
+        if (offset == 0 || offset > static_cast<size_t>(op - out) ||
+            length > static_cast<size_t>(oend - op))
+        {
+            return false;
+        }
+        const uint8_t *ref = op - offset;
+        if (offset >= length)
+        {
+            std::memcpy(op, ref, length);
+        }
+        else if (offset == 1)
+        {
+            std::memset(op, *ref, length);
+        }
+        else
+        {
+            for (size_t i = 0; i < length; ++i)
+            {
+                op[i] = ref[i];
+            }
+        }
+        op += length;
+    }
+    return op == oend;
+}
+
+/*
+ * Huffman: 256 code lengths of 4 bits, the uint32 sizes of the first three
+ * streams and four streams, coding the four quarters of the segment. The
+ * canonical codes are read from the lowest bit of each byte on and are at
+ * most HuffmanMaxBits long, so one table lookup decodes a byte. The quarters
+ * are decoded interleaved, which hides the latency of the lookups.
+ */
+
+constexpr unsigned HuffmanMaxBits = 11;
+constexpr size_t HuffmanStreams = 4;
+constexpr size_t HuffmanHeaderSize = 128 + (HuffmanStreams - 1) * sizeof(uint32_t);
+
+/** counts of every step-th byte */
+void Histogram(const uint8_t *in, const size_t n, uint32_t *counts, const size_t step = 1)
+{
+    // eight tables so runs of equal bytes do not wait for one counter
+    uint32_t c[8][256] = {};
+    size_t i = 0;
+    if (step == 1)
+    {
+        for (; i + 8 <= n; i += 8)
+        {
+            uint64_t word;
+            std::memcpy(&word, in + i, sizeof(word));
+            for (size_t k = 0; k < 8; ++k)
+            {
+                ++c[k][(word >> (8 * k)) & 255];
+            }
+        }
+    }
+    for (size_t k = 0; i < n; i += step, ++k)
+    {
+        ++c[k & 7][in[i]];
+    }
+    for (size_t b = 0; b < 256; ++b)
+    {
+        counts[b] = c[0][b] + c[1][b] + c[2][b] + c[3][b] + c[4][b] + c[5][b] + c[6][b] + c[7][b];
+    }
+}
+
+/** log2 of x > 0, within 0.09, from the exponent and mantissa of a float */
+inline float FastLog2(const uint32_t x)
+{
+    const float f = static_cast<float>(x);
+    uint32_t bits;
+    std::memcpy(&bits, &f, sizeof(bits));
+    return static_cast<float>(bits) * (1.0f / (1 << 23)) - 127.0f;
+}
+
+/** order 0 entropy of n bytes with counts, in bytes */
+size_t EntropySize(const uint32_t *counts, const size_t n)
+{
+    const float log2n = FastLog2(static_cast<uint32_t>(n));
+    float bits = 0.0f;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        if (counts[b])
+        {
+            bits += static_cast<float>(counts[b]) * (log2n - FastLog2(counts[b]));
+        }
+    }
+    return static_cast<size_t>(bits / 8.0f);
+}
+
+/** code lengths of a Huffman code of the used bytes, 0 for the others */
+void HuffmanLengths(const uint32_t *counts, uint8_t *lengths)
+{
+    // weight and byte in one key, sorted by weight
+    uint64_t keys[256];
+    uint16_t symbols[256];
+    size_t m = 0;
+    for (uint16_t b = 0; b < 256; ++b)
+    {
+        if (counts[b])
+        {
+            keys[m++] = static_cast<uint64_t>(counts[b]) << 8 | b;
+        }
+    }
+    std::sort(keys, keys + m);
+    for (size_t x = 0; x < m; ++x)
+    {
+        symbols[x] = static_cast<uint16_t>(keys[x] & 255);
+    }
+    std::memset(lengths, 0, 256);
+    if (m == 1)
+    {
+        lengths[symbols[0]] = 1;
+        return;
+    }
+
+    // two queues: leaves by weight and the inner nodes in creation order
+    uint64_t inner[255];
+    uint16_t parent[511];
+    size_t leaf = 0, node = 0;
+    auto lf_Weight = [&](const size_t x) -> uint64_t {
+        return x < m ? keys[x] >> 8 : inner[x - m];
+    };
+    auto lf_Smallest = [&](const size_t created) -> size_t {
+        if (leaf < m && (node == created || (keys[leaf] >> 8) <= inner[node]))
+        {
+            return leaf++;
+        }
+        return m + node++;
+    };
+    for (size_t k = 0; k < m - 1; ++k)
+    {
+        const size_t a = lf_Smallest(k);
+        const size_t b = lf_Smallest(k);
+        inner[k] = lf_Weight(a) + lf_Weight(b);
+        parent[a] = static_cast<uint16_t>(m + k);
+        parent[b] = static_cast<uint16_t>(m + k);
+    }
+
+    // depths from the root, the last inner node, cut at HuffmanMaxBits
+    uint8_t depth[511];
+    depth[2 * m - 2] = 0;
+    const uint32_t limit = 1u << HuffmanMaxBits;
+    uint32_t kraft = 0;
+    for (size_t x = 2 * m - 2; x-- > 0;)
+    {
+        depth[x] = static_cast<uint8_t>(depth[parent[x]] + 1);
+        if (x < m)
+        {
+            depth[x] = static_cast<uint8_t>(std::min<unsigned>(depth[x], HuffmanMaxBits));
+            kraft += limit >> depth[x];
+        }
+    }
+    // the cut codes overfill the code space, lengthen the codes of the
+    // rarest bytes just below the limit until it fits again
+    for (unsigned l = HuffmanMaxBits - 1; kraft > limit && l > 0; --l)
+    {
+        for (size_t x = 0; x < m && kraft > limit; ++x)
+        {
+            if (depth[x] == l)
+            {
+                ++depth[x];
+                kraft -= limit >> (l + 1);
+            }
+        }
+    }
+    for (size_t x = 0; x < m; ++x)
+    {
+        lengths[symbols[x]] = depth[x];
+    }
+}
+
+/** canonical codes of the lengths, bit reversed for the stream */
+void HuffmanCodes(const uint8_t *lengths, uint16_t *codes)
+{
+    unsigned perLength[HuffmanMaxBits + 1] = {};
+    for (size_t b = 0; b < 256; ++b)
+    {
+        ++perLength[lengths[b]];
+    }
+    perLength[0] = 0;
+    unsigned next[HuffmanMaxBits + 1] = {};
+    for (unsigned l = 1; l <= HuffmanMaxBits; ++l)
+    {
+        next[l] = (next[l - 1] + perLength[l - 1]) << 1;
+    }
+    for (size_t b = 0; b < 256; ++b)
+    {
+        const unsigned l = lengths[b];
+        codes[b] = 0;
+        if (l)
+        {
+            const unsigned code = next[l]++;
+            for (unsigned i = 0; i < l; ++i)
+            {
+                codes[b] = static_cast<uint16_t>(codes[b] | ((code >> i) & 1) << (l - 1 - i));
+            }
+        }
+    }
+}
+
+/** upper bound of the coded size, each stream ends in a partial byte */
+size_t HuffmanSize(const uint32_t *counts, const uint8_t *lengths)
+{
+    uint64_t bits = 0;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        bits += static_cast<uint64_t>(counts[b]) * lengths[b];
+    }
+    return HuffmanHeaderSize + static_cast<size_t>(bits / 8) + HuffmanStreams;
+}
+
+/** @return bytes written, 8 more bytes of out may be overwritten */
+size_t HuffmanEncodeStream(const uint8_t *in, const size_t n, const uint16_t *codes,
+                           const uint8_t *lengths, uint8_t *out)
+{
+    uint8_t *op = out;
+    uint64_t bits = 0;
+    unsigned count = 0;
+    size_t i = 0;
+    // up to 7 pending bits and four codes fit in the 64 bit accumulator
+    for (; i + 4 <= n; i += 4)
+    {
+        for (size_t k = 0; k < 4; ++k)
+        {
+            bits |= static_cast<uint64_t>(codes[in[i + k]]) << count;
+            count += lengths[in[i + k]];
+        }
+        std::memcpy(op, &bits, sizeof(bits));
+        op += count >> 3;
+        bits >>= count & ~7u;
+        count &= 7;
+    }
+    for (; i < n; ++i)
+    {
+        bits |= static_cast<uint64_t>(codes[in[i]]) << count;
+        count += lengths[in[i]];
+    }
+    std::memcpy(op, &bits, sizeof(bits));
+    return static_cast<size_t>(op - out) + (count + 7) / 8;
+}
+
+/** @return coded size, out has room for HuffmanSize + 8 bytes */
+size_t HuffmanEncode(const uint8_t *in, const size_t n, const uint8_t *lengths, uint8_t *out)
+{
+    for (size_t b = 0; b < 256; b += 2)
+    {
+        out[b / 2] = static_cast<uint8_t>(lengths[b] | lengths[b + 1] << 4);
+    }
+    uint16_t codes[256];
+    HuffmanCodes(lengths, codes);
+
+    const size_t quarter = (n + HuffmanStreams - 1) / HuffmanStreams;
+    uint8_t *op = out + HuffmanHeaderSize;
+    for (size_t k = 0; k < HuffmanStreams; ++k)
+    {
+        const size_t begin = std::min(k * quarter, n);
+        const size_t size =
+            HuffmanEncodeStream(in + begin, std::min(quarter, n - begin), codes, lengths, op);
+        if (k + 1 < HuffmanStreams)
+        {
+            const uint32_t size32 = static_cast<uint32_t>(size);
+            std::memcpy(out + 128 + k * sizeof(uint32_t), &size32, sizeof(size32));
+        }
+        op += size;
+    }
+    return static_cast<size_t>(op - out);
+}
+
+struct BitReader
+{
+    const uint8_t *ip;
+    const uint8_t *end;
+    uint64_t bits;
+    unsigned count;
+};
+
+/** @return false if the coded data is corrupted */
+bool HuffmanDecode(const uint8_t *in, const size_t size, uint8_t *out, const size_t n)
+{
+    if (size < HuffmanHeaderSize)
+    {
+        return false;
+    }
+    uint8_t lengths[256];
+    uint32_t kraft = 0;
+    for (size_t b = 0; b < 256; ++b)
+    {
+        lengths[b] = static_cast<uint8_t>(b & 1 ? in[b / 2] >> 4 : in[b / 2] & 15);
+        if (lengths[b] > HuffmanMaxBits)
+        {
+            return false;
+        }
+        kraft += lengths[b] ? 1u << (HuffmanMaxBits - lengths[b]) : 0;
+    }
+    if (kraft > 1u << HuffmanMaxBits)
+    {
+        return false;
+    }
+    uint16_t codes[256];
+    HuffmanCodes(lengths, codes);
+    // length | byte << 8 for every HuffmanMaxBits bits starting with a code,
+    // unused bits decode as length 0, so the stream stops advancing
+    uint16_t table[size_t(1) << HuffmanMaxBits] = {};
+    for (size_t b = 0; b < 256; ++b)
+    {
+        for (size_t x = codes[b]; lengths[b] && x < (size_t(1) << HuffmanMaxBits);
+             x += size_t(1) << lengths[b])
+        {
+            table[x] = static_cast<uint16_t>(lengths[b] | b << 8);
+        }
+    }
+
+    const uint8_t *const iend = in + size;
+    BitReader r[HuffmanStreams];
+    const uint8_t *ip = in + HuffmanHeaderSize;
+    for (size_t k = 0; k < HuffmanStreams; ++k)
+    {
+        size_t streamSize = static_cast<size_t>(iend - ip);
+        if (k + 1 < HuffmanStreams)
+        {
+            uint32_t size32;
+            std::memcpy(&size32, in + 128 + k * sizeof(uint32_t), sizeof(size32));
+            if (size32 > streamSize)
+            {
+                return false;
+            }
+            streamSize = size32;
+        }
+        r[k] = {ip, ip + streamSize, 0, 0};
+        ip += streamSize;
+    }
+
+    const size_t quarter = (n + HuffmanStreams - 1) / HuffmanStreams;
+    const uint64_t mask = (uint64_t(1) << HuffmanMaxBits) - 1;
+    // refill to at least 56 bits, reading past the stream is harmless
+    auto lf_Refill = [&](BitReader &b) {
+        uint64_t word;
+        std::memcpy(&word, b.ip, sizeof(word));
+        b.bits |= word << b.count;
+        b.ip += (63 - b.count) >> 3;
+        b.count |= 56;
+    };
+    auto lf_Decode = [&](BitReader &b, uint8_t *op) {
+        const unsigned e = table[b.bits & mask];
+        *op = static_cast<uint8_t>(e >> 8);
+        b.bits >>= e & 63;
+        b.count -= e & 63;
+    };
+    // four bytes of each quarter per round, the last quarter is the shortest
+    size_t i = 0;
+    const size_t last = n - std::min(n, (HuffmanStreams - 1) * quarter);
+    BitReader r0 = r[0], r1 = r[1], r2 = r[2], r3 = r[3];
+    uint8_t *o0 = out, *o1 = out + quarter, *o2 = out + 2 * quarter, *o3 = out + 3 * quarter;
+    for (; i + 4 <= last && iend - r3.ip >= 8 && iend - r2.ip >= 8 && iend - r1.ip >= 8 &&
+           iend - r0.ip >= 8;
+         i += 4)
+    {
+        lf_Refill(r0);
+        lf_Refill(r1);
+        lf_Refill(r2);
+        lf_Refill(r3);
+        for (size_t j = i; j < i + 4; ++j)
+        {
+            lf_Decode(r0, o0 + j);
+            lf_Decode(r1, o1 + j);
+            lf_Decode(r2, o2 + j);
+            lf_Decode(r3, o3 + j);
+        }
+    }
+    r[0] = r0;
+    r[1] = r1;
+    r[2] = r2;
+    r[3] = r3;
+
+    for (size_t k = 0; k < HuffmanStreams; ++k)
+    {
+        BitReader &b = r[k];
+        const size_t begin = std::min(k * quarter, n);
+        const size_t end = std::min(begin + quarter, n);
+        for (size_t j = begin + i; j < end; ++j)
+        {
+            while (b.count < HuffmanMaxBits && b.ip < b.end)
+            {
+                b.bits |= static_cast<uint64_t>(*b.ip++) << b.count;
+                b.count += 8;
+            }
+            const uint16_t e = table[b.bits & mask];
+            const unsigned length = e & 63;
+            if (!length || length > b.count)
+            {
+                return false;
+            }
+            out[j] = static_cast<uint8_t>(e >> 8);
+            b.bits >>= length;
+            b.count -= length;
+        }
+        // the codes must end in the last byte of the stream
+        const ptrdiff_t unread = (b.end - b.ip) * 8 + static_cast<ptrdiff_t>(b.count);
+        if (unread < 0 || unread > 7)
+        {
+            return false;
+        }
+    }
+    return true;
+}
+
+/** the segments of a chunk of bytes, see the buffer layout */
+void Segments(const size_t bytes, const size_t wordSize, std::vector<size_t> &sizes)
+{
+    const size_t n = bytes / wordSize;
+    sizes.assign(n ? wordSize : 0, n);
+    if (bytes - n * wordSize)
+    {
+        sizes.push_back(bytes - n * wordSize);
+    }
+}
+
+/** @return bytes written to out, which has room for SegmentHeaderSize + n */
+size_t EncodeSegment(const uint8_t *in, const size_t n, char *out, uint16_t *table)
+{
+    uint8_t *coded = reinterpret_cast<uint8_t *>(out + SegmentHeaderSize);
+    Coding coding = Repeated;
+    size_t codedSize = 1;
+    if (std::find_if(in, in + n, [&](const uint8_t b) { return b != in[0]; }) == in + n)
+    {
+        coded[0] = in[0];
+    }
+    else
+    {
+        // build the Huffman code only if the entropy of a sample promises a
+        // gain, its streams are written 8 bytes at a time
+        const size_t step = n >= 16384 ? 8 : 1;
+        uint32_t counts[256];
+        Histogram(in, n, counts, step);
+        uint8_t lengths[256];
+        size_t best = n;
+        if (EntropySize(counts, (n + step - 1) / step) * step + HuffmanHeaderSize +
+                sizeof(uint64_t) <
+            n - n / 32)
+        {
+            if (step > 1)
+            {
+                Histogram(in, n, counts);
+            }
+            HuffmanLengths(counts, lengths);
+            const size_t huffmanSize = HuffmanSize(counts, lengths);
+            if (huffmanSize + sizeof(uint64_t) <= n)
+            {
+                best = huffmanSize;
+            }
+        }
+
+        // only keep the LZ coding if it is smaller
+        coding = LZ;
+        codedSize = Encode(in, n, coded, best - 1, table);
+        if (codedSize == 0 && best < n)
+        {
+            coding = Huffman;
+            codedSize = HuffmanEncode(in, n, lengths, coded);
+        }
+        else if (codedSize == 0)
+        {
+            coding = Stored;
+            codedSize = n;
+            std::memcpy(coded, in, n);
+        }
+    }
+    out[0] = static_cast<char>(coding);
+    const uint32_t size = static_cast<uint32_t>(codedSize);
+    std::memcpy(out + 1, &size, sizeof(size));
+    return SegmentHeaderSize + codedSize;
+}
+
+/** @return false if the coded data is corrupted */
+bool DecodeSegment(const Coding coding, const uint8_t *coded, const size_t codedSize,
+                   uint8_t *out, const size_t n)
+{
+    switch (coding)
+    {
+    case Stored:
+        if (codedSize != n)
+        {
+            return false;
+        }
+        std::memcpy(out, coded, n);
+        return true;
+    case LZ:
+        return Decode(coded, codedSize, out, n);
+    case Repeated:
+        if (codedSize != 1)
+        {
+            return false;
+        }
+        std::memset(out, coded[0], n);
+        return true;
+    case Huffman:
+        return HuffmanDecode(coded, codedSize, out, n);
+    default:
+        return false;
+    }
+}
+
+} // end anonymous namespace
+
+CompressPack::CompressPack(const Params &parameters)
+: Operator("pack", COMPRESS_PACK, "compress", parameters)
+{
+}
+
+size_t CompressPack::Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                             const DataType type, char *bufferOut)
+{
+    const uint8_t bufferVersion = 2;
+    size_t bufferOutOffset = 0;
+    MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
+
+    size_t wordSize = helper::GetDataTypeSize(type);
+    uint8_t lanes = 1;
+    if (type == DataType::FloatComplex || type == DataType::DoubleComplex)
+    {
+        wordSize /= 2;
+        lanes = 2;
+    }
+    const bool floating = type == DataType::Float || type == DataType::Double || lanes == 2;
+
+    std::string predict = "auto";
+    helper::SetParameterValue("predict", m_Parameters, predict);
+    predict = helper::LowerCase(predict);
+    Prediction p;
+    if (predict == "auto")
+    {
+        p = wordSize > 8 ? None : (floating ? Xor : Sub);
+    }
+    else if (predict == "xor" || predict == "sub" || predict == "none")
+    {
+        p = predict == "xor" ? Xor : (predict == "sub" ? Sub : None);
+    }
+    else
+    {
+        helper::Throw<std::invalid_argument>("Operator", "CompressPack", "Operate",
+                                             "predict must be auto, xor, sub or none, not " +
+                                                 predict);
+    }
+
+    const uint64_t totalBytes = helper::GetTotalSize(blockCount, helper::GetDataTypeSize(type));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(wordSize));
+    PutParameter(bufferOut, bufferOutOffset, lanes);
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(p));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(0));
+    const size_t chunkSize = ChunkWords * wordSize;
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint32_t>(chunkSize));
+    PutParameter(bufferOut, bufferOutOffset, totalBytes);
+
+    std::vector<uint8_t> planes(chunkSize);
+    std::vector<char> predicted(chunkSize);
+    std::vector<uint16_t> table(size_t(1) << HashLog, 0);
+    std::vector<size_t> segments;
+    for (uint64_t pos = 0; pos < totalBytes; pos += chunkSize)
+    {
+        const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunkSize, totalBytes - pos));
+        SplitChunk(dataIn + pos, planes.data(), predicted.data(), bytes, wordSize, lanes, p);
+        Segments(bytes, wordSize, segments);
+        const uint8_t *segment = planes.data();
+        for (const size_t n : segments)
+        {
+            bufferOutOffset += EncodeSegment(segment, n, bufferOut + bufferOutOffset, table.data());
+            segment += n;
+        }
+    }
+    return bufferOutOffset;
+}
+
+size_t CompressPack::InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut)
+{
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+    // version 1 has the same layout without Huffman coded segments
+    if (bufferVersion != 1 && bufferVersion != 2)
+    {
+        helper::Throw<std::runtime_error>("Operator", "CompressPack", "InverseOperate",
+                                          "invalid pack buffer version");
+    }
+
+    const size_t wordSize = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const size_t lanes = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const Prediction p = static_cast<Prediction>(GetParameter<uint8_t>(bufferIn, bufferInOffset));
+    bufferInOffset += 1;
+    const size_t chunkSize = GetParameter<uint32_t>(bufferIn, bufferInOffset);
+    const uint64_t totalBytes = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+    if (wordSize == 0 || lanes == 0 || lanes > 2 || chunkSize == 0 || chunkSize > ChunkWords * wordSize ||
+        chunkSize % wordSize)
+    {
+        helper::Throw<std::runtime_error>("Operator", "CompressPack", "InverseOperate",
+                                          "corrupted pack header");
+    }
+
+    std::vector<uint8_t> planes(chunkSize);
+    std::vector<size_t> segments;
+    for (uint64_t pos = 0; pos < totalBytes; pos += chunkSize)
+    {
+        const size_t bytes = static_cast<size_t>(std::min<uint64_t>(chunkSize, totalBytes - pos));
+        Segments(bytes, wordSize, segments);
+        uint8_t *segment = planes.data();
+        for (const size_t n : segments)
+        {
+            if (bufferInOffset + SegmentHeaderSize > sizeIn)
+            {
+                helper::Throw<std::runtime_error>("Operator", "CompressPack", "InverseOperate",
+                                                  "truncated pack buffer");
+            }
+            const Coding coding =
+                static_cast<Coding>(GetParameter<uint8_t>(bufferIn, bufferInOffset));
+            const size_t codedSize = GetParameter<uint32_t>(bufferIn, bufferInOffset);
+            const uint8_t *coded = reinterpret_cast<const uint8_t *>(bufferIn + bufferInOffset);
+            if (codedSize > sizeIn - bufferInOffset ||
+                !DecodeSegment(coding, coded, codedSize, segment, n))
+            {
+                helper::Throw<std::runtime_error>("Operator", "CompressPack", "InverseOperate",
+                                                  "corrupted pack buffer");
+            }
+            bufferInOffset += codedSize;
+            segment += n;
+        }
+        JoinChunk(planes.data(), dataOut + pos, bytes, wordSize, lanes, p);
+    }
+    return static_cast<size_t>(totalBytes);
+}
+
+bool CompressPack::IsDataTypeValid(const DataType type) const
+{
+    return type != DataType::String && type != DataType::Struct && type != DataType::None;
+}
+
+size_t CompressPack::GetHeaderSize() const { return HeaderSize; }
+
+size_t CompressPack::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize,
+                                      const size_t ndims, const size_t *dims) const
+{
+    const size_t bytes = ElemCount * ElemSize;
+    // chunks have at least ChunkWords bytes
+    const size_t chunks = (bytes + ChunkWords - 1) / ChunkWords;
+    // every segment stored as is, at most one more than the word size
+    return HeaderSize + chunks * (ElemSize + 1) * SegmentHeaderSize + bytes;
+}
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,51 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * CompressPack.h : lossless compressor without external dependencies,
+ * available in every build. Each chunk of a block is predicted from the
+ * previous value (xor for floating point, subtraction for integers),
+ * split into byte planes and LZ77 or Huffman coded.
+ */
+
+#ifndef ADIOS2_OPERATOR_COMPRESS_COMPRESSPACK_H_
+#define ADIOS2_OPERATOR_COMPRESS_COMPRESSPACK_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+class CompressPack : public Operator
+{
+
+public:
+    CompressPack(const Params &parameters);
+
+    ~CompressPack() = default;
+
+    /**
+     * @return size of compressed buffer, never more than GetEstimatedSize
+     */
+    size_t Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                   const DataType type, char *bufferOut) final;
+
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    size_t GetHeaderSize() const final;
+
+    size_t GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
+                            const size_t *dims) const final;
+};
+
+} // end namespace compress
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_COMPRESS_COMPRESSPACK_H_ */
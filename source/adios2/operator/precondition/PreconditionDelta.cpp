@@ -0,0 +1,191 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PreconditionDelta.cpp
+ *
+ */
+
+#include "PreconditionDelta.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <stdexcept>
+
+namespace adios2
+{
+namespace core
+{
+namespace precondition
+{
+
+namespace
+{
+// common header, word size, mode, lanes, 1 reserved, byte count
+constexpr size_t HeaderSize = 4 + 4 + sizeof(uint64_t);
+
+enum DeltaMode : uint8_t
+{
+    Sub = 0,
+    Xor = 1
+};
+
+// word i is the delta to word i - lanes
+template <class U>
+void Encode(const char *in, char *out, const size_t n, const DeltaMode mode, const size_t lanes)
+{
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        U prev = 0;
+        for (size_t i = lane; i < n; i += lanes)
+        {
+            U v;
+            std::memcpy(&v, in + i * sizeof(U), sizeof(U));
+            const U d = mode == Xor ? static_cast<U>(v ^ prev) : static_cast<U>(v - prev);
+            std::memcpy(out + i * sizeof(U), &d, sizeof(U));
+            prev = v;
+        }
+    }
+}
+
+template <class U>
+void Decode(const char *in, char *out, const size_t n, const DeltaMode mode, const size_t lanes)
+{
+    for (size_t lane = 0; lane < lanes; ++lane)
+    {
+        U prev = 0;
+        for (size_t i = lane; i < n; i += lanes)
+        {
+            U d;
+            std::memcpy(&d, in + i * sizeof(U), sizeof(U));
+            prev = mode == Xor ? static_cast<U>(prev ^ d) : static_cast<U>(prev + d);
+            std::memcpy(out + i * sizeof(U), &prev, sizeof(U));
+        }
+    }
+}
+
+template <class U>
+void Run(const bool encode, const char *in, char *out, const size_t bytes, const DeltaMode mode,
+         const size_t lanes)
+{
+    const size_t n = bytes / sizeof(U);
+    if (encode)
+    {
+        Encode<U>(in, out, n, mode, lanes);
+    }
+    else
+    {
+        Decode<U>(in, out, n, mode, lanes);
+    }
+    // left over bytes of a truncated element are kept as they are
+    std::memcpy(out + n * sizeof(U), in + n * sizeof(U), bytes - n * sizeof(U));
+}
+
+void Transform(const bool encode, const char *in, char *out, const size_t bytes,
+               const uint8_t wordSize, const DeltaMode mode, const uint8_t lanes)
+{
+    switch (wordSize)
+    {
+    case 1:
+        Run<uint8_t>(encode, in, out, bytes, mode, lanes);
+        break;
+    case 2:
+        Run<uint16_t>(encode, in, out, bytes, mode, lanes);
+        break;
+    case 4:
+        Run<uint32_t>(encode, in, out, bytes, mode, lanes);
+        break;
+    case 8:
+        Run<uint64_t>(encode, in, out, bytes, mode, lanes);
+        break;
+    default:
+        helper::Throw<std::runtime_error>("Operator", "PreconditionDelta", "Transform",
+                                          "invalid word size " + std::to_string(wordSize));
+    }
+}
+}
+
+PreconditionDelta::PreconditionDelta(const Params &parameters)
+: Operator("delta", PRECONDITION_DELTA, "precondition", parameters)
+{
+}
+
+size_t PreconditionDelta::Operate(const char *dataIn, const Dims &blockStart,
+                                  const Dims &blockCount, const DataType type, char *bufferOut)
+{
+    const uint8_t bufferVersion = 1;
+    size_t bufferOutOffset = 0;
+    MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
+
+    std::string modeString = "sub";
+    helper::SetParameterValue("mode", m_Parameters, modeString);
+    modeString = helper::LowerCase(modeString);
+    if (modeString != "sub" && modeString != "xor")
+    {
+        helper::Throw<std::invalid_argument>("Operator", "PreconditionDelta", "Operate",
+                                             "mode must be sub or xor, not " + modeString);
+    }
+    const DeltaMode mode = modeString == "xor" ? Xor : Sub;
+
+    // complex numbers are deltas of their real and imaginary parts
+    size_t wordSize = helper::GetDataTypeSize(type);
+    uint8_t lanes = 1;
+    if (type == DataType::FloatComplex || type == DataType::DoubleComplex)
+    {
+        wordSize /= 2;
+        lanes = 2;
+    }
+    const uint64_t totalBytes = helper::GetTotalSize(blockCount, helper::GetDataTypeSize(type));
+
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(wordSize));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(mode));
+    PutParameter(bufferOut, bufferOutOffset, lanes);
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(0));
+    PutParameter(bufferOut, bufferOutOffset, totalBytes);
+
+    Transform(true, dataIn, bufferOut + bufferOutOffset, totalBytes,
+              static_cast<uint8_t>(wordSize), mode, lanes);
+    return bufferOutOffset + totalBytes;
+}
+
+size_t PreconditionDelta::InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut)
+{
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        helper::Throw<std::runtime_error>("Operator", "PreconditionDelta", "InverseOperate",
+                                          "invalid delta buffer version");
+    }
+
+    const uint8_t wordSize = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    const DeltaMode mode = static_cast<DeltaMode>(GetParameter<uint8_t>(bufferIn, bufferInOffset));
+    const uint8_t lanes = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 1;
+    const uint64_t totalBytes = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+    if (bufferInOffset + totalBytes > sizeIn || lanes == 0)
+    {
+        helper::Throw<std::runtime_error>("Operator", "PreconditionDelta", "InverseOperate",
+                                          "corrupted delta buffer");
+    }
+
+    Transform(false, bufferIn + bufferInOffset, dataOut, totalBytes, wordSize, mode, lanes);
+    return totalBytes;
+}
+
+bool PreconditionDelta::IsDataTypeValid(const DataType type) const
+{
+    return type != DataType::String && type != DataType::Struct && type != DataType::None;
+}
+
+size_t PreconditionDelta::GetHeaderSize() const { return HeaderSize; }
+
+size_t PreconditionDelta::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize,
+                                           const size_t ndims, const size_t *dims) const
+{
+    return HeaderSize + ElemCount * ElemSize;
+}
+
+} // end namespace precondition
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,51 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PreconditionDelta.h : replaces every element by its difference to the
+ * previous one, computed on the element's bits so that it is lossless for
+ * floating point types too. Meant to run before a lossless compressor in an
+ * operator chain, smooth fields turn into many small values.
+ */
+
+#ifndef ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONDELTA_H_
+#define ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONDELTA_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace precondition
+{
+
+class PreconditionDelta : public Operator
+{
+
+public:
+    /**
+     * @param parameters "mode": "sub" (default, integer difference) or "xor"
+     */
+    PreconditionDelta(const Params &parameters);
+
+    ~PreconditionDelta() = default;
+
+    size_t Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                   const DataType type, char *bufferOut) final;
+
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    size_t GetHeaderSize() const final;
+
+    size_t GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
+                            const size_t *dims) const final;
+};
+
+} // end namespace precondition
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONDELTA_H_ */
@@ -0,0 +1,117 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PreconditionShuffle.cpp
+ *
+ */
+
+#include "PreconditionShuffle.h"
+#include "adios2/helper/adiosFunctions.h"
+
+#include <stdexcept>
+
+namespace adios2
+{
+namespace core
+{
+namespace precondition
+{
+
+namespace
+{
+// common header, element size, 3 reserved, byte count
+constexpr size_t HeaderSize = 4 + 4 + sizeof(uint64_t);
+
+/** byte b of element i goes to out[b * n + i] */
+void Shuffle(const char *in, char *out, const size_t n, const size_t elemSize)
+{
+    for (size_t b = 0; b < elemSize; ++b)
+    {
+        char *plane = out + b * n;
+        const char *src = in + b;
+        for (size_t i = 0; i < n; ++i)
+        {
+            plane[i] = src[i * elemSize];
+        }
+    }
+}
+
+void Unshuffle(const char *in, char *out, const size_t n, const size_t elemSize)
+{
+    for (size_t b = 0; b < elemSize; ++b)
+    {
+        const char *plane = in + b * n;
+        char *dst = out + b;
+        for (size_t i = 0; i < n; ++i)
+        {
+            dst[i * elemSize] = plane[i];
+        }
+    }
+}
+}
+
+PreconditionShuffle::PreconditionShuffle(const Params &parameters)
+: Operator("shuffle", PRECONDITION_SHUFFLE, "precondition", parameters)
+{
+}
+
+size_t PreconditionShuffle::Operate(const char *dataIn, const Dims &blockStart,
+                                    const Dims &blockCount, const DataType type, char *bufferOut)
+{
+    const uint8_t bufferVersion = 1;
+    size_t bufferOutOffset = 0;
+    MakeCommonHeader(bufferOut, bufferOutOffset, bufferVersion);
+
+    const size_t elemSize = helper::GetDataTypeSize(type);
+    const uint64_t totalBytes = helper::GetTotalSize(blockCount, elemSize);
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(elemSize));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint8_t>(0));
+    PutParameter(bufferOut, bufferOutOffset, static_cast<uint16_t>(0));
+    PutParameter(bufferOut, bufferOutOffset, totalBytes);
+
+    Shuffle(dataIn, bufferOut + bufferOutOffset, totalBytes / elemSize, elemSize);
+    return bufferOutOffset + totalBytes;
+}
+
+size_t PreconditionShuffle::InverseOperate(const char *bufferIn, const size_t sizeIn,
+                                           char *dataOut)
+{
+    size_t bufferInOffset = 1; // skip operator type
+    const uint8_t bufferVersion = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 2; // skip two reserved bytes
+    if (bufferVersion != 1)
+    {
+        helper::Throw<std::runtime_error>("Operator", "PreconditionShuffle", "InverseOperate",
+                                          "invalid shuffle buffer version");
+    }
+
+    const uint8_t elemSize = GetParameter<uint8_t>(bufferIn, bufferInOffset);
+    bufferInOffset += 3;
+    const uint64_t totalBytes = GetParameter<uint64_t>(bufferIn, bufferInOffset);
+    if (elemSize == 0 || bufferInOffset + totalBytes > sizeIn || totalBytes % elemSize)
+    {
+        helper::Throw<std::runtime_error>("Operator", "PreconditionShuffle", "InverseOperate",
+                                          "corrupted shuffle buffer");
+    }
+
+    Unshuffle(bufferIn + bufferInOffset, dataOut, totalBytes / elemSize, elemSize);
+    return totalBytes;
+}
+
+bool PreconditionShuffle::IsDataTypeValid(const DataType type) const
+{
+    return type != DataType::String && type != DataType::Struct && type != DataType::None;
+}
+
+size_t PreconditionShuffle::GetHeaderSize() const { return HeaderSize; }
+
+size_t PreconditionShuffle::GetEstimatedSize(const size_t ElemCount, const size_t ElemSize,
+                                             const size_t ndims, const size_t *dims) const
+{
+    return HeaderSize + ElemCount * ElemSize;
+}
+
+} // end namespace precondition
+} // end namespace core
+} // end namespace adios2
@@ -0,0 +1,47 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PreconditionShuffle.h : stores byte i of all elements, then byte i+1 of
+ * all elements and so on. Bytes of the same significance are alike in
+ * numerical data, so a following lossless compressor finds longer runs.
+ */
+
+#ifndef ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONSHUFFLE_H_
+#define ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONSHUFFLE_H_
+
+#include "adios2/core/Operator.h"
+
+namespace adios2
+{
+namespace core
+{
+namespace precondition
+{
+
+class PreconditionShuffle : public Operator
+{
+
+public:
+    PreconditionShuffle(const Params &parameters);
+
+    ~PreconditionShuffle() = default;
+
+    size_t Operate(const char *dataIn, const Dims &blockStart, const Dims &blockCount,
+                   const DataType type, char *bufferOut) final;
+
+    size_t InverseOperate(const char *bufferIn, const size_t sizeIn, char *dataOut) final;
+
+    bool IsDataTypeValid(const DataType type) const final;
+
+    size_t GetHeaderSize() const final;
+
+    size_t GetEstimatedSize(const size_t ElemCount, const size_t ElemSize, const size_t ndims,
+                            const size_t *dims) const final;
+};
+
+} // end namespace precondition
+} // end namespace core
+} // end namespace adios2
+
+#endif /* ADIOS2_OPERATOR_PRECONDITION_PRECONDITIONSHUFFLE_H_ */
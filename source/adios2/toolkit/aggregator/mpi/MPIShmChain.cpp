@@ -24,6 +24,7 @@ MPIShmChain::~MPIShmChain() { Close(); }
 
 void MPIShmChain::Close()
 {
+    DestroyShm();
     if (m_IsActive)
     {
         m_NodeComm.Free("free per-node comm in ~MPIShmChain()");
@@ -205,7 +206,7 @@ void MPIShmChain::HandshakeLinks_Complete(HandshakeStruct &hs)
 }
 
 void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
-                            const size_t alignment_size)
+                            const size_t alignment_size, const format::BufferAllocator *allocator)
 {
     if (!m_Comm.IsMPI())
     {
@@ -228,7 +229,32 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
             blocksize += helper::PaddingToAlignOffset(blocksize, alignment_size);
             totalsize = structsize + 2 * blocksize;
         }
+    }
+    if (m_ShmCreated)
+    {
+        // no process may still be in the previous step when the segment is reset
+        m_Comm.Barrier("before reuse of the shm segment in MPIShmChain::CreateShm");
+        int reuse = 0;
+        if (!m_Rank && blocksize <= m_Shm->sdbA.max_size)
+        {
+            reuse = 1;
+            ResetBuffers();
+        }
+        m_Comm.Bcast(&reuse, 1, 0, "reuse of the shm segment in MPIShmChain::CreateShm");
+        if (reuse)
+        {
+            return;
+        }
+        DestroyShm();
+    }
+    if (!m_Rank)
+    {
+        const size_t totalsize = structsize + 2 * blocksize;
         m_Win = m_Comm.Win_allocate_shared(totalsize, 1, &ptr);
+        if (allocator)
+        {
+            allocator->Advise(ptr, totalsize);
+        }
     }
     else
     {
@@ -238,18 +264,15 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
         m_Comm.Win_shared_query(m_Win, 0, &shmsize, &disp_unit, &ptr);
         blocksize = (shmsize - structsize) / 2;
     }
+    m_ShmCreated = true;
     m_Shm = reinterpret_cast<ShmSegment *>(ptr);
     m_ShmBufA = ptr + structsize;
     m_ShmBufB = m_ShmBufA + blocksize;
 
     if (!m_Rank)
     {
-        m_Shm->producerBuffer = LastBufferUsed::None;
-        m_Shm->consumerBuffer = LastBufferUsed::None;
-        m_Shm->NumBuffersFull = 0;
-        m_Shm->sdbA.buf = nullptr;
+        ResetBuffers();
         m_Shm->sdbA.max_size = blocksize;
-        m_Shm->sdbB.buf = nullptr;
         m_Shm->sdbB.max_size = blocksize;
     }
     /*std::cout << "Rank " << m_Rank << " shm = " << ptr
@@ -257,7 +280,23 @@ void MPIShmChain::CreateShm(size_t blocksize, const size_t maxsegmentsize,
               << " bufB = " << static_cast<void *>(m_Shm->bufB) << std::endl;*/
 }
 
-void MPIShmChain::DestroyShm() { m_Comm.Win_free(m_Win); }
+void MPIShmChain::ResetBuffers() noexcept
+{
+    m_Shm->producerBuffer = LastBufferUsed::None;
+    m_Shm->consumerBuffer = LastBufferUsed::None;
+    m_Shm->NumBuffersFull = 0;
+    m_Shm->sdbA.buf = nullptr;
+    m_Shm->sdbB.buf = nullptr;
+}
+
+void MPIShmChain::DestroyShm()
+{
+    if (m_ShmCreated)
+    {
+        m_Comm.Win_free(m_Win);
+        m_ShmCreated = false;
+    }
+}
 
 /*
    The buffering strategy is the following.
@@ -14,6 +14,7 @@
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/toolkit/aggregator/mpi/MPIAggregator.h"
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/shm/Spinlock.h"
 
 #include <atomic>
@@ -107,10 +108,15 @@ public:
     void UnlockProducerBuffer();
     ShmDataBuffer *LockConsumerBuffer();
     void UnlockConsumerBuffer();
+    // no buffer used or full, on rank 0 while no process uses the segment
     void ResetBuffers() noexcept;
 
     // 2*blocksize+some is allocated but only up to maxsegmentsize
-    void CreateShm(size_t blocksize, const size_t maxsegmentsize, const size_t alignment_size);
+    // the segment of a previous step that was not destroyed is reused if it is large enough
+    // allocator, if given, sets the page size and NUMA policy of a new segment
+    void CreateShm(size_t blocksize, const size_t maxsegmentsize, const size_t alignment_size,
+                   const format::BufferAllocator *allocator = nullptr);
+    // no-op without a segment
     void DestroyShm();
 
 private:
@@ -126,6 +132,7 @@ private:
     void HandshakeLinks_Complete(HandshakeStruct &hs);
 
     helper::Comm::Win m_Win;
+    bool m_ShmCreated = false;
 
     enum class LastBufferUsed
     {
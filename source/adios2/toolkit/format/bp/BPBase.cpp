@@ -412,7 +412,8 @@ std::string BPBase::ReadBPString(const std::vector<char> &buffer, size_t &positi
 // static members
 const std::set<std::string> BPBase::m_TransformTypes = {{"unknown", "none", "identity", "bzip2",
                                                          "sz", "zfp", "mgard", "png", "blosc",
-                                                         "sirius", "mgardplus", "plugin"}};
+                                                         "sirius", "mgardplus", "plugin",
+                                                         "pack", "auto"}};
 
 const std::map<int, std::string> BPBase::m_TransformTypesToNames = {
     {transform_unknown, "unknown"},
@@ -426,7 +427,9 @@ const std::map<int, std::string> BPBase::m_TransformTypesToNames = {
     {transform_blosc, "blosc"},
     {transform_sirius, "sirius"},
     {transform_mgardplus, "mgardplus"},
-    {transform_plugin, "plugin"}};
+    {transform_plugin, "plugin"},
+    {transform_pack, "pack"},
+    {transform_auto, "auto"}};
 
 BPBase::TransformTypes BPBase::TransformTypeEnum(const std::string transformType) const noexcept
 {
@@ -458,6 +458,8 @@ protected:
         transform_sirius = 14,
         transform_mgardplus = 15,
         transform_plugin = 16,
+        transform_pack = 17,
+        transform_auto = 18,
     };
 
     /** Supported transform types */
@@ -0,0 +1,133 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5Arena.cpp
+ *
+ */
+
+#include "BP5Arena.h"
+
+#include "adios2/helper/adiosLog.h"
+
+#include <algorithm>
+#include <cstdlib>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace adios2
+{
+namespace format
+{
+
+namespace
+{
+// every allocation is preceded by its capacity
+constexpr size_t HeaderSize = sizeof(size_t);
+
+inline size_t AlignUp(const size_t Size) { return (Size + 7) & ~static_cast<size_t>(7); }
+}
+
+BP5Arena::BP5Arena(const size_t ChunkSize) : m_ChunkSize(ChunkSize) {}
+
+BP5Arena::~BP5Arena()
+{
+    for (auto &C : m_Chunks)
+    {
+        free(C.Base);
+    }
+}
+
+void BP5Arena::NewChunk(const size_t MinSize)
+{
+    const size_t Size = std::max(m_ChunkSize, MinSize);
+    char *Base = (char *)malloc(Size);
+    if (!Base)
+    {
+        helper::Throw<std::runtime_error>("Toolkit", "format::BP5Arena", "NewChunk",
+                                          "failed to allocate " + std::to_string(Size) +
+                                              " bytes for metadata");
+    }
+    m_Chunks.push_back({Base, Size});
+    m_Offset = 0;
+    m_LastAlloc = 0;
+}
+
+void *BP5Arena::Allocate(const size_t Size)
+{
+    const size_t Cap = AlignUp(Size ? Size : 1);
+    const size_t Need = HeaderSize + Cap;
+    if (m_Chunks.empty() || (m_Offset + Need > m_Chunks.back().Size))
+    {
+        NewChunk(Need);
+    }
+    char *Header = m_Chunks.back().Base + m_Offset;
+    *(size_t *)Header = Cap;
+    m_LastAlloc = m_Offset;
+    m_Offset += Need;
+    m_Used += Need;
+    return Header + HeaderSize;
+}
+
+void *BP5Arena::Reallocate(void *Ptr, const size_t Size)
+{
+    if (!Ptr)
+    {
+        return Allocate(Size);
+    }
+    char *Header = (char *)Ptr - HeaderSize;
+    const size_t Cap = *(size_t *)Header;
+    if (Size <= Cap)
+    {
+        return Ptr;
+    }
+
+    size_t NewCap = AlignUp(Size);
+    const Chunk &Last = m_Chunks.back();
+    if ((Header == Last.Base + m_LastAlloc) && (m_LastAlloc + HeaderSize + NewCap <= Last.Size))
+    {
+        // last allocation in the chunk, just move the free pointer
+        *(size_t *)Header = NewCap;
+        m_Offset = m_LastAlloc + HeaderSize + NewCap;
+        m_Used += NewCap - Cap;
+        return Ptr;
+    }
+
+    NewCap = std::max(NewCap, 2 * Cap);
+    void *Ret = Allocate(NewCap);
+    memcpy(Ret, Ptr, Cap);
+    return Ret;
+}
+
+char *BP5Arena::StrDup(const char *Str)
+{
+    const size_t Len = strlen(Str) + 1;
+    char *Ret = (char *)Allocate(Len);
+    memcpy(Ret, Str, Len);
+    return Ret;
+}
+
+void BP5Arena::Reset()
+{
+    if (m_Chunks.size() > 1)
+    {
+        // coalesce, so the next step of the same size fits in one chunk
+        size_t Total = 0;
+        for (auto &C : m_Chunks)
+        {
+            Total += C.Size;
+            free(C.Base);
+        }
+        m_Chunks.clear();
+        NewChunk(Total);
+    }
+    m_Offset = 0;
+    m_LastAlloc = 0;
+    m_Used = 0;
+}
+
+size_t BP5Arena::Used() const noexcept { return m_Used; }
+
+} // end namespace format
+} // end namespace adios2
@@ -0,0 +1,78 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5Arena.h
+ *
+ * Bump allocator for the transient, per-step metadata of the BP5
+ * serializer and deserializer. Allocations are never freed individually,
+ * the whole arena is released with Reset() at step boundaries.
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP5_BP5ARENA_H_
+#define ADIOS2_TOOLKIT_FORMAT_BP5_BP5ARENA_H_
+
+#include <cstddef>
+#include <vector>
+
+namespace adios2
+{
+namespace format
+{
+
+class BP5Arena
+{
+public:
+    BP5Arena(const size_t ChunkSize = DefaultChunkSize);
+    ~BP5Arena();
+
+    BP5Arena(const BP5Arena &) = delete;
+    BP5Arena &operator=(const BP5Arena &) = delete;
+
+    static constexpr size_t DefaultChunkSize = 64 * 1024;
+
+    /** Returns size bytes of uninitialized, 8-byte aligned memory */
+    void *Allocate(const size_t Size);
+
+    /**
+     * Grows an allocation of this arena, keeping its content, like realloc.
+     * Ptr may be NULL. Extends in place when Ptr is the last allocation,
+     * otherwise capacity is at least doubled so that appending one element
+     * at a time stays amortized O(1).
+     */
+    void *Reallocate(void *Ptr, const size_t Size);
+
+    /** strdup() into the arena */
+    char *StrDup(const char *Str);
+
+    /**
+     * Releases all allocations at once. Memory is kept for the next step,
+     * if the last step needed more than one chunk they are merged into one.
+     */
+    void Reset();
+
+    /** Bytes currently handed out, including per-allocation headers */
+    size_t Used() const noexcept;
+
+private:
+    struct Chunk
+    {
+        char *Base;
+        size_t Size;
+    };
+
+    std::vector<Chunk> m_Chunks;
+    size_t m_ChunkSize;
+    /** offset of the free space in m_Chunks.back() */
+    size_t m_Offset = 0;
+    /** offset of the last allocation's header in m_Chunks.back() */
+    size_t m_LastAlloc = 0;
+    size_t m_Used = 0;
+
+    void NewChunk(const size_t MinSize);
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP5_BP5ARENA_H_ */
@@ -0,0 +1,205 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5BlockCache.cpp
+ *
+ */
+
+#include "BP5BlockCache.h"
+
+#include "adios2/common/ADIOSTypes.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosSystem.h"
+
+#include <atomic>
+#include <cstdio>
+#include <fstream>
+#include <stdexcept>
+
+#ifdef _WIN32
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+BP5BlockCache::BP5BlockCache(const size_t capacity, const std::string &spillDir,
+                             const size_t spillCapacity)
+: m_Capacity(capacity), m_SpillDir(spillDir), m_SpillCapacity(spillCapacity)
+{
+    if (!m_SpillDir.empty())
+    {
+        if (!helper::CreateDirectory(m_SpillDir))
+        {
+            helper::Throw<std::invalid_argument>("Toolkit", "format::BP5BlockCache",
+                                                 "BP5BlockCache",
+                                                 "can't create spill directory " + m_SpillDir);
+        }
+        // several readers of several processes may share the directory
+        static std::atomic<size_t> instances(0);
+        m_SpillPrefix = m_SpillDir + PathSeparator + "adios2_bp5cache_" +
+                        std::to_string(static_cast<long long>(getpid())) + "_" +
+                        std::to_string(instances++) + "_";
+    }
+}
+
+BP5BlockCache::~BP5BlockCache()
+{
+    for (const auto &spilled : m_Spilled)
+    {
+        std::remove(spilled.second.Path.c_str());
+    }
+}
+
+BP5BlockCache::Block BP5BlockCache::Get(const Key &key)
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Blocks.find(key);
+    if (it != m_Blocks.end())
+    {
+        m_Order.splice(m_Order.begin(), m_Order, it->second.Order);
+        ++m_Hits;
+        return it->second.Data;
+    }
+
+    auto spilled = m_Spilled.find(key);
+    if (spilled != m_Spilled.end())
+    {
+        std::shared_ptr<std::vector<char>> data =
+            std::make_shared<std::vector<char>>(spilled->second.Size);
+        std::ifstream file(spilled->second.Path, std::ios::binary);
+        file.read(data->data(), static_cast<std::streamsize>(data->size()));
+        const bool ok = static_cast<bool>(file);
+        file.close();
+        RemoveSpilled(spilled);
+        if (ok)
+        {
+            Insert(key, data);
+            ++m_Hits;
+            ++m_SpillHits;
+            return data;
+        }
+    }
+    ++m_Misses;
+    return nullptr;
+}
+
+BP5BlockCache::Block BP5BlockCache::Put(const Key &key, std::vector<char> &&data)
+{
+    Block block = std::make_shared<const std::vector<char>>(std::move(data));
+    if (!Fits(block->size()))
+    {
+        return block;
+    }
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto it = m_Blocks.find(key);
+    if (it != m_Blocks.end())
+    {
+        // another thread read the same block meanwhile
+        return it->second.Data;
+    }
+    Insert(key, block);
+    return block;
+}
+
+void BP5BlockCache::Insert(const Key &key, const Block &block)
+{
+    Evict(m_Capacity - block->size());
+    m_Order.push_front(key);
+    m_Blocks[key] = Entry{block, m_Order.begin()};
+    m_CachedBytes += block->size();
+}
+
+void BP5BlockCache::Evict(const size_t capacity)
+{
+    while (m_CachedBytes > capacity && !m_Order.empty())
+    {
+        const Key key = m_Order.back();
+        auto it = m_Blocks.find(key);
+        if (!m_SpillDir.empty())
+        {
+            Spill(key, *it->second.Data);
+        }
+        m_CachedBytes -= it->second.Data->size();
+        m_Blocks.erase(it);
+        m_Order.pop_back();
+    }
+}
+
+void BP5BlockCache::Spill(const Key &key, const std::vector<char> &data)
+{
+    auto old = m_Spilled.find(key);
+    if (old != m_Spilled.end())
+    {
+        RemoveSpilled(old);
+    }
+    if (m_SpillCapacity && data.size() > m_SpillCapacity)
+    {
+        return;
+    }
+    while (m_SpillCapacity && m_SpilledBytes + data.size() > m_SpillCapacity)
+    {
+        RemoveSpilled(m_Spilled.find(m_SpillOrder.back()));
+    }
+
+    const std::string path = m_SpillPrefix + std::to_string(m_SpillCounter++) + ".blk";
+    std::ofstream file(path, std::ios::binary | std::ios::trunc);
+    file.write(data.data(), static_cast<std::streamsize>(data.size()));
+    file.close();
+    if (!file)
+    {
+        // a full local disk only costs a reread
+        std::remove(path.c_str());
+        return;
+    }
+    m_SpillOrder.push_front(key);
+    m_Spilled[key] = SpillEntry{path, data.size(), m_SpillOrder.begin()};
+    m_SpilledBytes += data.size();
+}
+
+void BP5BlockCache::RemoveSpilled(std::unordered_map<Key, SpillEntry, KeyHash>::iterator it)
+{
+    std::remove(it->second.Path.c_str());
+    m_SpilledBytes -= it->second.Size;
+    m_SpillOrder.erase(it->second.Order);
+    m_Spilled.erase(it);
+}
+
+size_t BP5BlockCache::Hits() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Hits;
+}
+
+size_t BP5BlockCache::Misses() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_Misses;
+}
+
+size_t BP5BlockCache::SpillHits() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_SpillHits;
+}
+
+size_t BP5BlockCache::CachedBytes() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_CachedBytes;
+}
+
+size_t BP5BlockCache::SpilledBytes() const noexcept
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    return m_SpilledBytes;
+}
+
+} // end namespace format
+} // end namespace adios2
@@ -0,0 +1,149 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5BlockCache.h
+ *
+ * Reader side cache of whole BP5 data blocks, as stored in the file (raw)
+ * or after the operator ran (decompressed), so that Gets of overlapping
+ * selections over several PerformGets calls touch the file system and the
+ * decompressor only once per block. Least recently used blocks are dropped
+ * when over the memory capacity, or moved to files in a local spill
+ * directory if one is given.
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP5_BP5BLOCKCACHE_H_
+#define ADIOS2_TOOLKIT_FORMAT_BP5_BP5BLOCKCACHE_H_
+
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adios2
+{
+namespace format
+{
+
+class BP5BlockCache
+{
+public:
+    enum class Kind : uint8_t
+    {
+        Raw,         // bytes as stored in the data file
+        Decompressed // output of the block's operator
+    };
+
+    /** a block is identified by its location in the data files */
+    struct Key
+    {
+        size_t Timestep;
+        size_t WriterRank;
+        size_t Offset;
+        Kind BlockKind;
+
+        bool operator==(const Key &other) const noexcept
+        {
+            return Timestep == other.Timestep && WriterRank == other.WriterRank &&
+                   Offset == other.Offset && BlockKind == other.BlockKind;
+        }
+    };
+
+    /** shared so that a block stays valid while in use by another thread */
+    using Block = std::shared_ptr<const std::vector<char>>;
+
+    /**
+     * @param capacity max bytes of blocks kept in memory
+     * @param spillDir directory for evicted blocks, empty for no spill
+     * @param spillCapacity max bytes of spilled blocks, 0 for no limit
+     */
+    BP5BlockCache(const size_t capacity, const std::string &spillDir = "",
+                  const size_t spillCapacity = 0);
+
+    /** removes the spill files */
+    ~BP5BlockCache();
+
+    BP5BlockCache(const BP5BlockCache &) = delete;
+    BP5BlockCache &operator=(const BP5BlockCache &) = delete;
+
+    /** nullptr if not cached, a spilled block is read back into memory */
+    Block Get(const Key &key);
+
+    /**
+     * Insert a block, evicting the least recently used ones. A block larger
+     * than the memory capacity is returned but not kept.
+     */
+    Block Put(const Key &key, std::vector<char> &&data);
+
+    /** true if a block of this size can be kept at all */
+    bool Fits(const size_t size) const noexcept { return size <= m_Capacity; }
+
+    size_t Hits() const noexcept;
+    size_t Misses() const noexcept;
+    /** hits that were read back from the spill directory */
+    size_t SpillHits() const noexcept;
+    size_t CachedBytes() const noexcept;
+    size_t SpilledBytes() const noexcept;
+
+private:
+    struct KeyHash
+    {
+        size_t operator()(const Key &key) const noexcept
+        {
+            size_t h = key.Offset * 0x9E3779B97F4A7C15ULL;
+            h ^= key.Timestep + 0x7F4A7C15 + (h << 6) + (h >> 2);
+            h ^= key.WriterRank + 0x7F4A7C15 + (h << 6) + (h >> 2);
+            return h ^ static_cast<size_t>(key.BlockKind);
+        }
+    };
+
+    struct Entry
+    {
+        Block Data;
+        std::list<Key>::iterator Order;
+    };
+
+    struct SpillEntry
+    {
+        std::string Path;
+        size_t Size;
+        std::list<Key>::iterator Order;
+    };
+
+    const size_t m_Capacity;
+    const std::string m_SpillDir;
+    const size_t m_SpillCapacity;
+    /** spill file names are <prefix><n>.blk */
+    std::string m_SpillPrefix;
+    size_t m_SpillCounter = 0;
+
+    mutable std::mutex m_Mutex;
+    std::unordered_map<Key, Entry, KeyHash> m_Blocks;
+    std::unordered_map<Key, SpillEntry, KeyHash> m_Spilled;
+    /** front is the most recently used */
+    std::list<Key> m_Order;
+    std::list<Key> m_SpillOrder;
+    size_t m_CachedBytes = 0;
+    size_t m_SpilledBytes = 0;
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+    size_t m_SpillHits = 0;
+
+    /** insert into memory, m_Mutex is held */
+    void Insert(const Key &key, const Block &block);
+
+    /** evict to disk or drop until at most capacity, m_Mutex is held */
+    void Evict(const size_t capacity);
+
+    void Spill(const Key &key, const std::vector<char> &data);
+    void RemoveSpilled(std::unordered_map<Key, SpillEntry, KeyHash>::iterator it);
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP5_BP5BLOCKCACHE_H_ */
@@ -276,8 +276,13 @@ BP5Deserializer::BP5VarRec *BP5Deserializer::LookupVarByKey(void *Key) const
 
 BP5Deserializer::BP5VarRec *BP5Deserializer::LookupVarByName(const char *Name)
 {
-    auto ret = VarByName[Name];
-    return ret;
+    // find() rather than operator[], a miss must not insert an empty entry
+    auto it = VarByName.find(Name);
+    if (it == VarByName.end())
+    {
+        return nullptr;
+    }
+    return it->second;
 }
 
 BP5Deserializer::BP5VarRec *BP5Deserializer::CreateVarRec(const char *ArrayName)
@@ -664,6 +669,8 @@ void BP5Deserializer::SetupForStep(size_t Step, size_t WriterCount)
                 VarRec->LastJoinedShape = NULL;
             }
         }
+        // decoded metadata of the previous step is no longer referenced
+        m_MetaArena.Reset();
     }
     m_CurrentWriterCohortSize = WriterCount;
 }
@@ -718,7 +725,7 @@ void BP5Deserializer::InstallMetaData(void *MetadataBlock, size_t BlockLen, size
     {
         auto DecodedLength =
             FFS_est_decode_length(ReaderFFSContext, (char *)MetadataBlock, BlockLen);
-        BaseData = malloc(DecodedLength);
+        BaseData = m_MetaArena.Allocate(DecodedLength);
         FFSdecode_to_buffer(ReaderFFSContext, (char *)MetadataBlock, BaseData);
     }
     if (DumpMetadata == -1)
@@ -1061,7 +1068,7 @@ void BP5Deserializer::InstallAttributeData(void *AttributeBlock, size_t BlockLen
     {
         auto DecodedLength =
             FFS_est_decode_length(ReaderFFSContext, (char *)AttributeBlock, BlockLen);
-        BaseData = malloc(DecodedLength);
+        BaseData = m_MetaArena.Allocate(DecodedLength);
         FFSBuffer decode_buf = create_fixed_FFSBuffer((char *)BaseData, DecodedLength);
         FFSdecode_to_buffer(ReaderFFSContext, (char *)AttributeBlock, decode_buf);
     }
@@ -1616,6 +1623,9 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers, size_t *max
                                                             &writer_meta_base->Count[StartDim]);
                         }
                         RR.OffsetInBlock = 0;
+                        RR.BlockOffset = RR.StartOffset;
+                        RR.BlockLength = RR.ReadLength;
+                        RR.DecompressedCacheable = DecompressedCacheable(VarRec);
                         if (RR.DirectToAppMemory)
                         {
                             RR.DestinationAddr = (char *)Req->Data;
@@ -1684,6 +1694,9 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers, size_t *max
                                 RR.WriterRank = WriterRank;
                                 RR.StartOffset = writer_meta_base->DataBlockLocation[Block];
                                 RR.ReadLength = writer_meta_base->DataBlockSize[Block];
+                                RR.BlockOffset = RR.StartOffset;
+                                RR.BlockLength = RR.ReadLength;
+                                RR.DecompressedCacheable = DecompressedCacheable(VarRec);
                                 RR.DestinationAddr = nullptr;
                                 if (RR.StartOffset == (size_t)-1)
                                     throw std::runtime_error("No data exists for this variable");
@@ -1730,6 +1743,12 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers, size_t *max
                                 if (writer_meta_base->DataBlockLocation[Block] == (size_t)-1)
                                     throw std::runtime_error("No data exists for this variable");
                                 RR.ReadLength = EndOffsetInBlock - StartOffsetInBlock;
+                                RR.BlockOffset = writer_meta_base->DataBlockLocation[Block];
+                                RR.BlockLength =
+                                    VB->m_ElementSize *
+                                    CalcBlockLength(VarRec->DimCount,
+                                                    &writer_meta_base->Count[StartDim]);
+                                RR.DecompressedCacheable = false;
                                 if (Req->MemSpace != MemorySpace::Host)
                                     RR.DirectToAppMemory = false;
                                 else
@@ -1777,7 +1796,58 @@ BP5Deserializer::GenerateReadRequests(const bool doAllocTempBuffers, size_t *max
     return Ret;
 }
 
-void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
+bool BP5Deserializer::DecompressedCacheable(const BP5VarRec *VarRec) const
+{
+    if (VarRec->Operator == NULL)
+    {
+        return false;
+    }
+    // refactoring operators return more or less data depending on the accuracy
+    const VariableBase *VB = static_cast<const VariableBase *>(VarRec->Variable);
+    const Accuracy accuracy = VB->GetAccuracyRequested();
+    return accuracy.error == 0.0 && accuracy.norm == 0.0 && !accuracy.relative;
+}
+
+void BP5Deserializer::DecompressBlock(const ReadRequest &Read, std::vector<char> &decompressed)
+{
+    auto Req = PendingGetRequests[Read.ReqIndex];
+    MetaArrayRec *writer_meta_base = (MetaArrayRec *)GetMetadataBase(
+        ((struct BP5VarRec *)Req.VarRec), Read.Timestep, Read.WriterRank);
+    char *IncomingData = Read.DestinationAddr;
+
+    size_t DestSize = ((struct BP5VarRec *)Req.VarRec)->ElementSize;
+    for (size_t dim = 0; dim < ((struct BP5VarRec *)Req.VarRec)->DimCount; dim++)
+    {
+        DestSize *= writer_meta_base->Count[dim + Read.BlockID * writer_meta_base->Dims];
+    }
+    decompressed.resize(DestSize);
+
+    // Get the operator of the variable if exists or create one
+    std::shared_ptr<Operator> op = nullptr;
+    VariableBase *VB = static_cast<VariableBase *>(((struct BP5VarRec *)Req.VarRec)->Variable);
+    if (!VB->m_Operations.empty())
+    {
+        op = VB->m_Operations[0];
+    }
+    else
+    {
+        Operator::OperatorType compressorType =
+            static_cast<Operator::OperatorType>(IncomingData[0]);
+        op = MakeOperator(OperatorTypeToString(compressorType), {});
+    }
+    op->SetAccuracy(VB->GetAccuracyRequested());
+
+    {
+        std::lock_guard<std::mutex> lockGuard(mutexDecompress);
+        core::Decompress(IncomingData,
+                         ((MetaArrayRecOperator *)writer_meta_base)->DataBlockSize[Read.BlockID],
+                         decompressed.data(), Req.MemSpace, op);
+        VB->m_AccuracyProvided = op->GetAccuracy();
+    }
+}
+
+void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr,
+                                  const char *decompressedBlock)
 {
     auto Req = PendingGetRequests[Read.ReqIndex];
 
@@ -1803,37 +1873,12 @@ void BP5Deserializer::FinalizeGet(const ReadRequest &Read, const bool freeAddr)
     std::vector<char> decompressBuffer;
     if (((struct BP5VarRec *)Req.VarRec)->Operator != NULL)
     {
-        size_t DestSize = ((struct BP5VarRec *)Req.VarRec)->ElementSize;
-        for (size_t dim = 0; dim < ((struct BP5VarRec *)Req.VarRec)->DimCount; dim++)
-        {
-            DestSize *= writer_meta_base->Count[dim + Read.BlockID * writer_meta_base->Dims];
-        }
-        decompressBuffer.resize(DestSize);
-
-        // Get the operator of the variable if exists or create one
-        std::shared_ptr<Operator> op = nullptr;
-        VariableBase *VB = static_cast<VariableBase *>(((struct BP5VarRec *)Req.VarRec)->Variable);
-        if (!VB->m_Operations.empty())
-        {
-            op = VB->m_Operations[0];
-        }
-        else
-        {
-            Operator::OperatorType compressorType =
-                static_cast<Operator::OperatorType>(IncomingData[0]);
-            op = MakeOperator(OperatorTypeToString(compressorType), {});
-        }
-        op->SetAccuracy(VB->GetAccuracyRequested());
-
+        if (!decompressedBlock)
         {
-            std::lock_guard<std::mutex> lockGuard(mutexDecompress);
-            core::Decompress(
-                IncomingData,
-                ((MetaArrayRecOperator *)writer_meta_base)->DataBlockSize[Read.BlockID],
-                decompressBuffer.data(), Req.MemSpace, op);
-            VB->m_AccuracyProvided = op->GetAccuracy();
+            DecompressBlock(Read, decompressBuffer);
+            decompressedBlock = decompressBuffer.data();
         }
-        IncomingData = decompressBuffer.data();
+        IncomingData = (char *)decompressedBlock;
         VirtualIncomingData = IncomingData;
     }
     if (Req.Start.size())
@@ -13,6 +13,7 @@
 #include "adios2/core/IO.h"
 #include "adios2/core/Variable.h"
 
+#include "BP5Arena.h"
 #include "BP5Base.h"
 #include "atl.h"
 #include "ffs.h"
@@ -51,6 +52,11 @@ public:
         size_t ReqIndex;
         size_t OffsetInBlock;
         size_t BlockID;
+        /** file offset and stored size of the whole block */
+        size_t BlockOffset;
+        size_t BlockLength;
+        /** operator output only depends on the block, it may be reused */
+        bool DecompressedCacheable;
     };
     void InstallMetaMetaData(MetaMetaInfoBlock &MMList);
     void InstallMetaData(void *MetadataBlock, size_t BlockLen, size_t WriterRank,
@@ -75,7 +81,15 @@ public:
      */
     std::vector<ReadRequest> GenerateReadRequests(const bool doAllocTempBuffers,
                                                   size_t *maxReadSize);
-    void FinalizeGet(const ReadRequest &, const bool freeAddr);
+    /**
+     * copy the data of a read request into the user's memory
+     * @param decompressedBlock DecompressBlock() output to use instead of
+     * running the operator on the request's data, or nullptr
+     */
+    void FinalizeGet(const ReadRequest &, const bool freeAddr,
+                     const char *decompressedBlock = nullptr);
+    /** run the operator on the whole block read by an operator request */
+    void DecompressBlock(const ReadRequest &, std::vector<char> &decompressed);
     void FinalizeGets(std::vector<ReadRequest> &);
 
     MinVarInfo *AllRelativeStepsMinBlocksInfo(const VariableBase &var);
@@ -140,6 +154,9 @@ private:
         std::vector<size_t> PerWriterBlockStart;
     };
 
+    /** true if the operator output of this variable's blocks can be cached */
+    bool DecompressedCacheable(const BP5VarRec *VarRec) const;
+
     struct ControlStruct
     {
         int FieldOffset;
@@ -204,6 +221,10 @@ private:
     std::vector<std::vector<size_t *>> JoinedDimArray;
     size_t JDAIdx = 0;
 
+    // metadata blocks that could not be decoded in place, reset every step
+    // in streaming mode, kept until destruction in random access mode
+    BP5Arena m_MetaArena;
+
     ControlInfo *ControlBlocks = nullptr;
     ControlInfo *GetPriorControl(FMFormat Format);
     ControlInfo *BuildControl(FMFormat Format);
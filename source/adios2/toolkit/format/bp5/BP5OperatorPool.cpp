@@ -0,0 +1,69 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5OperatorPool.cpp
+ *
+ */
+
+#include "BP5OperatorPool.h"
+
+namespace adios2
+{
+namespace format
+{
+
+BP5OperatorPool::BP5OperatorPool(const size_t nThreads)
+{
+    for (size_t i = 0; i < nThreads; ++i)
+    {
+        m_Threads.emplace_back(&BP5OperatorPool::Work, this);
+    }
+}
+
+BP5OperatorPool::~BP5OperatorPool()
+{
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Stop = true;
+    }
+    m_Wake.notify_all();
+    for (auto &thread : m_Threads)
+    {
+        thread.join();
+    }
+}
+
+std::future<void> BP5OperatorPool::Submit(std::function<void()> task)
+{
+    std::packaged_task<void()> packaged(std::move(task));
+    std::future<void> future = packaged.get_future();
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Queue.push_back(std::move(packaged));
+    }
+    m_Wake.notify_one();
+    return future;
+}
+
+void BP5OperatorPool::Work()
+{
+    while (true)
+    {
+        std::packaged_task<void()> task;
+        {
+            std::unique_lock<std::mutex> lock(m_Mutex);
+            m_Wake.wait(lock, [this] { return m_Stop || !m_Queue.empty(); });
+            if (m_Queue.empty())
+            {
+                return;
+            }
+            task = std::move(m_Queue.front());
+            m_Queue.pop_front();
+        }
+        task();
+    }
+}
+
+} // end namespace format
+} // end namespace adios2
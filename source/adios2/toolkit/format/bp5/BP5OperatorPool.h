@@ -0,0 +1,58 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BP5OperatorPool.h
+ *
+ * Worker threads running the operators of Put blocks while the application
+ * goes on, see the BP5 OperatorThreads parameter. Tasks run in submission
+ * order as threads become free.
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BP5_BP5OPERATORPOOL_H_
+#define ADIOS2_TOOLKIT_FORMAT_BP5_BP5OPERATORPOOL_H_
+
+#include <condition_variable>
+#include <cstddef>
+#include <deque>
+#include <functional>
+#include <future>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace adios2
+{
+namespace format
+{
+
+class BP5OperatorPool
+{
+public:
+    BP5OperatorPool(const size_t nThreads);
+
+    /** runs the tasks still queued, then joins the threads */
+    ~BP5OperatorPool();
+
+    BP5OperatorPool(const BP5OperatorPool &) = delete;
+    BP5OperatorPool &operator=(const BP5OperatorPool &) = delete;
+
+    /** the future rethrows what the task threw */
+    std::future<void> Submit(std::function<void()> task);
+
+    size_t Threads() const noexcept { return m_Threads.size(); }
+
+private:
+    std::mutex m_Mutex;
+    std::condition_variable m_Wake;
+    std::deque<std::packaged_task<void()>> m_Queue;
+    bool m_Stop = false;
+    std::vector<std::thread> m_Threads;
+
+    void Work();
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BP5_BP5OPERATORPOOL_H_ */
@@ -14,10 +14,12 @@
 #include "adios2/core/VariableDerived.h"
 #endif
 #include "adios2/helper/adiosFunctions.h"
+#include "adios2/operator/OperatorChain.h"
 #include "adios2/toolkit/format/buffer/ffs/BufferFFS.h"
 
 #include <stddef.h> // max_align_t
 
+#include <chrono>
 #include <cstring>
 
 #include "BP5Serializer.h"
@@ -487,20 +489,33 @@ void BP5Serializer::ValidateWriterRec(BP5Serializer::BP5WriterRec Rec, void *Var
             "Toolkit", "format::BP5Serializer", "Marshal",
             "BP5 does not support adding operators after the first Put()");
     }
-    else if (VB->m_Operations.size() > 1)
-    {
-        // removed operator case
-        helper::Throw<std::logic_error>("Toolkit", "format::BP5Serializer", "Marshal",
-                                        "BP5 does not support multiple operators");
-    }
-    else if (Rec->OperatorType && VB->m_Operations.size() &&
-             (VB->m_Operations[0]->m_TypeString != std::string(Rec->OperatorType)))
+    else if (Rec->OperatorType &&
+             (core::OperatorChain::StagesString(VB->m_Operations) != Rec->OperatorType))
     {
         // removed operator case
         helper::Throw<std::logic_error>(
             "Toolkit", "format::BP5Serializer", "Marshal",
             "BP5 does not support changing operators after the first Put()");
     }
+    if (Rec->OperatorType)
+    {
+        SetWriterRecOperator(Rec, VB);
+    }
+}
+
+void BP5Serializer::SetWriterRecOperator(BP5WriterRec Rec, const core::VariableBase *VB)
+{
+    if (VB->m_Operations.size() == 1)
+    {
+        Rec->Operator = VB->m_Operations[0];
+        return;
+    }
+    // several operators run as one chain, kept as long as they are the same
+    auto chain = std::dynamic_pointer_cast<core::OperatorChain>(Rec->Operator);
+    if (!chain || chain->Stages() != VB->m_Operations)
+    {
+        Rec->Operator = std::make_shared<core::OperatorChain>(VB->m_Operations);
+    }
 }
 
 BP5Serializer::BP5WriterRec BP5Serializer::CreateWriterRec(void *Variable, const char *Name,
@@ -586,7 +601,7 @@ BP5Serializer::BP5WriterRec BP5Serializer::CreateWriterRec(void *Variable, const
         char *OperatorType = NULL;
         if (VB->m_Operations.size())
         {
-            OperatorType = strdup((VB->m_Operations[0])->m_TypeString.data());
+            OperatorType = strdup(core::OperatorChain::StagesString(VB->m_Operations).c_str());
         }
         // Array field.  To Metadata, add FMFields for DimCount, Shape, Count
         // and Offsets matching _MetaArrayRec
@@ -638,6 +653,10 @@ BP5Serializer::BP5WriterRec BP5Serializer::CreateWriterRec(void *Variable, const
         }
         Rec->MetaOffset = Info.MetaFields[Info.MetaFieldCount - 1].field_offset;
         Rec->OperatorType = OperatorType;
+        if (OperatorType)
+        {
+            SetWriterRecOperator(Rec, VB);
+        }
         free(LongName);
         RecalcMarshalStorageSize();
 
@@ -652,7 +671,7 @@ BP5Serializer::BP5WriterRec BP5Serializer::CreateWriterRec(void *Variable, const
 
 size_t *BP5Serializer::CopyDims(const size_t Count, const size_t *Vals)
 {
-    size_t *Ret = (size_t *)malloc(Count * sizeof(Ret[0]));
+    size_t *Ret = (size_t *)m_MetaArena.Allocate(Count * sizeof(Ret[0]));
     memcpy(Ret, Vals, Count * sizeof(Ret[0]));
     return Ret;
 }
@@ -660,7 +679,7 @@ size_t *BP5Serializer::CopyDims(const size_t Count, const size_t *Vals)
 size_t *BP5Serializer::AppendDims(size_t *OldDims, const size_t OldCount, const size_t Count,
                                   const size_t *Vals)
 {
-    size_t *Ret = (size_t *)realloc(OldDims, (OldCount + Count) * sizeof(Ret[0]));
+    size_t *Ret = (size_t *)m_MetaArena.Reallocate(OldDims, (OldCount + Count) * sizeof(Ret[0]));
     memcpy(Ret + OldCount, Vals, Count * sizeof(Ret[0]));
     return Ret;
 }
@@ -684,6 +703,9 @@ void BP5Serializer::PerformPuts(bool forceCopyDeferred)
 
 void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
 {
+    // deferred Puts with an operator are in the pool, not in DeferredExterns
+    FinishOperations();
+
     for (auto &Def : DeferredExterns)
     {
         MetaArrayRec *MetaEntry = (MetaArrayRec *)((char *)(MetadataBuf) + Def.MetaOffset);
@@ -695,6 +717,79 @@ void BP5Serializer::DumpDeferredBlocks(bool forceCopyDeferred)
     DeferredExterns.clear();
 }
 
+void BP5Serializer::QueueOperation(BP5WriterRec Rec, const size_t BlockID,
+                                   const std::string &Method, const Dims &Offsets,
+                                   const Dims &Count, const size_t ElemSize, const void *Data,
+                                   const bool Sync)
+{
+    if (!m_OperatorPool)
+    {
+        m_OperatorPool.reset(new BP5OperatorPool(m_OperatorThreads));
+    }
+
+    std::unique_ptr<PendingOperation> Op(new PendingOperation());
+    Op->MetaOffset = Rec->MetaOffset;
+    Op->BlockID = BlockID;
+    Op->ElemSize = ElemSize;
+    Op->Method = Method;
+    Op->InSize = helper::GetTotalSize(Count, ElemSize);
+    const char *In = static_cast<const char *>(Data);
+    if (Sync)
+    {
+        // the application may reuse its buffer when Put returns
+        Op->Input.assign(In, In + Op->InSize);
+        In = Op->Input.data();
+    }
+
+    // operators are not required to be reentrant, blocks of one operator
+    // run one at a time
+    std::unique_ptr<std::mutex> &OpMutex = m_OperatorMutexes[Rec->Operator.get()];
+    if (!OpMutex)
+    {
+        OpMutex.reset(new std::mutex());
+    }
+    std::mutex *Mutex = OpMutex.get();
+    std::shared_ptr<core::Operator> Operator = Rec->Operator;
+    const DataType Type = (DataType)Rec->Type;
+    PendingOperation *P = Op.get();
+    Op->Done = m_OperatorPool->Submit([P, Operator, Mutex, In, Type, Offsets, Count]() {
+        std::lock_guard<std::mutex> lock(*Mutex);
+        P->Output.resize(Operator->GetEstimatedSize(P->InSize / P->ElemSize, P->ElemSize,
+                                                    Count.size(), Count.data()));
+        P->OutSize = Operator->Operate(In, Offsets, Count, Type, P->Output.data());
+        // if the operator was not applied
+        if (P->OutSize == 0)
+            P->OutSize = helper::CopyMemoryWithOpHeader(In, Count, Type, P->Output.data(),
+                                                        Operator->GetHeaderSize(),
+                                                        MemorySpace::Host);
+    });
+    m_PendingOperations.push_back(std::move(Op));
+}
+
+void BP5Serializer::FinishOperations()
+{
+    for (auto &Op : m_PendingOperations)
+    {
+        const auto start = std::chrono::steady_clock::now();
+        Op->Done.get();
+        m_OperatorWaitMicros +=
+            std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now() - start)
+                .count();
+
+        // the data block goes wherever the buffer is now
+        MetaArrayRecOperator *OpEntry =
+            (MetaArrayRecOperator *)((char *)(MetadataBuf) + Op->MetaOffset);
+        OpEntry->DataBlockLocation[Op->BlockID] =
+            m_PriorDataBufferSizeTotal +
+            CurDataBuffer->AddToVec(Op->OutSize, Op->Output.data(), Op->ElemSize, true);
+        OpEntry->DataBlockSize[Op->BlockID] = Op->OutSize;
+        OperatorBytes &opBytes = m_OperatorBytes[Op->Method];
+        opBytes.In += Op->InSize;
+        opBytes.Out += Op->OutSize;
+    }
+    m_PendingOperations.clear();
+}
+
 static void GetMinMax(const void *Data, size_t ElemCount, const DataType Type, MinMaxStruct &MinMax,
                       MemorySpace MemSpace)
 {
@@ -803,9 +898,8 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
         else
         {
             char **StrPtr = (char **)((char *)(MetadataBuf) + Rec->MetaOffset);
-            if (AlreadyWritten && (*StrPtr != NULL))
-                free(*StrPtr);
-            *StrPtr = strdup(*(char **)Data);
+            // a previous value of this step stays in the arena until EndStep
+            *StrPtr = m_MetaArena.StrDup(*(char **)Data);
         }
     }
     else
@@ -848,19 +942,32 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
                 if (Offsets)
                     tmpOffsets.push_back(Offsets[i]);
             }
-            size_t AllocSize =
-                VB->m_Operations[0]->GetEstimatedSize(ElemCount, ElemSize, DimCount, Count);
-            BufferV::BufferPos pos = CurDataBuffer->Allocate(AllocSize, ElemSize);
-            char *CompressedData = (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
-            DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
-            CompressedSize = VB->m_Operations[0]->Operate((const char *)Data, tmpOffsets, tmpCount,
-                                                          (DataType)Rec->Type, CompressedData);
-            // if the operator was not applied
-            if (CompressedSize == 0)
-                CompressedSize = helper::CopyMemoryWithOpHeader(
-                    (const char *)Data, tmpCount, (DataType)Rec->Type, CompressedData,
-                    VB->m_Operations[0]->GetHeaderSize(), MemSpace);
-            CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+            if (m_OperatorThreads && MemSpace == MemorySpace::Host && !Span)
+            {
+                // location and size are filled in by FinishOperations
+                const size_t BlockID = AlreadyWritten ? MetaEntry->BlockCount : 0;
+                QueueOperation(Rec, BlockID, compressionMethod, tmpOffsets, tmpCount, ElemSize,
+                               Data, Sync);
+            }
+            else
+            {
+                size_t AllocSize =
+                    Rec->Operator->GetEstimatedSize(ElemCount, ElemSize, DimCount, Count);
+                BufferV::BufferPos pos = CurDataBuffer->Allocate(AllocSize, ElemSize);
+                char *CompressedData = (char *)GetPtr(pos.bufferIdx, pos.posInBuffer);
+                DataOffset = m_PriorDataBufferSizeTotal + pos.globalPos;
+                CompressedSize = Rec->Operator->Operate((const char *)Data, tmpOffsets, tmpCount,
+                                                        (DataType)Rec->Type, CompressedData);
+                // if the operator was not applied
+                if (CompressedSize == 0)
+                    CompressedSize = helper::CopyMemoryWithOpHeader(
+                        (const char *)Data, tmpCount, (DataType)Rec->Type, CompressedData,
+                        Rec->Operator->GetHeaderSize(), MemSpace);
+                CurDataBuffer->DownsizeLastAlloc(AllocSize, CompressedSize);
+                OperatorBytes &opBytes = m_OperatorBytes[compressionMethod];
+                opBytes.In += ElemCount * ElemSize;
+                opBytes.Out += CompressedSize;
+            }
         }
         else if (!WriteData)
         {
@@ -892,12 +999,12 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             MetaEntry->DBCount = DimCount;
             MetaEntry->Count = CopyDims(DimCount, Count);
             MetaEntry->BlockCount = 1;
-            MetaEntry->DataBlockLocation = (size_t *)malloc(sizeof(size_t));
+            MetaEntry->DataBlockLocation = (size_t *)m_MetaArena.Allocate(sizeof(size_t));
             MetaEntry->DataBlockLocation[0] = DataOffset;
             if (Rec->OperatorType)
             {
                 MetaArrayRecOperator *OpEntry = (MetaArrayRecOperator *)MetaEntry;
-                OpEntry->DataBlockSize = (size_t *)malloc(sizeof(size_t));
+                OpEntry->DataBlockSize = (size_t *)m_MetaArena.Allocate(sizeof(size_t));
                 OpEntry->DataBlockSize[0] = CompressedSize;
             }
             if (Offsets)
@@ -907,7 +1014,7 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             if (DoMinMax)
             {
                 void **MMPtrLoc = (void **)(((char *)MetaEntry) + Rec->MinMaxOffset);
-                *MMPtrLoc = (void *)malloc(ElemSize * 2);
+                *MMPtrLoc = m_MetaArena.Allocate(ElemSize * 2);
                 if (!Span)
                 {
                     memcpy(*MMPtrLoc, &MinMax.MinUnion, ElemSize);
@@ -936,20 +1043,20 @@ void BP5Serializer::Marshal(void *Variable, const char *Name, const DataType Typ
             MetaEntry->DBCount += DimCount;
             MetaEntry->BlockCount++;
             MetaEntry->Count = AppendDims(MetaEntry->Count, PreviousDBCount, DimCount, Count);
-            MetaEntry->DataBlockLocation = (size_t *)realloc(
+            MetaEntry->DataBlockLocation = (size_t *)m_MetaArena.Reallocate(
                 MetaEntry->DataBlockLocation, MetaEntry->BlockCount * sizeof(size_t));
             MetaEntry->DataBlockLocation[MetaEntry->BlockCount - 1] = DataOffset;
             if (Rec->OperatorType)
             {
                 MetaArrayRecOperator *OpEntry = (MetaArrayRecOperator *)MetaEntry;
-                OpEntry->DataBlockSize =
-                    (size_t *)realloc(OpEntry->DataBlockSize, OpEntry->BlockCount * sizeof(size_t));
+                OpEntry->DataBlockSize = (size_t *)m_MetaArena.Reallocate(
+                    OpEntry->DataBlockSize, OpEntry->BlockCount * sizeof(size_t));
                 OpEntry->DataBlockSize[OpEntry->BlockCount - 1] = CompressedSize;
             }
             if (DoMinMax)
             {
                 void **MMPtrLoc = (void **)(((char *)MetaEntry) + Rec->MinMaxOffset);
-                *MMPtrLoc = (void *)realloc(*MMPtrLoc, MetaEntry->BlockCount * ElemSize * 2);
+                *MMPtrLoc = m_MetaArena.Reallocate(*MMPtrLoc, MetaEntry->BlockCount * ElemSize * 2);
                 if (!Span)
                 {
                     memcpy(((char *)*MMPtrLoc) + ElemSize * (2 * (MetaEntry->BlockCount - 1)),
@@ -991,6 +1098,9 @@ const void *BP5Serializer::SearchDeferredBlocks(size_t MetaOffset, size_t BlockI
 
 MinVarInfo *BP5Serializer::MinBlocksInfo(const core::VariableBase &Var)
 {
+    // blocks still in the operator pool have no location yet
+    FinishOperations();
+
     BP5WriterRec VarRec = LookupWriterRec((void *)&Var);
 
     if (!VarRec)
@@ -1422,19 +1532,17 @@ BP5Serializer::TimestepInfo BP5Serializer::CloseTimestep(int timestep, bool forc
     }
 
     // FMdump_encoded_data(Info.MetaFormat, MetaDataBlock, 1024000);
-    /* free all those copied dimensions, etc */
-    MBase = (struct BP5MetadataInfoStruct *)Metadata;
-    size_t *tmp = MBase->BitField;
     /*
-     * BitField value is saved away from FMfree_var_rec_elements() so that it
-     * isn't unnecessarily free'd.
+     * All copied dimensions, block locations, min/max and strings live in the
+     * metadata arena, release them at once.  The BitField is malloc'd and
+     * reused for the next step, save it from the memset.
      */
-    MBase->BitField = NULL;
-    if (Info.MetaFormat)
-        FMfree_var_rec_elements(Info.MetaFormat, MetadataBuf);
+    MBase = (struct BP5MetadataInfoStruct *)MetadataBuf;
+    size_t *tmp = MBase->BitField;
     if (MetadataBuf && MetadataSize)
         memset(MetadataBuf, 0, MetadataSize);
     MBase->BitField = tmp;
+    m_MetaArena.Reset();
     NewAttribute = false;
 
     struct TimestepInfo Ret;
@@ -8,7 +8,9 @@
 #ifndef ADIOS2_TOOLKIT_FORMAT_BP5_BP5SERIALIZER_H_
 #define ADIOS2_TOOLKIT_FORMAT_BP5_BP5SERIALIZER_H_
 
+#include "BP5Arena.h"
 #include "BP5Base.h"
+#include "BP5OperatorPool.h"
 #include "adios2/core/Attribute.h"
 #include "adios2/core/CoreTypes.h"
 #include "adios2/core/IO.h"
@@ -21,6 +23,11 @@
 #pragma warning(disable : 4250)
 #endif
 
+#include <deque>
+#include <future>
+#include <map>
+#include <memory>
+#include <mutex>
 #include <unordered_map>
 
 namespace adios2
@@ -133,6 +140,21 @@ public:
 
     int m_StatsLevel = 1;
 
+    /* Bytes given to and produced by each operator type, for engine metrics */
+    struct OperatorBytes
+    {
+        size_t In = 0;
+        size_t Out = 0;
+    };
+    std::map<std::string, OperatorBytes> m_OperatorBytes;
+
+    /* Threads running operators while the application goes on, 0 to run
+     * them in Marshal */
+    size_t m_OperatorThreads = 0;
+    /* time spent waiting for them, for engine metrics */
+    double m_OperatorWaitMicros = 0.0;
+    size_t PendingOperations() const noexcept { return m_PendingOperations.size(); }
+
     /* Variables to help appending to existing file */
     size_t m_PreMetaMetadataFileLength = 0;
 
@@ -150,6 +172,8 @@ private:
         size_t DataOffset;
         size_t MetaOffset;
         char *OperatorType = NULL;
+        /** the variable's operator, or a chain of all of them */
+        std::shared_ptr<core::Operator> Operator;
         int DimCount;
         int Type;
         size_t MinMaxOffset;
@@ -195,10 +219,31 @@ private:
     };
     std::vector<DeferredSpanMinMax> DefSpanMinMax;
 
+    /* a block given to the operator pool, its data is added to the buffer
+     * in Put order by FinishOperations */
+    struct PendingOperation
+    {
+        size_t MetaOffset;
+        size_t BlockID;
+        size_t ElemSize;
+        std::string Method;
+        size_t InSize;
+        std::vector<char> Input; // copy of the data of a sync Put
+        std::vector<char> Output;
+        size_t OutSize = 0;
+        std::future<void> Done;
+    };
+    std::deque<std::unique_ptr<PendingOperation>> m_PendingOperations;
+    std::unordered_map<const core::Operator *, std::unique_ptr<std::mutex>> m_OperatorMutexes;
+    /* declared after m_PendingOperations, its threads are joined first */
+    std::unique_ptr<BP5OperatorPool> m_OperatorPool;
+
     BP5AttrStruct *PendingAttrs = nullptr;
 
     FFSWriterMarshalBase Info;
     void *MetadataBuf = NULL;
+    /** dimensions, block locations and min/max of the open step */
+    BP5Arena m_MetaArena;
     bool NewAttribute = false;
 
     size_t MetadataSize = 0;
@@ -212,6 +257,8 @@ private:
     BP5WriterRec CreateWriterRec(void *Variable, const char *Name, DataType Type, size_t ElemSize,
                                  size_t DimCount);
     void ValidateWriterRec(BP5WriterRec Rec, void *Variable);
+    /** set Rec->Operator from the variable's operations */
+    void SetWriterRecOperator(BP5WriterRec Rec, const core::VariableBase *VB);
     void CollectFinalShapeValues();
     void RecalcMarshalStorageSize();
     void RecalcAttributeStorageSize();
@@ -237,6 +284,11 @@ private:
                        const size_t *Vals);
 
     void DumpDeferredBlocks(bool forceCopyDeferred = false);
+    void QueueOperation(BP5WriterRec Rec, const size_t BlockID, const std::string &Method,
+                        const Dims &Offsets, const Dims &Count, const size_t ElemSize,
+                        const void *Data, const bool Sync);
+    /** wait for the operator pool, then add its blocks to the data buffer */
+    void FinishOperations();
     void VariableStatsEnabled(void *Variable);
 
     typedef struct _ArrayRec
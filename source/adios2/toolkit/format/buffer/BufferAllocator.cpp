@@ -0,0 +1,401 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BufferAllocator.cpp
+ *
+ */
+
+#include "BufferAllocator.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
+#include <algorithm>
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+#include <sys/mman.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+
+#ifndef MAP_HUGE_SHIFT
+#define MAP_HUGE_SHIFT 26
+#endif
+// from numaif.h, without linking libnuma
+#ifndef MPOL_PREFERRED
+#define MPOL_PREFERRED 1
+#endif
+#ifndef MPOL_BIND
+#define MPOL_BIND 2
+#endif
+#ifndef MPOL_MF_MOVE
+#define MPOL_MF_MOVE (1 << 1)
+#endif
+#endif
+
+namespace adios2
+{
+namespace format
+{
+
+namespace
+{
+const size_t HugePage2MB = size_t(1) << 21;
+const size_t HugePage1GB = size_t(1) << 30;
+
+// warn once per process about missing huge pages or a failing NUMA binding
+std::atomic<bool> HugeTLBWarned(false);
+std::atomic<bool> BindWarned(false);
+
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+bool Bind(void *p, const size_t size, const int mode, const int node)
+{
+    if (node < 0)
+    {
+        return false;
+    }
+    const size_t bits = 8 * sizeof(unsigned long);
+    std::vector<unsigned long> mask(static_cast<size_t>(node) / bits + 1, 0);
+    mask[static_cast<size_t>(node) / bits] |= 1UL << (static_cast<size_t>(node) % bits);
+    return syscall(SYS_mbind, p, size, mode, mask.data(), mask.size() * bits + 1,
+                   MPOL_MF_MOVE) == 0;
+}
+#endif
+}
+
+BufferAllocator::BufferAllocator(const std::string &hugePages, const std::string &numaPolicy,
+                                 const size_t poolSize)
+: m_PoolSize(poolSize)
+{
+    const std::string pages = helper::LowerCase(hugePages);
+    if (pages == "transparent" || pages == "thp")
+    {
+        m_HugePages = HugePages::Transparent;
+    }
+    else if (pages == "2mb")
+    {
+        m_HugePages = HugePages::Huge2MB;
+    }
+    else if (pages == "1gb")
+    {
+        m_HugePages = HugePages::Huge1GB;
+    }
+    else if (!pages.empty() && pages != "none")
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "format::BufferAllocator",
+                                             "BufferAllocator",
+                                             "BufferHugePages must be none, transparent, 2MB or "
+                                             "1GB, not " +
+                                                 hugePages);
+    }
+
+    const std::string numa = helper::LowerCase(numaPolicy);
+    if (numa == "firsttouch")
+    {
+        m_NumaPolicy = NumaPolicy::FirstTouch;
+    }
+    else if (numa == "local")
+    {
+        m_NumaPolicy = NumaPolicy::Local;
+    }
+    else if (!numa.empty() && numa != "none")
+    {
+        m_NumaPolicy = NumaPolicy::Node;
+        m_NumaNode = static_cast<int>(helper::StringToSizeT(
+            numa, "BufferNumaPolicy must be none, firsttouch, local or a node number"));
+    }
+
+#ifndef ADIOS2_HAVE_MEMORY_POLICY
+    if (m_HugePages != HugePages::None || m_NumaPolicy != NumaPolicy::None)
+    {
+        helper::Log("Toolkit", "format::BufferAllocator", "BufferAllocator",
+                    "huge pages and NUMA placement are not supported on this platform, "
+                    "BufferHugePages and BufferNumaPolicy are ignored",
+                    helper::LogMode::WARNING);
+        m_HugePages = HugePages::None;
+        m_NumaPolicy = NumaPolicy::None;
+    }
+#endif
+}
+
+BufferAllocator::~BufferAllocator()
+{
+    for (const auto &entry : m_Pool)
+    {
+        if (UsesMap())
+        {
+            Unmap(entry.Ptr, entry.Size);
+        }
+        else
+        {
+            free(entry.Ptr);
+        }
+    }
+}
+
+void *BufferAllocator::Allocate(const size_t size, size_t &allocated)
+{
+    if (m_PoolBytes)
+    {
+        // smallest pooled block that fits, but not wasting more than half of it
+        const int node = CurrentNode();
+        std::lock_guard<std::mutex> lock(m_PoolMutex);
+        auto best = m_Pool.end();
+        for (auto it = m_Pool.begin(); it != m_Pool.end(); ++it)
+        {
+            if (it->Size >= size && it->Size / 2 <= size && it->Node == node &&
+                (best == m_Pool.end() || it->Size < best->Size))
+            {
+                best = it;
+            }
+        }
+        if (best != m_Pool.end())
+        {
+            void *p = best->Ptr;
+            allocated = best->Size;
+            m_PoolBytes -= best->Size;
+            m_Pool.erase(best);
+            return p;
+        }
+    }
+
+    if (UsesMap())
+    {
+        return Map(size, allocated);
+    }
+    allocated = size;
+    return malloc(size);
+}
+
+void *BufferAllocator::Reallocate(void *p, const size_t allocated, const size_t used,
+                                  const size_t size, size_t &newAllocated)
+{
+    if (p && size <= allocated)
+    {
+        // shrinking keeps the whole block, it goes back to the pool as it is
+        newAllocated = allocated;
+        return p;
+    }
+    if (!UsesMap() && !m_PoolSize)
+    {
+        newAllocated = size;
+        return realloc(p, size);
+    }
+    void *q = Allocate(size, newAllocated);
+    if (q && p)
+    {
+        std::memcpy(q, p, std::min(used, size));
+        Free(p, allocated);
+    }
+    return q;
+}
+
+void BufferAllocator::Free(void *p, const size_t allocated)
+{
+    if (!p)
+    {
+        return;
+    }
+    {
+        std::lock_guard<std::mutex> lock(m_PoolMutex);
+        if (m_PoolBytes + allocated <= m_PoolSize)
+        {
+            // the thread freeing is not necessarily the one that allocated
+            int node = -1;
+            if (m_NumaPolicy == NumaPolicy::Local)
+            {
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+                int mode = 0;
+                unsigned long mask = 0;
+                const unsigned long flags = 1 | 2; // MPOL_F_NODE | MPOL_F_ADDR
+                if (syscall(SYS_get_mempolicy, &mode, &mask, 8 * sizeof(mask), p, flags) == 0)
+                {
+                    node = mode;
+                }
+#endif
+            }
+            m_Pool.push_back({p, allocated, node});
+            m_PoolBytes += allocated;
+            return;
+        }
+    }
+    if (UsesMap())
+    {
+        Unmap(p, allocated);
+    }
+    else
+    {
+        free(p);
+    }
+}
+
+void BufferAllocator::Advise(void *p, const size_t size) const
+{
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+    if (m_HugePages == HugePages::None && m_NumaPolicy == NumaPolicy::None)
+    {
+        return;
+    }
+    // madvise and mbind work on whole pages
+    const uintptr_t page = static_cast<uintptr_t>(sysconf(_SC_PAGESIZE));
+    const uintptr_t begin = (reinterpret_cast<uintptr_t>(p) + page - 1) & ~(page - 1);
+    const uintptr_t end = (reinterpret_cast<uintptr_t>(p) + size) & ~(page - 1);
+    if (end <= begin)
+    {
+        return;
+    }
+    char *b = reinterpret_cast<char *>(begin);
+    const size_t length = static_cast<size_t>(end - begin);
+
+    if (m_HugePages != HugePages::None)
+    {
+        // fails harmlessly on MAP_HUGETLB memory
+        madvise(b, length, MADV_HUGEPAGE);
+    }
+
+    bool bound = true;
+    switch (m_NumaPolicy)
+    {
+    case NumaPolicy::FirstTouch:
+        for (size_t i = 0; i < length; i += page)
+        {
+            // keeps the content, the page is placed on this thread's node
+            volatile char *c = b + i;
+            *c = *c;
+        }
+        break;
+    case NumaPolicy::Local:
+        bound = Bind(b, length, MPOL_PREFERRED, CurrentNode());
+        break;
+    case NumaPolicy::Node:
+        bound = Bind(b, length, MPOL_BIND, m_NumaNode);
+        break;
+    default:
+        break;
+    }
+    if (!bound && !BindWarned.exchange(true))
+    {
+        helper::Log("Toolkit", "format::BufferAllocator", "Advise",
+                    "mbind() failed, buffers are not placed by BufferNumaPolicy",
+                    helper::LogMode::WARNING);
+    }
+#endif
+}
+
+size_t BufferAllocator::PoolBytes() const
+{
+    std::lock_guard<std::mutex> lock(m_PoolMutex);
+    return m_PoolBytes;
+}
+
+bool BufferAllocator::UsesMap() const noexcept
+{
+    return m_HugePages != HugePages::None || m_NumaPolicy != NumaPolicy::None;
+}
+
+size_t BufferAllocator::PageSize() const noexcept
+{
+    switch (m_HugePages)
+    {
+    case HugePages::Transparent:
+    case HugePages::Huge2MB:
+        return HugePage2MB;
+    case HugePages::Huge1GB:
+        return HugePage1GB;
+    default:
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+        return static_cast<size_t>(sysconf(_SC_PAGESIZE));
+#else
+        return 4096;
+#endif
+    }
+}
+
+void *BufferAllocator::Map(const size_t size, size_t &allocated)
+{
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+    // a block smaller than a huge page would waste the rest of it, it gets
+    // transparent huge pages, or normal pages below 2MB
+    void *p = MAP_FAILED;
+    if ((m_HugePages == HugePages::Huge2MB || m_HugePages == HugePages::Huge1GB) &&
+        size >= PageSize())
+    {
+        const int shift = m_HugePages == HugePages::Huge2MB ? 21 : 30;
+        allocated = (size + PageSize() - 1) / PageSize() * PageSize();
+        p = mmap(nullptr, allocated, PROT_READ | PROT_WRITE,
+                 MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB | (shift << MAP_HUGE_SHIFT), -1, 0);
+        if (p == MAP_FAILED && !HugeTLBWarned.exchange(true))
+        {
+            helper::Log("Toolkit", "format::BufferAllocator", "Map",
+                        "no huge pages of the size of BufferHugePages are available, "
+                        "using transparent huge pages instead",
+                        helper::LogMode::WARNING);
+        }
+    }
+    if (p == MAP_FAILED)
+    {
+        // over-map by one huge page to align the block to it
+        const size_t align =
+            m_HugePages == HugePages::None || size < HugePage2MB ? 0 : HugePage2MB;
+        const size_t page = align ? align : static_cast<size_t>(sysconf(_SC_PAGESIZE));
+        allocated = (size + page - 1) / page * page;
+        char *q = static_cast<char *>(mmap(nullptr, allocated + align, PROT_READ | PROT_WRITE,
+                                           MAP_PRIVATE | MAP_ANONYMOUS, -1, 0));
+        if (q == MAP_FAILED)
+        {
+            return nullptr;
+        }
+        if (align)
+        {
+            char *a = reinterpret_cast<char *>((reinterpret_cast<uintptr_t>(q) + align - 1) &
+                                               ~(static_cast<uintptr_t>(align) - 1));
+            if (a > q)
+            {
+                munmap(q, static_cast<size_t>(a - q));
+            }
+            const size_t tail = static_cast<size_t>((q + allocated + align) - (a + allocated));
+            if (tail)
+            {
+                munmap(a + allocated, tail);
+            }
+            q = a;
+        }
+        p = q;
+    }
+    Advise(p, allocated);
+    return p;
+#else
+    allocated = size;
+    return malloc(size);
+#endif
+}
+
+void BufferAllocator::Unmap(void *p, const size_t allocated)
+{
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+    munmap(p, allocated);
+#else
+    free(p);
+#endif
+}
+
+int BufferAllocator::CurrentNode() const noexcept
+{
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+    if (m_NumaPolicy == NumaPolicy::Local)
+    {
+        unsigned int cpu = 0, node = 0;
+        if (syscall(SYS_getcpu, &cpu, &node, nullptr) == 0)
+        {
+            return static_cast<int>(node);
+        }
+    }
+#endif
+    return -1;
+}
+
+} // end namespace format
+} // end namespace adios2
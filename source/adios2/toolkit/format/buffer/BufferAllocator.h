@@ -0,0 +1,101 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BufferAllocator.h
+ * Memory of BufferV buffers with an optional page size and NUMA placement,
+ * and a pool keeping freed blocks for the next steps
+ */
+
+#ifndef ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_
+#define ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_
+
+#include "adios2/common/ADIOSConfig.h"
+
+#include <cstddef>
+#include <mutex>
+#include <string>
+#include <vector>
+
+namespace adios2
+{
+namespace format
+{
+
+class BufferAllocator
+{
+public:
+    enum class HugePages
+    {
+        None,
+        Transparent, // madvise(MADV_HUGEPAGE) on 2MB aligned memory
+        Huge2MB,     // MAP_HUGETLB, needs reserved huge pages
+        Huge1GB
+    };
+
+    enum class NumaPolicy
+    {
+        None,
+        FirstTouch, // pages are touched by the allocating thread
+        Local,      // preferred node is the one of the allocating thread
+        Node        // bound to m_NumaNode
+    };
+
+    /**
+     * @param hugePages none, transparent, 2MB or 1GB
+     * @param numaPolicy none, firsttouch, local or a node number
+     * @param poolSize max bytes of freed blocks kept for reuse
+     */
+    BufferAllocator(const std::string &hugePages, const std::string &numaPolicy,
+                    const size_t poolSize);
+    ~BufferAllocator();
+
+    /**
+     * at least size bytes, the usable size is returned in allocated. Huge
+     * pages are only used for blocks of at least one huge page, blocks
+     * below 2MB get normal pages.
+     */
+    void *Allocate(const size_t size, size_t &allocated);
+
+    /** p if it is large enough, otherwise a new block with the first used bytes of p */
+    void *Reallocate(void *p, const size_t allocated, const size_t used, const size_t size,
+                     size_t &newAllocated);
+
+    /** back to the pool if there is room, to the system otherwise */
+    void Free(void *p, const size_t allocated);
+
+    /** the page size and NUMA policy for memory allocated elsewhere */
+    void Advise(void *p, const size_t size) const;
+
+    size_t PoolBytes() const;
+
+private:
+    HugePages m_HugePages = HugePages::None;
+    NumaPolicy m_NumaPolicy = NumaPolicy::None;
+    int m_NumaNode = -1;
+    const size_t m_PoolSize;
+
+    struct PoolEntry
+    {
+        void *Ptr;
+        size_t Size;
+        int Node; // of a Local allocation, -1 otherwise
+    };
+    mutable std::mutex m_PoolMutex;
+    std::vector<PoolEntry> m_Pool;
+    size_t m_PoolBytes = 0;
+
+    /** malloc/free without a page size or NUMA policy, mmap otherwise */
+    bool UsesMap() const noexcept;
+    /** the huge page of m_HugePages, the system page for None */
+    size_t PageSize() const noexcept;
+    void *Map(const size_t size, size_t &allocated);
+    void Unmap(void *p, const size_t allocated);
+    /** node of the calling thread for Local, -1 otherwise */
+    int CurrentNode() const noexcept;
+};
+
+} // end namespace format
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_FORMAT_BUFFER_BUFFERALLOCATOR_H_ */
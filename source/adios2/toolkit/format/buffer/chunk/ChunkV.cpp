@@ -22,8 +22,10 @@ namespace format
 {
 
 ChunkV::ChunkV(const std::string type, const bool AlwaysCopy, const size_t MemAlign,
-               const size_t MemBlockSize, const size_t ChunkSize)
-: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_ChunkSize(ChunkSize)
+               const size_t MemBlockSize, const size_t ChunkSize,
+               std::shared_ptr<BufferAllocator> Allocator)
+: BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_ChunkSize(ChunkSize),
+  m_Allocator(std::move(Allocator))
 {
 }
 
@@ -31,7 +33,14 @@ ChunkV::~ChunkV()
 {
     for (const auto &Chunk : m_Chunks)
     {
-        free(Chunk.AllocatedPtr);
+        if (m_Allocator)
+        {
+            m_Allocator->Free(Chunk.AllocatedPtr, Chunk.Allocated);
+        }
+        else
+        {
+            free(Chunk.AllocatedPtr);
+        }
     }
 }
 
@@ -47,7 +56,17 @@ size_t ChunkV::ChunkAlloc(Chunk &v, const size_t size)
     }
 
     // align usable buffer to m_MemAlign bytes
-    void *b = realloc(v.AllocatedPtr, actualsize + m_MemAlign - 1);
+    void *b;
+    if (m_Allocator)
+    {
+        // downsizing keeps the block, it is reused whole through the pool
+        b = m_Allocator->Reallocate(v.AllocatedPtr, v.Allocated, v.Size + m_MemAlign - 1,
+                                    actualsize + m_MemAlign - 1, v.Allocated);
+    }
+    else
+    {
+        b = realloc(v.AllocatedPtr, actualsize + m_MemAlign - 1);
+    }
     if (b)
     {
         if (b != v.AllocatedPtr)
@@ -139,7 +158,7 @@ size_t ChunkV::AddToVec(const size_t size, const void *buf, size_t align, bool C
             size_t NewSize = m_ChunkSize;
             if (size > m_ChunkSize)
                 NewSize = size;
-            Chunk c{nullptr, nullptr, 0};
+            Chunk c{nullptr, nullptr, 0, 0};
             ChunkAlloc(c, NewSize);
             m_Chunks.push_back(c);
             m_TailChunk = &m_Chunks.back();
@@ -219,7 +238,7 @@ BufferV::BufferPos ChunkV::Allocate(const size_t size, size_t align)
         size_t NewSize = m_ChunkSize;
         if (size > m_ChunkSize)
             NewSize = size;
-        Chunk c{nullptr, nullptr, 0};
+        Chunk c{nullptr, nullptr, 0, 0};
         ChunkAlloc(c, NewSize);
         m_Chunks.push_back(c);
         m_TailChunk = &m_Chunks.back();
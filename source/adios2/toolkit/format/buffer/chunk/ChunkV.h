@@ -11,8 +11,11 @@
 #include "adios2/common/ADIOSTypes.h"
 #include "adios2/core/CoreTypes.h"
 
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 
+#include <memory>
+
 namespace adios2
 {
 namespace format
@@ -26,7 +29,8 @@ public:
     const size_t m_ChunkSize;
 
     ChunkV(const std::string type, const bool AlwaysCopy = false, const size_t MemAlign = 1,
-           const size_t MemBlockSize = 1, const size_t ChunkSize = DefaultBufferChunkSize);
+           const size_t MemBlockSize = 1, const size_t ChunkSize = DefaultBufferChunkSize,
+           std::shared_ptr<BufferAllocator> Allocator = nullptr);
     virtual ~ChunkV();
 
     virtual std::vector<core::iovec> DataVec() noexcept;
@@ -48,8 +52,12 @@ private:
         char *Ptr;          // aligned, do not free
         void *AllocatedPtr; // original ptr, free this
         size_t Size;
+        size_t Allocated; // of AllocatedPtr, only with m_Allocator
     };
 
+    // chunk memory with a page size, NUMA policy and pool, malloc if not set
+    std::shared_ptr<BufferAllocator> m_Allocator;
+
     std::vector<Chunk> m_Chunks;
     size_t m_TailChunkPos = 0;
     Chunk *m_TailChunk = nullptr;
@@ -21,16 +21,37 @@ namespace format
 {
 
 MallocV::MallocV(const std::string type, const bool AlwaysCopy, const size_t MemAlign,
-                 const size_t MemBlockSize, size_t InitialBufferSize, double GrowthFactor)
+                 const size_t MemBlockSize, size_t InitialBufferSize, double GrowthFactor,
+                 std::shared_ptr<BufferAllocator> Allocator)
 : BufferV(type, AlwaysCopy, MemAlign, MemBlockSize), m_InitialBufferSize(InitialBufferSize),
-  m_GrowthFactor(GrowthFactor)
+  m_GrowthFactor(GrowthFactor), m_Allocator(std::move(Allocator))
 {
 }
 
 MallocV::~MallocV()
 {
     if (m_InternalBlock)
-        free(m_InternalBlock);
+    {
+        if (m_Allocator)
+            m_Allocator->Free(m_InternalBlock, m_BlockAllocated);
+        else
+            free(m_InternalBlock);
+    }
+}
+
+void MallocV::Resize(const size_t NewSize)
+{
+    if (m_Allocator)
+    {
+        m_InternalBlock = (char *)m_Allocator->Reallocate(m_InternalBlock, m_BlockAllocated,
+                                                          m_internalPos, NewSize, m_BlockAllocated);
+        m_AllocatedSize = m_BlockAllocated;
+    }
+    else
+    {
+        m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
+        m_AllocatedSize = NewSize;
+    }
 }
 
 void MallocV::Reset()
@@ -72,8 +93,7 @@ size_t MallocV::AddToVec(const size_t size, const void *buf, size_t align, bool
             {
                 NewSize = (size_t)(m_AllocatedSize * m_GrowthFactor);
             }
-            m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
-            m_AllocatedSize = NewSize;
+            Resize(NewSize);
         }
 #ifdef ADIOS2_HAVE_GPU_SUPPORT
         if (MemSpace == MemorySpace::GPU)
@@ -120,8 +140,7 @@ BufferV::BufferPos MallocV::Allocate(const size_t size, size_t align)
         {
             NewSize = (size_t)(m_AllocatedSize * m_GrowthFactor);
         }
-        m_InternalBlock = (char *)realloc(m_InternalBlock, NewSize);
-        m_AllocatedSize = NewSize;
+        Resize(NewSize);
     }
 
     if (DataV.size() && !DataV.back().External &&
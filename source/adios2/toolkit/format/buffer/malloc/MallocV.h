@@ -11,8 +11,11 @@
 #include "adios2/common/ADIOSTypes.h"
 #include "adios2/core/CoreTypes.h"
 
+#include "adios2/toolkit/format/buffer/BufferAllocator.h"
 #include "adios2/toolkit/format/buffer/BufferV.h"
 
+#include <memory>
+
 namespace adios2
 {
 namespace format
@@ -25,7 +28,8 @@ public:
 
     MallocV(const std::string type, const bool AlwaysCopy = false, const size_t MemAlign = 1,
             const size_t MemBlockSize = 1, size_t InitialBufferSize = DefaultInitialBufferSize,
-            double GrowthFactor = DefaultBufferGrowthFactor);
+            double GrowthFactor = DefaultBufferGrowthFactor,
+            std::shared_ptr<BufferAllocator> Allocator = nullptr);
     virtual ~MallocV();
 
     virtual std::vector<core::iovec> DataVec() noexcept;
@@ -49,6 +53,11 @@ private:
     size_t m_AllocatedSize = 0;
     const size_t m_InitialBufferSize = 16 * 1024;
     const double m_GrowthFactor = 1.05;
+    // block memory with a page size, NUMA policy and pool, malloc if not set
+    std::shared_ptr<BufferAllocator> m_Allocator;
+    size_t m_BlockAllocated = 0; // of m_InternalBlock, only with m_Allocator
+
+    void Resize(const size_t NewSize);
 };
 
 } // end namespace format
@@ -11,11 +11,15 @@
 #include "HDF5Common.h"
 #include "HDF5Common.tcc"
 
+#include <algorithm>
 #include <complex>
 #include <ios>
 #include <iostream>
 #include <limits>
+#include <map>
+#include <memory>
 #include <mutex>
+#include <set>
 #include <stdexcept>
 #include <vector>
 
@@ -50,6 +54,14 @@ const std::string HDF5Common::PARAMETER_COLLECTIVE = "H5CollectiveMPIO";
 const std::string HDF5Common::PARAMETER_CHUNK_FLAG = "H5ChunkDim";
 const std::string HDF5Common::PARAMETER_CHUNK_VARS = "H5ChunkVars";
 const std::string HDF5Common::PARAMETER_HAS_IDLE_WRITER_RANK = "IdleH5Writer";
+const std::string HDF5Common::PARAMETER_DEFERRED_PUTS = "H5DeferredPuts";
+const std::string HDF5Common::PARAMETER_CHUNK_BY_BLOCK = "H5ChunkByBlock";
+
+// registered HDF5 filter identifiers of the compressors ADIOS operators use
+constexpr H5Z_filter_t FILTER_ID_BZIP2 = 307;
+constexpr H5Z_filter_t FILTER_ID_BLOSC = 32001;
+constexpr H5Z_filter_t FILTER_ID_ZFP = 32013;
+constexpr H5Z_filter_t FILTER_ID_SZ = 32017;
 
 #define CHECK_H5_RETURN(returnCode, reason)                                                        \
     {                                                                                              \
@@ -100,6 +112,19 @@ HDF5Common::~HDF5Common() { Close(); }
 
 void HDF5Common::ParseParameters(core::IO &io)
 {
+    {
+        auto itKey = io.m_Parameters.find(PARAMETER_DEFERRED_PUTS);
+        if (itKey != io.m_Parameters.end())
+        {
+            m_DeferredPuts = (itKey->second == "yes" || itKey->second == "true");
+        }
+        itKey = io.m_Parameters.find(PARAMETER_CHUNK_BY_BLOCK);
+        if (itKey != io.m_Parameters.end())
+        {
+            m_ChunkByBlock = (itKey->second == "yes" || itKey->second == "true");
+        }
+    }
+
     if (m_MPI)
     {
         m_MPI->set_dxpl_mpio(m_PropertyTxfID,
@@ -110,6 +135,11 @@ void HDF5Common::ParseParameters(core::IO &io)
             if (itKey->second == "yes" || itKey->second == "true")
                 m_MPI->set_dxpl_mpio(m_PropertyTxfID, H5FD_MPIO_COLLECTIVE);
         }
+        else if (m_DeferredPuts)
+        {
+            // batched writes are collective calls anyway
+            m_MPI->set_dxpl_mpio(m_PropertyTxfID, H5FD_MPIO_COLLECTIVE);
+        }
 
         itKey = io.m_Parameters.find(PARAMETER_HAS_IDLE_WRITER_RANK);
         if (itKey != io.m_Parameters.end())
@@ -170,6 +200,7 @@ void HDF5Common::ParseParameters(core::IO &io)
 
 void HDF5Common::Append(const std::string &name, helper::Comm const &comm)
 {
+    m_Comm = &comm;
     m_PropertyListId = H5Pcreate(H5P_FILE_ACCESS);
 
     if (MPI_API const *mpi = GetHDF5Common_MPI_API())
@@ -217,6 +248,7 @@ void HDF5Common::Append(const std::string &name, helper::Comm const &comm)
 void HDF5Common::Init(const std::string &name, helper::Comm const &comm, bool toWrite)
 {
     m_WriteMode = toWrite;
+    m_Comm = &comm;
     m_PropertyListId = H5Pcreate(H5P_FILE_ACCESS);
 
     if (MPI_API const *mpi = GetHDF5Common_MPI_API())
@@ -967,7 +999,7 @@ hid_t HDF5Common::GetTypeStringScalar(const std::string &input)
 }
 
 void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type, hid_t filespaceID,
-                               std::vector<hid_t> &datasetChain)
+                               std::vector<hid_t> &datasetChain, hid_t createProperty)
 {
     std::vector<std::string> list;
     char delimiter = '/';
@@ -1003,13 +1035,10 @@ void HDF5Common::CreateDataset(const std::string &varName, hid_t h5Type, hid_t f
         }
     }
 
-    hid_t varCreateProperty = H5P_DEFAULT;
-    if (-1 != m_ChunkPID)
+    hid_t varCreateProperty = createProperty;
+    if (varCreateProperty == H5P_DEFAULT && HasChunkParameter(varName))
     {
-        if (m_ChunkVarNames.size() == 0) // applies to all var
-            varCreateProperty = m_ChunkPID;
-        else if (m_ChunkVarNames.find(varName) != m_ChunkVarNames.end())
-            varCreateProperty = m_ChunkPID;
+        varCreateProperty = m_ChunkPID;
     }
 
     /*
@@ -1771,18 +1800,518 @@ void HDF5Common::StaticGetAdiosStepString(std::string &stepName, size_t ts)
     stepName = "/Step" + std::to_string(ts);
 }
 
+void HDF5Common::PerformWrites(helper::Comm const &comm, core::IO &io)
+{
+    if (!m_DeferredPuts)
+    {
+        // Puts were written right away, nothing to agree on
+        return;
+    }
+
+    std::map<std::string, std::vector<const DeferredBlock *>> blocks;
+    for (const auto &block : m_DeferredBlocks)
+    {
+        blocks[block.name].push_back(&block);
+    }
+
+    // datasets of all ranks, sorted so that every rank creates them in the
+    // same order
+    std::vector<std::string> names;
+    if (comm.Size() > 1)
+    {
+        std::string local;
+        for (const auto &entry : blocks)
+        {
+            local += entry.first;
+            local += '\0';
+        }
+        const std::vector<size_t> sizes = comm.AllGatherValues(local.size());
+        std::vector<size_t> displs(sizes.size(), 0);
+        for (size_t i = 1; i < sizes.size(); ++i)
+        {
+            displs[i] = displs[i - 1] + sizes[i - 1];
+        }
+        std::string all(displs.back() + sizes.back(), '\0');
+        if (all.empty())
+        {
+            return;
+        }
+        comm.Allgatherv(local.data(), local.size(), &all[0], sizes.data(), displs.data());
+        std::set<std::string> unique;
+        for (size_t pos = 0; pos < all.size();)
+        {
+            const size_t end = all.find('\0', pos);
+            unique.insert(all.substr(pos, end - pos));
+            pos = end + 1;
+        }
+        names.assign(unique.begin(), unique.end());
+    }
+    else
+    {
+        for (const auto &entry : blocks)
+        {
+            names.push_back(entry.first);
+        }
+    }
+    if (names.empty())
+    {
+        return;
+    }
+
+    // reductions for the number of blocks, the shape and the largest block
+    // of every dataset, first [nblocks, ndims + 1, undefined] per dataset
+    const core::VarMap &variables = io.GetVariables();
+    std::vector<size_t> local(3 * names.size(), 0);
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const auto it = blocks.find(names[i]);
+        if (it != blocks.end())
+        {
+            local[3 * i] = it->second.size();
+            local[3 * i + 1] = it->second.front()->dims.size() + 1;
+        }
+        else if (variables.find(names[i]) == variables.end())
+        {
+            local[3 * i + 2] = 1;
+        }
+    }
+    std::vector<size_t> global(local);
+    if (comm.Size() > 1)
+    {
+        comm.Allreduce(local.data(), global.data(), local.size(), helper::Comm::Op::Max);
+    }
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        if (global[3 * i + 2])
+        {
+            m_DeferredBlocks.clear();
+            helper::Throw<std::invalid_argument>("Toolkit", "interop::hdf5::HDF5Common",
+                                                 "PerformWrites",
+                                                 "variable " + names[i] +
+                                                     " must be defined on all ranks");
+        }
+    }
+
+    // then [dims_0 ... dims_ndims-1, count_0 ... count_ndims-1] per dataset
+    std::vector<size_t> localShape;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const size_t ndims = global[3 * i + 1] - 1;
+        const auto it = blocks.find(names[i]);
+        if (it == blocks.end())
+        {
+            localShape.insert(localShape.end(), 2 * ndims, 0);
+            continue;
+        }
+        const auto &list = it->second;
+        localShape.insert(localShape.end(), list.front()->dims.begin(),
+                          list.front()->dims.end());
+        for (size_t d = 0; d < ndims; ++d)
+        {
+            size_t c = 0;
+            for (const DeferredBlock *block : list)
+            {
+                c = std::max(c, static_cast<size_t>(block->count[d]));
+            }
+            localShape.push_back(c);
+        }
+    }
+    std::vector<size_t> globalShape(localShape);
+    if (comm.Size() > 1 && !localShape.empty())
+    {
+        comm.Allreduce(localShape.data(), globalShape.data(), localShape.size(),
+                       helper::Comm::Op::Max);
+    }
+
+    struct Dataset
+    {
+        hid_t h5Type = -1;
+        std::vector<hsize_t> dims;
+        size_t globalBlocks = 0;
+        const std::vector<const DeferredBlock *> *list = nullptr;
+    };
+    const std::vector<const DeferredBlock *> noBlocks;
+    std::vector<Dataset> sets(names.size());
+    std::vector<hid_t> datasets;
+    std::vector<std::unique_ptr<HDF5DatasetGuard>> guards;
+    size_t nRounds = 0;
+    size_t pos = 0;
+    for (size_t i = 0; i < names.size(); ++i)
+    {
+        const std::string &name = names[i];
+        Dataset &set = sets[i];
+        const size_t ndims = global[3 * i + 1] - 1;
+        set.globalBlocks = global[3 * i];
+        nRounds = std::max(nRounds, set.globalBlocks);
+        set.dims.assign(globalShape.begin() + pos, globalShape.begin() + pos + ndims);
+        const std::vector<hsize_t> block(globalShape.begin() + pos + ndims,
+                                         globalShape.begin() + pos + 2 * ndims);
+        pos += 2 * ndims;
+
+        const core::VariableBase *variable = nullptr;
+        const auto it = blocks.find(name);
+        if (it != blocks.end())
+        {
+            set.list = &it->second;
+            set.h5Type = it->second.front()->h5Type;
+            variable = it->second.front()->variable;
+        }
+        else
+        {
+            set.list = &noBlocks;
+            variable = variables.at(name).get();
+#define declare_type(T)                                                                            \
+    if (variable->m_Type == helper::GetDataType<T>())                                              \
+    {                                                                                              \
+        set.h5Type = GetHDF5Type<T>();                                                             \
+    }
+            ADIOS2_FOREACH_STDTYPE_1ARG(declare_type)
+#undef declare_type
+        }
+
+        hid_t fileSpace = ndims ? H5Screate_simple(static_cast<int>(ndims), set.dims.data(), NULL)
+                                : H5Screate(H5S_SCALAR);
+        HDF5TypeGuard fs(fileSpace, E_H5_SPACE);
+
+        hid_t createProperty =
+            CreateDatasetProperty(*variable, set.h5Type, set.dims, block, m_ChunkByBlock);
+
+        std::vector<hid_t> chain;
+        CreateDataset(name, set.h5Type, fileSpace, chain, createProperty);
+        if (createProperty != H5P_DEFAULT)
+        {
+            H5Pclose(createProperty);
+        }
+        if (chain.back() < 0)
+        {
+            m_DeferredBlocks.clear();
+            helper::Throw<std::ios_base::failure>("Toolkit", "interop::hdf5::HDF5Common",
+                                                  "PerformWrites",
+                                                  "unable to create dataset " + name);
+        }
+        guards.emplace_back(new HDF5DatasetGuard(chain));
+        datasets.push_back(chain.back());
+    }
+
+    // round r writes the r-th block of every dataset, ranks with fewer blocks
+    // take part with an empty selection as required by collective I/O
+    const char empty = 0;
+    for (size_t r = 0; r < nRounds; ++r)
+    {
+        std::vector<hid_t> dsets, memTypes, memSpaces, fileSpaces;
+        std::vector<const void *> buffers;
+        for (size_t i = 0; i < names.size(); ++i)
+        {
+            const Dataset &set = sets[i];
+            if (r >= set.globalBlocks)
+            {
+                continue;
+            }
+            const auto &list = *set.list;
+            const int ndims = static_cast<int>(set.dims.size());
+
+            hid_t fileSpace, memSpace;
+            if (ndims == 0)
+            {
+                fileSpace = H5Screate(H5S_SCALAR);
+                memSpace = H5Screate(H5S_SCALAR);
+            }
+            else
+            {
+                fileSpace = H5Dget_space(datasets[i]);
+                memSpace = H5Screate_simple(ndims, r < list.size() ? list[r]->count.data()
+                                                                   : set.dims.data(),
+                                            NULL);
+            }
+
+            if (r < list.size())
+            {
+                const DeferredBlock &block = *list[r];
+                if (ndims > 0)
+                {
+                    H5Sselect_hyperslab(fileSpace, H5S_SELECT_SET, block.offset.data(), NULL,
+                                        block.count.data(), NULL);
+                }
+                buffers.push_back(block.data);
+            }
+            else
+            {
+                H5Sselect_none(fileSpace);
+                H5Sselect_none(memSpace);
+                buffers.push_back(&empty);
+            }
+            dsets.push_back(datasets[i]);
+            memTypes.push_back(set.h5Type);
+            memSpaces.push_back(memSpace);
+            fileSpaces.push_back(fileSpace);
+        }
+
+#if H5_VERSION_GE(1, 14, 0)
+        herr_t status = H5Dwrite_multi(dsets.size(), dsets.data(), memTypes.data(),
+                                       memSpaces.data(), fileSpaces.data(), m_PropertyTxfID,
+                                       buffers.data());
+#else
+        herr_t status = 0;
+        for (size_t i = 0; i < dsets.size() && status >= 0; ++i)
+        {
+            status = H5Dwrite(dsets[i], memTypes[i], memSpaces[i], fileSpaces[i], m_PropertyTxfID,
+                              buffers[i]);
+        }
+#endif
+
+        for (size_t i = 0; i < dsets.size(); ++i)
+        {
+            H5Sclose(memSpaces[i]);
+            H5Sclose(fileSpaces[i]);
+        }
+        if (status < 0)
+        {
+            m_DeferredBlocks.clear();
+            helper::Throw<std::ios_base::failure>("Toolkit", "interop::hdf5::HDF5Common",
+                                                  "PerformWrites", "HDF5 file Write failed");
+        }
+    }
+
+    m_DeferredBlocks.clear();
+}
+
 void HDF5Common::CheckVariableOperations(const core::VariableBase &variable) const
 {
-    if (!variable.m_Operations.empty())
+    H5Z_filter_t filter;
+    std::vector<unsigned int> cdValues;
+    for (const auto &op : variable.m_Operations)
+    {
+        GetOperatorFilter(*op, filter, cdValues);
+    }
+}
+
+void HDF5Common::GetOperatorFilter(core::Operator &op, H5Z_filter_t &filter,
+                                   std::vector<unsigned int> &cdValues)
+{
+    const std::string type = helper::LowerCase(op.m_TypeString);
+    const Params &parameters = op.GetParameters();
+    const std::string hint(" in call to HDF5Common GetOperatorFilter " + type + "\n");
+
+    // store a double in two client data values, as the filters read them
+    auto lf_PutDouble = [&cdValues](const size_t pos, const double value) {
+        std::memcpy(&cdValues[pos], &value, sizeof(double));
+    };
+
+    if (type == "bzip2")
+    {
+        int blockSize100k = 1;
+        helper::SetParameterValueInt("blockSize100k", parameters, blockSize100k, hint);
+        filter = FILTER_ID_BZIP2;
+        cdValues = {static_cast<unsigned int>(blockSize100k)};
+    }
+    else if (type == "blosc")
+    {
+        // 0-3 are filled in by the filter itself
+        unsigned int clevel = 1;
+        unsigned int shuffle = 1;
+        unsigned int compressor = 0;
+        for (const auto &p : parameters)
+        {
+            if (p.first == "compression_level" || p.first == "clevel")
+            {
+                clevel = helper::StringTo<uint32_t>(p.second, hint);
+            }
+            else if (p.first == "doshuffle")
+            {
+                shuffle = (p.second == "BLOSC_NOSHUFFLE")    ? 0
+                          : (p.second == "BLOSC_BITSHUFFLE") ? 2
+                                                             : 1;
+            }
+            else if (p.first == "compressor")
+            {
+                const std::vector<std::string> compressors = {"blosclz", "lz4",  "lz4hc",
+                                                              "snappy",  "zlib", "zstd"};
+                auto it = std::find(compressors.begin(), compressors.end(), p.second);
+                if (it == compressors.end())
+                {
+                    helper::Throw<std::invalid_argument>(
+                        "Toolkit", "interop::hdf5::HDF5Common", "GetOperatorFilter",
+                        "Blosc compressor must be blosclz, lz4, lz4hc, snappy, zlib or zstd");
+                }
+                compressor = static_cast<unsigned int>(it - compressors.begin());
+            }
+        }
+        filter = FILTER_ID_BLOSC;
+        cdValues = {0, 0, 0, 0, clevel, shuffle, compressor};
+    }
+    else if (type == "zfp")
+    {
+        // H5Z-ZFP generic interface: mode, unused, mode parameter
+        cdValues.assign(4, 0);
+        auto itAccuracy = parameters.find("accuracy");
+        auto itRate = parameters.find("rate");
+        auto itPrecision = parameters.find("precision");
+        if (itAccuracy != parameters.end())
+        {
+            cdValues[0] = 3;
+            lf_PutDouble(2, helper::StringTo<double>(itAccuracy->second, hint));
+        }
+        else if (itRate != parameters.end())
+        {
+            cdValues[0] = 1;
+            lf_PutDouble(2, helper::StringTo<double>(itRate->second, hint));
+        }
+        else if (itPrecision != parameters.end())
+        {
+            cdValues[0] = 2;
+            cdValues[2] = helper::StringTo<uint32_t>(itPrecision->second, hint);
+            cdValues.resize(3);
+        }
+        else
+        {
+            cdValues[0] = 5; // reversible
+            cdValues.resize(1);
+        }
+        filter = FILTER_ID_ZFP;
+    }
+    else if (type == "sz")
+    {
+        // H5Z-SZ error configuration: mode, then abs, rel, pw_rel and psnr
+        // bounds as doubles
+        unsigned int mode = 0; // ABS
+        double absBound = 1e-4;
+        double relBound = 0.;
+        double pwrBound = 0.;
+        for (const auto &p : parameters)
+        {
+            if (p.first == "abs" || p.first == "absolute" || p.first == "accuracy" ||
+                p.first == "absErrBound")
+            {
+                mode = 0;
+                absBound = helper::StringTo<double>(p.second, hint);
+            }
+            else if (p.first == "rel" || p.first == "relative" || p.first == "relBoundRatio")
+            {
+                mode = 1;
+                relBound = helper::StringTo<double>(p.second, hint);
+            }
+            else if (p.first == "pw" || p.first == "pwr" || p.first == "pwrel" ||
+                     p.first == "pwrelative" || p.first == "pw_relBoundRatio")
+            {
+                mode = 10;
+                pwrBound = helper::StringTo<double>(p.second, hint);
+            }
+        }
+        cdValues.assign(9, 0);
+        cdValues[0] = mode;
+        lf_PutDouble(1, absBound);
+        lf_PutDouble(3, relBound);
+        lf_PutDouble(5, pwrBound);
+        lf_PutDouble(7, 0.);
+        filter = FILTER_ID_SZ;
+    }
+    else
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "interop::hdf5::HDF5Common",
+                                             "GetOperatorFilter",
+                                             "operator " + op.m_TypeString +
+                                                 " has no HDF5 filter equivalent, the HDF5 "
+                                                 "engine supports blosc, bzip2, sz and zfp");
+    }
+}
+
+bool HDF5Common::HasChunkParameter(const std::string &varName) const
+{
+    if (-1 == m_ChunkPID)
+    {
+        return false;
+    }
+    // applies to all variables if none is named
+    return m_ChunkVarNames.empty() || m_ChunkVarNames.count(varName) > 0;
+}
+
+std::vector<hsize_t> HDF5Common::ChunkBlock(const core::VariableBase &variable,
+                                            const std::vector<hsize_t> &count) const
+{
+    const bool filtered = !variable.m_Operations.empty() && variable.m_Type != DataType::String;
+    if (!filtered || count.empty() || HasChunkParameter(variable.m_Name) || !m_Comm ||
+        m_Comm->Size() < 2)
+    {
+        return count;
+    }
+    std::vector<size_t> local(count.begin(), count.end());
+    std::vector<size_t> global(local.size());
+    m_Comm->Allreduce(local.data(), global.data(), local.size(), helper::Comm::Op::Max);
+    return std::vector<hsize_t>(global.begin(), global.end());
+}
+
+hid_t HDF5Common::CreateDatasetProperty(const core::VariableBase &variable, hid_t h5Type,
+                                        const std::vector<hsize_t> &dims,
+                                        const std::vector<hsize_t> &block,
+                                        bool chunkByBlock) const
+{
+    // filters need a chunked layout, scalars are stored as they are
+    const bool filtered = !variable.m_Operations.empty() && variable.m_Type != DataType::String;
+    if (dims.empty() || (!filtered && !chunkByBlock))
+    {
+        return H5P_DEFAULT;
+    }
+
+    hid_t createProperty = -1;
+    if (HasChunkParameter(variable.m_Name))
     {
-        helper::Throw<std::runtime_error>("Toolkit", "interop::hdf5::HDF5Common",
-                                          "CheckVariableOperations",
-                                          "ADIOS2 Operators are not supported for HDF5 engine");
+        if (!filtered)
+        {
+            return H5P_DEFAULT;
+        }
+        createProperty = H5Pcopy(m_ChunkPID);
+    }
+    else
+    {
+        std::vector<hsize_t> chunk(dims.size());
+        size_t chunkBytes = H5Tget_size(h5Type);
+        for (size_t d = 0; d < dims.size(); ++d)
+        {
+            chunk[d] = std::min(block[d], dims[d]);
+            chunkBytes *= chunk[d];
+        }
+        if (chunkBytes == 0)
+        {
+            // empty dataset, nothing to chunk or compress
+            return H5P_DEFAULT;
+        }
+        // HDF5 chunks must stay under 4GB, split the slowest dimension
+        const size_t maxChunkBytes = (static_cast<size_t>(1) << 32) - 1;
+        if (chunkBytes > maxChunkBytes)
+        {
+            const size_t sliceBytes = chunkBytes / chunk[0];
+            chunk[0] = std::max(static_cast<size_t>(1), maxChunkBytes / sliceBytes);
+        }
+        createProperty = H5Pcreate(H5P_DATASET_CREATE);
+        H5Pset_chunk(createProperty, static_cast<int>(chunk.size()), chunk.data());
+    }
+
+    if (filtered)
+    {
+        for (const auto &op : variable.m_Operations)
+        {
+            H5Z_filter_t filter;
+            std::vector<unsigned int> cdValues;
+            GetOperatorFilter(*op, filter, cdValues);
+            if (H5Zfilter_avail(filter) <= 0)
+            {
+                H5Pclose(createProperty);
+                helper::Throw<std::runtime_error>(
+                    "Toolkit", "interop::hdf5::HDF5Common", "CreateDatasetProperty",
+                    "HDF5 filter " + std::to_string(filter) + " for operator " +
+                        op->m_TypeString + " of variable " + variable.m_Name +
+                        " is not available, set HDF5_PLUGIN_PATH to the HDF5 filter plugins");
+            }
+            H5Pset_filter(createProperty, filter, H5Z_FLAG_MANDATORY, cdValues.size(),
+                          cdValues.data());
+        }
     }
+    return createProperty;
 }
 
 #define declare_template_instantiation(T)                                                          \
-    template void HDF5Common::Write(core::Variable<T> &, const T *);
+    template void HDF5Common::Write(core::Variable<T> &, const T *);                             \
+    template void HDF5Common::DeferWrite(core::Variable<T> &, const T *);
 
 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
 #undef declare_template_instantiation
@@ -127,6 +127,8 @@ public:
     static const std::string PARAMETER_CHUNK_FLAG;
     static const std::string PARAMETER_CHUNK_VARS;
     static const std::string PARAMETER_HAS_IDLE_WRITER_RANK;
+    static const std::string PARAMETER_DEFERRED_PUTS;
+    static const std::string PARAMETER_CHUNK_BY_BLOCK;
 
     void ParseParameters(core::IO &io);
     void Init(const std::string &name, helper::Comm const &comm, bool toWrite);
@@ -135,6 +137,32 @@ public:
     template <class T>
     void Write(core::Variable<T> &variable, const T *values);
 
+    /*
+     * Queue a block for PerformWrites(). values must stay valid until then,
+     * unless the variable has a memory selection (the block is copied).
+     * Strings are written right away.
+     */
+    template <class T>
+    void DeferWrite(core::Variable<T> &variable, const T *values);
+
+    /*
+     * Create the datasets of all queued blocks and write them together.
+     * Collective with H5DeferredPuts: the ranks exchange the names of their
+     * datasets, a rank without blocks of one takes part with an empty
+     * selection. Variables must be defined in io on all ranks. Does nothing
+     * without H5DeferredPuts.
+     */
+    void PerformWrites(helper::Comm const &comm, core::IO &io);
+
+    bool DeferredPuts() const noexcept { return m_DeferredPuts; }
+
+    /*
+     * HDF5 filter and its client data matching an ADIOS operator and its
+     * parameters, throws for operators without an equivalent
+     */
+    static void GetOperatorFilter(core::Operator &op, H5Z_filter_t &filter,
+                                  std::vector<unsigned int> &cdValues);
+
     /*
      * This function will define a non string variable to HDF5
      * note that define a dataset in HDF5 means allocate space and place an
@@ -145,7 +173,7 @@ public:
     void DefineDataset(core::Variable<T> &variable);
 
     void CreateDataset(const std::string &varName, hid_t h5Type, hid_t filespaceID,
-                       std::vector<hid_t> &chain);
+                       std::vector<hid_t> &chain, hid_t createProperty = H5P_DEFAULT);
     bool OpenDataset(const std::string &varName, std::vector<hid_t> &chain);
     void RemoveEmptyDataset(const std::string &varName);
     void StoreADIOSName(const std::string adiosName, hid_t dsetID);
@@ -245,13 +273,38 @@ private:
     void GetHDF5SpaceSpec(const core::Variable<T> &variable, std::vector<hsize_t> &,
                           std::vector<hsize_t> &, std::vector<hsize_t> &);
 
+    /** throws for operators without an HDF5 filter equivalent */
     void CheckVariableOperations(const core::VariableBase &variable) const;
 
+    /** true if H5ChunkDim applies to the variable */
+    bool HasChunkParameter(const std::string &varName) const;
+
+    /*
+     * Dataset creation property for a variable: chunked with the shape of
+     * block (clamped to dims) if chunkByBlock or the variable has operators,
+     * and the operators added as filters. H5P_DEFAULT if nothing applies,
+     * otherwise the caller closes it.
+     */
+    hid_t CreateDatasetProperty(const core::VariableBase &variable, hid_t h5Type,
+                                const std::vector<hsize_t> &dims,
+                                const std::vector<hsize_t> &block, bool chunkByBlock) const;
+
+    /*
+     * Block shape for CreateDatasetProperty outside of PerformWrites: the
+     * largest count over all ranks for filtered variables, since H5Dcreate
+     * is collective and the chunk shape must be the same on all ranks.
+     * Collective for those variables.
+     */
+    std::vector<hsize_t> ChunkBlock(const core::VariableBase &variable,
+                                    const std::vector<hsize_t> &count) const;
+
     bool m_WriteMode = false;
 
     size_t m_NumAdiosSteps = 0;
 
     MPI_API const *m_MPI = nullptr;
+    /** communicator of Init or Append, owned by the engine */
+    helper::Comm const *m_Comm = nullptr;
     int m_CommRank = 0;
     int m_CommSize = 1;
 
@@ -267,6 +320,21 @@ private:
     std::set<std::string> m_ChunkVarNames;
     bool m_OrderByC = true; // C or fortran
 
+    // a block waiting for PerformWrites()
+    struct DeferredBlock
+    {
+        std::string name;
+        hid_t h5Type;
+        std::vector<hsize_t> dims, count, offset; // empty for scalars
+        const void *data;
+        std::vector<char> copy; // owns data for memory selections
+        const core::VariableBase *variable;
+    };
+    std::vector<DeferredBlock> m_DeferredBlocks;
+    bool m_DeferredPuts = false;
+    // chunk shape = largest block of a variable over all ranks
+    bool m_ChunkByBlock = false;
+
     // Some write rank can be idle. This causes conflict with HDF5 collective
     // requirement in functions Guard this by load vars in beginStep
     bool m_IdleWriterOn = false;
@@ -55,8 +55,14 @@ void HDF5Common::DefineDataset(core::Variable<T> &variable)
     hid_t fileSpace = H5Screate_simple(static_cast<int>(dimSize), dimsf.data(), NULL);
     HDF5TypeGuard fs(fileSpace, E_H5_SPACE);
 
+    hid_t createProperty =
+        CreateDatasetProperty(variable, h5Type, dimsf, ChunkBlock(variable, count), false);
     std::vector<hid_t> chain;
-    CreateDataset(variable.m_Name, h5Type, fileSpace, chain);
+    CreateDataset(variable.m_Name, h5Type, fileSpace, chain, createProperty);
+    if (createProperty != H5P_DEFAULT)
+    {
+        H5Pclose(createProperty);
+    }
     HDF5DatasetGuard g(chain);
 }
 
@@ -194,8 +200,15 @@ void HDF5Common::Write(core::Variable<T> &variable, const T *values)
     hid_t fileSpace = H5Screate_simple(static_cast<int>(dimSize), dimsf.data(), NULL);
 #ifndef RELAY_DEFINE_TO_HDF5 // RELAY_DEFINE_TO_HDF5 = variables in io are
                              // created at begin_step
+    // with idle writers the dataset was created in BeginStep by all ranks
+    hid_t createProperty = CreateDatasetProperty(
+        variable, h5Type, dimsf, m_IdleWriterOn ? count : ChunkBlock(variable, count), false);
     std::vector<hid_t> chain;
-    CreateDataset(variable.m_Name, h5Type, fileSpace, chain);
+    CreateDataset(variable.m_Name, h5Type, fileSpace, chain, createProperty);
+    if (createProperty != H5P_DEFAULT)
+    {
+        H5Pclose(createProperty);
+    }
     hid_t dsetID = chain.back();
     HDF5DatasetGuard g(chain);
 #else
@@ -259,6 +272,47 @@ void HDF5Common::Write(core::Variable<T> &variable, const T *values)
     H5Sclose(memSpace);
 }
 
+template <class T>
+void HDF5Common::DeferWrite(core::Variable<T> &variable, const T *values)
+{
+    if (std::is_same<T, std::string>::value)
+    {
+        // type depends on the value, nothing to batch
+        Write(variable, values);
+        return;
+    }
+
+    CheckWriteGroup();
+    CheckVariableOperations(variable);
+
+    DeferredBlock block;
+    block.name = variable.m_Name;
+    block.h5Type = GetHDF5Type<T>();
+    block.data = values;
+    block.variable = &variable;
+
+    const size_t dimSize = std::max(variable.m_Shape.size(), variable.m_Count.size());
+    if (dimSize > 0)
+    {
+        GetHDF5SpaceSpec(variable, block.dims, block.count, block.offset);
+    }
+
+    if (dimSize > 0 && !variable.m_MemoryStart.empty())
+    {
+        const size_t blockSize = helper::GetTotalSize(variable.m_Count);
+        block.copy.resize(blockSize * sizeof(T));
+        T *k = reinterpret_cast<T *>(block.copy.data());
+
+        adios2::Dims zero(variable.m_Start.size(), 0);
+        helper::CopyMemoryBlock(k, zero, variable.m_Count, true, values, zero, variable.m_Count,
+                                true, false, Dims(), Dims(), variable.m_MemoryStart,
+                                variable.m_MemoryCount);
+        block.data = block.copy.data();
+    }
+
+    m_DeferredBlocks.push_back(std::move(block));
+}
+
 template <class T>
 void HDF5Common::AddStats(const core::Variable<T> &variable, hid_t parentId, std::vector<T> &stats)
 {
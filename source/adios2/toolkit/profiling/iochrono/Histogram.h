@@ -0,0 +1,133 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Histogram.h : log-linear latency histogram with constant time Record
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef ADIOS2_TOOLKIT_PROFILING_IOCHRONO_HISTOGRAM_H_
+#define ADIOS2_TOOLKIT_PROFILING_IOCHRONO_HISTOGRAM_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <array>
+#include <cstdint>
+/// \endcond
+
+namespace adios2
+{
+namespace profiling
+{
+
+/**
+ * Values below 16 have a bucket each, above that every power of two range
+ * is split in 8 buckets, so a percentile is off by at most 12.5%.
+ * Values past 2^40 (12 days in microseconds) share the last range.
+ */
+class Histogram
+{
+public:
+    /** add one value, negative values count as 0 */
+    void Record(int64_t value) noexcept
+    {
+        if (value < 0)
+        {
+            value = 0;
+        }
+        ++m_Buckets[Bucket(static_cast<uint64_t>(value))];
+        ++m_Count;
+        if (value > m_Max)
+        {
+            m_Max = value;
+        }
+    }
+
+    uint64_t Count() const noexcept { return m_Count; }
+    int64_t Max() const noexcept { return m_Max; }
+
+    /**
+     * Upper bound of the bucket holding the q-th quantile, clamped to Max()
+     * @param q in [0, 1]
+     * @return 0 if nothing was recorded
+     */
+    int64_t Percentile(const double q) const noexcept
+    {
+        if (m_Count == 0)
+        {
+            return 0;
+        }
+        uint64_t rank = static_cast<uint64_t>(q * static_cast<double>(m_Count) + 0.5);
+        if (rank < 1)
+        {
+            rank = 1;
+        }
+        uint64_t seen = 0;
+        for (size_t b = 0; b < NBuckets; ++b)
+        {
+            seen += m_Buckets[b];
+            if (seen >= rank)
+            {
+                // the last bucket is open ended
+                const int64_t bound = b + 1 < NBuckets ? UpperBound(b) : m_Max;
+                return bound < m_Max ? bound : m_Max;
+            }
+        }
+        return m_Max;
+    }
+
+private:
+    static constexpr unsigned int Linear = 16;
+    static constexpr unsigned int SubBits = 3;
+    static constexpr unsigned int MaxBits = 40;
+    static constexpr size_t NBuckets = Linear + (MaxBits - 4 + 1) * (1 << SubBits);
+
+    std::array<uint64_t, NBuckets> m_Buckets = {};
+    uint64_t m_Count = 0;
+    int64_t m_Max = 0;
+
+    static unsigned int Log2(uint64_t v) noexcept
+    {
+#if defined(__GNUC__) || defined(__clang__)
+        return 63 - __builtin_clzll(v);
+#else
+        unsigned int r = 0;
+        while (v >>= 1)
+        {
+            ++r;
+        }
+        return r;
+#endif
+    }
+
+    static size_t Bucket(const uint64_t v) noexcept
+    {
+        if (v < Linear)
+        {
+            return static_cast<size_t>(v);
+        }
+        unsigned int msb = Log2(v);
+        if (msb > MaxBits)
+        {
+            return NBuckets - 1;
+        }
+        const uint64_t sub = (v >> (msb - SubBits)) & ((1 << SubBits) - 1);
+        return Linear + (msb - 4) * (1 << SubBits) + static_cast<size_t>(sub);
+    }
+
+    static int64_t UpperBound(const size_t b) noexcept
+    {
+        if (b < Linear)
+        {
+            return static_cast<int64_t>(b);
+        }
+        const unsigned int msb = static_cast<unsigned int>((b - Linear) >> SubBits) + 4;
+        const uint64_t sub = (b - Linear) & ((1 << SubBits) - 1);
+        return static_cast<int64_t>(((uint64_t(1) << msb) + ((sub + 1) << (msb - SubBits))) - 1);
+    }
+};
+
+} // end namespace profiling
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_PROFILING_IOCHRONO_HISTOGRAM_H_ */
@@ -11,6 +11,8 @@
 #include "IOChrono.h"
 #include "adios2/helper/adiosMemory.h"
 
+#include <atomic>
+
 namespace adios2
 {
 namespace profiling
@@ -20,6 +22,7 @@ void IOChrono::Start(const std::string process) noexcept
 {
     if (m_IsActive)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Timers.at(process).Resume();
     }
 }
@@ -28,17 +31,41 @@ void IOChrono::Stop(const std::string process)
 {
     if (m_IsActive)
     {
+        std::lock_guard<std::mutex> lock(m_Mutex);
         m_Timers.at(process).Pause();
     }
 }
 
+void IOChrono::AddBytes(const std::string &process, const size_t bytes) noexcept
+{
+    if (m_IsActive)
+    {
+        std::lock_guard<std::mutex> lock(m_Mutex);
+        m_Bytes[process] += bytes;
+    }
+}
+
+bool IOChrono::Snapshot(const std::string &process, size_t &bytes, double &micros) const
+{
+    std::lock_guard<std::mutex> lock(m_Mutex);
+    auto itBytes = m_Bytes.find(process);
+    auto itTimer = m_Timers.find(process);
+    bytes = itBytes != m_Bytes.end() ? itBytes->second : 0;
+    micros = itTimer != m_Timers.end() ? itTimer->second.ProcessTimeMicros() : 0.0;
+    return itBytes != m_Bytes.end() || itTimer != m_Timers.end();
+}
+
 //
 // class JSON Profiler
 //
-JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm)
+namespace
 {
-    m_Profiler.m_IsActive = true; // default is true
+std::atomic<uint64_t> ProfilerSerial(0);
+}
 
+JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm), m_Serial(++ProfilerSerial)
+{
+    // same order as ProfilerTimer
     AddTimerWatch("buffering");
     AddTimerWatch("ES");
     AddTimerWatch("PP");
@@ -54,25 +81,87 @@ JSONProfiler::JSONProfiler(helper::Comm const &comm) : m_Comm(comm)
     AddTimerWatch("BS_WaitOnAsync");
     AddTimerWatch("DC_WaitOnAsync1");
     AddTimerWatch("DC_WaitOnAsync2");
+    AddTimerWatch("WaitOnAsyncMetadata");
     AddTimerWatch("PDW");
 
     AddTimerWatch("DeriveVars");
 
-    m_Profiler.m_Bytes.emplace("buffering", 0);
+    m_Bytes.emplace("buffering", 0);
     AddTimerWatch("DataRead");
-    m_Profiler.m_Bytes.emplace("dataread", 0);
+    m_Bytes.emplace("dataread", 0);
     AddTimerWatch("MetaDataRead");
-    m_Profiler.m_Bytes.emplace("metadataread", 0);
+    m_Bytes.emplace("metadataread", 0);
     AddTimerWatch("MetaMetaDataRead");
-    m_Profiler.m_Bytes.emplace("metadmetaataread", 0);
+    m_Bytes.emplace("metadmetaataread", 0);
+    AddTimerWatch("PG");
+    AddTimerWatch("AggWait");
 
     m_RankMPI = m_Comm.Rank();
 }
 
-void JSONProfiler::AddTimerWatch(const std::string &name, const bool trace)
+size_t JSONProfiler::AddTimerWatch(const std::string &name, const bool trace)
 {
+    auto it = m_TimerIds.find(name);
+    if (it != m_TimerIds.end())
+    {
+        return it->second;
+    }
     const TimeUnit timerUnit = DefaultTimeUnitEnum;
-    m_Profiler.m_Timers.emplace(name, profiling::Timer(name, timerUnit, trace));
+    m_Timers.emplace_back(name, timerUnit, trace);
+    m_TimerIds.emplace(name, m_Timers.size() - 1);
+    return m_Timers.size() - 1;
+}
+
+void JSONProfiler::AddMetrics(std::map<std::string, double> &metrics, const std::string &key,
+                              const ProfilerTimer timer) const
+{
+    const Timer &t = GetTimer(timer);
+    metrics[key + "_mus"] = t.ProcessTimeMicros();
+    metrics[key + "_calls"] = static_cast<double>(t.m_nCalls);
+    metrics[key + "_p50_mus"] = static_cast<double>(t.m_Histogram.Percentile(0.5));
+    metrics[key + "_p99_mus"] = static_cast<double>(t.m_Histogram.Percentile(0.99));
+    metrics[key + "_max_mus"] = static_cast<double>(t.m_Histogram.Max());
+}
+
+TraceBuffer &JSONProfiler::ThreadTraceBuffer()
+{
+    // a thread alternating between a few engines keeps hitting its cache
+    struct CacheEntry
+    {
+        uint64_t Serial;
+        TraceBuffer *Buffer;
+    };
+    constexpr size_t CacheSize = 4;
+    static thread_local CacheEntry cache[CacheSize] = {};
+    static thread_local size_t next = 0;
+
+    for (size_t i = 0; i < CacheSize; ++i)
+    {
+        if (cache[i].Serial == m_Serial)
+        {
+            return *cache[i].Buffer;
+        }
+    }
+
+    std::lock_guard<std::mutex> lock(m_TraceMutex);
+    const std::thread::id thread = std::this_thread::get_id();
+    TraceBuffer *buffer = nullptr;
+    for (size_t t = 0; t < m_TraceThreads.size(); ++t)
+    {
+        if (m_TraceThreads[t] == thread)
+        {
+            buffer = m_TraceBuffers[t].get();
+        }
+    }
+    if (!buffer)
+    {
+        m_TraceBuffers.emplace_back(new TraceBuffer(m_TraceCapacity, m_TraceBuffers.size()));
+        m_TraceThreads.push_back(thread);
+        buffer = m_TraceBuffers.back().get();
+    }
+    cache[next] = {m_Serial, buffer};
+    next = (next + 1) % CacheSize;
+    return *buffer;
 }
 
 std::string JSONProfiler::GetRankProfilingJSON(
@@ -88,18 +177,16 @@ std::string JSONProfiler::GetRankProfilingJSON(
     // prepare string dictionary per rank
     std::string rankLog("{ \"rank\":" + std::to_string(m_RankMPI));
 
-    auto &profiler = m_Profiler;
-
-    std::string timeDate(profiler.m_Timers.at("buffering").m_LocalTimeDate);
+    std::string timeDate(
+        m_Timers[static_cast<size_t>(ProfilerTimer::Buffering)].m_LocalTimeDate);
     timeDate.pop_back();
     // avoid whitespace
     std::replace(timeDate.begin(), timeDate.end(), ' ', '_');
 
     rankLog += ", \"start\":\"" + timeDate + "\"";
 
-    for (const auto &timerPair : profiler.m_Timers)
+    for (const auto &timer : m_Timers)
     {
-        const profiling::Timer &timer = timerPair.second;
         if (timer.m_nCalls > 0)
         {
             rankLog += ",\"" + timer.m_Process + "_" + timer.GetShortUnits() +
@@ -108,9 +195,9 @@ std::string JSONProfiler::GetRankProfilingJSON(
         }
     }
 
-    size_t DataBytes = m_Profiler.m_Bytes["dataread"];
-    size_t MetaDataBytes = m_Profiler.m_Bytes["metadataread"];
-    size_t MetaMetaDataBytes = m_Profiler.m_Bytes["metametadataread"];
+    size_t DataBytes = m_Bytes["dataread"];
+    size_t MetaDataBytes = m_Bytes["metadataread"];
+    size_t MetaMetaDataBytes = m_Bytes["metametadataread"];
     rankLog += ", \"databytes\":" + std::to_string(DataBytes);
     rankLog += ", \"metadatabytes\":" + std::to_string(MetaDataBytes);
     rankLog += ", \"metametadatabytes\":" + std::to_string(MetaMetaDataBytes);
@@ -145,6 +232,26 @@ std::string JSONProfiler::GetRankProfilingJSON(
     return rankLog;
 }
 
+std::string JSONProfiler::GetRankTraceJSON() const noexcept
+{
+    const std::string pid(std::to_string(m_RankMPI));
+    // metadata event first, so that a rank without events still has a line
+    std::string rankLog("{\"name\":\"process_name\", \"ph\":\"M\", \"pid\":" + pid +
+                        ", \"args\":{\"name\":\"rank " + pid + "\"}},\n");
+    for (const auto &buffer : m_TraceBuffers)
+    {
+        const std::string tid(std::to_string(buffer->m_ThreadIndex));
+        buffer->ForEach([&](const TraceEvent &event) {
+            rankLog += "{\"name\":\"" + m_Timers[event.TimerId].m_Process +
+                       "\", \"cat\":\"adios2\", \"ph\":\"X\", \"ts\":" +
+                       std::to_string(event.Start) + ", \"dur\":" +
+                       std::to_string(event.Duration) + ", \"pid\":" + pid + ", \"tid\":" + tid +
+                       "},\n";
+        });
+    }
+    return rankLog;
+}
+
 std::vector<char> JSONProfiler::AggregateProfilingJSON(const std::string &rankLog) const
 {
     // Gather sizes
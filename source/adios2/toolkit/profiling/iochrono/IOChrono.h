@@ -12,6 +12,10 @@
 #define ADIOS2_TOOLKIT_PROFILING_IOCHRONO_IOCHRONO_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <map>
+#include <memory>
+#include <mutex>
+#include <thread>
 #include <unordered_map>
 #include <vector>
 /// \endcond
@@ -19,6 +23,7 @@
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/helper/adiosComm.h"
 #include "adios2/toolkit/profiling/iochrono/Timer.h"
+#include "adios2/toolkit/profiling/iochrono/TraceBuffer.h"
 
 namespace adios2
 {
@@ -46,6 +51,13 @@ public:
     /** flag to determine if IOChrono object is being used */
     bool m_IsActive = false;
 
+    /**
+     * Guards m_Timers and m_Bytes in Start, Stop, AddBytes and Snapshot.
+     * Transports are written by asynchronous threads of the engines while
+     * the application thread reads their counters for metrics.
+     */
+    mutable std::mutex m_Mutex;
+
     IOChrono() = default;
     ~IOChrono() = default;
 
@@ -57,6 +69,44 @@ public:
      * @throws std::invalid_argument if Start wasn't called
      * */
     void Stop(const std::string process);
+
+    /** Adds bytes to the byte counter of process */
+    void AddBytes(const std::string &process, const size_t bytes) noexcept;
+
+    /**
+     * Consistent copy of the byte counter and process time of process
+     * @return false if process is tracked by neither
+     */
+    bool Snapshot(const std::string &process, size_t &bytes, double &micros) const;
+};
+
+/**
+ * Timers every JSONProfiler registers, in this order, so engines address them
+ * by id instead of hashing a name on each Start/Stop
+ */
+enum class ProfilerTimer : size_t
+{
+    Buffering,
+    ES,
+    PP,
+    ES_meta1_gather,
+    ES_meta2_gather,
+    ES_meta1,
+    ES_meta2,
+    ES_close,
+    ES_AWD,
+    WaitOnAsync,
+    BS_WaitOnAsync,
+    DC_WaitOnAsync1,
+    DC_WaitOnAsync2,
+    WaitOnAsyncMetadata,
+    PDW,
+    DeriveVars,
+    DataRead,
+    MetaDataRead,
+    MetaMetaDataRead,
+    PG,
+    AggWait
 };
 
 class JSONProfiler
@@ -64,25 +114,88 @@ class JSONProfiler
 public:
     JSONProfiler(helper::Comm const &comm);
     void Gather();
-    void AddTimerWatch(const std::string &, const bool trace = false);
 
-    void Start(const std::string process) { m_Profiler.Start(process); };
-    void Stop(const std::string process) { m_Profiler.Stop(process); };
-    void AddBytes(const std::string process, size_t bytes)
+    /**
+     * Registers a timer, or finds the one already registered under name
+     * @return id for Start/Stop
+     */
+    size_t AddTimerWatch(const std::string &, const bool trace = false);
+
+    void Start(const size_t id) noexcept { m_Timers[id].Resume(); }
+    void Stop(const size_t id)
     {
-        m_Profiler.m_Bytes[process] += bytes;
-    };
+        Timer &timer = m_Timers[id];
+        timer.Pause();
+        if (m_TraceCapacity > 0)
+        {
+            ThreadTraceBuffer().Push(id, timer.StartMicros(),
+                                     timer.EndMicros() - timer.StartMicros());
+        }
+    }
+
+    void Start(const ProfilerTimer timer) noexcept { Start(static_cast<size_t>(timer)); }
+    void Stop(const ProfilerTimer timer) { Stop(static_cast<size_t>(timer)); }
+
+    /** lookup by name, prefer the id overloads on frequent calls */
+    void Start(const std::string &process) { Start(m_TimerIds.at(process)); };
+    void Stop(const std::string &process) { Stop(m_TimerIds.at(process)); };
+
+    void AddBytes(const std::string process, size_t bytes) { m_Bytes[process] += bytes; };
+
+    const Timer &GetTimer(const ProfilerTimer timer) const noexcept
+    {
+        return m_Timers[static_cast<size_t>(timer)];
+    }
+
+    /**
+     * Adds key_mus, key_calls and the key_p50_mus, key_p99_mus, key_max_mus
+     * latencies of a timer to engine metrics
+     */
+    void AddMetrics(std::map<std::string, double> &metrics, const std::string &key,
+                    const ProfilerTimer timer) const;
+
+    /** bytes counted by AddBytes, 0 if none */
+    size_t GetBytes(const std::string &process) const noexcept
+    {
+        auto it = m_Bytes.find(process);
+        return it == m_Bytes.end() ? 0 : it->second;
+    }
+
+    /**
+     * Keep the last capacity Start/Stop intervals of each thread for
+     * GetRankTraceJSON, 0 (the default) turns tracing off
+     */
+    void EnableTrace(const size_t capacity) noexcept { m_TraceCapacity = capacity; }
+    bool TraceEnabled() const noexcept { return m_TraceCapacity > 0; }
 
     std::string GetRankProfilingJSON(
         const std::vector<std::string> &transportsTypes,
         const std::vector<adios2::profiling::IOChrono *> &transportsProfilers) noexcept;
 
+    /**
+     * Traced intervals of this rank as Chrome trace (Perfetto) complete
+     * events, one per line each followed by ",\n", pid is the rank
+     */
+    std::string GetRankTraceJSON() const noexcept;
+
     std::vector<char> AggregateProfilingJSON(const std::string &rankLog) const;
 
 private:
-    IOChrono m_Profiler;
+    std::vector<Timer> m_Timers;
+    std::unordered_map<std::string, size_t> m_TimerIds;
+    std::unordered_map<std::string, size_t> m_Bytes;
     int m_RankMPI = 0;
     helper::Comm const &m_Comm;
+
+    size_t m_TraceCapacity = 0;
+    /** distinguishes profilers in the threads' buffer caches */
+    const uint64_t m_Serial;
+    std::mutex m_TraceMutex;
+    std::vector<std::unique_ptr<TraceBuffer>> m_TraceBuffers;
+    std::vector<std::thread::id> m_TraceThreads;
+
+    /** buffer of the calling thread, created on its first event */
+    TraceBuffer &ThreadTraceBuffer();
 };
 
 } // end namespace profiling
@@ -33,11 +33,32 @@ void Timer::Resume() noexcept
 void Timer::Pause()
 {
     m_ElapsedTime = std::chrono::high_resolution_clock::now();
-    m_ProcessTime += GetElapsedTime();
+    m_LastTime = GetElapsedTime();
+    m_ProcessTime += m_LastTime;
+    m_Histogram.Record(m_LastTime);
 
     AddDetail();
 }
 
+double Timer::ProcessTimeMicros() const noexcept
+{
+    const double time = static_cast<double>(m_ProcessTime);
+    switch (m_TimeUnit)
+    {
+    case TimeUnit::Microseconds:
+        return time;
+    case TimeUnit::Milliseconds:
+        return time * 1e3;
+    case TimeUnit::Seconds:
+        return time * 1e6;
+    case TimeUnit::Minutes:
+        return time * 60e6;
+    case TimeUnit::Hours:
+        return time * 3600e6;
+    }
+    return time;
+}
+
 std::string Timer::GetShortUnits() const noexcept
 {
     std::string units;
@@ -18,6 +18,7 @@
 
 #include "adios2/common/ADIOSConfig.h"
 #include "adios2/common/ADIOSTypes.h"
+#include "adios2/toolkit/profiling/iochrono/Histogram.h"
 
 #include <iostream> // myTimer
 
@@ -64,6 +65,28 @@ public:
      */
     void Pause();
 
+    /** microseconds from program start to the last Resume, for tracing */
+    int64_t StartMicros() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(m_InitialTime -
+                                                                     m_ADIOS2ProgStart)
+            .count();
+    }
+
+    /** microseconds from program start to the last Pause, for tracing */
+    int64_t EndMicros() const noexcept
+    {
+        return std::chrono::duration_cast<std::chrono::microseconds>(m_ElapsedTime -
+                                                                     m_ADIOS2ProgStart)
+            .count();
+    }
+
+    /** elapsed time of the last Resume/Pause pair in m_TimeUnit */
+    int64_t LastTime() const noexcept { return m_LastTime; }
+
+    /** m_ProcessTime converted to microseconds */
+    double ProcessTimeMicros() const noexcept;
+
     /** Returns TimeUnit as a short std::string  */
     std::string GetShortUnits() const noexcept;
 
@@ -104,6 +127,9 @@ public:
         }
         rankLog += "\"" + m_Process + "\":{\"mus\":" + std::to_string(m_ProcessTime);
         rankLog += ", \"nCalls\":" + std::to_string(m_nCalls);
+        rankLog += ", \"p50\":" + std::to_string(m_Histogram.Percentile(0.5));
+        rankLog += ", \"p99\":" + std::to_string(m_Histogram.Percentile(0.99));
+        rankLog += ", \"max\":" + std::to_string(m_Histogram.Max());
 
         if (500 > m_nCalls)
         {
@@ -118,6 +144,9 @@ public:
     std::string m_Details;
     uint64_t m_nCalls = 0;
 
+    /** distribution of the Resume/Pause intervals in m_TimeUnit */
+    Histogram m_Histogram;
+
 private:
     /** Set at Resume */
     std::chrono::time_point<std::chrono::high_resolution_clock> m_InitialTime;
@@ -128,6 +157,8 @@ private:
     /** Checks if m_InitialTime is set, timer is running */
     bool m_InitialTimeSet = false;
 
+    int64_t m_LastTime = 0;
+
     /** called by Pause to get time between Pause and Resume */
     int64_t GetElapsedTime();
 };
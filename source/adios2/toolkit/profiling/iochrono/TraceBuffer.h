@@ -0,0 +1,92 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TraceBuffer.h : per thread ring of the most recent timer events
+ *
+ *  Created on: Oct 18, 2026
+ */
+
+#ifndef ADIOS2_TOOLKIT_PROFILING_IOCHRONO_TRACEBUFFER_H_
+#define ADIOS2_TOOLKIT_PROFILING_IOCHRONO_TRACEBUFFER_H_
+
+/// \cond EXCLUDE_FROM_DOXYGEN
+#include <atomic>
+#include <cstdint>
+#include <vector>
+/// \endcond
+
+namespace adios2
+{
+namespace profiling
+{
+
+struct TraceEvent
+{
+    /** timer id in the owning JSONProfiler */
+    size_t TimerId;
+    /** microseconds since program start */
+    int64_t Start;
+    int64_t Duration;
+};
+
+/**
+ * Single producer ring, only the owning thread pushes and never takes a lock,
+ * once full the oldest events are overwritten. Readers must run when the
+ * producer is idle (engine Close), they see the last Capacity() events.
+ */
+class TraceBuffer
+{
+public:
+    /** @param capacity rounded up to a power of two */
+    TraceBuffer(const size_t capacity, const size_t threadIndex) : m_ThreadIndex(threadIndex)
+    {
+        size_t c = 1;
+        while (c < capacity)
+        {
+            c <<= 1;
+        }
+        m_Events.resize(c);
+        m_Mask = c - 1;
+    }
+
+    void Push(const size_t timerId, const int64_t start, const int64_t duration) noexcept
+    {
+        const uint64_t head = m_Head.load(std::memory_order_relaxed);
+        TraceEvent &event = m_Events[head & m_Mask];
+        event.TimerId = timerId;
+        event.Start = start;
+        event.Duration = duration;
+        m_Head.store(head + 1, std::memory_order_release);
+    }
+
+    /** calls f(const TraceEvent &) from the oldest to the newest kept event */
+    template <class F>
+    void ForEach(F f) const
+    {
+        const uint64_t head = m_Head.load(std::memory_order_acquire);
+        const uint64_t first = head > m_Events.size() ? head - m_Events.size() : 0;
+        for (uint64_t i = first; i < head; ++i)
+        {
+            f(m_Events[i & m_Mask]);
+        }
+    }
+
+    size_t Capacity() const noexcept { return m_Events.size(); }
+
+    /** events pushed since creation, including overwritten ones */
+    uint64_t Pushed() const noexcept { return m_Head.load(std::memory_order_acquire); }
+
+    /** order of the thread's first event in the profiler, the trace "tid" */
+    const size_t m_ThreadIndex;
+
+private:
+    std::vector<TraceEvent> m_Events;
+    uint64_t m_Mask = 0;
+    std::atomic<uint64_t> m_Head{0};
+};
+
+} // end namespace profiling
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_PROFILING_IOCHRONO_TRACEBUFFER_H_ */
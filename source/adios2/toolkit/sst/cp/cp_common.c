@@ -235,7 +235,7 @@ static char *SstMarshalStr[] = {"FFS", "BP", "BP5"};
 static char *SstQueueFullStr[] = {"Block", "Discard"};
 static char *SstCompressStr[] = {"None", "ZFP"};
 static char *SstCommPatternStr[] = {"Min", "Peer"};
-static char *SstPreloadModeStr[] = {"Off", "On", "Auto"};
+static char *SstPreloadModeStr[] = {"Off", "On", "Auto", "Learned"};
 static char *SstStepDistributionModeStr[] = {"StepsAllToAll", "StepsRoundRobin", "StepsOnDemand"};
 
 extern void CP_dumpParams(SstStream Stream, struct _SstParams *Params, int ReaderSide)
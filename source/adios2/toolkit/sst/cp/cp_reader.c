@@ -579,6 +579,10 @@ SstStream SstReaderOpen(const char *Name, SstParams Params, SMPI_Comm comm)
                 ReaderRegister.SpecPreload = SpecPreloadOn;
             }
             break;
+        case SpecPreloadLearned:
+            // the reader engine prefetches what it read the step before
+            ReaderRegister.SpecPreload = SpecPreloadOff;
+            break;
         }
 
         ReaderRegister.CP_ReaderInfo = malloc(ReaderRegister.ReaderCohortSize * sizeof(void *));
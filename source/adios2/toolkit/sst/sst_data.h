@@ -92,7 +92,8 @@ typedef enum
 {
     SpecPreloadOff,
     SpecPreloadOn,
-    SpecPreloadAuto
+    SpecPreloadAuto,
+    SpecPreloadLearned
 } SpeculativePreloadMode;
 
 typedef enum
@@ -0,0 +1,258 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BlockCache.cpp
+ *
+ */
+
+#include "BlockCache.h"
+
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
+#include <algorithm>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <ios>
+#include <stdexcept>
+
+namespace adios2
+{
+namespace transport
+{
+
+BlockCache::BlockCache(FetchFunction fetch, const size_t objectSize, const size_t blockSize,
+                       const size_t capacity, const EvictionPolicy policy,
+                       const size_t maxParallel, const size_t readAhead)
+: m_Fetch(fetch), m_ObjectSize(objectSize), m_BlockSize(blockSize), m_Capacity(capacity),
+  m_Policy(policy), m_MaxParallel(std::max(maxParallel, static_cast<size_t>(1))),
+  m_ReadAhead(readAhead)
+{
+    if (m_BlockSize == 0)
+    {
+        helper::Throw<std::invalid_argument>("Toolkit", "transport::BlockCache", "BlockCache",
+                                             "block size must be greater than 0");
+    }
+}
+
+BlockCache::~BlockCache()
+{
+    for (auto &readAhead : m_ReadAheads)
+    {
+        readAhead.second.done.wait();
+    }
+}
+
+BlockCache::EvictionPolicy BlockCache::StringToPolicy(const std::string &policy)
+{
+    const std::string p = helper::LowerCase(policy);
+    if (p == "lru")
+    {
+        return EvictionPolicy::LRU;
+    }
+    if (p == "fifo")
+    {
+        return EvictionPolicy::FIFO;
+    }
+    helper::Throw<std::invalid_argument>("Toolkit", "transport::BlockCache", "StringToPolicy",
+                                         "unknown eviction policy " + policy +
+                                             ", use lru or fifo");
+    return EvictionPolicy::LRU;
+}
+
+size_t BlockCache::BlockLength(const size_t block) const noexcept
+{
+    return std::min(m_BlockSize, m_ObjectSize - block * m_BlockSize);
+}
+
+void BlockCache::Read(char *buffer, const size_t size, const size_t start)
+{
+    if (size == 0)
+    {
+        return;
+    }
+    if (start + size > m_ObjectSize)
+    {
+        helper::Throw<std::ios_base::failure>(
+            "Toolkit", "transport::BlockCache", "Read",
+            "can't read " + std::to_string(size) + " bytes from position " +
+                std::to_string(start) + " of object of size " + std::to_string(m_ObjectSize));
+    }
+
+    const size_t first = start / m_BlockSize;
+    const size_t last = (start + size - 1) / m_BlockSize;
+    size_t lastFetch = last;
+    if (m_ReadAhead && start == m_LastEnd)
+    {
+        const size_t nBlocks = (m_ObjectSize + m_BlockSize - 1) / m_BlockSize;
+        lastFetch = std::min(last + m_ReadAhead, nBlocks - 1);
+    }
+    m_LastEnd = start + size;
+
+    // read-ahead that has arrived in the meantime
+    std::vector<size_t> arrived;
+    for (auto &readAhead : m_ReadAheads)
+    {
+        if (readAhead.second.done.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+        {
+            arrived.push_back(readAhead.first);
+        }
+    }
+    for (const size_t b : arrived)
+    {
+        FinishReadAhead(b);
+    }
+
+    std::vector<size_t> missing, pending;
+    for (size_t b = first; b <= last; ++b)
+    {
+        auto it = m_Blocks.find(b);
+        if (it != m_Blocks.end())
+        {
+            ++m_Hits;
+            if (m_Policy == EvictionPolicy::LRU)
+            {
+                m_Order.splice(m_Order.end(), m_Order, it->second.order);
+            }
+        }
+        else if (m_ReadAheads.count(b))
+        {
+            pending.push_back(b);
+        }
+        else
+        {
+            missing.push_back(b);
+        }
+    }
+    for (size_t b = last + 1; b <= lastFetch; ++b)
+    {
+        if (!m_Blocks.count(b) && !m_ReadAheads.count(b))
+        {
+            StartReadAhead(b);
+        }
+    }
+    FetchBlocks(missing);
+    missing.clear();
+    for (const size_t b : pending)
+    {
+        if (FinishReadAhead(b))
+        {
+            ++m_Hits;
+        }
+        else
+        {
+            missing.push_back(b);
+        }
+    }
+    // a failed read-ahead is fetched again, which throws if it fails again
+    FetchBlocks(missing);
+
+    size_t pos = start;
+    char *dst = buffer;
+    for (size_t b = first; b <= last; ++b)
+    {
+        const Block &block = m_Blocks.at(b);
+        const size_t offset = pos - b * m_BlockSize;
+        const size_t n = std::min(block.data.size() - offset, start + size - pos);
+        std::memcpy(dst, block.data.data() + offset, n);
+        dst += n;
+        pos += n;
+    }
+
+    Evict(first, last);
+}
+
+void BlockCache::FetchBlocks(const std::vector<size_t> &blocks)
+{
+    m_Misses += blocks.size();
+    for (size_t i = 0; i < blocks.size(); i += m_MaxParallel)
+    {
+        const size_t n = std::min(m_MaxParallel, blocks.size() - i);
+        std::vector<std::vector<char>> data(n);
+        std::vector<std::future<void>> futures;
+        futures.reserve(n);
+        for (size_t j = 0; j < n; ++j)
+        {
+            const size_t b = blocks[i + j];
+            data[j].resize(BlockLength(b));
+            futures.push_back(std::async(std::launch::async, m_Fetch, data[j].data(),
+                                         data[j].size(), b * m_BlockSize));
+        }
+        // wait for all before rethrowing the first failure
+        for (auto &f : futures)
+        {
+            f.wait();
+        }
+        for (auto &f : futures)
+        {
+            f.get();
+        }
+
+        for (size_t j = 0; j < n; ++j)
+        {
+            Insert(blocks[i + j], std::move(data[j]));
+        }
+    }
+}
+
+void BlockCache::Insert(const size_t block, std::vector<char> &&data)
+{
+    m_CachedBytes += data.size();
+    Block &b = m_Blocks[block];
+    b.data = std::move(data);
+    b.order = m_Order.insert(m_Order.end(), block);
+}
+
+void BlockCache::StartReadAhead(const size_t block)
+{
+    ++m_Misses;
+    ReadAhead &readAhead = m_ReadAheads[block];
+    readAhead.data.resize(BlockLength(block));
+    readAhead.done = std::async(std::launch::async, m_Fetch, readAhead.data.data(),
+                                readAhead.data.size(), block * m_BlockSize);
+}
+
+bool BlockCache::FinishReadAhead(const size_t block)
+{
+    auto it = m_ReadAheads.find(block);
+    bool fetched = true;
+    try
+    {
+        it->second.done.get();
+    }
+    catch (...)
+    {
+        // nobody asked for the block yet, a read of it fetches it again
+        fetched = false;
+    }
+    if (fetched)
+    {
+        Insert(block, std::move(it->second.data));
+    }
+    m_ReadAheads.erase(it);
+    return fetched;
+}
+
+void BlockCache::Evict(const size_t first, const size_t last)
+{
+    auto it = m_Order.begin();
+    while (m_CachedBytes > m_Capacity && it != m_Order.end())
+    {
+        const size_t b = *it;
+        if (b >= first && b <= last)
+        {
+            // needed by the current read, keep it
+            ++it;
+            continue;
+        }
+        auto blockIt = m_Blocks.find(b);
+        m_CachedBytes -= blockIt->second.data.size();
+        m_Blocks.erase(blockIt);
+        it = m_Order.erase(it);
+    }
+}
+
+} // end namespace transport
+} // end namespace adios2
@@ -0,0 +1,129 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * BlockCache.h
+ *
+ * In-memory cache of fixed size blocks of a remote object for transports
+ * where every request has a high latency (S3). Missing blocks of a read are
+ * fetched with concurrent ranged requests, blocks read ahead are fetched in
+ * the background.
+ */
+
+#ifndef ADIOS2_TOOLKIT_TRANSPORT_BLOCKCACHE_H_
+#define ADIOS2_TOOLKIT_TRANSPORT_BLOCKCACHE_H_
+
+#include <cstddef>
+#include <functional>
+#include <future>
+#include <list>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace adios2
+{
+namespace transport
+{
+
+class BlockCache
+{
+public:
+    /**
+     * Fetches the byte range [start, start+size) of the object into buffer.
+     * Called concurrently from several threads, must throw on failure.
+     */
+    using FetchFunction = std::function<void(char *buffer, size_t size, size_t start)>;
+
+    enum class EvictionPolicy
+    {
+        LRU, // least recently used block goes first
+        FIFO // oldest fetched block goes first
+    };
+
+    /**
+     * @param fetch ranged read of the remote object
+     * @param objectSize size of the remote object
+     * @param blockSize cache granularity
+     * @param capacity max bytes of cached blocks, at least one read is kept
+     * @param policy which block to drop when over capacity
+     * @param maxParallel max concurrent fetches
+     * @param readAhead blocks to prefetch in the background after a
+     * sequential read, on top of maxParallel
+     */
+    BlockCache(FetchFunction fetch, const size_t objectSize, const size_t blockSize,
+               const size_t capacity, const EvictionPolicy policy, const size_t maxParallel,
+               const size_t readAhead);
+
+    /** waits for the read-ahead still in flight, fetch must be valid until then */
+    ~BlockCache();
+
+    /** Read [start, start+size) through the cache */
+    void Read(char *buffer, const size_t size, const size_t start);
+
+    /** blocks served from the cache */
+    size_t Hits() const noexcept { return m_Hits; }
+    /** blocks fetched from the object, read ahead or not */
+    size_t Misses() const noexcept { return m_Misses; }
+    /** bytes of cached blocks */
+    size_t CachedBytes() const noexcept { return m_CachedBytes; }
+
+    /** "lru" or "fifo", throws std::invalid_argument otherwise */
+    static EvictionPolicy StringToPolicy(const std::string &policy);
+
+private:
+    struct Block
+    {
+        std::vector<char> data;
+        std::list<size_t>::iterator order;
+    };
+
+    FetchFunction m_Fetch;
+    const size_t m_ObjectSize;
+    const size_t m_BlockSize;
+    const size_t m_Capacity;
+    const EvictionPolicy m_Policy;
+    const size_t m_MaxParallel;
+    const size_t m_ReadAhead;
+
+    std::unordered_map<size_t, Block> m_Blocks;
+    struct ReadAhead
+    {
+        std::vector<char> data;
+        std::future<void> done;
+    };
+    /** blocks being read ahead, not cached until they are done */
+    std::unordered_map<size_t, ReadAhead> m_ReadAheads;
+    /** eviction order, front is evicted first */
+    std::list<size_t> m_Order;
+    size_t m_CachedBytes = 0;
+    /** end of the previous read, to detect sequential access */
+    size_t m_LastEnd = 0;
+    size_t m_Hits = 0;
+    size_t m_Misses = 0;
+
+    size_t BlockLength(const size_t block) const noexcept;
+
+    /** fetch the given blocks concurrently and insert them */
+    void FetchBlocks(const std::vector<size_t> &blocks);
+
+    /** cache a block at the end of the eviction order */
+    void Insert(const size_t block, std::vector<char> &&data);
+
+    /** start fetching a block in the background */
+    void StartReadAhead(const size_t block);
+
+    /**
+     * wait for a read-ahead block and cache it
+     * @return false if its fetch failed, the block is not cached then
+     */
+    bool FinishReadAhead(const size_t block);
+
+    /** evict blocks until under capacity, keeping blocks in [first, last] */
+    void Evict(const size_t first, const size_t last);
+};
+
+} // end namespace transport
+} // end namespace adios2
+
+#endif /* ADIOS2_TOOLKIT_TRANSPORT_BLOCKCACHE_H_ */
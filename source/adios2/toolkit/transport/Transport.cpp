@@ -38,6 +38,14 @@ void Transport::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
     }
 }
 
+void Transport::ReadV(const ReadRange *ranges, const size_t count)
+{
+    for (size_t i = 0; i < count; ++i)
+    {
+        Read(ranges[i].buffer, ranges[i].size, ranges[i].start);
+    }
+}
+
 void Transport::InitProfiler(const Mode openMode, const TimeUnit timeUnit)
 {
     m_Profiler.m_IsActive = true;
@@ -98,30 +106,19 @@ void Transport::Flush()
 
 size_t Transport::GetSize() { return 0; }
 
-void Transport::ProfilerWriteBytes(size_t bytes) noexcept
-{
-    if (m_Profiler.m_IsActive)
-    {
-        m_Profiler.m_Bytes.at("write") += bytes;
-    }
-}
+void Transport::ProfilerWriteBytes(size_t bytes) noexcept { m_Profiler.AddBytes("write", bytes); }
 
-void Transport::ProfilerStart(const std::string process) noexcept
-{
-    if (m_Profiler.m_IsActive)
-    {
-        m_Profiler.m_Timers.at(process).Resume();
-    }
-}
+void Transport::ProfilerReadBytes(size_t bytes) noexcept { m_Profiler.AddBytes("read", bytes); }
 
-void Transport::ProfilerStop(const std::string process) noexcept
+void Transport::AddMetrics(std::map<std::string, double> & /*metrics*/,
+                           const std::string & /*prefix*/) const
 {
-    if (m_Profiler.m_IsActive)
-    {
-        m_Profiler.m_Timers.at(process).Pause();
-    }
 }
 
+void Transport::ProfilerStart(const std::string process) noexcept { m_Profiler.Start(process); }
+
+void Transport::ProfilerStop(const std::string process) noexcept { m_Profiler.Stop(process); }
+
 void Transport::CheckName() const
 {
     if (m_Name.empty())
@@ -12,6 +12,7 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_TRANSPORT_H_
 
 /// \cond EXCLUDE_FROM_DOXYGEN
+#include <map>
 #include <string>
 #include <vector>
 /// \endcond
@@ -123,6 +124,23 @@ public:
      */
     virtual void Read(char *buffer, size_t size, size_t start = MaxSizeT) = 0;
 
+    /** one range of a ReadV call */
+    struct ReadRange
+    {
+        char *buffer;
+        size_t size;
+        size_t start;
+    };
+
+    /**
+     * Reads several ranges, readv version. The default calls Read for
+     * each range, transports with a high per-request latency fetch them
+     * together.
+     * @param ranges array pointer
+     * @param count number of entries
+     */
+    virtual void ReadV(const ReadRange *ranges, const size_t count);
+
     /**
      * Returns the size of current data in transport
      * @return size as size_t
@@ -132,6 +150,13 @@ public:
     /** flushes current contents to physical medium without closing */
     virtual void Flush();
 
+    /**
+     * Adds counters specific to this transport (e.g. cache hits) to metrics,
+     * keys start with prefix. Default adds nothing.
+     */
+    virtual void AddMetrics(std::map<std::string, double> &metrics,
+                            const std::string &prefix) const;
+
     /** closes current file, after this file becomes unreachable */
     virtual void Close() = 0;
 
@@ -150,6 +175,7 @@ public:
 
 protected:
     void ProfilerWriteBytes(size_t bytes) noexcept;
+    void ProfilerReadBytes(size_t bytes) noexcept;
     void ProfilerStart(const std::string process) noexcept;
 
     void ProfilerStop(const std::string process) noexcept;
@@ -14,10 +14,11 @@
 #include "adios2/helper/adiosString.h"
 #include "adios2/helper/adiosSystem.h"
 
-#include <cstdio>  // remove
-#include <cstring> // strerror
-#include <errno.h> // errno
-#include <fcntl.h> // open
+#include <algorithm> // std::max
+#include <cstdio>    // remove
+#include <cstring>   // strerror
+#include <errno.h>   // errno
+#include <fcntl.h>   // open
 #include <regex>
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
@@ -71,6 +72,32 @@ void FileAWSSDK::SetParameters(const Params &params)
 
     helper::SetParameterValueInt("verbose", params, m_Verbose, "");
 
+    std::string blockCacheSize;
+    helper::SetParameterValue("block_cache_size", params, blockCacheSize);
+    if (!blockCacheSize.empty())
+    {
+        m_BlockCacheSize = helper::StringToByteUnits(helper::LowerCase(blockCacheSize),
+                                                     "for block_cache_size");
+    }
+    std::string blockSize;
+    helper::SetParameterValue("block_size", params, blockSize);
+    if (!blockSize.empty())
+    {
+        m_BlockSize = helper::StringToByteUnits(helper::LowerCase(blockSize), "for block_size");
+    }
+    std::string policy;
+    helper::SetParameterValue("block_cache_policy", params, policy);
+    if (!policy.empty())
+    {
+        m_BlockCachePolicy = BlockCache::StringToPolicy(policy);
+    }
+    int parallelGets = static_cast<int>(m_ParallelGets);
+    helper::SetParameterValueInt("parallel_gets", params, parallelGets, "");
+    m_ParallelGets = static_cast<size_t>(std::max(parallelGets, 1));
+    int readAhead = static_cast<int>(m_ReadAhead);
+    helper::SetParameterValueInt("read_ahead", params, readAhead, "");
+    m_ReadAhead = static_cast<size_t>(std::max(readAhead, 0));
+
     std::string recheckStr = "true";
     helper::SetParameterValue("recheck_metadata", params, recheckStr);
     m_RecheckMetadata = helper::StringTo<bool>(recheckStr, "");
@@ -259,6 +286,20 @@ void FileAWSSDK::Open(const std::string &name, const Mode openMode, const bool a
                 CheckCache(m_Size);
             }
 
+            if (!m_IsCached && m_BlockCacheSize > 0)
+            {
+                // metadata files are read front to back, data files randomly
+                const bool isMetadata = helper::EndsWith(m_ObjectName, "md.idx") ||
+                                        helper::EndsWith(m_ObjectName, "md.0") ||
+                                        helper::EndsWith(m_ObjectName, "mmd.0");
+                m_BlockCache.reset(new BlockCache(
+                    [this](char *buffer, size_t size, size_t start) {
+                        GetRange(buffer, size, start);
+                    },
+                    m_Size, m_BlockSize, m_BlockCacheSize, m_BlockCachePolicy, m_ParallelGets,
+                    isMetadata ? m_ReadAhead : 0));
+            }
+
             m_Errno = errno;
         }
         ProfilerStop("open");
@@ -337,11 +378,35 @@ void FileAWSSDK::Read(char *buffer, size_t size, size_t start)
         return;
     }
 
+    if (m_BlockCache)
+    {
+        m_BlockCache->Read(buffer, size, m_SeekPos);
+    }
+    else
+    {
+        GetRange(buffer, size, m_SeekPos);
+    }
+
+    /* Save to cache */
+    if (m_CachingThisFile)
+    {
+        m_CacheFileWrite->Write(buffer, size, m_SeekPos);
+        m_CacheFileWrite->Flush();
+        if (m_Verbose > 0)
+        {
+            std::cout << "FileAWSSDK::Read: Written to cache " << m_CacheFileWrite->m_Name
+                      << " start = " << m_SeekPos << " size = " << size << std::endl;
+        }
+    }
+}
+
+void FileAWSSDK::GetRange(char *buffer, size_t size, size_t start)
+{
     Aws::S3::Model::GetObjectRequest request;
     request.SetBucket(m_BucketName);
     request.SetKey(m_ObjectName);
     std::stringstream range;
-    range << "bytes=" << m_SeekPos << "-" << m_SeekPos + size - 1;
+    range << "bytes=" << start << "-" << start + size - 1;
     request.SetRange(range.str());
 
     Aws::S3::Model::GetObjectOutcome outcome = s3Client->GetObject(request);
@@ -354,30 +419,15 @@ void FileAWSSDK::Read(char *buffer, size_t size, size_t start)
             "'bucket/object'  " + m_Name + ", range " + range.str() +
                 "GetObject: " + err.GetExceptionName() + ": " + err.GetMessage());
     }
-    else
+    if (m_Verbose > 0)
     {
-        if (m_Verbose > 0)
-        {
-            std::cout << "FileAWSSDK::Read: Successfully retrieved '" << m_ObjectName << "' from '"
-                      << m_BucketName << "'."
-                      << "\nObject length = " << outcome.GetResult().GetContentLength()
-                      << "\nRange requested = " << range.str() << std::endl;
-        }
-        auto body = outcome.GetResult().GetBody().rdbuf();
-        body->sgetn(buffer, size);
-
-        /* Save to cache */
-        if (m_CachingThisFile)
-        {
-            m_CacheFileWrite->Write(buffer, size, m_SeekPos);
-            m_CacheFileWrite->Flush();
-            if (m_Verbose > 0)
-            {
-                std::cout << "FileAWSSDK::Read: Written to cache " << m_CacheFileWrite->m_Name
-                          << " start = " << m_SeekPos << " size = " << size << std::endl;
-            }
-        }
+        std::cout << "FileAWSSDK::Read: Successfully retrieved '" << m_ObjectName << "' from '"
+                  << m_BucketName << "'."
+                  << "\nObject length = " << outcome.GetResult().GetContentLength()
+                  << "\nRange requested = " << range.str() << std::endl;
     }
+    auto body = outcome.GetResult().GetBody().rdbuf();
+    body->sgetn(buffer, size);
 }
 
 size_t FileAWSSDK::GetSize()
@@ -409,6 +459,12 @@ void FileAWSSDK::Close()
     ProfilerStart("close");
     errno = 0;
     m_Errno = errno;
+    if (m_BlockCache)
+    {
+        m_ClosedCacheHits += m_BlockCache->Hits();
+        m_ClosedCacheMisses += m_BlockCache->Misses();
+    }
+    m_BlockCache.reset();
     if (s3Client)
     {
         delete s3Client;
@@ -434,6 +490,20 @@ void FileAWSSDK::Close()
     ProfilerStop("close");
 }
 
+void FileAWSSDK::AddMetrics(std::map<std::string, double> &metrics,
+                            const std::string &prefix) const
+{
+    size_t hits = m_ClosedCacheHits;
+    size_t misses = m_ClosedCacheMisses;
+    if (m_BlockCache)
+    {
+        hits += m_BlockCache->Hits();
+        misses += m_BlockCache->Misses();
+    }
+    metrics[prefix + "cache_hits"] += static_cast<double>(hits);
+    metrics[prefix + "cache_misses"] += static_cast<double>(misses);
+}
+
 void FileAWSSDK::Delete()
 {
     WaitForOpen();
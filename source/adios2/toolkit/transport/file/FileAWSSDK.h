@@ -13,8 +13,10 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_FILE_AWSSDK_H_
 
 #include <future> //std::async, std::future
+#include <memory> //std::unique_ptr
 
 #include "adios2/common/ADIOSConfig.h"
+#include "adios2/toolkit/transport/BlockCache.h"
 #include "adios2/toolkit/transport/Transport.h"
 #include "adios2/toolkit/transport/file/FileFStream.h"
 
@@ -68,6 +70,10 @@ public:
 
     void Delete() final;
 
+    /** block cache hits, misses and bytes fetched from the object store */
+    void AddMetrics(std::map<std::string, double> &metrics,
+                    const std::string &prefix) const final;
+
     void SeekToEnd() final;
 
     void SeekToBegin() final;
@@ -107,6 +113,20 @@ private:
     FileFStream *m_CacheFileRead;
     std::string m_CacheFilePath; // full path to file in cache
 
+    /* In-memory block cache for objects not cached as a whole */
+    size_t m_BlockCacheSize = 0; // capacity in bytes, 0 turns it off
+    size_t m_BlockSize = 4 * 1024 * 1024;
+    BlockCache::EvictionPolicy m_BlockCachePolicy = BlockCache::EvictionPolicy::LRU;
+    size_t m_ParallelGets = 8;
+    size_t m_ReadAhead = 2; // blocks fetched in the background, only for metadata files
+    std::unique_ptr<BlockCache> m_BlockCache;
+    /* counters of block caches already closed, for AddMetrics */
+    size_t m_ClosedCacheHits = 0;
+    size_t m_ClosedCacheMisses = 0;
+
+    /** one ranged GetObject, thread-safe */
+    void GetRange(char *buffer, size_t size, size_t start);
+
     /**
      * Check if m_FileDescriptor is -1 after an operation
      * @param hint exception message
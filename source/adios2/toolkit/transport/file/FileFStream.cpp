@@ -221,6 +221,7 @@ void FileFStream::Read(char *buffer, size_t size, size_t start)
         ProfilerStart("read");
         m_FileStream.read(buffer, static_cast<std::streamsize>(size));
         ProfilerStop("read");
+        ProfilerReadBytes(static_cast<size_t>(m_FileStream.gcount()));
         CheckFile("couldn't read from file " + m_Name + ", in call to fstream read");
     };
 
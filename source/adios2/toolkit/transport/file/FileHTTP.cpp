@@ -8,7 +8,14 @@
  *      Author: Dmitry Ganyushin  ganyushin@gmail.com
  */
 #include "FileHTTP.h"
+#include "adios2/helper/adiosLog.h"
+#include "adios2/helper/adiosString.h"
+
+#include <algorithm>
 #include <cstring>
+#include <map>
+#include <mutex>
+#include <set>
 #ifdef _MSC_VER
 #define FD_SETSIZE 1024
 #include <process.h>
@@ -17,10 +24,9 @@
 
 #include <windows.h>
 #define getpid() _getpid()
-#define read(fd, buf, len) recv(fd, (buf), (len), 0)
-#define write(fd, buf, len) send(fd, buf, (len), 0)
 #define close(x) closesocket(x)
 #define INST_ADDRSTRLEN 50
+#define ADIOS2_HTTP_SEND_FLAGS 0
 #else
 #include <netinet/in.h>
 #include <sys/socket.h>
@@ -29,20 +35,67 @@
 #include <cstring>
 #include <netdb.h>
 #include <netinet/in.h>
+#include <netinet/tcp.h>
 #include <unistd.h>
+#ifdef MSG_NOSIGNAL
+// a kept-alive connection closed by the server must not raise SIGPIPE
+#define ADIOS2_HTTP_SEND_FLAGS MSG_NOSIGNAL
+#else
+#define ADIOS2_HTTP_SEND_FLAGS 0
+#endif
 #endif
 namespace adios2
 {
 namespace transport
 {
 
-FileHTTP::FileHTTP(helper::Comm const &comm) : Transport("File", "HTTP", comm) {}
+namespace
+{
+/* Idle keep-alive connections of all FileHTTP transports, by host:port */
+std::mutex PoolMutex;
+std::multimap<std::string, SOCKET> IdleConnections;
+constexpr size_t MaxIdleConnectionsPerServer = 16;
+/* Servers answering the size request with raw text, without HTTP headers */
+std::set<std::string> LegacyServers;
 
-FileHTTP::~FileHTTP()
+/* Parses the decimal number at s[pos] into value, returns the position after
+ * it or npos if there is no number or it does not fit into size_t */
+size_t ParseSize(const std::string &s, const size_t pos, size_t &value)
 {
-    if (m_IsOpen)
+    size_t end = pos;
+    value = 0;
+    while (end < s.size() && s[end] >= '0' && s[end] <= '9')
     {
+        const size_t digit = static_cast<size_t>(s[end] - '0');
+        if (value > (MaxSizeT - digit) / 10)
+        {
+            return std::string::npos;
+        }
+        value = value * 10 + digit;
+        ++end;
     }
+    return (end > pos) ? end : std::string::npos;
+}
+}
+
+FileHTTP::FileHTTP(helper::Comm const &comm) : Transport("File", "HTTP", comm) {}
+
+FileHTTP::~FileHTTP() { Disconnect(true); }
+
+void FileHTTP::SetParameters(const Params &params)
+{
+    helper::SetParameterValue("hostname", params, m_hostname);
+    helper::SetParameterValueInt("port", params, m_server_port,
+                                 "in call to FileHTTP::SetParameters");
+    int maxRanges = static_cast<int>(m_MaxRanges);
+    helper::SetParameterValueInt("max_ranges", params, maxRanges,
+                                 "in call to FileHTTP::SetParameters");
+    m_MaxRanges = static_cast<size_t>(std::max(maxRanges, 1));
+    int pipelineDepth = static_cast<int>(m_PipelineDepth);
+    helper::SetParameterValueInt("pipeline_depth", params, pipelineDepth,
+                                 "in call to FileHTTP::SetParameters");
+    m_PipelineDepth = static_cast<size_t>(std::max(pipelineDepth, 1));
+    helper::GetParameter(params, "head_timeout", m_HeadTimeout);
 }
 
 void FileHTTP::WaitForOpen()
@@ -63,6 +116,7 @@ void FileHTTP::Open(const std::string &name, const Mode openMode, const bool asy
     uint32_t addr_tmp;
 
     m_Name = name;
+    m_SeekPos = 0;
     /* Build the socket. */
     protoent = getprotobyname("tcp");
     if (protoent == NULL)
@@ -198,124 +252,754 @@ void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
 }
 #endif
 
-void FileHTTP::Read(char *buffer, size_t size, size_t start)
+std::string FileHTTP::Server() const
 {
-    /* not using BUFSIZ, the server might use another value for that */
-    const size_t BUF_SIZE = 8192;
-    enum CONSTEXPR
+    return m_hostname + ":" + std::to_string(m_server_port);
+}
+
+bool FileHTTP::IsLegacyServer() const
+{
+    std::lock_guard<std::mutex> lock(PoolMutex);
+    return LegacyServers.count(Server()) > 0;
+}
+
+bool FileHTTP::Connect(const std::string &hint)
+{
+    if (m_socketFileDescriptor != -1)
     {
-        MAX_REQUEST_LEN = 1024
-    };
-    char request[MAX_REQUEST_LEN] = {'\0'};
-    int request_len = snprintf(request, MAX_REQUEST_LEN, request_template.c_str(), m_Name.c_str(),
-                               m_hostname.c_str(), start, start + size - 1);
-    if (request_len >= MAX_REQUEST_LEN)
+        if (!m_ResponsePending)
+        {
+            return true;
+        }
+        // an exception left a response unread
+        Disconnect(false);
+    }
+
+    const std::string server = Server();
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                              "request length too long:  " +
-                                                  std::to_string(request_len));
+        std::lock_guard<std::mutex> lock(PoolMutex);
+        auto it = IdleConnections.find(server);
+        if (it != IdleConnections.end())
+        {
+            m_socketFileDescriptor = it->second;
+            IdleConnections.erase(it);
+            return true;
+        }
     }
+
     m_socketFileDescriptor = socket(AF_INET, SOCK_STREAM, m_p_proto);
     if (m_socketFileDescriptor == -1)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
                                               "cannot open socket");
     }
     /* Actually connect. */
     if (connect(m_socketFileDescriptor, (struct sockaddr *)&sockaddr_in, sizeof(sockaddr_in)) == -1)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                              "cannot connect");
+        m_Errno = errno;
+        close(m_socketFileDescriptor);
+        m_socketFileDescriptor = -1;
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
+                                              "cannot connect to " + server + SysErrMsg());
+    }
+    // requests are small and latency bound
+    int one = 1;
+    setsockopt(m_socketFileDescriptor, IPPROTO_TCP, TCP_NODELAY, (const char *)&one, sizeof(one));
+    return false;
+}
+
+void FileHTTP::Disconnect(const bool keepAlive)
+{
+    if (m_socketFileDescriptor == -1)
+    {
+        return;
     }
-    /* Send HTTP request. */
-    int nbytes_total = 0;
-    while (nbytes_total < request_len)
+    // leftover bytes mean we lost track of the responses, do not reuse
+    if (keepAlive && !m_ResponsePending && m_RecvBuffer.empty())
     {
-        int nbytes_last =
-            write(m_socketFileDescriptor, request + nbytes_total, request_len - nbytes_total);
-        if (nbytes_last == -1)
+        const std::string server = Server();
+        std::lock_guard<std::mutex> lock(PoolMutex);
+        if (IdleConnections.count(server) < MaxIdleConnectionsPerServer)
         {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                                  "cannot send request");
+            IdleConnections.emplace(server, m_socketFileDescriptor);
+            m_socketFileDescriptor = -1;
+            return;
+        }
+    }
+    close(m_socketFileDescriptor);
+    m_socketFileDescriptor = -1;
+    m_RecvBuffer.clear();
+    m_ResponsePending = false;
+}
+
+bool FileHTTP::Send(const std::string &request)
+{
+    m_ResponsePending = true;
+    size_t nbytes_total = 0;
+    while (nbytes_total < request.size())
+    {
+        auto nbytes_last = send(m_socketFileDescriptor, request.data() + nbytes_total,
+                                request.size() - nbytes_total, ADIOS2_HTTP_SEND_FLAGS);
+        if (nbytes_last <= 0)
+        {
+            m_Errno = errno;
+            return false;
         }
-        nbytes_total += nbytes_last;
+        nbytes_total += static_cast<size_t>(nbytes_last);
     }
+    return true;
+}
 
-    /* Read the response. */
-    size_t bytes_recd = 0;
+bool FileHTTP::ReceiveMore()
+{
+    /* not using BUFSIZ, the server might use another value for that */
+    char buf[8192];
+    auto n = recv(m_socketFileDescriptor, buf, sizeof(buf), 0);
+    if (n <= 0)
+    {
+        m_Errno = errno;
+        return false;
+    }
+    m_RecvBuffer.append(buf, static_cast<size_t>(n));
+    return true;
+}
+
+bool FileHTTP::ReceiveHeader(Response &response, const std::string &hint)
+{
+    size_t headerEnd;
+    while ((headerEnd = m_RecvBuffer.find("\r\n\r\n")) == std::string::npos)
+    {
+        if (m_RecvBuffer.size() >= 5 && m_RecvBuffer.compare(0, 5, "HTTP/") != 0)
+        {
+            // no status line: raw content (proxy not speaking HTTP)
+            response.raw = true;
+            response.keepAlive = false;
+            return true;
+        }
+        if (!ReceiveMore())
+        {
+            if (m_RecvBuffer.empty())
+            {
+                return false;
+            }
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
+                                                  "connection closed in response header of " +
+                                                      m_Name);
+        }
+    }
+
+    const std::string header = m_RecvBuffer.substr(0, headerEnd + 2);
+    m_RecvBuffer.erase(0, headerEnd + 4);
+
+    // status line, e.g. HTTP/1.1 206 Partial Content
+    size_t lineEnd = header.find("\r\n");
+    const std::string statusLine = header.substr(0, lineEnd);
+    const size_t sp = statusLine.find(' ');
+    response.status = (sp == std::string::npos) ? 0 : atoi(statusLine.c_str() + sp + 1);
+    response.keepAlive = (statusLine.compare(0, 8, "HTTP/1.0") != 0);
+
+    size_t pos = lineEnd + 2;
+    while (pos < header.size())
+    {
+        lineEnd = header.find("\r\n", pos);
+        const std::string line = header.substr(pos, lineEnd - pos);
+        pos = lineEnd + 2;
+        const size_t colon = line.find(':');
+        if (colon == std::string::npos)
+        {
+            continue;
+        }
+        const std::string name = helper::LowerCase(line.substr(0, colon));
+        size_t vstart = line.find_first_not_of(" \t", colon + 1);
+        const std::string value =
+            (vstart == std::string::npos)
+                ? std::string()
+                : line.substr(vstart, line.find_last_not_of(" \t") + 1 - vstart);
+        if (name == "content-length")
+        {
+            if (ParseSize(value, 0, response.contentLength) != value.size())
+            {
+                helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP",
+                                                      hint,
+                                                      "invalid Content-Length " + value +
+                                                          " in response for " + m_Name);
+            }
+        }
+        else if (name == "content-range")
+        {
+            // bytes first-last/total, or bytes */total
+            const size_t slash = value.find('/');
+            const size_t digit = value.find_first_of("0123456789");
+            bool valid = (slash != std::string::npos);
+            if (valid && digit < slash)
+            {
+                const size_t end = ParseSize(value, digit, response.rangeFirst);
+                valid = (end < slash && value[end] == '-');
+            }
+            if (valid && value.compare(slash + 1, 1, "*") != 0)
+            {
+                valid = (ParseSize(value, slash + 1, response.totalSize) == value.size());
+            }
+            if (!valid)
+            {
+                helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP",
+                                                      hint,
+                                                      "invalid Content-Range " + value +
+                                                          " in response for " + m_Name);
+            }
+        }
+        else if (name == "content-type" &&
+                 helper::LowerCase(value).compare(0, 20, "multipart/byteranges") == 0)
+        {
+            const size_t b = value.find("boundary=");
+            if (b != std::string::npos)
+            {
+                response.boundary = value.substr(b + 9);
+                const size_t end = response.boundary.find(';');
+                if (end != std::string::npos)
+                {
+                    response.boundary.erase(end);
+                }
+                if (response.boundary.size() >= 2 && response.boundary.front() == '"')
+                {
+                    response.boundary = response.boundary.substr(1, response.boundary.size() - 2);
+                }
+            }
+        }
+        else if (name == "connection")
+        {
+            const std::string v = helper::LowerCase(value);
+            if (v == "close")
+            {
+                response.keepAlive = false;
+            }
+            else if (v == "keep-alive")
+            {
+                response.keepAlive = true;
+            }
+        }
+        else if (name == "transfer-encoding" && helper::LowerCase(value) != "identity")
+        {
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
+                                                  "unsupported Transfer-Encoding " + value +
+                                                      " in response for " + m_Name);
+        }
+    }
+    return true;
+}
+
+void FileHTTP::ReceiveBody(char *buffer, size_t size, const std::string &hint)
+{
+    // bytes already received with the header come first
+    const size_t fromBuffer = std::min(size, m_RecvBuffer.size());
+    if (buffer && fromBuffer)
+    {
+        std::memcpy(buffer, m_RecvBuffer.data(), fromBuffer);
+    }
+    m_RecvBuffer.erase(0, fromBuffer);
+
+    size_t bytes_recd = fromBuffer;
+    char discard[8192];
     while (bytes_recd < size)
     {
-        size_t remaining = size - bytes_recd;
-        int read_len = (int)(remaining < BUF_SIZE ? remaining : BUF_SIZE);
-        nbytes_total = read(m_socketFileDescriptor, buffer + bytes_recd, read_len);
-        if (nbytes_total == -1)
+        const size_t remaining = size - bytes_recd;
+        char *dst = buffer ? buffer + bytes_recd : discard;
+        const size_t len = buffer ? remaining : std::min(remaining, sizeof(discard));
+        auto n = recv(m_socketFileDescriptor, dst, len, 0);
+        if (n <= 0)
+        {
+            m_Errno = errno;
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "transport::file::FileHTTP", hint,
+                "cannot get response, received " + std::to_string(bytes_recd) + " of " +
+                    std::to_string(size) + " bytes of " + m_Name + SysErrMsg());
+        }
+        bytes_recd += static_cast<size_t>(n);
+    }
+}
+
+std::string FileHTTP::ReceiveLine(const std::string &hint)
+{
+    size_t lineEnd;
+    while ((lineEnd = m_RecvBuffer.find("\r\n")) == std::string::npos)
+    {
+        if (!ReceiveMore())
+        {
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
+                                                  "connection closed in multipart response of " +
+                                                      m_Name + SysErrMsg());
+        }
+    }
+    const std::string line = m_RecvBuffer.substr(0, lineEnd);
+    m_RecvBuffer.erase(0, lineEnd + 2);
+    return line;
+}
+
+void FileHTTP::SetReceiveTimeout(const float seconds)
+{
+#ifdef _MSC_VER
+    DWORD t = static_cast<DWORD>(seconds * 1000);
+#else
+    struct timeval t;
+    t.tv_sec = static_cast<time_t>(seconds);
+    t.tv_usec = static_cast<suseconds_t>((seconds - static_cast<float>(t.tv_sec)) * 1e6f);
+#endif
+    setsockopt(m_socketFileDescriptor, SOL_SOCKET, SO_RCVTIMEO, (const char *)&t, sizeof(t));
+}
+
+bool FileHTTP::Request(const std::string &request, Response &response, const std::string &hint,
+                       const float timeout)
+{
+    for (int attempt = 0;; ++attempt)
+    {
+        const bool reused = Connect(hint);
+        if (timeout > 0.0f)
+        {
+            SetReceiveTimeout(timeout);
+        }
+        const bool answered = Send(request) && ReceiveHeader(response, hint);
+        if (timeout > 0.0f && m_socketFileDescriptor != -1)
+        {
+            SetReceiveTimeout(0.0f);
+        }
+        if (answered)
         {
+            return true;
+        }
+        // the server may close an idle kept-alive connection any time
+        Disconnect(false);
+        if (!reused || attempt > 0)
+        {
+            if (timeout > 0.0f)
+            {
+                return false;
+            }
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", hint,
+                                                  "connection closed by " + m_hostname +
+                                                      " without response for " + m_Name +
+                                                      SysErrMsg());
+        }
+    }
+}
+
+void FileHTTP::Read(char *buffer, size_t size, size_t start)
+{
+    if (start == MaxSizeT)
+    {
+        start = m_SeekPos;
+    }
+    m_SeekPos = start + size;
+    if (size == 0)
+    {
+        return;
+    }
+
+    const std::string request = "GET " + m_Name + " HTTP/1.1\r\nHost: " + m_hostname +
+                                "\r\nRange: bytes=" + std::to_string(start) + "-" +
+                                std::to_string(start + size - 1) + "\r\n\r\n";
+    Response response;
+    Request(request, response, "Read");
+
+    if (response.raw)
+    {
+        ReceiveBody(buffer, size, "Read");
+        Disconnect(false);
+        return;
+    }
+
+    if (response.status == 206)
+    {
+        if (response.contentLength != MaxSizeT && response.contentLength != size)
+        {
+            Disconnect(false);
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "transport::file::FileHTTP", "Read",
+                "server returned " + std::to_string(response.contentLength) + " bytes instead of " +
+                    std::to_string(size) + " at offset " + std::to_string(start) + " of " + m_Name);
+        }
+        ReceiveBody(buffer, size, "Read");
+        if (!response.keepAlive || response.contentLength == MaxSizeT)
+        {
+            Disconnect(false);
+        }
+    }
+    else if (response.status == 200)
+    {
+        // Range ignored, the whole file follows
+        if (response.contentLength != MaxSizeT && response.contentLength < start + size)
+        {
+            Disconnect(false);
             helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
-                                                  "cannot get response");
+                                                  "reading past the end of " + m_Name);
+        }
+        ReceiveBody(nullptr, start, "Read");
+        ReceiveBody(buffer, size, "Read");
+        // not worth draining the rest of the file to keep the connection
+        if (!response.keepAlive || response.contentLength != start + size)
+        {
+            Disconnect(false);
         }
-        bytes_recd += nbytes_total;
     }
+    else
+    {
+        Disconnect(false);
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "Read",
+                                              "HTTP status " + std::to_string(response.status) +
+                                                  " for " + m_Name);
+    }
+    m_ResponsePending = false;
+}
 
-    close(m_socketFileDescriptor);
-    return;
+size_t FileHTTP::ReceiveRanges(const size_t first, const size_t length,
+                               const ReadRange *const *ranges, const size_t count)
+{
+    const size_t end = first + length;
+    // next byte of the file to come from the connection
+    size_t pos = first;
+    size_t copied = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        const ReadRange &r = *ranges[i];
+        const size_t b = std::max(r.start, first);
+        const size_t e = std::min(r.start + r.size, end);
+        if (b >= e)
+        {
+            continue;
+        }
+        // overlaps ranges before it, those bytes are received already
+        for (size_t j = 0; j < i && b < pos; ++j)
+        {
+            const ReadRange &q = *ranges[j];
+            const size_t qb = std::max(q.start, b);
+            const size_t qe = std::min(std::min(q.start + q.size, e), pos);
+            if (qb < qe)
+            {
+                std::memcpy(r.buffer + (qb - r.start), q.buffer + (qb - q.start), qe - qb);
+            }
+        }
+        if (e > pos)
+        {
+            const size_t from = std::max(b, pos);
+            ReceiveBody(nullptr, from - pos, "ReadV");
+            ReceiveBody(r.buffer + (from - r.start), e - from, "ReadV");
+            pos = e;
+        }
+        copied += e - b;
+    }
+    ReceiveBody(nullptr, end - pos, "ReadV");
+    return copied;
 }
 
-size_t FileHTTP::GetSize()
+bool FileHTTP::ReceiveBatch(const Response &response, const ReadRange *const *ranges,
+                            const size_t count)
+{
+    size_t requested = 0;
+    size_t last = 0;
+    for (size_t i = 0; i < count; ++i)
+    {
+        requested += ranges[i]->size;
+        last = std::max(last, ranges[i]->start + ranges[i]->size);
+    }
+
+    size_t copied = 0;
+    bool keepAlive = response.keepAlive;
+    if (response.status == 206 && !response.boundary.empty())
+    {
+        // --boundary, part headers with Content-Range, empty line, part data,
+        // CRLF, ... --boundary--
+        const std::string delimiter = "--" + response.boundary;
+        size_t consumed = 0;
+        auto lf_NextLine = [&]() {
+            const std::string line = ReceiveLine("ReadV");
+            consumed += line.size() + 2;
+            return line;
+        };
+        std::string line;
+        while ((line = lf_NextLine()).compare(0, delimiter.size(), delimiter) != 0)
+        {
+        }
+        while (line.compare(delimiter.size(), 2, "--") != 0)
+        {
+            Response part;
+            while (!(line = lf_NextLine()).empty())
+            {
+                const size_t colon = line.find(':');
+                if (colon != std::string::npos &&
+                    helper::LowerCase(line.substr(0, colon)) == "content-range")
+                {
+                    // bytes first-last/total
+                    const size_t digit = line.find_first_of("0123456789", colon);
+                    size_t first = 0;
+                    size_t lastByte = 0;
+                    const size_t dash = ParseSize(line, digit, first);
+                    const size_t slash = (dash < line.size() && line[dash] == '-')
+                                             ? ParseSize(line, dash + 1, lastByte)
+                                             : std::string::npos;
+                    if (slash >= line.size() || line[slash] != '/' || lastByte < first)
+                    {
+                        Disconnect(false);
+                        helper::Throw<std::ios_base::failure>(
+                            "Toolkit", "transport::file::FileHTTP", "ReadV",
+                            "invalid multipart Content-Range " + line + " for " + m_Name);
+                    }
+                    part.rangeFirst = first;
+                    part.contentLength = lastByte - first + 1;
+                }
+            }
+            if (part.rangeFirst == MaxSizeT)
+            {
+                Disconnect(false);
+                helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP",
+                                                      "ReadV",
+                                                      "multipart response part without "
+                                                      "Content-Range for " +
+                                                          m_Name);
+            }
+            copied += ReceiveRanges(part.rangeFirst, part.contentLength, ranges, count);
+            consumed += part.contentLength;
+            while ((line = lf_NextLine()).compare(0, delimiter.size(), delimiter) != 0)
+            {
+            }
+        }
+        if (response.contentLength == MaxSizeT)
+        {
+            keepAlive = false;
+        }
+        else if (response.contentLength > consumed)
+        {
+            // epilogue after the last boundary
+            ReceiveBody(nullptr, response.contentLength - consumed, "ReadV");
+        }
+    }
+    else if (response.status == 206)
+    {
+        // one range, the server may have merged the requested ones
+        if (response.rangeFirst == MaxSizeT || response.contentLength == MaxSizeT)
+        {
+            Disconnect(false);
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "ReadV",
+                                                  "partial response without Content-Range or "
+                                                  "Content-Length for " +
+                                                      m_Name);
+        }
+        copied = ReceiveRanges(response.rangeFirst, response.contentLength, ranges, count);
+    }
+    else if (response.status == 200)
+    {
+        // Range ignored, the whole file follows
+        if (response.contentLength != MaxSizeT && response.contentLength < last)
+        {
+            Disconnect(false);
+            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "ReadV",
+                                                  "reading past the end of " + m_Name);
+        }
+        copied = ReceiveRanges(0, last, ranges, count);
+        // not worth draining the rest of the file to keep the connection
+        keepAlive = keepAlive && response.contentLength == last;
+    }
+    else
+    {
+        Disconnect(false);
+        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "ReadV",
+                                              "HTTP status " + std::to_string(response.status) +
+                                                  " for " + m_Name);
+    }
+
+    if (copied < requested)
+    {
+        Disconnect(false);
+        helper::Throw<std::ios_base::failure>(
+            "Toolkit", "transport::file::FileHTTP", "ReadV",
+            "server returned " + std::to_string(copied) + " of " + std::to_string(requested) +
+                " requested bytes of " + m_Name);
+    }
+    return keepAlive;
+}
+
+void FileHTTP::ReadV(const ReadRange *ranges, const size_t count)
 {
-    char request_template[] = "GET %s HTTP/1.1\r\nHost: %s\r\nContent-Length: bytes\r\n\r\n";
-    enum CONSTEXPR
+    std::vector<const ReadRange *> sorted;
+    sorted.reserve(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        if (ranges[i].size)
+        {
+            sorted.push_back(&ranges[i]);
+        }
+    }
+    if (sorted.size() < 2 || m_MaxRanges < 2 || IsLegacyServer())
+    {
+        // the legacy proxy only knows single ranges
+        Transport::ReadV(ranges, count);
+        return;
+    }
+    std::sort(sorted.begin(), sorted.end(), [](const ReadRange *a, const ReadRange *b) {
+        return a->start < b->start || (a->start == b->start && a->size < b->size);
+    });
+
+    // one GET with up to m_MaxRanges ranges per batch, touching ranges merged
+    struct Batch
     {
-        MAX_REQUEST_LEN = 1024,
-        BUF_SIZE = 128
+        size_t begin;
+        size_t end;
+        std::string request;
     };
-    char request[MAX_REQUEST_LEN];
-    char buffer[BUF_SIZE] = {'\0'};
-    int request_len =
-        snprintf(request, MAX_REQUEST_LEN, request_template, m_Name.c_str(), m_hostname.c_str());
-    if (request_len >= MAX_REQUEST_LEN)
+    std::vector<Batch> batches;
+    for (size_t begin = 0; begin < sorted.size(); begin += m_MaxRanges)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "request length too long:  " +
-                                                  std::to_string(request_len));
+        const size_t end = std::min(sorted.size(), begin + m_MaxRanges);
+        std::string spec;
+        size_t first = sorted[begin]->start;
+        size_t last = first + sorted[begin]->size;
+        for (size_t i = begin + 1; i <= end; ++i)
+        {
+            if (i < end && sorted[i]->start <= last)
+            {
+                last = std::max(last, sorted[i]->start + sorted[i]->size);
+                continue;
+            }
+            spec += (spec.empty() ? "" : ",") + std::to_string(first) + "-" +
+                    std::to_string(last - 1);
+            if (i < end)
+            {
+                first = sorted[i]->start;
+                last = first + sorted[i]->size;
+            }
+        }
+        batches.push_back({begin, end,
+                           "GET " + m_Name + " HTTP/1.1\r\nHost: " + m_hostname +
+                               "\r\nRange: bytes=" + spec + "\r\n\r\n"});
     }
-    m_socketFileDescriptor = socket(AF_INET, SOCK_STREAM, m_p_proto);
-    if (m_socketFileDescriptor == -1)
+
+    // up to depth requests are sent ahead of their responses
+    size_t depth = m_PipelineDepth;
+    size_t sent = 0;
+    size_t received = 0;
+    bool reused = Connect("ReadV");
+    bool answered = false;
+    while (received < batches.size())
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "cannot bind socket");
+        bool ok = true;
+        while (ok && sent < batches.size() && sent - received < depth)
+        {
+            ok = Send(batches[sent++].request);
+        }
+        Response response;
+        if (ok && ReceiveHeader(response, "ReadV"))
+        {
+            const Batch &batch = batches[received];
+            if (response.raw)
+            {
+                // not an HTTP server, no multi-range support
+                Disconnect(false);
+                {
+                    std::lock_guard<std::mutex> lock(PoolMutex);
+                    LegacyServers.insert(Server());
+                }
+                for (size_t i = batch.begin; i < sorted.size(); ++i)
+                {
+                    Read(sorted[i]->buffer, sorted[i]->size, sorted[i]->start);
+                }
+                break;
+            }
+            const bool keepAlive =
+                ReceiveBatch(response, &sorted[batch.begin], batch.end - batch.begin);
+            ++received;
+            answered = true;
+            if (keepAlive)
+            {
+                continue;
+            }
+            // requests sent after this one are lost with the connection
+            Disconnect(false);
+            if (received == batches.size())
+            {
+                break;
+            }
+        }
+        else
+        {
+            // the server may close a kept-alive connection any time, and
+            // a reset for unread pipelined requests can drop its responses
+            Disconnect(false);
+            if (!reused && !answered && depth > 1)
+            {
+                depth = 1;
+            }
+            else if (!reused && !answered)
+            {
+                helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP",
+                                                      "ReadV",
+                                                      "connection closed by " + m_hostname +
+                                                          " without response for " + m_Name +
+                                                          SysErrMsg());
+            }
+        }
+        reused = Connect("ReadV");
+        answered = false;
+        sent = received;
     }
-    /* Actually connect. */
-    if (connect(m_socketFileDescriptor, (struct sockaddr *)&sockaddr_in, sizeof(sockaddr_in)) == -1)
+    m_ResponsePending = false;
+    if (count)
     {
-        helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "cannot connect");
+        m_SeekPos = ranges[count - 1].start + ranges[count - 1].size;
     }
-    /* Send HTTP request. */
-    int nbytes_total = 0;
-    while (nbytes_total < request_len)
+}
+
+size_t FileHTTP::GetSize()
+{
+    if (!IsLegacyServer())
     {
-        int nbytes_last =
-            write(m_socketFileDescriptor, request + nbytes_total, request_len - nbytes_total);
-        if (nbytes_last == -1)
+        // the legacy proxy does not answer HEAD, bound the wait for it
+        const std::string request =
+            "HEAD " + m_Name + " HTTP/1.1\r\nHost: " + m_hostname + "\r\n\r\n";
+        Response response;
+        if (Request(request, response, "GetSize", m_HeadTimeout))
         {
-            helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                                  "sending request failed");
+            if (!response.raw && response.status == 200 &&
+                response.contentLength != MaxSizeT)
+            {
+                // HEAD response has no body
+                m_ResponsePending = false;
+                if (!response.keepAlive)
+                {
+                    Disconnect(false);
+                }
+                return response.contentLength;
+            }
+            Disconnect(false);
         }
-        nbytes_total += nbytes_last;
     }
+    return GetSizeLegacy();
+}
+
+size_t FileHTTP::GetSizeLegacy()
+{
+    const std::string request = "GET " + m_Name + " HTTP/1.1\r\nHost: " + m_hostname +
+                                "\r\nContent-Length: bytes\r\n\r\n";
+    Response response;
+    Request(request, response, "GetSize");
 
-    /* Read the response. */
-    while ((nbytes_total = read(m_socketFileDescriptor, buffer, BUF_SIZE)) > 0)
-        ;
-    if (nbytes_total == -1)
+    if (response.raw)
+    {
+        while (ReceiveMore())
+            ;
+        size_t result = atoi(m_RecvBuffer.c_str());
+        m_RecvBuffer.clear();
+        Disconnect(false);
+        std::lock_guard<std::mutex> lock(PoolMutex);
+        LegacyServers.insert(Server());
+        return result;
+    }
+    // not worth draining the file to keep the connection
+    Disconnect(false);
+    if (response.status != 200 || response.contentLength == MaxSizeT)
     {
         helper::Throw<std::ios_base::failure>("Toolkit", "transport::file::FileHTTP", "GetSize",
-                                              "receiving response failed");
+                                              "HTTP status " + std::to_string(response.status) +
+                                                  ", cannot get size of " + m_Name);
     }
-    close(m_socketFileDescriptor);
-    size_t result = atoi(buffer);
-
-    return result;
+    return response.contentLength;
 }
 
 void FileHTTP::Flush()
@@ -324,7 +1008,7 @@ void FileHTTP::Flush()
      * slows down IO performance */
 }
 
-void FileHTTP::Close() { return; }
+void FileHTTP::Close() { Disconnect(true); }
 
 void FileHTTP::Delete() { return; }
 
@@ -344,9 +1028,15 @@ std::string FileHTTP::SysErrMsg() const
 
 void FileHTTP::SeekToEnd() { return; }
 
-void FileHTTP::SeekToBegin() { return; }
+void FileHTTP::SeekToBegin() { m_SeekPos = 0; }
 
-void FileHTTP::Seek(const size_t start) { return; }
+void FileHTTP::Seek(const size_t start)
+{
+    if (start != MaxSizeT)
+    {
+        m_SeekPos = start;
+    }
+}
 
 void FileHTTP::Truncate(const size_t length) { return; }
 
@@ -12,6 +12,8 @@
 
 #include "../Transport.h"
 #include "adios2/common/ADIOSConfig.h"
+
+#include <string>
 #ifdef _MSC_VER
 #define FD_SETSIZE 1024
 #include <process.h>
@@ -36,7 +38,11 @@ class Comm;
 namespace transport
 {
 
-/** File descriptor transport using the POSIX IO library */
+/**
+ * Read-only transport fetching byte ranges with HTTP/1.1 GET requests.
+ * Connections are kept alive between reads and returned to a process-wide
+ * pool on Close(), so reads and reopened files skip the TCP connect.
+ */
 class FileHTTP : public Transport
 {
 
@@ -45,6 +51,15 @@ public:
 
     ~FileHTTP();
 
+    /**
+     * hostname and port of the server, default localhost:9999, max_ranges
+     * per multi-range GET in ReadV (default 32), pipeline_depth requests
+     * sent ahead of their responses in ReadV (default 4), head_timeout in
+     * seconds before GetSize falls back to the legacy proxy request
+     * (default 5)
+     */
+    void SetParameters(const Params &parameters) final;
+
     void Open(const std::string &name, const Mode openMode, const bool async = false,
               const bool directio = false) final;
 
@@ -60,6 +75,12 @@ public:
 
     void Read(char *buffer, size_t size, size_t start = MaxSizeT) final;
 
+    /**
+     * Fetches the ranges with multi-range GET requests, max_ranges per
+     * request, pipelined on the kept-alive connection
+     */
+    void ReadV(const ReadRange *ranges, const size_t count) final;
+
     size_t GetSize() final;
 
     /** Does nothing, each write is supposed to flush */
@@ -80,17 +101,107 @@ public:
     void MkDir(const std::string &fileName) final;
 
 private:
-    /** POSIX file handle returned by Open */
+    /** connected socket, kept open between requests (keep-alive) */
     SOCKET m_socketFileDescriptor = -1;
     int m_Errno = 0;
     bool m_IsOpening = false;
-    /* if filename is very lomg, we can get lout from array boundaries */
-    std::string request_template = "GET %s HTTP/1.1\r\nHost: %s\r\nRange: bytes=%d-%d\r\n\r\n";
     std::string m_hostname = "localhost";
     int m_server_port = 9999;
+    size_t m_MaxRanges = 32;
+    size_t m_PipelineDepth = 4;
+    float m_HeadTimeout = 5.0f;
     struct sockaddr_in sockaddr_in;
     /* protocol number */
     int m_p_proto;
+    /** position for reads without explicit start */
+    size_t m_SeekPos = 0;
+    /** received bytes not consumed by the last response yet */
+    std::string m_RecvBuffer;
+    /**
+     * set by Send until the response is completely received, a connection
+     * left by an exception in between is not reused
+     */
+    bool m_ResponsePending = false;
+
+    struct Response
+    {
+        int status = 0;
+        /** MaxSizeT if the server did not send Content-Length */
+        size_t contentLength = MaxSizeT;
+        /** total file size from Content-Range, MaxSizeT if absent */
+        size_t totalSize = MaxSizeT;
+        /** first byte from Content-Range, MaxSizeT if absent */
+        size_t rangeFirst = MaxSizeT;
+        /** boundary of a multipart/byteranges body, empty otherwise */
+        std::string boundary;
+        bool keepAlive = true;
+        /** no status line, the body follows immediately (legacy proxy) */
+        bool raw = false;
+    };
+
+    /**
+     * Takes over a pooled connection or connects a new socket
+     * @return true if the connection was used before, thus may have been
+     * closed by the server in the meantime
+     */
+    bool Connect(const std::string &hint);
+
+    /**
+     * Returns the connection to the pool if keepAlive and no response is
+     * pending on it, otherwise closes it
+     */
+    void Disconnect(const bool keepAlive);
+
+    /** Sends a request over the connection, false if it is broken */
+    bool Send(const std::string &request);
+
+    /** host:port, key of the connection pool */
+    std::string Server() const;
+
+    /** true once the server answered the legacy size request with raw text */
+    bool IsLegacyServer() const;
+
+    /**
+     * Sends the request and parses the response header into response,
+     * reconnecting once if a kept-alive connection was closed by the server.
+     * With a timeout (seconds) it returns false instead of throwing if no
+     * response arrives.
+     */
+    bool Request(const std::string &request, Response &response, const std::string &hint,
+                 const float timeout = 0.0f);
+
+    /** Bounds recv() on the connection, 0 waits forever */
+    void SetReceiveTimeout(const float seconds);
+
+    /** Size request of the original proxy, which does not answer HEAD */
+    size_t GetSizeLegacy();
+
+    /** false if the server closed the connection before responding */
+    bool ReceiveHeader(Response &response, const std::string &hint);
+
+    /** Receive more data into m_RecvBuffer, false on EOF */
+    bool ReceiveMore();
+
+    /** Copy size bytes of the response body into buffer, nullptr skips them */
+    void ReceiveBody(char *buffer, size_t size, const std::string &hint);
+
+    /** One line of the response body without its CRLF */
+    std::string ReceiveLine(const std::string &hint);
+
+    /**
+     * Receives the file bytes [first, first + length) and copies them into
+     * the parts of ranges (sorted by start) they overlap
+     * @return bytes copied into ranges
+     */
+    size_t ReceiveRanges(const size_t first, const size_t length, const ReadRange *const *ranges,
+                         const size_t count);
+
+    /**
+     * Receives the body of a response to a multi-range GET into ranges
+     * @return false if the connection cannot be reused
+     */
+    bool ReceiveBatch(const Response &response, const ReadRange *const *ranges,
+                      const size_t count);
 
     /**
      * Check if m_FileDescriptor is -1 after an operation
@@ -13,6 +13,8 @@
 #endif
 #endif
 
+#include <algorithm>   // std::min
+#include <climits>     // IOV_MAX
 #include <cstdio>      // remove
 #include <cstring>     // strerror
 #include <errno.h>     // errno
@@ -20,8 +22,10 @@
 #include <sys/stat.h>  // open, fstat
 #include <sys/types.h> // open
 #include <thread>
+#include <vector>
 #ifndef _MSC_VER
-#include <unistd.h> // write, close, ftruncate
+#include <sys/uio.h> // writev
+#include <unistd.h>  // write, close, ftruncate
 #define O_BINARY 0
 #else
 #include <io.h>
@@ -314,70 +318,9 @@ void FilePOSIX::Write(const char *buffer, size_t size, size_t start)
     }
 }
 
-#ifdef REALLY_WANT_WRITEV
+#ifndef _MSC_VER
 void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
 {
-    auto lf_Write = [&](const core::iovec *iov, const int iovcnt) {
-        ProfilerStart("write");
-        errno = 0;
-        size_t nBytesExpected = 0;
-        for (int i = 0; i < iovcnt; ++i)
-        {
-            nBytesExpected += iov[i].iov_len;
-        }
-        const iovec *v = reinterpret_cast<const iovec *>(iov);
-        const auto ret = writev(m_FileDescriptor, v, iovcnt);
-        m_Errno = errno;
-        ProfilerStop("write");
-
-        size_t written;
-        if (ret == -1)
-        {
-            if (errno != EINTR)
-            {
-                helper::Throw<std::ios_base::failure>(
-                    "Toolkit", "transport::file::FilePOSIX", "WriteV",
-                    "couldn't write to file " + m_Name + " " + SysErrMsg());
-            }
-            written = 0;
-        }
-        else
-        {
-            written = static_cast<size_t>(ret);
-        }
-
-        ProfilerWriteBytes(written);
-
-        if (written < nBytesExpected)
-        {
-            /* Fall back to write calls with individual buffers */
-            // find where the writing has ended
-            int c = 0;
-            size_t n = 0;
-            size_t pos = 0;
-            while (n < written)
-            {
-                if (n + iov[c].iov_len <= written)
-                {
-                    n += iov[c].iov_len;
-                    ++c;
-                }
-                else
-                {
-                    pos = written - n;
-                    n = written;
-                }
-            }
-
-            // write the rest one by one
-            Write(static_cast<const char *>(iov[c].iov_base) + pos, iov[c].iov_len - pos);
-            for (; c < iovcnt; ++c)
-            {
-                Write(static_cast<const char *>(iov[c].iov_base), iov[c].iov_len);
-            }
-        }
-    };
-
     WaitForOpen();
     if (start != MaxSizeT)
     {
@@ -394,16 +337,63 @@ void FilePOSIX::WriteV(const core::iovec *iov, const int iovcnt, size_t start)
         }
     }
 
-    int cntTotal = 0;
-    while (cntTotal < iovcnt)
+#ifdef IOV_MAX
+    const int maxIov = IOV_MAX;
+#else
+    const int maxIov = 1024;
+#endif
+    std::vector<struct iovec> v(static_cast<size_t>(std::min(iovcnt, maxIov)));
+
+    // iov[c] is written up to pos, writev may write less than asked for
+    int c = 0;
+    size_t pos = 0;
+    while (c < iovcnt)
     {
-        int cnt = iovcnt - cntTotal;
-        if (cnt > 8)
+        int n = 0;
+        size_t batchSize = 0;
+        for (; n < maxIov && c + n < iovcnt; ++n)
         {
-            cnt = 8;
+            const size_t skip = n ? 0 : pos;
+            const char *base = static_cast<const char *>(iov[c + n].iov_base);
+            v[n].iov_base = const_cast<char *>(base + skip);
+            v[n].iov_len = iov[c + n].iov_len - skip;
+            batchSize += v[n].iov_len;
         }
-        lf_Write(iov + cntTotal, cnt);
-        cntTotal += cnt;
+
+        ProfilerStart("write");
+        errno = 0;
+        const auto ret = writev(m_FileDescriptor, v.data(), n);
+        m_Errno = errno;
+        ProfilerStop("write");
+
+        if (ret == -1)
+        {
+            if (errno == EINTR)
+            {
+                continue;
+            }
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "transport::file::FilePOSIX", "WriteV",
+                "couldn't write to file " + m_Name + " " + SysErrMsg());
+        }
+        if (ret == 0 && batchSize > 0)
+        {
+            // no progress, retrying would loop forever
+            helper::Throw<std::ios_base::failure>(
+                "Toolkit", "transport::file::FilePOSIX", "WriteV",
+                "couldn't write to file " + m_Name + ", wrote 0 of " +
+                    std::to_string(batchSize) + " bytes " + SysErrMsg());
+        }
+        ProfilerWriteBytes(static_cast<size_t>(ret));
+
+        size_t written = static_cast<size_t>(ret);
+        while (c < iovcnt && written >= iov[c].iov_len - pos)
+        {
+            written -= iov[c].iov_len - pos;
+            pos = 0;
+            ++c;
+        }
+        pos += written;
     }
 }
 #endif
@@ -419,6 +409,10 @@ void FilePOSIX::Read(char *buffer, size_t size, size_t start)
             const auto readSize = read(m_FileDescriptor, buffer, size);
             m_Errno = errno;
             ProfilerStop("read");
+            if (readSize > 0)
+            {
+                ProfilerReadBytes(static_cast<size_t>(readSize));
+            }
 
             if (readSize == -1)
             {
@@ -40,8 +40,8 @@ public:
 
     void Write(const char *buffer, size_t size, size_t start = MaxSizeT) final;
 
-#ifdef REALLY_WANT_WRITEV
-    /* Actual writev() function, inactive for now */
+#ifndef _MSC_VER
+    /* Writes IOV_MAX buffers per writev() call */
     void WriteV(const core::iovec *iov, const int iovcnt, size_t start = MaxSizeT) final;
 #endif
 
@@ -259,6 +259,7 @@ void FileStdio::Read(char *buffer, size_t size, size_t start)
         ProfilerStart("read");
         const auto readSize = std::fread(buffer, sizeof(char), size, m_File);
         ProfilerStop("read");
+        ProfilerReadBytes(readSize);
 
         CheckFile("couldn't read to file " + m_Name + ", in call to stdio fread");
 
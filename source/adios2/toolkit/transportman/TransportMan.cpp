@@ -217,6 +217,33 @@ std::vector<profiling::IOChrono *> TransportMan::GetTransportsProfilers() noexce
     return profilers;
 }
 
+void TransportMan::AddMetrics(std::map<std::string, double> &metrics,
+                              const std::string &prefix) const
+{
+    // the transports may be written by an engine's async thread meanwhile
+    auto lf_Add = [&](const profiling::IOChrono &profiler, const std::string &process,
+                      const std::string &bytesKey, const std::string &timeKey) {
+        size_t bytes;
+        double micros;
+        if (profiler.Snapshot(process, bytes, micros))
+        {
+            metrics[prefix + bytesKey] += static_cast<double>(bytes);
+            metrics[prefix + timeKey] += micros;
+        }
+    };
+
+    for (const auto &transportPair : m_Transports)
+    {
+        const auto &transport = transportPair.second;
+        if (transport->m_Profiler.m_IsActive)
+        {
+            lf_Add(transport->m_Profiler, "write", "bytes_written", "write_mus");
+            lf_Add(transport->m_Profiler, "read", "bytes_read", "read_mus");
+        }
+        transport->AddMetrics(metrics, prefix);
+    }
+}
+
 void TransportMan::WriteFiles(const char *buffer, const size_t size, const int transportIndex)
 {
     if (transportIndex == -1)
@@ -409,6 +436,14 @@ void TransportMan::ReadFile(char *buffer, const size_t size, const size_t start,
     itTransport->second->Read(buffer, size, start);
 }
 
+void TransportMan::ReadFileV(const Transport::ReadRange *ranges, const size_t count,
+                             const size_t transportIndex)
+{
+    auto itTransport = m_Transports.find(transportIndex);
+    CheckFile(itTransport, ", in call to ReadFileV with index " + std::to_string(transportIndex));
+    itTransport->second->ReadV(ranges, count);
+}
+
 void TransportMan::SetParameters(const Params &params, const int transportIndex)
 {
     if (transportIndex == -1)
@@ -10,6 +10,7 @@
 #define ADIOS2_TOOLKIT_TRANSPORT_TRANSPORTMANAGER_H_
 
 #include <future> //std::async, std::future
+#include <map>
 #include <memory> //std::shared_ptr
 #include <string>
 #include <unordered_map>
@@ -121,6 +122,14 @@ public:
      * m_Transports.m_Profiler */
     std::vector<profiling::IOChrono *> GetTransportsProfilers() noexcept;
 
+    /**
+     * Adds the bytes and time written and read by all transports to metrics
+     * (prefix + "bytes_written", "write_mus", "bytes_read", "read_mus") and
+     * the counters of each transport's AddMetrics. Values are summed into
+     * existing keys so several managers can share a prefix.
+     */
+    void AddMetrics(std::map<std::string, double> &metrics, const std::string &prefix) const;
+
     /**
      * Write to file transports
      * @param transportIndex
@@ -169,6 +178,15 @@ public:
     void ReadFile(char *buffer, const size_t size, const size_t start = 0,
                   const size_t transportIndex = 0);
 
+    /**
+     * Read several ranges from a single file, see Transport::ReadV
+     * @param ranges
+     * @param count
+     * @param transportIndex
+     */
+    void ReadFileV(const Transport::ReadRange *ranges, const size_t count,
+                   const size_t transportIndex = 0);
+
     /**
      * Flush file or files depending on transport index. Throws an exception
      * if transport is not a file when transportIndex > -1.
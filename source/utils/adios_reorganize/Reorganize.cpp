@@ -19,7 +19,10 @@
 
 #include "Reorganize.h"
 
+#include <algorithm>
 #include <assert.h>
+#include <functional>
+#include <future>
 #include <iomanip>
 #include <string>
 
@@ -74,10 +77,25 @@ Reorganize::Reorganize(int argc, char *argv[]) : Utils("adios_reorganize", argc,
     wmethodparam_str = std::string(argv[6]);
 
     int nd = 0;
-    int j = 7;
     char *end;
-    while (argc > j && j < 13)
-    { // get max 6 dimensions
+    for (int j = 7; j < argc; ++j)
+    {
+        const std::string arg(argv[j]);
+        if (arg.compare(0, 2, "--") == 0)
+        {
+            ParseOption(arg);
+            continue;
+        }
+        if (arg == "auto")
+        {
+            m_AutoDecomposition = true;
+            continue;
+        }
+        if (nd == 6)
+        {
+            helper::Throw<std::invalid_argument>("Utils", "AdiosReorganize", "Reorganize",
+                                                 "Up to 6 decomposition arguments are supported");
+        }
         errno = 0;
         decomp_values[nd] = std::strtol(argv[j], &end, 10);
         if (errno || (end != 0 && *end != '\0'))
@@ -88,13 +106,14 @@ Reorganize::Reorganize(int argc, char *argv[]) : Utils("adios_reorganize", argc,
             helper::Throw<std::invalid_argument>("Utils", "AdiosReorganize", "Reorganize", errmsg);
         }
         nd++;
-        j++;
     }
 
-    if (argc > j)
+    if (m_AutoDecomposition && nd > 0)
     {
-        helper::Throw<std::invalid_argument>("Utils", "AdiosReorganize", "Reorganize",
-                                             "Up to 6 decomposition arguments are supported");
+        PrintUsage();
+        helper::Throw<std::invalid_argument>(
+            "Utils", "AdiosReorganize", "Reorganize",
+            "auto decomposition cannot be combined with decomposition numbers");
     }
 
     int prod = 1;
@@ -115,6 +134,8 @@ Reorganize::Reorganize(int argc, char *argv[]) : Utils("adios_reorganize", argc,
     }
 }
 
+std::vector<VarInfo> varinfo;
+
 void Reorganize::Run()
 {
     ParseArguments();
@@ -127,9 +148,18 @@ void Reorganize::Run()
     print0("Read method parameters  = ", rmethodparam_str);
     print0("Write method            = ", wmethodname);
     print0("Write method parameters = ", wmethodparam_str);
+    print0("Decomposition           = ", (m_AutoDecomposition ? "auto" : "fixed"));
+    print0("Pipelined read/write    = ", (m_Pipeline ? "on" : "off"));
+    if (!m_OperatorType.empty())
+    {
+        print0("Operator                = ", m_OperatorType);
+    }
 
     core::ADIOS adios(m_Comm.Duplicate(), "C++");
     core::IO &io = adios.DeclareIO("group");
+    // separate output IO so that writing a step does not touch the variables
+    // of the step being read
+    core::IO &wio = adios.DeclareIO("output");
 
     print0("Waiting to open stream ", infilename, "...");
 
@@ -138,10 +168,12 @@ void Reorganize::Run()
     core::Engine &rStream = io.Open(infilename, adios2::Mode::Read);
     // rStream.FixedSchedule();
 
-    io.ClearParameters();
-    io.SetEngine(wmethodname);
-    io.SetParameters(wmethodparams);
-    core::Engine &wStream = io.Open(outfilename, adios2::Mode::Write);
+    wio.SetEngine(wmethodname);
+    wio.SetParameters(wmethodparams);
+    core::Engine &wStream = wio.Open(outfilename, adios2::Mode::Write);
+
+    // step being written in the background
+    std::future<void> writeFuture;
 
     int steps = 0;
     int curr_step = -1;
@@ -199,13 +231,33 @@ void Reorganize::Run()
         if (retval)
             break;
 
-        retval = ReadWrite(rStream, wStream, io, variables, steps);
+        retval = Read(rStream, variables);
         if (retval)
             break;
 
-        CleanUpStep(io);
+        // the output IO is free again once the previous step is written
+        if (writeFuture.valid())
+        {
+            writeFuture.get();
+        }
+        DefineOutput(io, wio, varinfo);
+        if (m_Pipeline)
+        {
+            writeFuture = std::async(std::launch::async, &Reorganize::Write, this,
+                                     std::ref(wStream), std::move(varinfo));
+        }
+        else
+        {
+            Write(wStream, std::move(varinfo));
+        }
+        varinfo.clear();
     }
 
+    if (writeFuture.valid())
+    {
+        writeFuture.get();
+    }
+    CleanUpStep(varinfo);
     rStream.Close();
     wStream.Close();
     print0("Bye after processing ", steps, " steps");
@@ -256,8 +308,48 @@ void Reorganize::ParseArguments()
     wmethodparams = parseParams(wmethodparam_str);
 }
 
+void Reorganize::ParseOption(const std::string &arg)
+{
+    const size_t eq = arg.find('=');
+    const std::string key = arg.substr(0, eq);
+    const std::string value = (eq == std::string::npos ? "" : arg.substr(eq + 1));
+    if (key == "--pipeline")
+    {
+        m_Pipeline = helper::StringTo<bool>(value, "in --pipeline option");
+    }
+    else if (key == "--operator")
+    {
+        m_OperatorType = value;
+    }
+    else if (key == "--operator-params")
+    {
+        m_OperatorParams = parseParams(value);
+    }
+    else if (key == "--chunk-size")
+    {
+        m_ChunkSize = helper::StringToByteUnits(helper::LowerCase(value), "in --chunk-size option");
+    }
+    else
+    {
+        PrintUsage();
+        helper::Throw<std::invalid_argument>("Utils", "AdiosReorganize", "ParseOption",
+                                             "Unknown option " + arg);
+    }
+}
+
 void Reorganize::ProcessParameters()
 {
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Query_thread(&provided);
+    if (m_Pipeline && provided < MPI_THREAD_MULTIPLE)
+    {
+        // reading and writing at the same time calls MPI from two threads
+        print0("MPI does not support MPI_THREAD_MULTIPLE, pipelining is turned off");
+        m_Pipeline = false;
+    }
+#endif
+
     if (rmethodname.empty())
     {
         handleAsStream = false;
@@ -300,7 +392,19 @@ void Reorganize::PrintUsage() const noexcept
                  "values,\n"
                  "            will be decomposed with using the appropriate number "
                  "of\n"
-                 "            values."
+                 "            values.\n"
+                 "            auto: distribute the blocks of the input among the\n"
+                 "            processes so that each one reads and writes about the\n"
+                 "            same amount of data. Blocks are split if needed.\n"
+                 "Options (after the parameters):\n"
+                 "    --pipeline=on|off       Read the next step while writing the\n"
+                 "                            previous one (default on)\n"
+                 "    --chunk-size=<size>     Max size of an output block with auto\n"
+                 "                            decomposition, e.g. 1GB\n"
+                 "    --operator=<type>       Operator to apply to every output array,\n"
+                 "                            e.g. blosc, zfp, sz (not to arrays\n"
+                 "                            with a global size below 4KB)\n"
+                 "    --operator-params=\"..\" Operator parameters (comma-separated list)"
               << std::endl;
 }
 
@@ -308,28 +412,27 @@ void Reorganize::PrintExamples() const noexcept {}
 
 void Reorganize::SetParameters(const std::string argument, const bool isLong) {}
 
-std::vector<VarInfo> varinfo;
-
-// cleanup all info from previous step except
+// cleanup all info from a step
 // do
-//   remove all variable and attribute definitions from output group
 //   free all varinfo (will be inquired again at next step)
-//   free read buffer (required size may change at next step)
+//   free read buffers (required size may change at next step)
 // do NOT
-//   destroy group
+//   remove variable and attribute definitions from the output group
 //
-void Reorganize::CleanUpStep(core::IO &io)
+void Reorganize::CleanUpStep(std::vector<VarInfo> &vars)
 {
-    for (auto &vi : varinfo)
+    for (auto &vi : vars)
     {
-        if (vi.readbuf != nullptr)
+        for (auto &b : vi.blocks)
         {
-            free(vi.readbuf);
+            if (b.readbuf != nullptr)
+            {
+                free(b.readbuf);
+                b.readbuf = nullptr;
+            }
         }
     }
-    varinfo.clear();
-    // io.RemoveAllVariables();
-    // io.RemoveAllAttributes();
+    vars.clear();
 }
 
 template <typename T>
@@ -360,13 +463,14 @@ size_t Reorganize::Decompose(int numproc, int rank, VarInfo &vi,
     {
         if (rank == 0)
         {
+            VarBlock b;
             writesize = 1;
             for (size_t i = 0; i < vi.v->m_Count.size(); i++)
             {
                 writesize *= vi.v->m_Count[i];
-                // vi.start.push_back(0);
-                vi.count.push_back(vi.v->m_Count[i]);
+                b.count.push_back(vi.v->m_Count[i]);
             }
+            vi.blocks.push_back(b);
         }
         else
         {
@@ -375,14 +479,17 @@ size_t Reorganize::Decompose(int numproc, int rank, VarInfo &vi,
         return writesize;
     }
 
-    size_t ndim = vi.v->Shape().size();
+    size_t ndim = vi.shape.size();
 
     /* Scalars */
     if (ndim == 0)
     {
         // scalars -> rank 0 writes them
         if (rank == 0)
+        {
             writesize = 1;
+            vi.blocks.push_back(VarBlock());
+        }
         else
             writesize = 0;
         return writesize;
@@ -412,8 +519,9 @@ size_t Reorganize::Decompose(int numproc, int rank, VarInfo &vi,
     */
     int nps = 1;
     std::vector<int> pos(ndim); // rank's position in each dimensions
-    vi.start.reserve(ndim);
-    vi.count.reserve(ndim);
+    VarBlock b;
+    b.start.reserve(ndim);
+    b.count.reserve(ndim);
 
     size_t i = 0;
     for (i = 0; i < ndim - 1; i++)
@@ -448,24 +556,161 @@ size_t Reorganize::Decompose(int numproc, int rank, VarInfo &vi,
         }
         else
         {
-            count = vi.v->Shape()[i] / np[i];
+            count = vi.shape[i] / np[i];
             start = count * pos[i];
             if (pos[i] == np[i] - 1)
             {
                 // last one in the dimension may need to read more than the rest
-                count = vi.v->Shape()[i] - count * (np[i] - 1);
+                count = vi.shape[i] - count * (np[i] - 1);
             }
         }
-        vi.start.push_back(start);
-        vi.count.push_back(count);
+        b.start.push_back(start);
+        b.count.push_back(count);
         writesize *= count;
     }
-    ints = VectorToString(vi.count);
+    ints = VectorToString(b.count);
     std::cout << "rank " << rank << ": ldims in " << ndim << "-D space = {" << ints << "}"
               << std::endl;
-    ints = VectorToString(vi.start);
+    ints = VectorToString(b.start);
     std::cout << "rank " << rank << ": offsets in " << ndim << "-D space = {" << ints << "}"
               << std::endl;
+    if (writesize)
+    {
+        vi.blocks.push_back(b);
+    }
+    return writesize;
+}
+
+template <class T>
+std::vector<VarBlock> Reorganize::InputBlocks(core::Engine &rStream, core::Variable<T> &variable)
+{
+    std::vector<VarBlock> blocks;
+    const bool isLocal = (variable.m_ShapeID == adios2::ShapeID::LocalArray);
+    MinVarInfo *minBlocks = rStream.MinBlocksInfo(variable, rStream.CurrentStep());
+    if (minBlocks)
+    {
+        const size_t ndim = static_cast<size_t>(minBlocks->Dims);
+        for (const auto &mb : minBlocks->BlocksInfo)
+        {
+            VarBlock b;
+            b.blockID = mb.BlockID;
+            if (minBlocks->WasLocalValue)
+            {
+                b.start = {reinterpret_cast<size_t>(mb.Start)};
+                b.count = {reinterpret_cast<size_t>(mb.Count)};
+            }
+            else
+            {
+                b.count.assign(mb.Count, mb.Count + ndim);
+                if (!isLocal)
+                {
+                    b.start.assign(mb.Start, mb.Start + ndim);
+                }
+            }
+            blocks.push_back(b);
+        }
+        delete minBlocks;
+        return blocks;
+    }
+
+    const auto coreBlocks = rStream.BlocksInfo(variable, rStream.CurrentStep());
+    for (const auto &cb : coreBlocks)
+    {
+        VarBlock b;
+        b.blockID = cb.BlockID;
+        b.count = cb.Count;
+        if (!isLocal)
+        {
+            b.start = cb.Start;
+        }
+        blocks.push_back(b);
+    }
+    return blocks;
+}
+
+size_t Reorganize::DecomposeBalanced(int numproc, int rank, VarInfo &vi,
+                                     const std::vector<VarBlock> &inputBlocks)
+{
+    const bool isLocal = (vi.v->m_ShapeID == adios2::ShapeID::LocalArray);
+    const size_t elemsize = vi.v->m_ElementSize;
+
+    std::vector<VarBlock> pieces;
+    size_t total = 0;
+    for (const auto &b : inputBlocks)
+    {
+        total += helper::GetTotalSize(b.count) * elemsize;
+    }
+    if (total == 0)
+    {
+        return 0;
+    }
+
+    size_t target = (total + numproc - 1) / numproc;
+    if (m_ChunkSize > 0 && m_ChunkSize < target)
+    {
+        target = m_ChunkSize;
+    }
+
+    for (const auto &b : inputBlocks)
+    {
+        const size_t bytes = helper::GetTotalSize(b.count) * elemsize;
+        if (bytes == 0)
+        {
+            continue;
+        }
+        // split a global array block along its slowest dimension
+        if (isLocal || bytes <= target || b.count[0] < 2)
+        {
+            pieces.push_back(b);
+            pieces.back().writesize = bytes;
+            continue;
+        }
+        const size_t nparts = std::min((bytes + target - 1) / target, b.count[0]);
+        const size_t rows = b.count[0] / nparts;
+        size_t offset = 0;
+        for (size_t k = 0; k < nparts; ++k)
+        {
+            VarBlock p = b;
+            p.start[0] = b.start[0] + offset;
+            p.count[0] = (k == nparts - 1 ? b.count[0] - offset : rows);
+            p.writesize = helper::GetTotalSize(p.count) * elemsize;
+            offset += p.count[0];
+            pieces.push_back(p);
+        }
+    }
+
+    /* Largest piece first to the least loaded process. Every process
+       computes the same assignment, no communication needed. */
+    std::vector<size_t> order(pieces.size());
+    for (size_t i = 0; i < order.size(); ++i)
+    {
+        order[i] = i;
+    }
+    std::stable_sort(order.begin(), order.end(), [&pieces](size_t a, size_t b) {
+        return pieces[a].writesize > pieces[b].writesize;
+    });
+    std::vector<size_t> load(numproc, 0);
+    std::vector<int> owner(pieces.size());
+    for (const size_t i : order)
+    {
+        const int p =
+            static_cast<int>(std::min_element(load.begin(), load.end()) - load.begin());
+        owner[i] = p;
+        load[p] += pieces[i].writesize;
+    }
+
+    size_t writesize = 0;
+    for (size_t i = 0; i < pieces.size(); ++i)
+    {
+        if (owner[i] == rank)
+        {
+            writesize += helper::GetTotalSize(pieces[i].count);
+            vi.blocks.push_back(pieces[i]);
+        }
+    }
+    std::cout << "rank " << rank << ": " << vi.blocks.size() << " of " << pieces.size()
+              << " blocks of " << vi.name << ", " << writesize * elemsize << " of " << total
+              << " bytes" << std::endl;
     return writesize;
 }
 
@@ -487,6 +732,7 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
         core::VariableBase *variable = nullptr;
         print0("Get info on variable ", varidx, ": ", name);
         size_t nBlocks = 1;
+        std::vector<VarBlock> inputBlocks;
 
         if (type == DataType::Struct)
         {
@@ -496,19 +742,11 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
         core::Variable<T> *v = io.InquireVariable<T>(variablePair.first);                          \
-        if (v->m_ShapeID == adios2::ShapeID::LocalArray)                                           \
+        if (v->m_ShapeID == adios2::ShapeID::LocalArray ||                                         \
+            (m_AutoDecomposition && v->m_ShapeID == adios2::ShapeID::GlobalArray))                 \
         {                                                                                          \
-                                                                                                   \
-            const auto minBlocks = rStream.MinBlocksInfo(*v, step);                                \
-            if (minBlocks)                                                                         \
-            {                                                                                      \
-                nBlocks = minBlocks->BlocksInfo.size();                                            \
-            }                                                                                      \
-            else                                                                                   \
-            {                                                                                      \
-                auto blocks = rStream.BlocksInfo(*v, rStream.CurrentStep());                       \
-                nBlocks = blocks.size();                                                           \
-            }                                                                                      \
+            inputBlocks = InputBlocks(rStream, *v);                                                \
+            nBlocks = inputBlocks.size();                                                          \
         }                                                                                          \
         variable = v;                                                                              \
     }
@@ -519,6 +757,8 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
 
         if (variable != nullptr)
         {
+            varinfo[varidx].name = name;
+            varinfo[varidx].shape = variable->Shape();
 
             // print variable type and dimensions
             if (!m_Rank)
@@ -546,11 +786,11 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
             else if (variable->m_ShapeID == adios2::ShapeID::LocalArray)
             {
                 print0("\t local array ");
-                if (nBlocks > 1)
+                if (nBlocks > 1 && !m_AutoDecomposition)
                 {
                     print0("ERROR: adios_reorganize does not support Local Arrays "
                            "except when there is only 1 written block in each "
-                           "step. This one has ",
+                           "step or with auto decomposition. This one has ",
                            nBlocks, " blocks in this step ");
                     return 1;
                 }
@@ -562,15 +802,24 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
             }
 
             // determine subset we will write
-            size_t sum_count = Decompose(m_Size, m_Rank, varinfo[varidx], decomp_values);
+            size_t sum_count;
+            if (m_AutoDecomposition && variable->m_ShapeID != adios2::ShapeID::GlobalValue)
+            {
+                sum_count = DecomposeBalanced(m_Size, m_Rank, varinfo[varidx], inputBlocks);
+            }
+            else
+            {
+                sum_count = Decompose(m_Size, m_Rank, varinfo[varidx], decomp_values);
+            }
             varinfo[varidx].writesize = sum_count * variable->m_ElementSize;
 
-            if (varinfo[varidx].writesize != 0)
+            for (auto &b : varinfo[varidx].blocks)
             {
-                write_total += varinfo[varidx].writesize;
-                if (largest_block < varinfo[varidx].writesize)
-                    largest_block = varinfo[varidx].writesize;
+                b.writesize = helper::GetTotalSize(b.count) * variable->m_ElementSize;
+                if (largest_block < b.writesize)
+                    largest_block = b.writesize;
             }
+            write_total += varinfo[varidx].writesize;
         }
         else
         {
@@ -601,15 +850,14 @@ int Reorganize::ProcessMetadata(core::Engine &rStream, core::IO &io, const core:
     return retval;
 }
 
-int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO &io,
-                          const core::VarMap &variables, int step)
+int Reorganize::Read(core::Engine &rStream, const core::VarMap &variables)
 {
     int retval = 0;
 
     size_t nvars = variables.size();
     if (nvars != varinfo.size())
     {
-        helper::Log("Util", "Reorganize", "ReadWrite",
+        helper::Log("Util", "Reorganize", "Read",
                     "Invalid program state, number of variables (" + std::to_string(nvars) +
                         ") to read does not match the number of processed variables (" +
                         std::to_string(varinfo.size()) + ")",
@@ -621,15 +869,15 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO
      */
     for (size_t varidx = 0; varidx < nvars; ++varidx)
     {
-        if (varinfo[varidx].v != nullptr)
+        VarInfo &vi = varinfo[varidx];
+        if (vi.v != nullptr && vi.writesize != 0)
         {
-            const std::string &name = varinfo[varidx].v->m_Name;
-            assert(varinfo[varidx].readbuf == nullptr);
-            if (varinfo[varidx].writesize != 0)
+            // read variable subset
+            std::cout << "rank " << m_Rank << ": Read variable " << vi.name << std::endl;
+            const DataType type = vi.v->m_Type;
+            for (auto &b : vi.blocks)
             {
-                // read variable subset
-                std::cout << "rank " << m_Rank << ": Read variable " << name << std::endl;
-                const DataType type = variables.at(name)->m_Type;
+                assert(b.readbuf == nullptr);
                 if (type == DataType::Struct)
                 {
                     // not supported
@@ -637,16 +885,24 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO
 #define declare_template_instantiation(T)                                                          \
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        varinfo[varidx].readbuf = calloc(1, varinfo[varidx].writesize);                            \
-        if (varinfo[varidx].count.size() == 0)                                                     \
+        core::Variable<T> *v = dynamic_cast<core::Variable<T> *>(vi.v);                            \
+        b.readbuf = calloc(1, b.writesize);                                                        \
+        if (b.count.size() == 0)                                                                   \
         {                                                                                          \
-            rStream.Get<T>(name, reinterpret_cast<T *>(varinfo[varidx].readbuf),                   \
-                           adios2::Mode::Sync);                                                    \
+            rStream.Get<T>(*v, reinterpret_cast<T *>(b.readbuf), adios2::Mode::Sync);              \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
-            varinfo[varidx].v->SetSelection({varinfo[varidx].start, varinfo[varidx].count});       \
-            rStream.Get<T>(name, reinterpret_cast<T *>(varinfo[varidx].readbuf));                  \
+            if (v->m_ShapeID == adios2::ShapeID::LocalArray)                                       \
+            {                                                                                      \
+                v->SetBlockSelection(b.blockID);                                                   \
+                v->SetSelection({Dims(b.count.size(), 0), b.count});                               \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                v->SetSelection({b.start, b.count});                                               \
+            }                                                                                      \
+            rStream.Get<T>(*v, reinterpret_cast<T *>(b.readbuf));                                  \
         }                                                                                          \
     }
                 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
@@ -655,21 +911,104 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO
         }
     }
     rStream.EndStep(); // read in data into allocated pointers
+    return retval;
+}
 
+void Reorganize::DefineOutput(core::IO &io, core::IO &wio, std::vector<VarInfo> &vars)
+{
+    for (auto &vi : vars)
+    {
+        if (vi.v == nullptr)
+        {
+            continue;
+        }
+        const DataType type = vi.v->m_Type;
+        if (type == DataType::Struct)
+        {
+            // not supported
+        }
+#define declare_template_instantiation(T)                                                          \
+    else if (type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        core::Variable<T> *wv = wio.InquireVariable<T>(vi.name);                                   \
+        if (wv == nullptr)                                                                         \
+        {                                                                                          \
+            if (vi.v->m_ShapeID == adios2::ShapeID::GlobalArray)                                   \
+            {                                                                                      \
+                wv = &wio.DefineVariable<T>(vi.name, vi.shape, Dims(vi.shape.size(), 0),           \
+                                            vi.shape);                                             \
+            }                                                                                      \
+            else if (vi.v->m_ShapeID == adios2::ShapeID::LocalArray)                               \
+            {                                                                                      \
+                wv = &wio.DefineVariable<T>(vi.name, {}, {}, vi.v->m_Count);                       \
+            }                                                                                      \
+            else                                                                                   \
+            {                                                                                      \
+                wv = &wio.DefineVariable<T>(vi.name);                                              \
+            }                                                                                      \
+            if (!m_OperatorType.empty() && vi.v->m_ShapeID != adios2::ShapeID::GlobalValue &&      \
+                type != DataType::String &&                                                        \
+                helper::GetTotalSize(wv->m_Count) * wv->m_ElementSize >= m_OperatorMinSize)        \
+            {                                                                                      \
+                wv->AddOperation(m_OperatorType, m_OperatorParams);                                \
+            }                                                                                      \
+        }                                                                                          \
+        else if (vi.v->m_ShapeID == adios2::ShapeID::GlobalArray && wv->m_Shape != vi.shape)       \
+        {                                                                                          \
+            wv->SetShape(vi.shape);                                                                \
+        }                                                                                          \
+        vi.wv = wv;                                                                                \
+    }
+        ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+    }
+
+    // attributes are expected to be the same in every step, copy new ones
+    for (const auto &attributePair : io.GetAttributes())
+    {
+        const std::string &name = attributePair.first;
+        const DataType type = attributePair.second->m_Type;
+        if (wio.GetAttributes().count(name) != 0)
+        {
+            continue;
+        }
+        if (type == DataType::Struct)
+        {
+            // not supported
+        }
+#define declare_template_instantiation(T)                                                          \
+    else if (type == helper::GetDataType<T>())                                                     \
+    {                                                                                              \
+        const core::Attribute<T> *a = io.InquireAttribute<T>(name);                                \
+        if (a->m_IsSingleValue)                                                                    \
+        {                                                                                          \
+            wio.DefineAttribute<T>(name, a->m_DataSingleValue);                                    \
+        }                                                                                          \
+        else                                                                                       \
+        {                                                                                          \
+            wio.DefineAttribute<T>(name, a->m_DataArray.data(), a->m_DataArray.size());            \
+        }                                                                                          \
+    }
+        ADIOS2_FOREACH_ATTRIBUTE_STDTYPE_1ARG(declare_template_instantiation)
+#undef declare_template_instantiation
+    }
+}
+
+void Reorganize::Write(core::Engine &wStream, std::vector<VarInfo> vars)
+{
     /*
      * Write all variables
      */
     wStream.BeginStep();
-    for (size_t varidx = 0; varidx < nvars; ++varidx)
+    for (auto &vi : vars)
     {
-        if (varinfo[varidx].v != nullptr)
+        if (vi.wv != nullptr && vi.writesize != 0)
         {
-            const std::string &name = varinfo[varidx].v->m_Name;
-            if (varinfo[varidx].writesize != 0)
+            // Write variable subset
+            std::cout << "rank " << m_Rank << ": Write variable " << vi.name << std::endl;
+            const DataType type = vi.wv->m_Type;
+            for (auto &b : vi.blocks)
             {
-                // Write variable subset
-                std::cout << "rank " << m_Rank << ": Write variable " << name << std::endl;
-                const DataType type = variables.at(name)->m_Type;
                 if (type == DataType::Struct)
                 {
                     // not supported
@@ -677,20 +1016,20 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO
 #define declare_template_instantiation(T)                                                          \
     else if (type == helper::GetDataType<T>())                                                     \
     {                                                                                              \
-        if (varinfo[varidx].count.size() == 0)                                                     \
+        core::Variable<T> *wv = dynamic_cast<core::Variable<T> *>(vi.wv);                          \
+        if (b.count.size() == 0)                                                                   \
         {                                                                                          \
-            wStream.Put<T>(name, reinterpret_cast<T *>(varinfo[varidx].readbuf),                   \
-                           adios2::Mode::Sync);                                                    \
+            wStream.Put<T>(*wv, reinterpret_cast<T *>(b.readbuf), adios2::Mode::Sync);             \
         }                                                                                          \
-        else if (varinfo[varidx].v->m_ShapeID == adios2::ShapeID::LocalArray)                      \
+        else if (wv->m_ShapeID == adios2::ShapeID::LocalArray)                                     \
         {                                                                                          \
-            wStream.Put<T>(name, reinterpret_cast<T *>(varinfo[varidx].readbuf),                   \
-                           adios2::Mode::Sync);                                                    \
+            wv->SetSelection({{}, b.count});                                                       \
+            wStream.Put<T>(*wv, reinterpret_cast<T *>(b.readbuf), adios2::Mode::Sync);             \
         }                                                                                          \
         else                                                                                       \
         {                                                                                          \
-            varinfo[varidx].v->SetSelection({varinfo[varidx].start, varinfo[varidx].count});       \
-            wStream.Put<T>(name, reinterpret_cast<T *>(varinfo[varidx].readbuf));                  \
+            wv->SetSelection({b.start, b.count});                                                  \
+            wStream.Put<T>(*wv, reinterpret_cast<T *>(b.readbuf));                                 \
         }                                                                                          \
     }
                 ADIOS2_FOREACH_STDTYPE_1ARG(declare_template_instantiation)
@@ -699,7 +1038,7 @@ int Reorganize::ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO
         }
     }
     wStream.EndStep(); // write output buffer to file
-    return retval;
+    CleanUpStep(vars);
 }
 
 } // end namespace utils
@@ -11,25 +11,39 @@
 #ifndef UTILS_REORGANIZE_REORGANIZE_H_
 #define UTILS_REORGANIZE_REORGANIZE_H_
 
+#include "adios2/core/Engine.h"
 #include "adios2/core/IO.h"
 #include "adios2/helper/adiosComm.h"
 #include "utils/Utils.h"
 
+#include <string>
+#include <vector>
+
 namespace adios2
 {
 namespace utils
 {
 
-struct VarInfo
+/* One box of a variable that this process reads and then writes as one block */
+struct VarBlock
 {
-    core::VariableBase *v = nullptr;
-    std::string type;
     Dims start;
     Dims count;
-    size_t writesize = 0;    // size of subset this process writes, 0: do not write
+    size_t blockID = 0;      // block to read for local arrays
+    size_t writesize = 0;    // size in bytes
     void *readbuf = nullptr; // read in buffer
 };
 
+struct VarInfo
+{
+    core::VariableBase *v = nullptr;  // variable in the input
+    core::VariableBase *wv = nullptr; // variable in the output
+    std::string name;
+    Dims shape;                  // shape in this step
+    std::vector<VarBlock> blocks; // boxes this process reads and writes
+    size_t writesize = 0;         // size of all boxes, 0: do not write
+};
+
 class Reorganize : public Utils
 {
 public:
@@ -52,7 +66,7 @@ private:
     void PrintExamples() const noexcept final;
     void SetParameters(const std::string argument, const bool isLong) final;
 
-    void CleanUpStep(core::IO &io);
+    void CleanUpStep(std::vector<VarInfo> &vars);
 
     template <typename T>
     std::string VectorToString(const T &v);
@@ -60,11 +74,22 @@ private:
     size_t Decompose(int numproc, int rank, VarInfo &vi,
                      const int *np // number of processes in each dimension
     );
+    /** assign the input blocks to processes so that each one gets about the
+     * same number of bytes, splitting blocks larger than the average */
+    size_t DecomposeBalanced(int numproc, int rank, VarInfo &vi,
+                             const std::vector<VarBlock> &inputBlocks);
+    template <class T>
+    std::vector<VarBlock> InputBlocks(core::Engine &rStream, core::Variable<T> &variable);
     int ProcessMetadata(core::Engine &rStream, core::IO &io, const core::VarMap &variables,
                         const core::AttrMap &attributes, int step);
-    int ReadWrite(core::Engine &rStream, core::Engine &wStream, core::IO &io,
-                  const core::VarMap &variables, int step);
+    int Read(core::Engine &rStream, const core::VarMap &variables);
+    /** define variables and attributes of the step in the output IO */
+    void DefineOutput(core::IO &io, core::IO &wio, std::vector<VarInfo> &vars);
+    /** write one step and free its buffers, runs in the background when
+     * pipelining */
+    void Write(core::Engine &wStream, std::vector<VarInfo> vars);
     Params parseParams(const std::string &param_str);
+    void ParseOption(const std::string &arg);
 
     // Input arguments
     std::string infilename;       // File/stream to read
@@ -99,6 +124,18 @@ private:
     bool handleAsStream = true;
 
     int decomp_values[10] = {1, 1, 1, 1, 1, 1, 1, 1, 1, 1};
+    // balance bytes per process using the blocks in the input
+    bool m_AutoDecomposition = false;
+    // read the next step while writing the previous one
+    bool m_Pipeline = true;
+    // max size of an output block in automatic decomposition, 0: no limit
+    size_t m_ChunkSize = 0;
+    // operator applied to every output array
+    std::string m_OperatorType;
+    Params m_OperatorParams;
+    // arrays smaller than this are not compressed: the global array size (or
+    // the block size of a local array) when the output variable is defined
+    static const size_t m_OperatorMinSize = 4096;
 
     template <typename Arg, typename... Args>
     void print0(Arg &&arg, Args &&...args);
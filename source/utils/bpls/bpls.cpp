@@ -27,6 +27,7 @@
 #include <fstream>
 #include <string>
 #include <thread>
+#include <type_traits>
 #include <vector>
 
 #include <errno.h>
@@ -106,6 +107,8 @@ int hidden_attrs_flag;   // to be passed on in option struct
 bool show_decomp;        // show decomposition of arrays
 bool show_version;       // print binary version info of file before work
 bool show_derived_expr;  // show the expression string for derived vars
+bool show_stats;         // print per-step statistics from metadata only
+int nthreads;            // number of threads to read data with
 adios2::Accuracy accuracy;
 bool accuracyWasSet = false;
 
@@ -177,6 +180,10 @@ void display_help()
            "file\n"
            "  --decomp    | -D           Show decomposition of variables as layed "
            "out in file\n"
+           "  --stats                    Print number of blocks and min/max of each "
+           "step\n"
+           "                               from metadata only (no data is read)\n"
+           "  --threads   | -j N         Read data with N threads when dumping\n"
            "  --error     | -X string    Specify read accuracy (error,norm,rel|abs)\n"
            "                             e.g. error=\"0.0,0.0,abs\"\n"
            "                             L2 norm = 0.0, Linf = inf\n"
@@ -647,6 +654,11 @@ int bplsMain(int argc, char *argv[])
     arg.AddBooleanArgument("--decompose", &show_decomp,
                            "| -D Show decomposition of variables as layed out in file");
     arg.AddBooleanArgument("-D", &show_decomp, "");
+    arg.AddBooleanArgument("--stats", &show_stats,
+                           "Print number of blocks and min/max of each step from metadata");
+    arg.AddArgument("--threads", argT::SPACE_ARGUMENT, &nthreads,
+                    "| -j N    Read data with N threads when dumping");
+    arg.AddArgument("-j", argT::SPACE_ARGUMENT, &nthreads, "");
     arg.AddBooleanArgument("--version", &show_version,
                            "Print version information (add -verbose for additional"
                            " information)");
@@ -725,6 +737,9 @@ int bplsMain(int argc, char *argv[])
     if (attrsonly)
         listattrs = true;
 
+    if (nthreads < 1)
+        nthreads = 1;
+
     retval = parseAccuracy();
     if (retval)
         return retval;
@@ -791,6 +806,8 @@ void init_globals()
     show_decomp = false;
     show_version = false;
     show_derived_expr = false;
+    show_stats = false;
+    nthreads = 1;
     for (i = 0; i < MAX_DIMS; i++)
     {
         istart[i] = 0LL;
@@ -1278,6 +1295,11 @@ int printVariableInfo(core::Engine *fp, core::IO *io, core::Variable<T> *variabl
                 print_decomp(fp, io, variable);
             }
         }
+
+        if (show_stats)
+        {
+            print_stats(fp, io, variable);
+        }
     }
     else
     {
@@ -1666,6 +1688,12 @@ int doList(std::string path)
         engineList.push_back(engine_name);
     }
 
+    if (nthreads > 1)
+    {
+        // BP5 reads the deferred Gets of one PerformGets with this many threads
+        io.SetParameter("Threads", std::to_string(nthreads));
+    }
+
     if (!engine_params.empty())
     {
         auto p = helper::BuildParametersMap(engine_params, '=', ',');
@@ -1972,6 +2000,33 @@ int getTypeInfo(DataType adiosvartype, int *elemsize)
     return 0;
 }
 
+/** Queue a deferred Get of the current selection of a variable into a new slice */
+template <class T>
+void getDeferredSlice(core::Engine *fp, core::Variable<T> *variable,
+                      std::vector<DeferredSlice<T>> &slices, const uint64_t *s, const uint64_t *c,
+                      int tdims)
+{
+    slices.emplace_back();
+    DeferredSlice<T> &slice = slices.back();
+    std::copy(s, s + tdims, slice.s);
+    std::copy(c, c + tdims, slice.c);
+    slice.data.resize(variable->SelectionSize());
+    fp->Get(*variable, slice.data.data(), adios2::Mode::Deferred);
+}
+
+/** Perform the queued Gets and print the slices in order, then clear them */
+template <class T>
+void printDeferredSlices(core::Engine *fp, DataType vartype, std::vector<DeferredSlice<T>> &slices,
+                         int tdims, int *ndigits_dims)
+{
+    fp->PerformGets();
+    for (auto &slice : slices)
+    {
+        print_dataset(slice.data.data(), vartype, slice.s, slice.c, tdims, ndigits_dims);
+    }
+    slices.clear();
+}
+
 /** Read data of a variable and print
  * Return: 0: ok, != 0 on error
  */
@@ -2197,6 +2252,10 @@ int readVar(core::Engine *fp, core::IO *io, core::Variable<T> *variable)
             ndigits(start_t[j] + count_t[j] - 1); // -1: dim=100 results in 2 digits (0..99)
     }
 
+    // with threads, several slices are read at once with deferred Gets
+    std::vector<DeferredSlice<T>> slices;
+    slices.reserve(nthreads);
+
     // read until read all 'nelems' elements
     sum = 0;
     while (sum < nelems)
@@ -2247,11 +2306,22 @@ int readVar(core::Engine *fp, core::IO *io, core::Variable<T> *variable)
             variable->SetStepSelection({s[0], c[0]});
         }
 
-        dataV.resize(variable->SelectionSize());
-        fp->Get(*variable, dataV, adios2::Mode::Sync);
+        if (nthreads > 1)
+        {
+            getDeferredSlice(fp, variable, slices, s, c, tdims);
+            if (slices.size() == static_cast<size_t>(nthreads) || sum + actualreadn >= nelems)
+            {
+                printDeferredSlices(fp, variable->m_Type, slices, tdims, ndigits_dims);
+            }
+        }
+        else
+        {
+            dataV.resize(variable->SelectionSize());
+            fp->Get(*variable, dataV, adios2::Mode::Sync);
 
-        // print slice
-        print_dataset(dataV.data(), variable->m_Type, s, c, tdims, ndigits_dims);
+            // print slice
+            print_dataset(dataV.data(), variable->m_Type, s, c, tdims, ndigits_dims);
+        }
 
         // prepare for next read
         sum += actualreadn;
@@ -2437,6 +2507,10 @@ int readVarBlock(core::Engine *fp, core::IO *io, core::Variable<T> *variable, si
             ndigits(start_t[j] + count_t[j] - 1); // -1: dim=100 results in 2 digits (0..99)
     }
 
+    // with threads, several slices are read at once with deferred Gets
+    std::vector<DeferredSlice<T>> slices;
+    slices.reserve(nthreads);
+
     // read until read all 'nelems' elements
     sum = 0;
     while (sum < nelems)
@@ -2510,10 +2584,21 @@ int readVarBlock(core::Engine *fp, core::IO *io, core::Variable<T> *variable, si
             variable->SetStepSelection({step, 1});
         }
 
-        dataV.resize(variable->SelectionSize());
-        fp->Get(*variable, dataV, adios2::Mode::Sync);
-        // print slice
-        print_dataset(dataV.data(), variable->m_Type, s, c, ndim, ndigits_dims);
+        if (nthreads > 1)
+        {
+            getDeferredSlice(fp, variable, slices, s, c, ndim);
+            if (slices.size() == static_cast<size_t>(nthreads) || sum + actualreadn >= nelems)
+            {
+                printDeferredSlices(fp, variable->m_Type, slices, ndim, ndigits_dims);
+            }
+        }
+        else
+        {
+            dataV.resize(variable->SelectionSize());
+            fp->Get(*variable, dataV, adios2::Mode::Sync);
+            // print slice
+            print_dataset(dataV.data(), variable->m_Type, s, c, ndim, ndigits_dims);
+        }
 
         // prepare for next read
         sum += actualreadn;
@@ -3899,6 +3984,127 @@ void print_decomp_singlestep(core::Engine *fp, core::IO *io, core::Variable<T> *
         delete minBlocks;
 }
 
+/* min/max only make sense for ordered types, others only print block counts */
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+stats_add(const T &bmin, const T &bmax, T &min, T &max, bool &valid)
+{
+    if (bmin > bmax)
+    {
+        // block without statistics
+        return;
+    }
+    if (!valid || bmin < min)
+        min = bmin;
+    if (!valid || bmax > max)
+        max = bmax;
+    valid = true;
+}
+
+template <class T>
+typename std::enable_if<!std::is_arithmetic<T>::value>::type
+stats_add(const T &, const T &, T &, T &, bool &)
+{
+}
+
+template <class T>
+typename std::enable_if<std::is_arithmetic<T>::value>::type
+stats_add(const MinMaxStruct &mm, T &min, T &max, bool &valid)
+{
+    stats_add(*reinterpret_cast<const T *>(&mm.MinUnion),
+              *reinterpret_cast<const T *>(&mm.MaxUnion), min, max, valid);
+}
+
+template <class T>
+typename std::enable_if<!std::is_arithmetic<T>::value>::type
+stats_add(const MinMaxStruct &, T &, T &, bool &)
+{
+}
+
+template <class T>
+void print_stats_step(DataType adiosvartype, const int ndigits_nsteps, const size_t step,
+                      const size_t nblocks, const T &min, const T &max, const bool valid)
+{
+    fprintf(outf, "%c       step %*zu: %zu blocks", commentchar, ndigits_nsteps, step, nblocks);
+    if (valid)
+    {
+        fprintf(outf, " = ");
+        print_data(&min, 0, adiosvartype, false);
+        fprintf(outf, " / ");
+        print_data(&max, 0, adiosvartype, false);
+    }
+    fprintf(outf, "\n");
+}
+
+template <class T>
+void print_stats(core::Engine *fp, core::IO *io, core::Variable<T> *variable)
+{
+    /* Print per-step block count and min/max, using metadata only */
+    const DataType adiosvartype = variable->m_Type;
+    const size_t nsteps = (timestep ? 1 : variable->m_AvailableStepsCount);
+
+    const size_t stepLast = (timestep ? fp->CurrentStep() : nsteps - 1);
+    MinVarInfo *mvi = fp->MinBlocksInfo(*variable, stepLast);
+    if (mvi)
+    {
+        const int ndigits_nsteps = ndigits(mvi->Step);
+        delete mvi;
+        for (size_t RelStep = 0; RelStep < nsteps; RelStep++)
+        {
+            mvi = fp->MinBlocksInfo(*variable, timestep ? stepLast : RelStep);
+            if (!mvi)
+            {
+                continue;
+            }
+            T min{}, max{};
+            bool valid = false;
+            for (const auto &b : mvi->BlocksInfo)
+            {
+                stats_add(b.MinMax, min, max, valid);
+            }
+            print_stats_step(adiosvartype, ndigits_nsteps, mvi->Step, mvi->BlocksInfo.size(),
+                             min, max, valid);
+            delete mvi;
+        }
+        return;
+    }
+
+    std::map<size_t, std::vector<typename core::Variable<T>::BPInfo>> allblocks;
+    if (timestep)
+    {
+        allblocks[fp->CurrentStep()] = fp->BlocksInfo(*variable, fp->CurrentStep());
+    }
+    else
+    {
+        allblocks = fp->AllStepsBlocksInfo(*variable);
+    }
+    if (allblocks.empty())
+    {
+        return;
+    }
+    const bool isValue = (variable->m_ShapeID == ShapeID::GlobalValue ||
+                          variable->m_ShapeID == ShapeID::LocalValue);
+    const int ndigits_nsteps = ndigits(allblocks.rbegin()->first);
+    for (const auto &blockpair : allblocks)
+    {
+        T min{}, max{};
+        bool valid = false;
+        for (const auto &b : blockpair.second)
+        {
+            if (isValue)
+            {
+                stats_add(b.Value, b.Value, min, max, valid);
+            }
+            else
+            {
+                stats_add(b.Min, b.Max, min, max, valid);
+            }
+        }
+        print_stats_step(adiosvartype, ndigits_nsteps, blockpair.first, blockpair.second.size(),
+                         min, max, valid);
+    }
+}
+
 int parseAccuracy()
 {
     if (accuracy_def.empty())
@@ -18,6 +18,7 @@
 
 #include <map>
 #include <string>
+#include <vector>
 
 namespace adios2
 {
@@ -38,6 +39,16 @@ namespace utils
 #define MAX_MASKS 10
 #define MAX_BUFFERSIZE (10 * 1024 * 1024)
 
+/* A slice of a variable requested with a deferred Get and printed after
+ * PerformGets, so that the engine can read several slices concurrently */
+template <class T>
+struct DeferredSlice
+{
+    std::vector<T> data;
+    uint64_t s[MAX_DIMS];
+    uint64_t c[MAX_DIMS];
+};
+
 struct Entry
 {
     DataType typeName;
@@ -108,6 +119,9 @@ void print_decomp(core::Engine *fp, core::IO *io, core::Variable<T> *variable);
 
 template <class T>
 void print_decomp_singlestep(core::Engine *fp, core::IO *io, core::Variable<T> *variable);
+
+template <class T>
+void print_stats(core::Engine *fp, core::IO *io, core::Variable<T> *variable);
 // close namespace
 }
 }
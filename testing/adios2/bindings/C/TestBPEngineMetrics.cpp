@@ -0,0 +1,90 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * TestBPEngineMetrics.cpp : test the C bindings of engine metrics
+ */
+
+#include <cstdlib>
+#include <string>
+
+#include <adios2_c.h>
+#include <gtest/gtest.h>
+
+class ADIOS2_C_API : public ::testing::Test
+{
+public:
+    ADIOS2_C_API() { adiosH = adios2_init_serial(); }
+
+    ~ADIOS2_C_API() { adios2_finalize(adiosH); }
+
+    adios2_adios *adiosH;
+};
+
+TEST_F(ADIOS2_C_API, ADIOS2BPEngineMetrics)
+{
+    const char fname[] = "ADIOS2_C_API.ADIOS2BPEngineMetrics.bp";
+    const size_t NSteps = 2;
+
+    adios2_io *ioH = adios2_declare_io(adiosH, "CMetrics");
+    adios2_set_engine(ioH, "BP5");
+
+    size_t shape[1] = {10};
+    size_t start[1] = {0};
+    size_t count[1] = {10};
+    int32_t data[10] = {0, 1, 2, 3, 4, 5, 6, 7, 8, 9};
+    adios2_variable *varI32 = adios2_define_variable(ioH, "varI32", adios2_type_int32_t, 1, shape,
+                                                     start, count, adios2_constant_dims_true);
+
+    adios2_engine *engineH = adios2_open(ioH, fname, adios2_mode_write);
+    adios2_step_status status;
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        adios2_begin_step(engineH, adios2_step_mode_append, -1., &status);
+        adios2_put(engineH, varI32, data, adios2_mode_sync);
+        adios2_end_step(engineH);
+    }
+
+    char **names = NULL;
+    double *values = NULL;
+    size_t size = 0;
+    ASSERT_EQ(adios2_engine_get_metrics(&names, &values, &size, engineH), adios2_error_none);
+    EXPECT_GT(size, 0);
+    bool foundSteps = false;
+    for (size_t i = 0; i < size; ++i)
+    {
+        if (std::string(names[i]) == "steps")
+        {
+            foundSteps = true;
+            EXPECT_EQ(values[i], static_cast<double>(NSteps));
+        }
+        free(names[i]);
+    }
+    free(names);
+    free(values);
+    EXPECT_TRUE(foundSteps);
+
+    double value = -1.;
+    int found = 0;
+    ASSERT_EQ(adios2_engine_get_metric(&value, &found, "endstep_calls", engineH),
+              adios2_error_none);
+    EXPECT_EQ(found, 1);
+    EXPECT_EQ(value, static_cast<double>(NSteps));
+
+    value = -1.;
+    ASSERT_EQ(adios2_engine_get_metric(&value, &found, "no_such_counter", engineH),
+              adios2_error_none);
+    EXPECT_EQ(found, 0);
+    EXPECT_EQ(value, -1.);
+
+    adios2_close(engineH);
+}
+
+int main(int argc, char **argv)
+{
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Overlapping selections read through the BP5 reader's block cache
+ */
+
+#include <cstdint>
+
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPBlockCache : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPBlockCache() = default;
+};
+
+namespace
+{
+const size_t Nx = 64;
+const size_t Ny = 64;
+const size_t NBlocks = 4; // along x
+const size_t NSteps = 2;
+
+double Value(const size_t step, const size_t x, const size_t y)
+{
+    return static_cast<double>(step * 100000 + x * Ny + y);
+}
+
+void WriteFile(adios2::ADIOS &adios, const std::string &fname)
+{
+    adios2::IO io = adios.DeclareIO("Write" + fname);
+    io.SetEngine(engineName);
+    const size_t bx = Nx / NBlocks;
+    auto var = io.DefineVariable<double>("plain", {Nx, Ny}, {0, 0}, {bx, Ny});
+    auto varOp = io.DefineVariable<double>("compressed", {Nx, Ny}, {0, 0}, {bx, Ny});
+#ifdef ADIOS2_HAVE_BZIP2
+    varOp.AddOperation("bzip2");
+#endif
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    std::vector<std::vector<double>> blocks(NBlocks, std::vector<double>(bx * Ny));
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            for (size_t x = 0; x < bx; ++x)
+            {
+                for (size_t y = 0; y < Ny; ++y)
+                {
+                    blocks[b][x * Ny + y] = Value(step, b * bx + x, y);
+                }
+            }
+            var.SetSelection({{b * bx, 0}, {bx, Ny}});
+            varOp.SetSelection({{b * bx, 0}, {bx, Ny}});
+            writer.Put(var, blocks[b].data());
+            writer.Put(varOp, blocks[b].data());
+        }
+        writer.EndStep();
+    }
+    writer.Close();
+}
+}
+
+TEST_P(BPBlockCache, PanAndZoom)
+{
+    const std::string spillDir = GetParam();
+    const std::string fname("BPBlockCache" + std::to_string(spillDir.size()) + ".bp");
+    adios2::ADIOS adios;
+    WriteFile(adios, fname);
+
+    adios2::IO io = adios.DeclareIO("Read");
+    io.SetEngine(engineName);
+    // a bit more than one block of each variable, so that spilling happens
+    io.SetParameter("BlockCacheSize", spillDir.empty() ? "1MB" : "40KB");
+    io.SetParameter("BlockCacheSpillDir", spillDir);
+    io.SetParameter("Threads", "2");
+    adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+    auto var = io.InquireVariable<double>("plain");
+    auto varOp = io.InquireVariable<double>("compressed");
+    ASSERT_TRUE(var);
+    ASSERT_TRUE(varOp);
+
+    // a window moving over the array, every frame overlaps the previous one
+    const size_t w = 24;
+    std::vector<double> in, inOp;
+    for (size_t frame = 0; frame < 6; ++frame)
+    {
+        const size_t step = frame % NSteps;
+        const size_t x0 = frame * 8;
+        const size_t y0 = frame * 4;
+        var.SetStepSelection({step, 1});
+        varOp.SetStepSelection({step, 1});
+        var.SetSelection({{x0, y0}, {w, w}});
+        varOp.SetSelection({{x0, y0}, {w, w}});
+        reader.Get(var, in, adios2::Mode::Sync);
+        reader.Get(varOp, inOp, adios2::Mode::Sync);
+        for (size_t x = 0; x < w; ++x)
+        {
+            for (size_t y = 0; y < w; ++y)
+            {
+                ASSERT_EQ(in[x * w + y], Value(step, x0 + x, y0 + y));
+                ASSERT_EQ(inOp[x * w + y], Value(step, x0 + x, y0 + y));
+            }
+        }
+    }
+
+    const std::map<std::string, double> metrics = reader.GetMetrics();
+    EXPECT_GT(metrics.at("block_cache_hits"), 0.0);
+    EXPECT_GT(metrics.at("block_cache_misses"), 0.0);
+    EXPECT_GT(metrics.at("block_cache_hit_rate"), 0.3);
+    if (!spillDir.empty())
+    {
+        EXPECT_GT(metrics.at("block_cache_spilled_bytes"), 0.0);
+    }
+    reader.Close();
+}
+
+INSTANTIATE_TEST_SUITE_P(BPBlockCache, BPBlockCache,
+                         ::testing::Values(std::string(""), std::string("BPBlockCacheSpill")));
+
+int main(int argc, char **argv)
+{
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
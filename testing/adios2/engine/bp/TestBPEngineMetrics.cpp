@@ -0,0 +1,216 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Engine::GetMetrics of BP5 while writing and reading
+ */
+
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPEngineMetrics : public ::testing::Test
+{
+public:
+    BPEngineMetrics() = default;
+};
+
+TEST_F(BPEngineMetrics, WriteRead)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPEngineMetrics_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPEngineMetrics.bp");
+#endif
+
+    const size_t Nx = 1000;
+    const size_t NSteps = 3;
+    std::vector<double> data(Nx);
+    std::iota(data.begin(), data.end(), static_cast<double>(mpiRank * Nx));
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        auto var = io.DefineVariable<double>("x", {Nx * mpiSize}, {Nx * mpiRank}, {Nx});
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+
+        double lastBytes = 0.0;
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            writer.Put(var, data.data());
+            writer.EndStep();
+
+            // counters are live, they grow with every step
+            const std::map<std::string, double> metrics = writer.GetMetrics();
+            ASSERT_EQ(metrics.count("steps"), 1);
+            EXPECT_EQ(metrics.at("steps"), static_cast<double>(step + 1));
+            EXPECT_EQ(metrics.at("endstep_calls"), static_cast<double>(step + 1));
+            EXPECT_GE(metrics.at("endstep_max_mus"), metrics.at("endstep_p50_mus"));
+            EXPECT_GE(metrics.at("buffer_high_water_bytes"), Nx * sizeof(double));
+            EXPECT_EQ(metrics.at("async_queue_depth"), 0.0);
+            EXPECT_EQ(metrics.count("data_mus"), 1);
+            EXPECT_EQ(metrics.count("metadata_mus"), 1);
+            EXPECT_EQ(metrics.count("aggregator_wait_mus"), 1);
+            if (metrics.count("data_file_bytes_written"))
+            {
+                EXPECT_GT(metrics.at("data_file_bytes_written"), lastBytes);
+                lastBytes = metrics.at("data_file_bytes_written");
+            }
+        }
+
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        std::vector<double> in;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var = io.InquireVariable<double>("x");
+            var.SetSelection({{Nx * mpiRank}, {Nx}});
+            reader.Get(var, in);
+            reader.EndStep();
+            ASSERT_EQ(in, data);
+        }
+        const std::map<std::string, double> metrics = reader.GetMetrics();
+        EXPECT_EQ(metrics.at("performgets_calls"), static_cast<double>(NSteps));
+        EXPECT_EQ(metrics.at("data_bytes_read"), static_cast<double>(NSteps * Nx * sizeof(double)));
+        if (mpiRank == 0)
+        {
+            // rank 0 reads metadata and broadcasts it
+            EXPECT_GT(metrics.at("metadata_bytes_read"), 0.0);
+        }
+        EXPECT_GE(metrics.at("data_file_bytes_read"), NSteps * Nx * sizeof(double));
+        reader.Close();
+    }
+}
+
+TEST_F(BPEngineMetrics, AsyncWrite)
+{
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPEngineMetricsAsync_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPEngineMetricsAsync.bp");
+#endif
+
+    const size_t Nx = 100000;
+    const size_t NSteps = 5;
+    std::vector<double> data(Nx);
+    std::iota(data.begin(), data.end(), static_cast<double>(mpiRank * Nx));
+
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    io.SetParameters({{"AsyncWrite", "Guided"},
+                      {"AsyncWriteQueueDepth", "3"},
+                      {"AsyncMetadataWrite", "true"}});
+    auto var = io.DefineVariable<double>("x", {Nx * mpiSize}, {Nx * mpiRank}, {Nx});
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+
+    // the transport counters are read while the async threads write
+    double lastBytes = 0.0;
+    double lastMetadataBytes = 0.0;
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        writer.EndStep();
+        for (int poll = 0; poll < 100; ++poll)
+        {
+            const std::map<std::string, double> metrics = writer.GetMetrics();
+            auto it = metrics.find("data_file_bytes_written");
+            if (it != metrics.end())
+            {
+                EXPECT_GE(it->second, lastBytes);
+                lastBytes = it->second;
+            }
+            it = metrics.find("metadata_file_bytes_written");
+            if (it != metrics.end())
+            {
+                EXPECT_GE(it->second, lastMetadataBytes);
+                lastMetadataBytes = it->second;
+            }
+        }
+    }
+    writer.Close();
+}
+
+TEST_F(BPEngineMetrics, OperatorRatio)
+{
+#ifndef ADIOS2_HAVE_BZIP2
+    GTEST_SKIP() << "needs an operator, bzip2 is not available";
+#else
+    int mpiRank = 0;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPEngineMetricsOperator_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPEngineMetricsOperator.bp");
+#endif
+    const size_t Nx = 10000;
+    std::vector<double> data(Nx, 1.0);
+
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    auto var = io.DefineVariable<double>("x", {}, {}, {Nx});
+    var.AddOperation("bzip2");
+    adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+    writer.BeginStep();
+    writer.Put(var, data.data());
+    writer.EndStep();
+
+    const std::map<std::string, double> metrics = writer.GetMetrics();
+    EXPECT_EQ(metrics.at("operator_bzip2_bytes_in"), Nx * sizeof(double));
+    EXPECT_GT(metrics.at("operator_bzip2_ratio"), 10.0);
+    writer.Close();
+#endif
+}
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,225 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Operators running on the BP5 OperatorThreads pool while Put returns
+ */
+
+#include <cstdint>
+
+#include <iostream>
+#include <map>
+#include <numeric>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPOperatorThreads : public ::testing::TestWithParam<size_t>
+{
+public:
+    BPOperatorThreads() = default;
+};
+
+namespace
+{
+const size_t Nx = 2000;
+const size_t NBlocks = 3;
+const size_t NSteps = 3;
+
+double Value(const int rank, const size_t step, const size_t block, const size_t i)
+{
+    return 1000.0 * rank + 100.0 * step + 10.0 * block + 0.001 * i;
+}
+}
+
+TEST_P(BPOperatorThreads, WriteRead)
+{
+    const size_t threads = GetParam();
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPOperatorThreads_" + std::to_string(threads) + "_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPOperatorThreads_" + std::to_string(threads) + ".bp");
+#endif
+    const size_t r = static_cast<size_t>(mpiRank);
+    const size_t n = static_cast<size_t>(mpiSize);
+    const size_t bx = Nx / NBlocks;
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameter("OperatorThreads", std::to_string(threads));
+        // Put(Sync) blocks, reusing one buffer
+        auto varSync = io.DefineVariable<double>("sync", {n * Nx}, {0}, {bx});
+        // deferred Put blocks, one buffer each
+        auto varDeferred = io.DefineVariable<double>("deferred", {n * Nx}, {0}, {bx});
+        // in between, without an operator
+        auto varPlain = io.DefineVariable<int32_t>("plain", {n * Nx}, {r * Nx}, {Nx});
+        varSync.AddOperation("delta");
+        varSync.AddOperation("shuffle");
+        varDeferred.AddOperation("shuffle");
+#ifdef ADIOS2_HAVE_BZIP2
+        varSync.AddOperation("bzip2");
+        varDeferred.AddOperation("bzip2");
+#endif
+
+        std::vector<double> syncBuffer(bx);
+        std::vector<std::vector<double>> deferredBuffers(NBlocks, std::vector<double>(bx));
+        std::vector<int32_t> plain(Nx);
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                const adios2::Box<adios2::Dims> sel({r * Nx + b * bx}, {bx});
+                for (size_t i = 0; i < bx; ++i)
+                {
+                    syncBuffer[i] = Value(mpiRank, step, b, i);
+                    deferredBuffers[b][i] = -Value(mpiRank, step, b, i);
+                }
+                varSync.SetSelection(sel);
+                writer.Put(varSync, syncBuffer.data(), adios2::Mode::Sync);
+                varDeferred.SetSelection(sel);
+                writer.Put(varDeferred, deferredBuffers[b].data());
+            }
+            // a Put(Sync) block must be copied before Put returns
+            std::fill(syncBuffer.begin(), syncBuffer.end(), 0.0);
+            std::iota(plain.begin(), plain.end(), static_cast<int32_t>(step));
+            writer.Put(varPlain, plain.data());
+
+            const std::map<std::string, double> metrics = writer.GetMetrics();
+            EXPECT_EQ(metrics.at("operator_pending_blocks"),
+                      threads ? static_cast<double>(2 * NBlocks) : 0.0);
+            writer.EndStep();
+            EXPECT_EQ(writer.GetMetrics().at("operator_pending_blocks"), 0.0);
+        }
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        std::vector<double> inSync, inDeferred;
+        std::vector<int32_t> inPlain;
+        size_t step = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto varSync = io.InquireVariable<double>("sync");
+            auto varDeferred = io.InquireVariable<double>("deferred");
+            auto varPlain = io.InquireVariable<int32_t>("plain");
+            varSync.SetSelection({{r * Nx}, {NBlocks * bx}});
+            varDeferred.SetSelection({{r * Nx}, {NBlocks * bx}});
+            varPlain.SetSelection({{r * Nx}, {Nx}});
+            reader.Get(varSync, inSync);
+            reader.Get(varDeferred, inDeferred);
+            reader.Get(varPlain, inPlain);
+            reader.EndStep();
+
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < bx; ++i)
+                {
+                    ASSERT_EQ(inSync[b * bx + i], Value(mpiRank, step, b, i));
+                    ASSERT_EQ(inDeferred[b * bx + i], -Value(mpiRank, step, b, i));
+                }
+            }
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                ASSERT_EQ(inPlain[i], static_cast<int32_t>(step + i));
+            }
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        reader.Close();
+    }
+}
+
+TEST_P(BPOperatorThreads, PerformPutsInStep)
+{
+    // PerformPuts adds the finished blocks, later Puts of the step go after
+    const size_t threads = GetParam();
+#if ADIOS2_USE_MPI
+    int mpiRank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    adios2::ADIOS adios(MPI_COMM_SELF);
+    const std::string fname("BPOperatorThreadsPP_" + std::to_string(threads) + "_" +
+                            std::to_string(mpiRank) + "_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPOperatorThreadsPP_" + std::to_string(threads) + ".bp");
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameter("OperatorThreads", std::to_string(threads));
+        auto var = io.DefineVariable<double>("x", {}, {}, {Nx});
+        var.AddOperation("shuffle");
+        std::vector<double> data(Nx);
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        writer.BeginStep();
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            std::iota(data.begin(), data.end(), static_cast<double>(b * Nx));
+            writer.Put(var, data.data());
+            writer.PerformPuts();
+            EXPECT_EQ(writer.GetMetrics().at("operator_pending_blocks"), 0.0);
+        }
+        writer.EndStep();
+        writer.Close();
+    }
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        reader.BeginStep();
+        auto var = io.InquireVariable<double>("x");
+        std::vector<double> in;
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            var.SetBlockSelection(b);
+            reader.Get(var, in, adios2::Mode::Sync);
+            ASSERT_EQ(in.size(), Nx);
+            EXPECT_EQ(in.front(), static_cast<double>(b * Nx));
+            EXPECT_EQ(in.back(), static_cast<double>(b * Nx + Nx - 1));
+        }
+        reader.EndStep();
+        reader.Close();
+    }
+}
+
+INSTANTIATE_TEST_SUITE_P(Threads, BPOperatorThreads, ::testing::Values(0, 1, 4));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
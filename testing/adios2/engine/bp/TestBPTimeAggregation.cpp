@@ -172,7 +172,7 @@ void TimeAggregation1D8(const std::string flushstepscount)
             io.SetEngine("BP4");
         }
 
-        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::ReadRandomAccess);
 
         auto var_iString = io.InquireVariable<std::string>("iString");
         EXPECT_TRUE(var_iString);
@@ -498,7 +498,7 @@ void TimeAggregation2D4x2(const std::string flushstepscount)
             // Create the BP Engine
             io.SetEngine("BP4");
         }
-        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::ReadRandomAccess);
 
         auto var_iString = io.InquireVariable<std::string>("iString");
         EXPECT_TRUE(var_iString);
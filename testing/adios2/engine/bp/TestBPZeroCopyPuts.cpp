@@ -0,0 +1,119 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * ZeroCopyPuts: many small sync and deferred Puts written from the
+ * application's buffers
+ */
+
+#include <cstdint>
+
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPZeroCopyPuts : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPZeroCopyPuts() = default;
+};
+
+namespace
+{
+// more blocks than one writev() call takes
+const size_t NBlocks = 3000;
+const size_t Nx = 5;
+const size_t NSteps = 3;
+
+int32_t Value(const size_t step, const size_t block, const size_t i)
+{
+    return static_cast<int32_t>(step * 1000000 + block * Nx + i);
+}
+}
+
+TEST_P(BPZeroCopyPuts, WriteRead)
+{
+    const std::string aggregation = GetParam();
+    const std::string fname = "BPZeroCopyPuts_" + aggregation + ".bp";
+    adios2::ADIOS adios;
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameters({{"ZeroCopyPuts", "true"}, {"AggregationType", aggregation}});
+        auto varSync = io.DefineVariable<int32_t>("sync", {NBlocks * Nx}, {0}, {Nx});
+        auto varDeferred = io.DefineVariable<int32_t>("deferred", {NBlocks * Nx}, {0}, {Nx});
+
+        // all buffers stay unchanged until EndStep
+        std::vector<int32_t> sync(NBlocks * Nx), deferred(NBlocks * Nx);
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    sync[b * Nx + i] = Value(step, b, i);
+                    deferred[b * Nx + i] = -Value(step, b, i);
+                }
+                varSync.SetSelection({{b * Nx}, {Nx}});
+                writer.Put(varSync, sync.data() + b * Nx, adios2::Mode::Sync);
+                varDeferred.SetSelection({{b * Nx}, {Nx}});
+                writer.Put(varDeferred, deferred.data() + b * Nx);
+            }
+            writer.PerformPuts();
+            writer.EndStep();
+        }
+        writer.Close();
+    }
+
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine(engineName);
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    size_t errors = 0;
+    size_t steps = 0;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        std::vector<int32_t> sync, deferred;
+        reader.Get(io.InquireVariable<int32_t>("sync"), sync);
+        reader.Get(io.InquireVariable<int32_t>("deferred"), deferred);
+        reader.EndStep();
+        ASSERT_EQ(sync.size(), NBlocks * Nx);
+        ASSERT_EQ(deferred.size(), NBlocks * Nx);
+        for (size_t b = 0; b < NBlocks; ++b)
+        {
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                errors += sync[b * Nx + i] != Value(steps, b, i);
+                errors += deferred[b * Nx + i] != -Value(steps, b, i);
+            }
+        }
+        ++steps;
+    }
+    reader.Close();
+    EXPECT_EQ(steps, NSteps);
+    EXPECT_EQ(errors, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(BPZeroCopyPuts, BPZeroCopyPuts,
+                         ::testing::Values(std::string("EveryoneWrites"),
+                                           std::string("TwoLevelShm")));
+
+int main(int argc, char **argv)
+{
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
@@ -0,0 +1,163 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadAuto : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadAuto() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+namespace
+{
+const size_t Nx = 10000;
+const size_t NBlocks = 4;
+const size_t NSteps = 3;
+
+/** like AMR output: empty blocks, smooth ones and noisy ones */
+double Value(const int rank, const size_t step, const size_t block, const size_t i)
+{
+    switch ((block + step) % NBlocks)
+    {
+    case 0:
+        return 0.0;
+    case 1:
+        return std::sin(0.001 * static_cast<double>(i) + step + rank);
+    case 2:
+        // not compressible, but not random either so it is reproducible
+        return static_cast<double>((i * 2654435761u + step * 40503u + rank) % 1000003u) / 7.0;
+    default:
+        return static_cast<double>(rank + 1);
+    }
+}
+}
+
+void AutoAccuracy1D(const std::string objective)
+{
+    // Each process writes NBlocks blocks of Nx values
+    int mpiRank = 0, mpiSize = 1;
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPWRAuto1D_" + objective + "_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPWRAuto1D_" + objective + ".bp");
+#endif
+    const size_t r = static_cast<size_t>(mpiRank);
+    const size_t n = static_cast<size_t>(mpiSize);
+
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BPFile");
+        }
+
+        auto var = io.DefineVariable<double>("field", {n * NBlocks * Nx}, {0}, {Nx});
+        var.AddOperation(adios2::ops::AutoSelect,
+                         {{adios2::ops::autoselect::key::objective, objective},
+                          {adios2::ops::autoselect::key::candidates, "pack, shuffle+pack"}});
+
+        std::vector<double> data(Nx);
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            bpWriter.BeginStep();
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    data[i] = Value(mpiRank, step, b, i);
+                }
+                var.SetSelection({{(r * NBlocks + b) * Nx}, {Nx}});
+                bpWriter.Put(var, data.data(), adios2::Mode::Sync);
+            }
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> in;
+        size_t step = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var = io.InquireVariable<double>("field");
+            var.SetSelection({{r * NBlocks * Nx}, {NBlocks * Nx}});
+            bpReader.Get(var, in, adios2::Mode::Sync);
+            bpReader.EndStep();
+
+            // lossless whatever was chosen
+            for (size_t b = 0; b < NBlocks; ++b)
+            {
+                for (size_t i = 0; i < Nx; ++i)
+                {
+                    ASSERT_EQ(in[b * Nx + i], Value(mpiRank, step, b, i));
+                }
+            }
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        bpReader.Close();
+    }
+}
+
+TEST_P(BPWriteReadAuto, ADIOS2BPWriteReadAuto1D) { AutoAccuracy1D(GetParam()); }
+
+INSTANTIATE_TEST_SUITE_P(Auto, BPWriteReadAuto,
+                         ::testing::Values(adios2::ops::autoselect::value::objective_ratio,
+                                           adios2::ops::autoselect::value::objective_time));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,248 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Variables with several operations: the delta and shuffle preconditioners
+ * followed by a compressor
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <complex>
+#include <iostream>
+#include <map>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadOperatorChain : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadOperatorChain() = default;
+};
+
+namespace
+{
+std::vector<std::string> Split(const std::string &chain)
+{
+    std::vector<std::string> ops;
+    size_t start = 0;
+    while (start <= chain.size())
+    {
+        size_t end = chain.find('+', start);
+        if (end == std::string::npos)
+        {
+            end = chain.size();
+        }
+        ops.push_back(chain.substr(start, end - start));
+        start = end + 1;
+    }
+    return ops;
+}
+}
+
+TEST_P(BPWriteReadOperatorChain, WriteRead)
+{
+    const std::string chain = GetParam();
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 1000;
+    const size_t Ny = 20;
+    const size_t NSteps = 2;
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+    const std::string fname("BPWR_OperatorChain_" + chain + "_MPI.bp");
+#else
+    adios2::ADIOS adios;
+    const std::string fname("BPWR_OperatorChain_" + chain + ".bp");
+#endif
+
+    // smooth fields, what the preconditioners are made for
+    std::vector<double> r64s(Nx * Ny);
+    std::vector<float> r32s(Nx);
+    std::vector<int32_t> i32s(Nx);
+    std::vector<std::complex<double>> c64s(Nx);
+    for (size_t i = 0; i < Nx; ++i)
+    {
+        r32s[i] = static_cast<float>(std::sin(0.01 * i) + mpiRank);
+        i32s[i] = static_cast<int32_t>(3 * i) - 100 + mpiRank;
+        c64s[i] = {std::cos(0.02 * i), static_cast<double>(i)};
+        for (size_t j = 0; j < Ny; ++j)
+        {
+            r64s[i * Ny + j] = 1000.0 + 0.5 * i + 0.001 * j + mpiRank;
+        }
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+
+        const size_t n = static_cast<size_t>(mpiSize);
+        const size_t r = static_cast<size_t>(mpiRank);
+        auto var_r64 = io.DefineVariable<double>("r64", {n * Nx, Ny}, {r * Nx, 0}, {Nx, Ny},
+                                                 adios2::ConstantDims);
+        auto var_r32 = io.DefineVariable<float>("r32", {n * Nx}, {r * Nx}, {Nx});
+        auto var_i32 = io.DefineVariable<int32_t>("i32", {n * Nx}, {r * Nx}, {Nx});
+        auto var_c64 = io.DefineVariable<std::complex<double>>("c64", {n * Nx}, {r * Nx}, {Nx});
+
+        for (const std::string &op : Split(chain))
+        {
+            var_r64.AddOperation(op);
+            if (op == "delta")
+            {
+                var_r32.AddOperation(op, {{"mode", "xor"}});
+            }
+            else
+            {
+                var_r32.AddOperation(op);
+            }
+            var_i32.AddOperation(op);
+            var_c64.AddOperation(op);
+        }
+
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            writer.BeginStep();
+            writer.Put(var_r64, r64s.data());
+            writer.Put(var_r32, r32s.data());
+            writer.Put(var_i32, i32s.data());
+            writer.Put(var_c64, c64s.data());
+            writer.EndStep();
+        }
+
+        // the stages show up in the operator metrics as one operator
+        const std::map<std::string, double> metrics = writer.GetMetrics();
+        EXPECT_EQ(metrics.count("operator_" + chain + "_bytes_in"), 1);
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<double> in_r64;
+        std::vector<float> in_r32;
+        std::vector<int32_t> in_i32;
+        std::vector<std::complex<double>> in_c64;
+        size_t steps = 0;
+        while (reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_r32 = io.InquireVariable<float>("r32");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            auto var_c64 = io.InquireVariable<std::complex<double>>("c64");
+            var_r64.SetSelection({{mpiRank * Nx, 0}, {Nx, Ny}});
+            var_r32.SetSelection({{mpiRank * Nx}, {Nx}});
+            var_i32.SetSelection({{mpiRank * Nx}, {Nx}});
+            var_c64.SetSelection({{mpiRank * Nx}, {Nx}});
+            reader.Get(var_r64, in_r64);
+            reader.Get(var_r32, in_r32);
+            reader.Get(var_i32, in_i32);
+            reader.Get(var_c64, in_c64);
+            reader.EndStep();
+
+            // lossless, bit for bit
+            EXPECT_EQ(in_r64, r64s);
+            EXPECT_EQ(in_r32, r32s);
+            EXPECT_EQ(in_i32, i32s);
+            EXPECT_EQ(in_c64, c64s);
+            ++steps;
+        }
+        EXPECT_EQ(steps, NSteps);
+        reader.Close();
+    }
+}
+
+class BPOperatorChainRatio : public ::testing::Test
+{
+public:
+    BPOperatorChainRatio() = default;
+};
+
+#ifdef ADIOS2_HAVE_BZIP2
+TEST_F(BPOperatorChainRatio, PreconditionHelpsCompression)
+{
+    // a slowly growing double: shuffled deltas are mostly zero bytes
+    const size_t Nx = 100000;
+    std::vector<double> data(Nx);
+    for (size_t i = 0; i < Nx; ++i)
+    {
+        data[i] = 1.0e6 + 0.25 * i;
+    }
+
+    // every rank writes its own file
+    std::string fname = "BPWR_OperatorChainRatio";
+#if ADIOS2_USE_MPI
+    int mpiRank = 0;
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    fname += "_" + std::to_string(mpiRank) + "_MPI";
+#endif
+
+    std::map<std::string, double> ratios;
+    for (const std::string chain : {"bzip2", "delta+shuffle+bzip2"})
+    {
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        auto var = io.DefineVariable<double>("x", {}, {}, {Nx});
+        for (const std::string &op : Split(chain))
+        {
+            var.AddOperation(op);
+        }
+        adios2::Engine writer = io.Open(fname + ".bp", adios2::Mode::Write);
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        writer.EndStep();
+        ratios[chain] = writer.GetMetrics().at("operator_" + chain + "_ratio");
+        writer.Close();
+    }
+    EXPECT_GT(ratios["delta+shuffle+bzip2"], ratios["bzip2"]);
+}
+#endif
+
+std::vector<std::string> Chains()
+{
+    std::vector<std::string> chains = {"delta", "shuffle", "delta+shuffle"};
+#ifdef ADIOS2_HAVE_BZIP2
+    chains.push_back("shuffle+bzip2");
+    chains.push_back("delta+shuffle+bzip2");
+#endif
+    return chains;
+}
+
+INSTANTIATE_TEST_SUITE_P(Chains, BPWriteReadOperatorChain, ::testing::ValuesIn(Chains()));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
@@ -0,0 +1,184 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+
+#include <complex>
+#include <iostream>
+#include <numeric> //std::iota
+#include <stdexcept>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+class BPWriteReadPack : public ::testing::TestWithParam<std::string>
+{
+public:
+    BPWriteReadPack() = default;
+
+    virtual void SetUp() {}
+    virtual void TearDown() {}
+};
+
+void PackAccuracy2D(const std::string predict)
+{
+    // Each process would write a Nx x Ny array and all processes would
+    // form a (mpiSize * Nx) x Ny 2D array
+    int mpiRank = 0, mpiSize = 1;
+    const size_t Nx = 100;
+    const size_t Ny = 50;
+    const size_t NSteps = 3;
+
+    std::vector<float> r32s(Nx * Ny);
+    std::vector<double> r64s(Nx * Ny);
+    std::vector<int32_t> i32s(Nx * Ny);
+    std::vector<std::complex<double>> c64s(Nx * Ny);
+
+#if ADIOS2_USE_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+    const std::string fname("BPWRPack2D_" + predict + "_MPI.bp");
+#else
+    const std::string fname("BPWRPack2D_" + predict + ".bp");
+#endif
+
+    auto lf_Fill = [&](const size_t step) {
+        for (size_t i = 0; i < Nx * Ny; ++i)
+        {
+            const double x = 0.01 * static_cast<double>(i) + step + mpiRank;
+            r32s[i] = static_cast<float>(std::sin(x));
+            r64s[i] = 1.0e3 * std::cos(x);
+            i32s[i] = static_cast<int32_t>(i) * 3 - static_cast<int32_t>(step);
+            c64s[i] = {x, -x};
+        }
+    };
+
+#if ADIOS2_USE_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("TestIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        else
+        {
+            io.SetEngine("BPFile");
+        }
+
+        const adios2::Dims shape{static_cast<size_t>(Nx * mpiSize), Ny};
+        const adios2::Dims start{static_cast<size_t>(Nx * mpiRank), 0};
+        const adios2::Dims count{Nx, Ny};
+
+        auto var_r32 = io.DefineVariable<float>("r32", shape, start, count, adios2::ConstantDims);
+        auto var_r64 = io.DefineVariable<double>("r64", shape, start, count, adios2::ConstantDims);
+        auto var_i32 = io.DefineVariable<int32_t>("i32", shape, start, count, adios2::ConstantDims);
+        auto var_c64 = io.DefineVariable<std::complex<double>>("c64", shape, start, count,
+                                                               adios2::ConstantDims);
+
+        // the built in operator needs no external library
+        const adios2::Params params = {{adios2::ops::pack::key::predict, predict}};
+        var_r32.AddOperation(adios2::ops::LosslessPack, params);
+        var_r64.AddOperation(adios2::ops::LosslessPack, params);
+        var_i32.AddOperation(adios2::ops::LosslessPack, params);
+        var_c64.AddOperation(adios2::ops::LosslessPack, params);
+
+        adios2::Engine bpWriter = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            lf_Fill(step);
+            bpWriter.BeginStep();
+            bpWriter.Put(var_r32, r32s.data());
+            bpWriter.Put(var_r64, r64s.data());
+            bpWriter.Put(var_i32, i32s.data());
+            bpWriter.Put(var_c64, c64s.data());
+            bpWriter.EndStep();
+        }
+        bpWriter.Close();
+    }
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        if (!engineName.empty())
+        {
+            io.SetEngine(engineName);
+        }
+        adios2::Engine bpReader = io.Open(fname, adios2::Mode::Read);
+
+        std::vector<float> in_r32;
+        std::vector<double> in_r64;
+        std::vector<int32_t> in_i32;
+        std::vector<std::complex<double>> in_c64;
+        const adios2::Box<adios2::Dims> sel({static_cast<size_t>(Nx * mpiRank), 0}, {Nx, Ny});
+
+        size_t step = 0;
+        while (bpReader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_r32 = io.InquireVariable<float>("r32");
+            auto var_r64 = io.InquireVariable<double>("r64");
+            auto var_i32 = io.InquireVariable<int32_t>("i32");
+            auto var_c64 = io.InquireVariable<std::complex<double>>("c64");
+            var_r32.SetSelection(sel);
+            var_r64.SetSelection(sel);
+            var_i32.SetSelection(sel);
+            var_c64.SetSelection(sel);
+            bpReader.Get(var_r32, in_r32);
+            bpReader.Get(var_r64, in_r64);
+            bpReader.Get(var_i32, in_i32);
+            bpReader.Get(var_c64, in_c64);
+            bpReader.EndStep();
+
+            // lossless, bit for bit
+            lf_Fill(step);
+            EXPECT_EQ(in_r32, r32s);
+            EXPECT_EQ(in_r64, r64s);
+            EXPECT_EQ(in_i32, i32s);
+            EXPECT_EQ(in_c64, c64s);
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        bpReader.Close();
+    }
+}
+
+TEST_P(BPWriteReadPack, ADIOS2BPWriteReadPack2D) { PackAccuracy2D(GetParam()); }
+
+INSTANTIATE_TEST_SUITE_P(Pack, BPWriteReadPack,
+                         ::testing::Values(adios2::ops::pack::value::predict_auto,
+                                           adios2::ops::pack::value::predict_xor,
+                                           adios2::ops::pack::value::predict_sub,
+                                           adios2::ops::pack::value::predict_none));
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+    result = RUN_ALL_TESTS();
+
+#if ADIOS2_USE_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
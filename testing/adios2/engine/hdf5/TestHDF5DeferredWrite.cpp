@@ -0,0 +1,290 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+#include <hdf5.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+// Puts of a step are queued with H5DeferredPuts and written at EndStep, each
+// rank writes two blocks of "a" so the batch takes two rounds
+void DeferredWrite(const std::string &fname, const bool chunkByBlock)
+{
+    int mpiRank = 0, mpiSize = 1;
+#ifdef TEST_HDF5_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+
+    // rows and columns of one block of "a"
+    const size_t Nx = 4;
+    const size_t Ny = 6;
+    // elements of "b" per rank, plus one ghost cell on each side
+    const size_t Nb = 10;
+    const size_t NSteps = 3;
+
+    const size_t rows = 2 * Nx * mpiSize;
+
+#ifdef TEST_HDF5_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameter("H5DeferredPuts", "yes");
+        if (chunkByBlock)
+        {
+            io.SetParameter("H5ChunkByBlock", "yes");
+        }
+
+        auto var_a = io.DefineVariable<double>("a", {rows, Ny}, {0, 0}, {Nx, Ny});
+        auto var_b = io.DefineVariable<int32_t>("b", {Nb * mpiSize}, {Nb * mpiRank}, {Nb});
+        var_b.SetMemorySelection({{1}, {Nb + 2}});
+        auto var_s = io.DefineVariable<int32_t>("s");
+
+        adios2::Engine h5Writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            // separate buffers, deferred Puts keep the pointers until EndStep
+            std::vector<std::vector<double>> a(2, std::vector<double>(Nx * Ny));
+            std::vector<int32_t> b(Nb + 2, -1);
+            const int32_t s = static_cast<int32_t>(step);
+
+            h5Writer.BeginStep();
+            for (size_t k = 0; k < 2; ++k)
+            {
+                const size_t row0 = (2 * mpiRank + k) * Nx;
+                for (size_t i = 0; i < Nx * Ny; ++i)
+                {
+                    a[k][i] = static_cast<double>(step * 1000 + row0 * Ny + i);
+                }
+                var_a.SetSelection({{row0, 0}, {Nx, Ny}});
+                h5Writer.Put(var_a, a[k].data());
+            }
+            for (size_t i = 0; i < Nb; ++i)
+            {
+                b[i + 1] = static_cast<int32_t>(step * 100 + Nb * mpiRank + i);
+            }
+            h5Writer.Put(var_b, b.data());
+            h5Writer.Put(var_s, &s);
+            h5Writer.EndStep();
+        }
+        h5Writer.Close();
+    }
+#ifdef TEST_HDF5_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine h5Reader = io.Open(fname, adios2::Mode::Read);
+
+        size_t step = 0;
+        while (h5Reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_a = io.InquireVariable<double>("a");
+            auto var_b = io.InquireVariable<int32_t>("b");
+            auto var_s = io.InquireVariable<int32_t>("s");
+            ASSERT_TRUE(var_a);
+            ASSERT_TRUE(var_b);
+            ASSERT_TRUE(var_s);
+            ASSERT_EQ(var_a.Shape(), adios2::Dims({rows, Ny}));
+
+            std::vector<double> a;
+            std::vector<int32_t> b;
+            int32_t s = -1;
+            var_a.SetSelection({{0, 0}, {rows, Ny}});
+            var_b.SetSelection({{0}, {Nb * mpiSize}});
+            h5Reader.Get(var_a, a, adios2::Mode::Sync);
+            h5Reader.Get(var_b, b, adios2::Mode::Sync);
+            h5Reader.Get(var_s, s, adios2::Mode::Sync);
+
+            for (size_t i = 0; i < rows * Ny; ++i)
+            {
+                ASSERT_EQ(a[i], static_cast<double>(step * 1000 + i)) << "step " << step;
+            }
+            for (size_t i = 0; i < Nb * mpiSize; ++i)
+            {
+                ASSERT_EQ(b[i], static_cast<int32_t>(step * 100 + i)) << "step " << step;
+            }
+            EXPECT_EQ(s, static_cast<int32_t>(step));
+            h5Reader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        h5Reader.Close();
+    }
+
+    if (mpiRank == 0)
+    {
+        hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+        ASSERT_GE(file, 0);
+        hid_t dset = H5Dopen(file, "/Step0/a", H5P_DEFAULT);
+        ASSERT_GE(dset, 0);
+        hid_t dcpl = H5Dget_create_plist(dset);
+        if (chunkByBlock)
+        {
+            ASSERT_EQ(H5Pget_layout(dcpl), H5D_CHUNKED);
+            hsize_t chunk[2] = {0, 0};
+            ASSERT_EQ(H5Pget_chunk(dcpl, 2, chunk), 2);
+            EXPECT_EQ(chunk[0], Nx);
+            EXPECT_EQ(chunk[1], Ny);
+        }
+        else
+        {
+            EXPECT_EQ(H5Pget_layout(dcpl), H5D_CONTIGUOUS);
+        }
+        H5Pclose(dcpl);
+        H5Dclose(dset);
+        H5Fclose(file);
+    }
+}
+
+TEST(HDF5DeferredWrite, Contiguous) { DeferredWrite("HDF5DeferredWriteContiguous.h5", false); }
+
+TEST(HDF5DeferredWrite, ChunkByBlock) { DeferredWrite("HDF5DeferredWriteChunkByBlock.h5", true); }
+
+// only rank 0 Puts "c", odd ranks Put "b" before "a": the ranks agree on the
+// datasets to create before writing them
+TEST(HDF5DeferredWrite, RankZeroOnly)
+{
+    int mpiRank = 0, mpiSize = 1;
+#ifdef TEST_HDF5_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    const std::string fname = "HDF5DeferredWriteRankZeroOnly.h5";
+    const size_t N = 8;
+    const size_t NSteps = 2;
+
+#ifdef TEST_HDF5_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        io.SetParameter("H5DeferredPuts", "yes");
+
+        auto var_a = io.DefineVariable<int32_t>("a", {N * mpiSize}, {N * mpiRank}, {N});
+        auto var_b = io.DefineVariable<double>("b", {N * mpiSize}, {N * mpiRank}, {N});
+        auto var_c = io.DefineVariable<int64_t>("c", {N}, {0}, {N});
+
+        adios2::Engine h5Writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            std::vector<int32_t> a(N);
+            std::vector<double> b(N);
+            std::vector<int64_t> c(N);
+            for (size_t i = 0; i < N; ++i)
+            {
+                a[i] = static_cast<int32_t>(step * 100 + N * mpiRank + i);
+                b[i] = static_cast<double>(a[i]) / 2;
+                c[i] = static_cast<int64_t>(step * 1000 + i);
+            }
+
+            h5Writer.BeginStep();
+            if (mpiRank % 2)
+            {
+                h5Writer.Put(var_b, b.data());
+                h5Writer.Put(var_a, a.data());
+            }
+            else
+            {
+                h5Writer.Put(var_a, a.data());
+                h5Writer.Put(var_b, b.data());
+            }
+            if (mpiRank == 0)
+            {
+                h5Writer.Put(var_c, c.data());
+            }
+            h5Writer.EndStep();
+        }
+        h5Writer.Close();
+    }
+#ifdef TEST_HDF5_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine h5Reader = io.Open(fname, adios2::Mode::Read);
+
+        size_t step = 0;
+        while (h5Reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_a = io.InquireVariable<int32_t>("a");
+            auto var_b = io.InquireVariable<double>("b");
+            auto var_c = io.InquireVariable<int64_t>("c");
+            ASSERT_TRUE(var_a);
+            ASSERT_TRUE(var_b);
+            ASSERT_TRUE(var_c);
+
+            std::vector<int32_t> a;
+            std::vector<double> b;
+            std::vector<int64_t> c;
+            var_a.SetSelection({{0}, {N * mpiSize}});
+            var_b.SetSelection({{0}, {N * mpiSize}});
+            var_c.SetSelection({{0}, {N}});
+            h5Reader.Get(var_a, a, adios2::Mode::Sync);
+            h5Reader.Get(var_b, b, adios2::Mode::Sync);
+            h5Reader.Get(var_c, c, adios2::Mode::Sync);
+
+            for (size_t i = 0; i < N * mpiSize; ++i)
+            {
+                ASSERT_EQ(a[i], static_cast<int32_t>(step * 100 + i)) << "step " << step;
+                ASSERT_EQ(b[i], static_cast<double>(step * 100 + i) / 2) << "step " << step;
+            }
+            for (size_t i = 0; i < N; ++i)
+            {
+                ASSERT_EQ(c[i], static_cast<int64_t>(step * 1000 + i)) << "step " << step;
+            }
+            h5Reader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        h5Reader.Close();
+    }
+}
+
+int main(int argc, char **argv)
+{
+#ifdef TEST_HDF5_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    engineName = "HDF5";
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef TEST_HDF5_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
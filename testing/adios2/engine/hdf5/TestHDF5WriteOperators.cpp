@@ -0,0 +1,373 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <iostream>
+#include <stdexcept>
+
+#include <adios2.h>
+#include <adios2/core/Operator.h>
+#include <adios2/toolkit/interop/hdf5/HDF5Common.h>
+#include <hdf5.h>
+
+#include <gtest/gtest.h>
+
+std::string engineName; // comes from command line
+
+namespace
+{
+
+// registered identifier of the HDF5 bzip2 filter
+const H5Z_filter_t FilterBZIP2 = 307;
+
+// stands in for the bzip2 filter plugin, stores data as it is
+size_t PassThrough(unsigned int, size_t, const unsigned int[], size_t nbytes, size_t *,
+                   void **)
+{
+    return nbytes;
+}
+
+void RegisterPassThrough()
+{
+    if (H5Zfilter_avail(FilterBZIP2) > 0)
+    {
+        return;
+    }
+    H5Z_class2_t filterClass = {H5Z_CLASS_T_VERS, FilterBZIP2, 1, 1, "test bzip2",
+                                NULL,             NULL,        PassThrough};
+    H5Zregister(&filterClass);
+}
+
+// checks the dataset is chunked as chunk with the bzip2 filter on it
+void CheckFilter(const std::string &fname, const std::string &dsetName,
+                 const std::vector<hsize_t> &chunk, const unsigned int blockSize100k)
+{
+    hid_t file = H5Fopen(fname.c_str(), H5F_ACC_RDONLY, H5P_DEFAULT);
+    ASSERT_GE(file, 0);
+    hid_t dset = H5Dopen(file, dsetName.c_str(), H5P_DEFAULT);
+    ASSERT_GE(dset, 0);
+    hid_t dcpl = H5Dget_create_plist(dset);
+
+    ASSERT_EQ(H5Pget_layout(dcpl), H5D_CHUNKED);
+    std::vector<hsize_t> h5Chunk(chunk.size());
+    ASSERT_EQ(H5Pget_chunk(dcpl, static_cast<int>(chunk.size()), h5Chunk.data()),
+              static_cast<int>(chunk.size()));
+    EXPECT_EQ(h5Chunk, chunk);
+
+    unsigned int flags = 0;
+    size_t nValues = 4;
+    unsigned int values[4] = {0, 0, 0, 0};
+    ASSERT_GE(H5Pget_filter_by_id2(dcpl, FilterBZIP2, &flags, &nValues, values, 0, NULL, NULL),
+              0);
+    ASSERT_EQ(nValues, 1);
+    EXPECT_EQ(values[0], blockSize100k);
+
+    H5Pclose(dcpl);
+    H5Dclose(dset);
+    H5Fclose(file);
+}
+
+// an operator with only a type and parameters, for the filter mapping
+class StubOperator : public adios2::core::Operator
+{
+public:
+    StubOperator(const std::string &type, const adios2::Params &parameters)
+    : Operator(type, COMPRESS_NULL, "compress", parameters)
+    {
+    }
+
+    size_t Operate(const char *, const adios2::Dims &, const adios2::Dims &,
+                   const adios2::DataType, char *) final
+    {
+        return 0;
+    }
+
+    size_t InverseOperate(const char *, const size_t, char *) final { return 0; }
+
+    bool IsDataTypeValid(const adios2::DataType) const final { return true; }
+};
+
+void GetFilter(const std::string &type, const adios2::Params &parameters, H5Z_filter_t &filter,
+               std::vector<unsigned int> &cdValues)
+{
+    StubOperator op(type, parameters);
+    adios2::interop::HDF5Common::GetOperatorFilter(op, filter, cdValues);
+}
+
+double GetDouble(const std::vector<unsigned int> &cdValues, const size_t pos)
+{
+    double value;
+    std::memcpy(&value, &cdValues[pos], sizeof(double));
+    return value;
+}
+
+} // end anonymous namespace
+
+void WriteWithOperator(const std::string &fname, const bool deferred)
+{
+    int mpiRank = 0, mpiSize = 1;
+#ifdef TEST_HDF5_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    RegisterPassThrough();
+
+    const size_t Nx = 8;
+    const size_t Ny = 5;
+    const size_t NSteps = 2;
+
+#ifdef TEST_HDF5_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+        if (deferred)
+        {
+            io.SetParameter("H5DeferredPuts", "yes");
+        }
+#ifdef TEST_HDF5_MPI
+        // filters need collective writes in parallel HDF5
+        io.SetParameter("H5CollectiveMPIO", "yes");
+#endif
+
+        auto var_a = io.DefineVariable<double>("a", {Nx * mpiSize, Ny}, {Nx * mpiRank, 0},
+                                               {Nx, Ny});
+        var_a.AddOperation("bzip2", {{"blockSize100k", "5"}});
+        auto var_s = io.DefineVariable<int32_t>("s");
+        var_s.AddOperation("bzip2");
+
+        std::vector<double> a(Nx * Ny);
+        adios2::Engine h5Writer = io.Open(fname, adios2::Mode::Write);
+        for (size_t step = 0; step < NSteps; ++step)
+        {
+            for (size_t i = 0; i < Nx * Ny; ++i)
+            {
+                a[i] = static_cast<double>(step * 1000 + Nx * Ny * mpiRank + i);
+            }
+            const int32_t s = static_cast<int32_t>(step);
+            h5Writer.BeginStep();
+            h5Writer.Put(var_a, a.data());
+            h5Writer.Put(var_s, s);
+            h5Writer.EndStep();
+        }
+        h5Writer.Close();
+    }
+#ifdef TEST_HDF5_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine h5Reader = io.Open(fname, adios2::Mode::Read);
+
+        size_t step = 0;
+        while (h5Reader.BeginStep() == adios2::StepStatus::OK)
+        {
+            auto var_a = io.InquireVariable<double>("a");
+            ASSERT_TRUE(var_a);
+            std::vector<double> a;
+            var_a.SetSelection({{0, 0}, {Nx * mpiSize, Ny}});
+            h5Reader.Get(var_a, a, adios2::Mode::Sync);
+            for (size_t i = 0; i < Nx * mpiSize * Ny; ++i)
+            {
+                ASSERT_EQ(a[i], static_cast<double>(step * 1000 + i)) << "step " << step;
+            }
+            h5Reader.EndStep();
+            ++step;
+        }
+        EXPECT_EQ(step, NSteps);
+        h5Reader.Close();
+    }
+
+    if (mpiRank == 0)
+    {
+        CheckFilter(fname, "/Step0/a", {Nx, Ny}, 5);
+        CheckFilter(fname, "/Step1/a", {Nx, Ny}, 5);
+    }
+}
+
+TEST(HDF5WriteOperators, BZIP2Sync) { WriteWithOperator("HDF5WriteOperatorsSync.h5", false); }
+
+TEST(HDF5WriteOperators, BZIP2Deferred)
+{
+    WriteWithOperator("HDF5WriteOperatorsDeferred.h5", true);
+}
+
+// every rank writes a block of another size, the chunk shape must be the
+// same on all ranks for the collective H5Dcreate
+TEST(HDF5WriteOperators, UnevenBlocks)
+{
+    int mpiRank = 0, mpiSize = 1;
+#ifdef TEST_HDF5_MPI
+    MPI_Comm_rank(MPI_COMM_WORLD, &mpiRank);
+    MPI_Comm_size(MPI_COMM_WORLD, &mpiSize);
+#endif
+    RegisterPassThrough();
+    const std::string fname = "HDF5WriteOperatorsUneven.h5";
+
+    // rank r writes Nx + r rows
+    const size_t Nx = 4;
+    const size_t Ny = 3;
+    const size_t rows = Nx * mpiSize + mpiSize * (mpiSize - 1) / 2;
+    const size_t row0 = Nx * mpiRank + mpiRank * (mpiRank - 1) / 2;
+    const size_t myRows = Nx + mpiRank;
+
+#ifdef TEST_HDF5_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    {
+        adios2::IO io = adios.DeclareIO("WriteIO");
+        io.SetEngine(engineName);
+#ifdef TEST_HDF5_MPI
+        io.SetParameter("H5CollectiveMPIO", "yes");
+#endif
+        auto var = io.DefineVariable<double>("u", {rows, Ny}, {row0, 0}, {myRows, Ny});
+        var.AddOperation("bzip2", {{"blockSize100k", "3"}});
+
+        std::vector<double> u(myRows * Ny);
+        for (size_t i = 0; i < u.size(); ++i)
+        {
+            u[i] = static_cast<double>(row0 * Ny + i);
+        }
+        adios2::Engine h5Writer = io.Open(fname, adios2::Mode::Write);
+        h5Writer.BeginStep();
+        h5Writer.Put(var, u.data(), adios2::Mode::Sync);
+        h5Writer.EndStep();
+        h5Writer.Close();
+    }
+#ifdef TEST_HDF5_MPI
+    MPI_Barrier(MPI_COMM_WORLD);
+#endif
+
+    {
+        adios2::IO io = adios.DeclareIO("ReadIO");
+        io.SetEngine(engineName);
+        adios2::Engine h5Reader = io.Open(fname, adios2::Mode::Read);
+        h5Reader.BeginStep();
+        auto var = io.InquireVariable<double>("u");
+        ASSERT_TRUE(var);
+        std::vector<double> u;
+        var.SetSelection({{0, 0}, {rows, Ny}});
+        h5Reader.Get(var, u, adios2::Mode::Sync);
+        for (size_t i = 0; i < rows * Ny; ++i)
+        {
+            ASSERT_EQ(u[i], static_cast<double>(i));
+        }
+        h5Reader.EndStep();
+        h5Reader.Close();
+    }
+
+    if (mpiRank == 0)
+    {
+        // the largest block
+        CheckFilter(fname, "/Step0/u", {Nx + mpiSize - 1, Ny}, 3);
+    }
+}
+
+TEST(HDF5WriteOperators, FilterMapping)
+{
+    H5Z_filter_t filter;
+    std::vector<unsigned int> cd;
+
+    // hdf5-blosc: 0-3 filled in by the filter, level, shuffle, compressor
+    GetFilter("blosc", {{"clevel", "7"}, {"doshuffle", "BLOSC_BITSHUFFLE"}, {"compressor", "zstd"}},
+              filter, cd);
+    EXPECT_EQ(filter, 32001);
+    EXPECT_EQ(cd, std::vector<unsigned int>({0, 0, 0, 0, 7, 2, 5}));
+    GetFilter("blosc", {}, filter, cd);
+    EXPECT_EQ(cd, std::vector<unsigned int>({0, 0, 0, 0, 1, 1, 0}));
+    EXPECT_THROW(GetFilter("blosc", {{"compressor", "gzip"}}, filter, cd),
+                 std::invalid_argument);
+
+    // H5Z-ZFP: mode, unused, then the rate or accuracy double or the precision
+    GetFilter("zfp", {{"rate", "8.5"}}, filter, cd);
+    EXPECT_EQ(filter, 32013);
+    ASSERT_EQ(cd.size(), 4);
+    EXPECT_EQ(cd[0], 1);
+    EXPECT_EQ(GetDouble(cd, 2), 8.5);
+    GetFilter("zfp", {{"accuracy", "0.001"}}, filter, cd);
+    ASSERT_EQ(cd.size(), 4);
+    EXPECT_EQ(cd[0], 3);
+    EXPECT_EQ(GetDouble(cd, 2), 0.001);
+    GetFilter("zfp", {{"precision", "20"}}, filter, cd);
+    EXPECT_EQ(cd, std::vector<unsigned int>({2, 0, 20}));
+    GetFilter("zfp", {}, filter, cd);
+    EXPECT_EQ(cd, std::vector<unsigned int>({5}));
+
+    // H5Z-SZ: error bound mode, then abs, rel, pw_rel and psnr doubles
+    GetFilter("sz", {{"rel", "0.01"}}, filter, cd);
+    EXPECT_EQ(filter, 32017);
+    ASSERT_EQ(cd.size(), 9);
+    EXPECT_EQ(cd[0], 1);
+    EXPECT_EQ(GetDouble(cd, 1), 1e-4);
+    EXPECT_EQ(GetDouble(cd, 3), 0.01);
+    EXPECT_EQ(GetDouble(cd, 5), 0.);
+    GetFilter("sz", {{"pwr", "0.1"}}, filter, cd);
+    EXPECT_EQ(cd[0], 10);
+    EXPECT_EQ(GetDouble(cd, 5), 0.1);
+    GetFilter("sz", {{"abs", "0.5"}}, filter, cd);
+    EXPECT_EQ(cd[0], 0);
+    EXPECT_EQ(GetDouble(cd, 1), 0.5);
+
+    GetFilter("bzip2", {{"blockSize100k", "9"}}, filter, cd);
+    EXPECT_EQ(filter, 307);
+    EXPECT_EQ(cd, std::vector<unsigned int>({9}));
+    EXPECT_THROW(GetFilter("mgard", {}, filter, cd), std::invalid_argument);
+}
+
+TEST(HDF5WriteOperators, Unsupported)
+{
+#ifdef TEST_HDF5_MPI
+    adios2::ADIOS adios(MPI_COMM_WORLD);
+#else
+    adios2::ADIOS adios;
+#endif
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine(engineName);
+    auto var = io.DefineVariable<double>("a", {10}, {0}, {10});
+    var.AddOperation("null");
+    std::vector<double> a(10, 1.);
+
+    adios2::Engine h5Writer = io.Open("HDF5WriteOperatorsUnsupported.h5", adios2::Mode::Write);
+    h5Writer.BeginStep();
+    EXPECT_THROW(h5Writer.Put(var, a.data(), adios2::Mode::Sync), std::invalid_argument);
+    h5Writer.EndStep();
+    h5Writer.Close();
+}
+
+int main(int argc, char **argv)
+{
+#ifdef TEST_HDF5_MPI
+    int provided;
+
+    // MPI_THREAD_MULTIPLE is only required if you enable the SST MPI_DP
+    MPI_Init_thread(nullptr, nullptr, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+
+    engineName = "HDF5";
+
+    if (argc > 1)
+    {
+        engineName = std::string(argv[1]);
+    }
+
+    result = RUN_ALL_TESTS();
+
+#ifdef TEST_HDF5_MPI
+    MPI_Finalize();
+#endif
+
+    return result;
+}
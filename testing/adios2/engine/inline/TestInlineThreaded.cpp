@@ -0,0 +1,238 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * Threaded inline engine: writer and reader on two threads
+ */
+#include <algorithm>
+#include <cstdint>
+#include <future>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+class InlineThreaded : public ::testing::TestWithParam<bool>
+{
+public:
+    InlineThreaded() = default;
+};
+
+namespace
+{
+const size_t Nx = 1000;
+const size_t NSteps = 20;
+const size_t QueueDepth = 3;
+
+double Value(const size_t step, const size_t i) { return static_cast<double>(step * Nx + i); }
+
+void Write(adios2::IO io, const bool copyOnPut)
+{
+    auto varA = io.DefineVariable<double>("a", {2 * Nx}, {0}, {Nx});
+    auto varStep = io.DefineVariable<uint64_t>("step");
+    auto varName = io.DefineVariable<std::string>("name");
+
+    // without copies the buffer of a step is free again QueueDepth steps later
+    std::vector<std::vector<double>> buffers(copyOnPut ? 1 : QueueDepth,
+                                             std::vector<double>(2 * Nx));
+    adios2::Engine writer = io.Open("threaded", adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        ASSERT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+        std::vector<double> &buffer = buffers[step % buffers.size()];
+        for (size_t block = 0; block < 2; ++block)
+        {
+            double *a = copyOnPut ? buffer.data() : buffer.data() + block * Nx;
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                a[i] = Value(step, block * Nx + i);
+            }
+            varA.SetSelection({{block * Nx}, {Nx}});
+            writer.Put(varA, a);
+            if (copyOnPut)
+            {
+                // the step has its own copy
+                std::fill(buffer.begin(), buffer.end(), -1.0);
+            }
+        }
+        writer.Put(varStep, static_cast<uint64_t>(step));
+        writer.Put(varName, "step " + std::to_string(step));
+        writer.EndStep();
+    }
+    writer.Close();
+}
+
+size_t Read(adios2::IO io, size_t &errors)
+{
+    adios2::Engine reader = io.Open("threaded", adios2::Mode::Read);
+    size_t steps = 0;
+    while (true)
+    {
+        const adios2::StepStatus status = reader.BeginStep(adios2::StepMode::Read, 10.0f);
+        if (status != adios2::StepStatus::OK)
+        {
+            errors += status != adios2::StepStatus::EndOfStream;
+            break;
+        }
+        const size_t step = reader.CurrentStep();
+        errors += step != steps;
+
+        auto varStep = io.InquireVariable<uint64_t>("step");
+        uint64_t value = 0;
+        reader.Get(varStep, value);
+        errors += value != step;
+
+        auto varName = io.InquireVariable<std::string>("name");
+        std::string name;
+        reader.Get(varName, name);
+        errors += name != "step " + std::to_string(step);
+
+        auto varA = io.InquireVariable<double>("a");
+        const auto blocks = reader.BlocksInfo(varA, step);
+        errors += blocks.size() != 2;
+        for (const auto &block : blocks)
+        {
+            varA.SetBlockSelection(block.BlockID);
+            typename adios2::Variable<double>::Info info = block;
+            reader.Get(varA, info);
+            reader.PerformGets();
+            const double *a = info.Data();
+            for (size_t i = 0; i < Nx; ++i)
+            {
+                errors += a[i] != Value(step, block.Start[0] + i);
+            }
+        }
+        reader.EndStep();
+        ++steps;
+    }
+    reader.Close();
+    return steps;
+}
+}
+
+TEST_P(InlineThreaded, WriteRead)
+{
+    const bool copyOnPut = GetParam();
+    adios2::ADIOS adios;
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("Inline");
+    writeIO.SetParameters({{"Threaded", "true"},
+                           {"QueueDepth", std::to_string(QueueDepth)},
+                           {"CopyOnPut", copyOnPut ? "true" : "false"}});
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("Inline");
+    readIO.SetParameters({{"Threaded", "true"}});
+
+    size_t errors = 0;
+    auto readFuture = std::async(std::launch::async, Read, readIO, std::ref(errors));
+    auto writeFuture = std::async(std::launch::async, Write, writeIO, copyOnPut);
+    writeFuture.get();
+    EXPECT_EQ(readFuture.get(), NSteps);
+    EXPECT_EQ(errors, 0);
+}
+
+INSTANTIATE_TEST_SUITE_P(Inline, InlineThreaded, ::testing::Values(false, true));
+
+TEST(InlineThreadedQueue, NotReady)
+{
+    adios2::ADIOS adios;
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("Inline");
+    writeIO.SetParameters({{"Threaded", "true"}, {"QueueDepth", "1"}});
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("Inline");
+    readIO.SetParameters({{"Threaded", "true"}});
+
+    adios2::Engine writer = writeIO.Open("queue", adios2::Mode::Write);
+    adios2::Engine reader = readIO.Open("queue", adios2::Mode::Read);
+    EXPECT_EQ(reader.BeginStep(adios2::StepMode::Read, 0.0f), adios2::StepStatus::NotReady);
+
+    // one slot, the second step has to wait for the reader
+    EXPECT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+    writer.EndStep();
+    EXPECT_EQ(writer.BeginStep(adios2::StepMode::Append, 0.0f), adios2::StepStatus::NotReady);
+
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    reader.EndStep();
+    EXPECT_EQ(writer.BeginStep(adios2::StepMode::Append, 0.0f), adios2::StepStatus::OK);
+    writer.EndStep();
+
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    EXPECT_EQ(reader.CurrentStep(), 1);
+    reader.EndStep();
+    writer.Close();
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+    reader.Close();
+}
+
+TEST(InlineThreadedQueue, CloseWithoutReader)
+{
+    adios2::ADIOS adios;
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("Inline");
+    writeIO.SetParameters({{"Threaded", "true"}, {"QueueDepth", "1"}});
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("Inline");
+    readIO.SetParameters({{"Threaded", "true"}});
+
+    // the step is dropped, a reader opening afterwards finds a new stream
+    adios2::Engine writer = writeIO.Open("noreader", adios2::Mode::Write);
+    EXPECT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+    writer.EndStep();
+    writer.Close();
+    adios2::Engine reader = readIO.Open("noreader", adios2::Mode::Read);
+    EXPECT_EQ(reader.BeginStep(adios2::StepMode::Read, 0.0f), adios2::StepStatus::NotReady);
+    reader.Close();
+}
+
+TEST(InlineThreadedQueue, ReaderGone)
+{
+    adios2::ADIOS adios;
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("Inline");
+    writeIO.SetParameters({{"Threaded", "true"}, {"QueueDepth", "2"}});
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("Inline");
+    readIO.SetParameters({{"Threaded", "true"}});
+
+    // the reader is destroyed without Close while it holds a step
+    adios2::Engine writer = writeIO.Open("gone", adios2::Mode::Write);
+    adios2::Engine reader = readIO.Open("gone", adios2::Mode::Read);
+    EXPECT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+    writer.EndStep();
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    adios.RemoveIO("ReadIO");
+    EXPECT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+    writer.EndStep();
+    writer.Close();
+}
+
+TEST(InlineThreadedQueue, CloseTimeout)
+{
+    adios2::ADIOS adios;
+    adios2::IO writeIO = adios.DeclareIO("WriteIO");
+    writeIO.SetEngine("Inline");
+    writeIO.SetParameters({{"Threaded", "true"}, {"CloseTimeoutSecs", "0.1"}});
+    adios2::IO readIO = adios.DeclareIO("ReadIO");
+    readIO.SetEngine("Inline");
+    readIO.SetParameters({{"Threaded", "true"}});
+
+    // the reader keeps its step past the writer's Close, which gives up
+    adios2::Engine writer = writeIO.Open("timeout", adios2::Mode::Write);
+    adios2::Engine reader = readIO.Open("timeout", adios2::Mode::Read);
+    EXPECT_EQ(writer.BeginStep(), adios2::StepStatus::OK);
+    writer.EndStep();
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::OK);
+    writer.Close();
+    reader.EndStep();
+    EXPECT_EQ(reader.BeginStep(), adios2::StepStatus::EndOfStream);
+    reader.Close();
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,224 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * SpeculativePreloadMode=Learned, writer and reader on two threads
+ */
+#include <cstdint>
+#include <future>
+#include <map>
+#include <string>
+#include <vector>
+
+#include <adios2.h>
+
+#include <gtest/gtest.h>
+
+#ifdef _MSC_VER
+#include <process.h>
+#define getpid _getpid
+#else
+#include <unistd.h>
+#endif
+
+class SstPrefetchTest : public ::testing::Test
+{
+public:
+    SstPrefetchTest() = default;
+};
+
+namespace
+{
+const size_t Nx = 40;
+const size_t Ny = 50;
+const size_t Nb = 1000;
+const size_t NSteps = 6;
+// the step in which the reader also takes a corner of "a", once
+const size_t ExtraStep = 3;
+
+double A(const size_t step, const size_t i, const size_t j)
+{
+    return static_cast<double>(step * 10000 + i * Ny + j);
+}
+
+int32_t B(const size_t step, const size_t i) { return static_cast<int32_t>(step * 7 + i); }
+
+bool Write(const std::string &name)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("WriteIO");
+    io.SetEngine("SST");
+    io.SetParameters({{"MarshalMethod", "BP5"}});
+    auto varA = io.DefineVariable<double>("a", {Nx, Ny}, {0, 0}, {Nx, Ny});
+    auto varB = io.DefineVariable<int32_t>("b", {Nb}, {0}, {Nb});
+
+    std::vector<double> a(Nx * Ny);
+    std::vector<int32_t> b(Nb);
+    adios2::Engine writer = io.Open(name, adios2::Mode::Write);
+    for (size_t step = 0; step < NSteps; ++step)
+    {
+        for (size_t i = 0; i < Nx; ++i)
+        {
+            for (size_t j = 0; j < Ny; ++j)
+            {
+                a[i * Ny + j] = A(step, i, j);
+            }
+        }
+        for (size_t i = 0; i < Nb; ++i)
+        {
+            b[i] = B(step, i);
+        }
+        writer.BeginStep();
+        writer.Put(varA, a.data());
+        writer.Put(varB, b.data());
+        writer.EndStep();
+    }
+    writer.Close();
+    return true;
+}
+
+std::map<std::string, double> Read(const std::string &name, size_t &errors, size_t &steps)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("SST");
+    io.SetParameters({{"SpeculativePreloadMode", "Learned"}});
+
+    adios2::Engine reader = io.Open(name, adios2::Mode::Read);
+    std::vector<double> slab, corner;
+    std::vector<int32_t> b;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        const size_t step = reader.CurrentStep();
+        auto varA = io.InquireVariable<double>("a");
+        auto varB = io.InquireVariable<int32_t>("b");
+        varA.SetSelection({{10, 0}, {20, Ny}});
+        reader.Get(varA, slab);
+        reader.Get(varB, b, adios2::Mode::Sync);
+        if (step == ExtraStep)
+        {
+            varA.SetSelection({{0, 0}, {5, 5}});
+            reader.Get(varA, corner, adios2::Mode::Sync);
+            for (size_t i = 0; i < 5; ++i)
+            {
+                for (size_t j = 0; j < 5; ++j)
+                {
+                    errors += corner[i * 5 + j] != A(step, i, j);
+                }
+            }
+        }
+        reader.EndStep();
+
+        for (size_t i = 0; i < 20; ++i)
+        {
+            for (size_t j = 0; j < Ny; ++j)
+            {
+                errors += slab[i * Ny + j] != A(step, i + 10, j);
+            }
+        }
+        for (size_t i = 0; i < Nb; ++i)
+        {
+            errors += b[i] != B(step, i);
+        }
+        ++steps;
+    }
+    const std::map<std::string, double> metrics = reader.GetMetrics();
+    reader.Close();
+    return metrics;
+}
+
+// from ExtraStep on, the slab of "a" goes into a buffer with a ghost layer
+std::map<std::string, double> ReadGhosts(const std::string &name, size_t &errors, size_t &steps)
+{
+    adios2::ADIOS adios;
+    adios2::IO io = adios.DeclareIO("ReadIO");
+    io.SetEngine("SST");
+    io.SetParameters({{"SpeculativePreloadMode", "Learned"}});
+
+    adios2::Engine reader = io.Open(name, adios2::Mode::Read);
+    std::vector<int32_t> b;
+    while (reader.BeginStep() == adios2::StepStatus::OK)
+    {
+        const size_t step = reader.CurrentStep();
+        const size_t ghost = step >= ExtraStep ? 1 : 0;
+        const size_t nx = 20 + 2 * ghost;
+        const size_t ny = Ny + 2 * ghost;
+        std::vector<double> slab(nx * ny, -1.0);
+        auto varA = io.InquireVariable<double>("a");
+        auto varB = io.InquireVariable<int32_t>("b");
+        varA.SetSelection({{10, 0}, {20, Ny}});
+        if (ghost)
+        {
+            varA.SetMemorySelection({{ghost, ghost}, {nx, ny}});
+        }
+        reader.Get(varA, slab.data());
+        reader.Get(varB, b, adios2::Mode::Sync);
+        reader.EndStep();
+
+        for (size_t i = 0; i < nx; ++i)
+        {
+            for (size_t j = 0; j < ny; ++j)
+            {
+                const bool inside = i >= ghost && i < nx - ghost && j >= ghost && j < ny - ghost;
+                errors += slab[i * ny + j] != (inside ? A(step, i - ghost + 10, j - ghost) : -1.0);
+            }
+        }
+        for (size_t i = 0; i < Nb; ++i)
+        {
+            errors += b[i] != B(step, i);
+        }
+        ++steps;
+    }
+    const std::map<std::string, double> metrics = reader.GetMetrics();
+    reader.Close();
+    return metrics;
+}
+}
+
+TEST_F(SstPrefetchTest, Learned)
+{
+    const std::string name = "SstPrefetch_P" + std::to_string(getpid());
+    size_t errors = 0, steps = 0;
+    auto readFuture = std::async(std::launch::async, Read, name, std::ref(errors), std::ref(steps));
+    auto writeFuture = std::async(std::launch::async, Write, name);
+    EXPECT_TRUE(writeFuture.get());
+    const std::map<std::string, double> metrics = readFuture.get();
+
+    EXPECT_EQ(steps, NSteps);
+    EXPECT_EQ(errors, 0);
+    // the first step and the extra corner go to the writer, all else is
+    // prefetched; the corner is prefetched once more for nothing
+    EXPECT_EQ(metrics.at("prefetch_misses"), 3.0);
+    EXPECT_EQ(metrics.at("prefetch_hits"), 2.0 * (NSteps - 1));
+    EXPECT_EQ(metrics.at("prefetch_unused"), 1.0);
+    EXPECT_EQ(metrics.at("prefetch_bytes"),
+              (NSteps - 1) * (20 * Ny * sizeof(double) + Nb * sizeof(int32_t)) +
+                  5 * 5 * sizeof(double));
+}
+
+TEST_F(SstPrefetchTest, MemorySelection)
+{
+    const std::string name = "SstPrefetchGhosts_P" + std::to_string(getpid());
+    size_t errors = 0, steps = 0;
+    auto readFuture =
+        std::async(std::launch::async, ReadGhosts, name, std::ref(errors), std::ref(steps));
+    auto writeFuture = std::async(std::launch::async, Write, name);
+    EXPECT_TRUE(writeFuture.get());
+    const std::map<std::string, double> metrics = readFuture.get();
+
+    EXPECT_EQ(steps, NSteps);
+    EXPECT_EQ(errors, 0);
+    // the slab prefetched for ExtraStep is not used, as it has a memory
+    // selection there, and it is not prefetched after that
+    EXPECT_EQ(metrics.at("prefetch_misses"), 2.0);
+    EXPECT_EQ(metrics.at("prefetch_hits"), (NSteps - 1) + (ExtraStep - 1));
+    EXPECT_EQ(metrics.at("prefetch_unused"), 1.0);
+    EXPECT_EQ(metrics.at("prefetch_bytes"),
+              (NSteps - 1) * Nb * sizeof(int32_t) + ExtraStep * 20 * Ny * sizeof(double));
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
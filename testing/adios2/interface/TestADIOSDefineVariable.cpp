@@ -624,6 +624,51 @@ TEST_F(ADIOSDefineVariableTest, DefineCheckType)
     EXPECT_EQ(io.VariableType("ul"), adios2::GetType<unsigned long>());
 }
 
+TEST_F(ADIOSDefineVariableTest, VariableHandles)
+{
+    const adios2::Dims shape = {10};
+    const adios2::Dims start = {0};
+    const adios2::Dims count = {10};
+
+    io.DefineVariable<double>("r64", shape, start, count);
+    io.DefineVariable<int32_t>("i32", shape, start, count);
+    const size_t r64 = io.VariableHandle("r64");
+    const size_t i32 = io.VariableHandle("i32");
+    EXPECT_NE(r64, i32);
+    EXPECT_EQ(io.VariableHandle("none"), adios2::MaxSizeT);
+
+    EXPECT_TRUE(io.InquireVariable<double>(r64));
+    EXPECT_EQ(io.InquireVariable<double>(r64).Name(), "r64");
+    EXPECT_FALSE(io.InquireVariable<float>(r64));
+    EXPECT_EQ(io.InquireVariable<int32_t>(i32).Name(), "i32");
+    EXPECT_FALSE(io.InquireVariable<double>(adios2::MaxSizeT));
+
+    // the handle of a removed variable is invalid until it is reused
+    EXPECT_TRUE(io.RemoveVariable("r64"));
+    EXPECT_FALSE(io.InquireVariable<double>(r64));
+    io.DefineVariable<float>("r32", shape, start, count);
+    EXPECT_EQ(io.VariableHandle("r32"), r64);
+    EXPECT_EQ(io.InquireVariable<float>(r64).Name(), "r32");
+    EXPECT_EQ(io.InquireVariable<int32_t>(i32).Name(), "i32");
+
+    io.RemoveAllVariables();
+    EXPECT_FALSE(io.InquireVariable<int32_t>(i32));
+}
+
+TEST_F(ADIOSDefineVariableTest, AvailableVariableInfo)
+{
+    io.DefineVariable<int32_t>("i32", {10}, {0}, {10});
+    io.DefineVariable<double>("r64");
+
+    const adios2::Params info = io.AvailableVariableInfo("i32");
+    EXPECT_EQ(info.at("Type"), "int32_t");
+    EXPECT_EQ(info.at("Shape"), "10");
+    EXPECT_EQ(info.at("SingleValue"), "false");
+    EXPECT_EQ(io.AvailableVariables().at("i32"), info);
+    EXPECT_EQ(io.AvailableVariableInfo("r64").at("SingleValue"), "true");
+    EXPECT_TRUE(io.AvailableVariableInfo("none").empty());
+}
+
 TEST_F(ADIOSDefineVariableTest, DefineStructVariable)
 {
     const adios2::Dims shape = {10};
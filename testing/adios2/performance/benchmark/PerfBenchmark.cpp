@@ -0,0 +1,923 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ *
+ * PerfBenchmark.cpp : engine level I/O benchmarks.
+ *
+ * Results are written as a JSON array with one entry per rank, laid out like
+ * the profiling.json of the JSONProfiler ("<case>_mus" plus a
+ * {"mus", "nCalls"} object per case), so compare_benchmarks.py can compare
+ * two runs of either.
+ */
+#include <algorithm>
+#include <cctype>
+#include <chrono>
+#include <cmath>
+#include <cstdint>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iostream>
+#include <sstream>
+#include <stdexcept>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2.h>
+#if ADIOS2_USE_MPI
+#include <mpi.h>
+#endif
+
+namespace
+{
+
+struct Options
+{
+    std::string engine = "BP5";
+    adios2::Params engineParams;
+    size_t sizeMB = 64; // per rank, for the bandwidth suites
+    size_t steps = 5;
+    size_t stagingKB = 1024;
+    std::string dir = ".";
+    std::string output; // stdout if empty
+    std::vector<std::string> suites;
+    std::vector<std::string> stagingEngines;
+    std::string role; // writer or reader, staging between two programs
+    bool quick = false;
+};
+
+Options opts;
+int rank = 0;
+int nproc = 1;
+#if ADIOS2_USE_MPI
+MPI_Comm comm = MPI_COMM_WORLD;
+#endif
+
+/** one benchmark case, written like a JSONProfiler timer */
+struct Measurement
+{
+    std::string name;
+    int64_t mus = 0;
+    uint64_t nCalls = 0;
+    uint64_t bytes = 0;
+};
+
+std::vector<Measurement> results;
+
+Measurement &Result(const std::string &name)
+{
+    for (auto &m : results)
+    {
+        if (m.name == name)
+        {
+            return m;
+        }
+    }
+    results.push_back(Measurement());
+    results.back().name = name;
+    return results.back();
+}
+
+int64_t NowMicros()
+{
+    return std::chrono::duration_cast<std::chrono::microseconds>(
+               std::chrono::steady_clock::now().time_since_epoch())
+        .count();
+}
+
+/** time f and add it as one call of case name moving bytes */
+template <class F>
+void Measure(const std::string &name, const uint64_t bytes, F f)
+{
+    const int64_t start = NowMicros();
+    f();
+    Measurement &m = Result(name);
+    m.mus += NowMicros() - start;
+    ++m.nCalls;
+    m.bytes += bytes;
+}
+
+void Barrier()
+{
+#if ADIOS2_USE_MPI
+    MPI_Barrier(comm);
+#endif
+}
+
+adios2::ADIOS MakeADIOS()
+{
+#if ADIOS2_USE_MPI
+    return adios2::ADIOS(comm);
+#else
+    return adios2::ADIOS();
+#endif
+}
+
+adios2::IO DeclareIO(adios2::ADIOS &adios, const std::string &name,
+                     const adios2::ArrayOrdering order = adios2::ArrayOrdering::Auto)
+{
+    adios2::IO io = adios.DeclareIO(name, order);
+    io.SetEngine(opts.engine);
+    io.SetParameters(opts.engineParams);
+    return io;
+}
+
+std::string ToLower(std::string s)
+{
+    std::transform(s.begin(), s.end(), s.begin(), ::tolower);
+    return s;
+}
+
+std::string FileName(const std::string &name) { return opts.dir + "/PerfBenchmark_" + name; }
+
+void Check(const bool ok, const std::string &what)
+{
+    if (!ok)
+    {
+        throw std::runtime_error("PerfBenchmark: wrong data read in " + what);
+    }
+}
+
+/*
+ * write/read: bandwidth of one contiguous block per rank of a global 1D
+ * array, opening and closing timed separately
+ */
+void WriteBandwidth()
+{
+    const size_t n = opts.sizeMB * 1024 * 1024 / sizeof(double);
+    std::vector<double> data(n);
+    adios2::ADIOS adios = MakeADIOS();
+    adios2::IO io = DeclareIO(adios, "write");
+    auto var = io.DefineVariable<double>("data", {n * nproc}, {n * rank}, {n});
+
+    adios2::Engine writer;
+    Barrier();
+    Measure("write_open", 0, [&]() { writer = io.Open(FileName("bw.bp"), adios2::Mode::Write); });
+    for (size_t step = 0; step < opts.steps; ++step)
+    {
+        std::fill(data.begin(), data.end(), static_cast<double>(step + rank));
+        Barrier();
+        Measure("write", n * sizeof(double), [&]() {
+            writer.BeginStep();
+            writer.Put(var, data.data());
+            writer.EndStep();
+        });
+    }
+    Measure("write_close", 0, [&]() { writer.Close(); });
+}
+
+void ReadBandwidth()
+{
+    const size_t n = opts.sizeMB * 1024 * 1024 / sizeof(double);
+    std::vector<double> data(n);
+    adios2::ADIOS adios = MakeADIOS();
+    adios2::IO io = DeclareIO(adios, "read");
+
+    adios2::Engine reader;
+    Barrier();
+    Measure("read_open", 0, [&]() { reader = io.Open(FileName("bw.bp"), adios2::Mode::Read); });
+    size_t step = 0;
+    while (true)
+    {
+        bool more = true;
+        Barrier();
+        Measure("read", n * sizeof(double), [&]() {
+            if (reader.BeginStep() != adios2::StepStatus::OK)
+            {
+                more = false;
+                return;
+            }
+            auto var = io.InquireVariable<double>("data");
+            var.SetSelection({{n * rank}, {n}});
+            reader.Get(var, data.data());
+            reader.EndStep();
+        });
+        if (!more)
+        {
+            // the last call only found the end of the stream
+            --Result("read").nCalls;
+            Result("read").bytes -= n * sizeof(double);
+            break;
+        }
+        Check(data[0] == static_cast<double>(step + rank) && data[n - 1] == data[0], "read");
+        ++step;
+    }
+    Measure("read_close", 0, [&]() { reader.Close(); });
+}
+
+/*
+ * metadata: cost of opening a file and walking its steps without reading
+ * data, for a growing number of steps of many small variables
+ */
+void Metadata()
+{
+    const size_t nVars = opts.quick ? 10 : 100;
+    std::vector<size_t> stepCounts = {1, 10, 100};
+    if (!opts.quick)
+    {
+        stepCounts.push_back(1000);
+    }
+
+    adios2::ADIOS adios = MakeADIOS();
+    for (const size_t nSteps : stepCounts)
+    {
+        const std::string fname = FileName("metadata_" + std::to_string(nSteps) + ".bp");
+        {
+            adios2::IO io = DeclareIO(adios, "metadata_w" + std::to_string(nSteps));
+            std::vector<adios2::Variable<double>> vars;
+            for (size_t v = 0; v < nVars; ++v)
+            {
+                vars.push_back(io.DefineVariable<double>("v" + std::to_string(v), {size_t(nproc)},
+                                                         {size_t(rank)}, {1}));
+            }
+            adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+            for (size_t step = 0; step < nSteps; ++step)
+            {
+                writer.BeginStep();
+                const double value = static_cast<double>(step);
+                for (auto &var : vars)
+                {
+                    writer.Put(var, &value, adios2::Mode::Sync);
+                }
+                writer.EndStep();
+            }
+            writer.Close();
+        }
+
+        const std::string name = "metadata_" + std::to_string(nSteps) + "steps";
+        adios2::IO io = DeclareIO(adios, "metadata_r" + std::to_string(nSteps));
+        Barrier();
+        Measure(name + "_open", 0, [&]() {
+            adios2::Engine reader = io.Open(fname, adios2::Mode::ReadRandomAccess);
+            reader.Close();
+        });
+        Barrier();
+        Measure(name + "_steps", 0, [&]() {
+            adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+            while (reader.BeginStep() == adios2::StepStatus::OK)
+            {
+                reader.EndStep();
+            }
+            reader.Close();
+        });
+    }
+}
+
+/*
+ * smallblocks: per block overhead of many tiny blocks per rank, one call
+ * per block
+ */
+void SmallBlocks()
+{
+    const size_t nBlocks = opts.quick ? 100 : 10000;
+    const size_t blockSize = 16;
+    const std::string fname = FileName("smallblocks.bp");
+    std::vector<double> data(nBlocks * blockSize);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<double>(i);
+    }
+
+    adios2::ADIOS adios = MakeADIOS();
+    {
+        adios2::IO io = DeclareIO(adios, "smallblocks_w");
+        const size_t total = nBlocks * blockSize * nproc;
+        auto var = io.DefineVariable<double>("data", {total}, {0}, {blockSize});
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        Barrier();
+        const int64_t start = NowMicros();
+        writer.BeginStep();
+        for (size_t b = 0; b < nBlocks; ++b)
+        {
+            var.SetSelection({{(rank * nBlocks + b) * blockSize}, {blockSize}});
+            writer.Put(var, data.data() + b * blockSize);
+        }
+        writer.EndStep();
+        writer.Close();
+        Measurement &m = Result("smallblocks_write");
+        m.mus += NowMicros() - start;
+        m.nCalls += nBlocks;
+        m.bytes += data.size() * sizeof(double);
+    }
+
+    std::vector<double> in(data.size());
+    adios2::IO io = DeclareIO(adios, "smallblocks_r");
+    Barrier();
+    const int64_t start = NowMicros();
+    adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+    reader.BeginStep();
+    auto var = io.InquireVariable<double>("data");
+    for (size_t b = 0; b < nBlocks; ++b)
+    {
+        var.SetSelection({{(rank * nBlocks + b) * blockSize}, {blockSize}});
+        reader.Get(var, in.data() + b * blockSize);
+    }
+    reader.EndStep();
+    reader.Close();
+    Measurement &m = Result("smallblocks_read");
+    m.mus += NowMicros() - start;
+    m.nCalls += nBlocks;
+    m.bytes += in.size() * sizeof(double);
+    Check(in == data, "smallblocks");
+}
+
+/*
+ * compression: write and read throughput of a smooth field through every
+ * operator this build has, "none" is the baseline
+ */
+void Compression()
+{
+    std::vector<std::pair<std::string, adios2::Params>> operators = {{"none", {}},
+                                                                     {"pack", {}}};
+#ifdef ADIOS2_HAVE_BZIP2
+    operators.push_back({"bzip2", {}});
+#endif
+#ifdef ADIOS2_HAVE_BLOSC2
+    operators.push_back({"blosc", {{"clevel", "5"}, {"doshuffle", "BLOSC_SHUFFLE"}}});
+#endif
+#ifdef ADIOS2_HAVE_ZFP
+    operators.push_back({"zfp", {{"rate", "8"}}});
+#endif
+#ifdef ADIOS2_HAVE_SZ
+    operators.push_back({"sz", {{"accuracy", "0.001"}}});
+#endif
+#ifdef ADIOS2_HAVE_MGARD
+    operators.push_back({"mgard", {{"accuracy", "0.001"}}});
+#endif
+
+    const size_t n = std::max<size_t>(opts.sizeMB / 4, 1) * 1024 * 1024 / sizeof(double);
+    std::vector<double> data(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        data[i] = std::sin(0.001 * static_cast<double>(i + n * rank));
+    }
+    std::vector<double> in(n);
+
+    adios2::ADIOS adios = MakeADIOS();
+    for (const auto &op : operators)
+    {
+        const std::string fname = FileName("compress_" + op.first + ".bp");
+        {
+            adios2::IO io = DeclareIO(adios, "compress_w_" + op.first);
+            auto var = io.DefineVariable<double>("data", {n * nproc}, {n * rank}, {n});
+            if (op.first != "none")
+            {
+                var.AddOperation(op.first, op.second);
+            }
+            adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+            Barrier();
+            Measure("compress_" + op.first + "_write", n * sizeof(double), [&]() {
+                writer.BeginStep();
+                writer.Put(var, data.data());
+                writer.EndStep();
+            });
+            writer.Close();
+        }
+        adios2::IO io = DeclareIO(adios, "compress_r_" + op.first);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        Barrier();
+        Measure("compress_" + op.first + "_read", n * sizeof(double), [&]() {
+            reader.BeginStep();
+            auto var = io.InquireVariable<double>("data");
+            var.SetSelection({{n * rank}, {n}});
+            reader.Get(var, in.data());
+            reader.EndStep();
+        });
+        reader.Close();
+    }
+}
+
+/*
+ * selection: reads of a 3D array written with one cube per rank, as a plane
+ * across all ranks, every 4th row of the own cube, and the own cube seen
+ * from a column-major reader
+ */
+void Selection()
+{
+    const size_t cubeBytes = std::max<size_t>(opts.sizeMB / 4, 1) * 1024 * 1024;
+    const size_t n = static_cast<size_t>(std::cbrt(static_cast<double>(cubeBytes / sizeof(float))));
+    const size_t gx = n * nproc;
+    const std::string fname = FileName("selection.bp");
+
+    std::vector<float> data(n * n * n);
+    for (size_t i = 0; i < data.size(); ++i)
+    {
+        data[i] = static_cast<float>(i % 1000);
+    }
+
+    adios2::ADIOS adios = MakeADIOS();
+    {
+        adios2::IO io = DeclareIO(adios, "selection_w");
+        auto var = io.DefineVariable<float>("data", {gx, n, n}, {n * rank, 0, 0}, {n, n, n});
+        adios2::Engine writer = io.Open(fname, adios2::Mode::Write);
+        writer.BeginStep();
+        writer.Put(var, data.data());
+        writer.EndStep();
+        writer.Close();
+    }
+
+    {
+        adios2::IO io = DeclareIO(adios, "selection_slice");
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        reader.BeginStep();
+        auto var = io.InquireVariable<float>("data");
+        std::vector<float> in(gx * n);
+        Barrier();
+        Measure("selection_slice", in.size() * sizeof(float), [&]() {
+            var.SetSelection({{0, 0, n / 2}, {gx, n, 1}});
+            reader.Get(var, in.data(), adios2::Mode::Sync);
+        });
+        Check(in[1] == data[n + n / 2], "selection_slice");
+        reader.EndStep();
+        reader.Close();
+    }
+
+    {
+        adios2::IO io = DeclareIO(adios, "selection_strided");
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        reader.BeginStep();
+        auto var = io.InquireVariable<float>("data");
+        const size_t stride = 4;
+        const size_t nRows = (n + stride - 1) / stride;
+        std::vector<float> in(nRows * n * n);
+        Barrier();
+        Measure("selection_strided", in.size() * sizeof(float), [&]() {
+            for (size_t r = 0; r < nRows; ++r)
+            {
+                var.SetSelection({{n * rank, r * stride, 0}, {n, 1, n}});
+                reader.Get(var, in.data() + r * n * n);
+            }
+            reader.PerformGets();
+        });
+        Check(in[n] == data[n * n] && (nRows < 2 || in[n * n] == data[stride * n]),
+              "selection_strided");
+        reader.EndStep();
+        reader.Close();
+    }
+
+    {
+        adios2::IO io = DeclareIO(adios, "selection_colmajor", adios2::ArrayOrdering::ColumnMajor);
+        adios2::Engine reader = io.Open(fname, adios2::Mode::Read);
+        reader.BeginStep();
+        auto var = io.InquireVariable<float>("data");
+        std::vector<float> in(data.size());
+        Barrier();
+        Measure("selection_colmajor", in.size() * sizeof(float), [&]() {
+            var.SetSelection({{0, 0, n * rank}, {n, n, n}});
+            reader.Get(var, in.data(), adios2::Mode::Sync);
+        });
+        Check(in == data, "selection_colmajor");
+        reader.EndStep();
+        reader.Close();
+    }
+}
+
+/*
+ * staging: the writer stamps every step, the reader records the time from
+ * the stamp of the slowest writer rank until the step is readable
+ */
+void StagingWriter(adios2::ADIOS &adios, const std::string &engine, const std::string &stream,
+                   const adios2::Params &params, const int wRank, const int wSize)
+{
+    const size_t n = opts.stagingKB * 1024 / sizeof(double);
+    std::vector<double> data(n, static_cast<double>(wRank));
+    adios2::IO io = adios.DeclareIO("staging_w_" + stream);
+    io.SetEngine(engine);
+    io.SetParameters(params);
+    auto varTime = io.DefineVariable<int64_t>("time", {size_t(wSize)}, {size_t(wRank)}, {1});
+    auto var = io.DefineVariable<double>("data", {n * wSize}, {n * wRank}, {n});
+
+    adios2::Engine writer = io.Open(stream, adios2::Mode::Write);
+    for (size_t step = 0; step < opts.steps * 4; ++step)
+    {
+        Measure("staging_" + engine + "_write", n * sizeof(double), [&]() {
+            writer.BeginStep();
+            const int64_t now = NowMicros();
+            writer.Put(varTime, &now);
+            writer.Put(var, data.data());
+            writer.EndStep();
+        });
+    }
+    writer.Close();
+}
+
+void StagingReader(adios2::ADIOS &adios, const std::string &engine, const std::string &stream,
+                   const adios2::Params &params, const int rRank, const int rSize)
+{
+    adios2::IO io = adios.DeclareIO("staging_r_" + stream);
+    io.SetEngine(engine);
+    io.SetParameters(params);
+    adios2::Engine reader = io.Open(stream, adios2::Mode::Read);
+    std::vector<int64_t> times;
+    std::vector<double> data;
+    while (reader.BeginStep(adios2::StepMode::Read, 60.0f) == adios2::StepStatus::OK)
+    {
+        auto varTime = io.InquireVariable<int64_t>("time");
+        auto var = io.InquireVariable<double>("data");
+        const size_t total = var.Shape()[0];
+        const size_t count = total / rSize;
+        var.SetSelection({{count * rRank}, {count}});
+        reader.Get(varTime, times);
+        reader.Get(var, data);
+        reader.EndStep();
+        const int64_t stamp = *std::max_element(times.begin(), times.end());
+        Measurement &m = Result("staging_" + engine + "_latency");
+        m.mus += NowMicros() - stamp;
+        ++m.nCalls;
+        m.bytes += count * sizeof(double);
+    }
+    reader.Close();
+}
+
+/** engine parameters, with defaults for a fair latency measurement */
+adios2::Params StagingParams(const std::string &engine, const int port)
+{
+    adios2::Params params = opts.engineParams;
+    const std::string engineLC = ToLower(engine);
+    if (engineLC == "sst")
+    {
+        // keep the writer at most a step ahead, or latency measures queueing
+        params.emplace("QueueLimit", "1");
+    }
+    else if (engineLC == "dataman")
+    {
+        params.emplace("IPAddress", "127.0.0.1");
+        params.emplace("Port", std::to_string(port));
+        params.emplace("TransportMode", "reliable");
+    }
+    return params;
+}
+
+/** writer and reader as two threads of every rank */
+void StagingPair(const std::string &engine)
+{
+    const std::string stream = opts.dir + "/PerfBenchmark_staging_" + engine + std::to_string(rank);
+    const adios2::Params params = StagingParams(engine, 12306 + 10 * rank);
+
+    if (engine == "inline")
+    {
+        // both sides in one IO and one thread, the reader consumes each step
+        const size_t n = opts.stagingKB * 1024 / sizeof(double);
+        std::vector<double> data(n, 1.);
+        adios2::ADIOS adios;
+        adios2::IO io = adios.DeclareIO("staging_inline");
+        io.SetEngine("inline");
+        auto varTime = io.DefineVariable<int64_t>("time", {1}, {0}, {1});
+        auto var = io.DefineVariable<double>("data", {n}, {0}, {n});
+        adios2::Engine writer = io.Open(stream + "_write", adios2::Mode::Write);
+        adios2::Engine reader = io.Open(stream + "_read", adios2::Mode::Read);
+        for (size_t step = 0; step < opts.steps * 4; ++step)
+        {
+            const int64_t now = NowMicros();
+            Measure("staging_inline_write", n * sizeof(double), [&]() {
+                writer.BeginStep();
+                writer.Put(varTime, &now);
+                writer.Put(var, data.data());
+                writer.EndStep();
+            });
+            int64_t stamp = 0;
+            std::vector<double> in;
+            reader.BeginStep();
+            reader.Get(varTime, stamp, adios2::Mode::Sync);
+            reader.Get(var, in, adios2::Mode::Sync);
+            reader.EndStep();
+            Measurement &m = Result("staging_inline_latency");
+            m.mus += NowMicros() - stamp;
+            ++m.nCalls;
+            m.bytes += n * sizeof(double);
+        }
+        writer.Close();
+        reader.Close();
+        return;
+    }
+
+    adios2::ADIOS writerADIOS;
+    adios2::ADIOS readerADIOS;
+    std::thread readerThread(
+        [&]() { StagingReader(readerADIOS, engine, stream, params, 0, 1); });
+    StagingWriter(writerADIOS, engine, stream, params, 0, 1);
+    readerThread.join();
+}
+
+void Staging()
+{
+    for (const auto &engine : opts.stagingEngines)
+    {
+        Barrier();
+        StagingPair(engine);
+    }
+}
+
+void ParseEngineParams(const std::string &input)
+{
+    std::istringstream ss(input);
+    std::string param;
+    while (std::getline(ss, param, ','))
+    {
+        const size_t eq = param.find('=');
+        if (eq == std::string::npos)
+        {
+            throw std::invalid_argument("Engine parameter \"" + param + "\" missing value");
+        }
+        opts.engineParams[param.substr(0, eq)] = param.substr(eq + 1);
+    }
+}
+
+std::vector<std::string> SplitList(const std::string &input)
+{
+    std::vector<std::string> list;
+    std::istringstream ss(input);
+    std::string item;
+    while (std::getline(ss, item, ','))
+    {
+        list.push_back(item);
+    }
+    return list;
+}
+
+void Usage()
+{
+    std::cout
+        << "PerfBenchmark [options] [suite ...]\n"
+        << "  suites: write read metadata smallblocks compression selection staging\n"
+        << "          (default: all of them)\n"
+        << "  --engine <name>           engine of the file suites (BP5)\n"
+        << "  --engine_params <p=v,...> parameters of every engine\n"
+        << "  --size <MB>               data per rank of the bandwidth suites (64)\n"
+        << "  --steps <n>               steps of the bandwidth suites (5)\n"
+        << "  --staging_engines <list>  engines of the staging suite\n"
+        << "  --staging_size <KB>       data per step and writer rank for staging (1024)\n"
+        << "  --role writer|reader      staging between two programs, for example\n"
+        << "                            mpirun -n 2 PerfBenchmark --engine ssc --role writer :\n"
+        << "                                   -n 2 PerfBenchmark --engine ssc --role reader\n"
+        << "  --dir <directory>         where files and streams are created (.)\n"
+        << "  --output <file>           JSON results, stdout by default\n"
+        << "  --quick                   small sizes for a smoke run\n";
+}
+
+void ParseArgs(int argc, char **argv)
+{
+    for (int i = 1; i < argc; ++i)
+    {
+        const std::string arg(argv[i]);
+        auto lf_Value = [&]() -> std::string {
+            if (i + 1 >= argc)
+            {
+                throw std::invalid_argument("missing value of " + arg);
+            }
+            return argv[++i];
+        };
+        if (arg == "--engine")
+        {
+            opts.engine = lf_Value();
+        }
+        else if (arg == "--engine_params")
+        {
+            ParseEngineParams(lf_Value());
+        }
+        else if (arg == "--size")
+        {
+            opts.sizeMB = std::stoul(lf_Value());
+        }
+        else if (arg == "--steps")
+        {
+            opts.steps = std::stoul(lf_Value());
+        }
+        else if (arg == "--staging_engines")
+        {
+            opts.stagingEngines = SplitList(lf_Value());
+        }
+        else if (arg == "--staging_size")
+        {
+            opts.stagingKB = std::stoul(lf_Value());
+        }
+        else if (arg == "--role")
+        {
+            opts.role = lf_Value();
+            if (opts.role != "writer" && opts.role != "reader")
+            {
+                throw std::invalid_argument("--role must be writer or reader");
+            }
+        }
+        else if (arg == "--dir")
+        {
+            opts.dir = lf_Value();
+        }
+        else if (arg == "--output")
+        {
+            opts.output = lf_Value();
+        }
+        else if (arg == "--quick")
+        {
+            opts.quick = true;
+        }
+        else if (arg == "-h" || arg == "--help")
+        {
+            Usage();
+            exit(0);
+        }
+        else if (!arg.empty() && arg[0] != '-')
+        {
+            opts.suites.push_back(arg);
+        }
+        else
+        {
+            Usage();
+            throw std::invalid_argument("unknown option " + arg);
+        }
+    }
+
+    if (opts.quick)
+    {
+        opts.sizeMB = 1;
+        opts.steps = 2;
+        opts.stagingKB = 64;
+    }
+    if (opts.suites.empty())
+    {
+        opts.suites = {"write",       "read",      "metadata", "smallblocks",
+                       "compression", "selection", "staging"};
+    }
+    if (opts.stagingEngines.empty())
+    {
+        opts.stagingEngines.push_back("inline");
+        if (!opts.quick)
+        {
+#ifdef ADIOS2_HAVE_SST
+            opts.stagingEngines.push_back("sst");
+#endif
+#ifdef ADIOS2_HAVE_DATAMAN
+            opts.stagingEngines.push_back("dataman");
+#endif
+        }
+    }
+}
+
+std::string RankJSON(const std::string &start)
+{
+    std::string json("{ \"rank\":" + std::to_string(rank));
+    json += ", \"start\":\"" + start + "\"";
+    json += ", \"version\":\"" + std::string(ADIOS2_VERSION_STR) + "\"";
+    json += ", \"engine\":\"" + opts.engine + "\"";
+    json += ", \"nproc\":" + std::to_string(nproc);
+    if (!opts.role.empty())
+    {
+        json += ", \"role\":\"" + opts.role + "\"";
+    }
+    for (const auto &m : results)
+    {
+        json += ",\"" + m.name + "_mus\": " + std::to_string(m.mus);
+        json += ", \"" + m.name + "\":{\"mus\":" + std::to_string(m.mus);
+        json += ", \"nCalls\":" + std::to_string(m.nCalls);
+        if (m.bytes > 0)
+        {
+            const double mbps = m.mus > 0 ? static_cast<double>(m.bytes) / m.mus : 0.;
+            json += ", \"bytes\":" + std::to_string(m.bytes);
+            json += ", \"MBps\":" + std::to_string(mbps);
+        }
+        json += "}";
+    }
+    json += " }";
+    return json;
+}
+
+void WriteJSON(const std::string &start)
+{
+    const std::string rankJSON = RankJSON(start);
+    std::string all;
+#if ADIOS2_USE_MPI
+    int size = static_cast<int>(rankJSON.size());
+    std::vector<int> sizes(nproc);
+    MPI_Gather(&size, 1, MPI_INT, sizes.data(), 1, MPI_INT, 0, comm);
+    std::vector<int> displs(nproc, 0);
+    for (int r = 1; r < nproc; ++r)
+    {
+        displs[r] = displs[r - 1] + sizes[r - 1];
+    }
+    std::vector<char> gathered(rank == 0 ? displs.back() + sizes.back() : 1);
+    MPI_Gatherv(rankJSON.data(), size, MPI_CHAR, gathered.data(), sizes.data(), displs.data(),
+                MPI_CHAR, 0, comm);
+    if (rank != 0)
+    {
+        return;
+    }
+    for (int r = 0; r < nproc; ++r)
+    {
+        all += (r ? ",\n" : "") + std::string(gathered.data() + displs[r], sizes[r]);
+    }
+#else
+    all = rankJSON;
+#endif
+    all = "[\n" + all + "\n]\n";
+
+    if (opts.output.empty())
+    {
+        std::cout << all;
+    }
+    else
+    {
+        std::ofstream out(opts.output);
+        out << all;
+    }
+}
+
+} // end anonymous namespace
+
+int main(int argc, char **argv)
+{
+#if ADIOS2_USE_MPI
+    int provided;
+    MPI_Init_thread(&argc, &argv, MPI_THREAD_MULTIPLE, &provided);
+#endif
+
+    int result = 0;
+    try
+    {
+        ParseArgs(argc, argv);
+#if ADIOS2_USE_MPI
+        if (!opts.role.empty())
+        {
+            // writers and readers are separate programs of one MPMD launch
+            int worldRank;
+            MPI_Comm_rank(MPI_COMM_WORLD, &worldRank);
+            MPI_Comm_split(MPI_COMM_WORLD, opts.role == "writer" ? 0 : 1, worldRank, &comm);
+        }
+        MPI_Comm_rank(comm, &rank);
+        MPI_Comm_size(comm, &nproc);
+#endif
+
+        std::time_t now = std::time(nullptr);
+        std::string start(std::ctime(&now));
+        start.pop_back();
+        std::replace(start.begin(), start.end(), ' ', '_');
+
+        if (!opts.role.empty())
+        {
+            adios2::ADIOS adios = MakeADIOS();
+            const std::string stream = opts.dir + "/PerfBenchmark_staging";
+            const adios2::Params params = StagingParams(opts.engine, 12306);
+            if (opts.role == "writer")
+            {
+                StagingWriter(adios, opts.engine, stream, params, rank, nproc);
+            }
+            else
+            {
+                StagingReader(adios, opts.engine, stream, params, rank, nproc);
+            }
+        }
+        else
+        {
+            for (const auto &suite : opts.suites)
+            {
+                if (suite == "write")
+                {
+                    WriteBandwidth();
+                }
+                else if (suite == "read")
+                {
+                    ReadBandwidth();
+                }
+                else if (suite == "metadata")
+                {
+                    Metadata();
+                }
+                else if (suite == "smallblocks")
+                {
+                    SmallBlocks();
+                }
+                else if (suite == "compression")
+                {
+                    Compression();
+                }
+                else if (suite == "selection")
+                {
+                    Selection();
+                }
+                else if (suite == "staging")
+                {
+                    Staging();
+                }
+                else
+                {
+                    throw std::invalid_argument("unknown suite " + suite);
+                }
+            }
+        }
+        WriteJSON(start);
+    }
+    catch (std::exception &e)
+    {
+        std::cerr << "PerfBenchmark rank " << rank << ": " << e.what() << std::endl;
+        result = 1;
+    }
+
+#if ADIOS2_USE_MPI
+    if (comm != MPI_COMM_WORLD)
+    {
+        MPI_Comm_free(&comm);
+    }
+    MPI_Finalize();
+#endif
+    return result;
+}
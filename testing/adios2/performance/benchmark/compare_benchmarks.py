@@ -0,0 +1,85 @@
+#!/usr/bin/env python3
+#
+# Distributed under the OSI-approved Apache License, Version 2.0.  See
+# accompanying file Copyright.txt for details.
+#
+# compare_benchmarks.py: compare two PerfBenchmark (or profiling.json) results
+#
+# Every timer is reduced to its maximum over ranks, the slowest rank being
+# what the application waits for. Exits with 1 if any timer common to both
+# files got slower than the threshold.
+
+import argparse
+import json
+import sys
+
+
+def flatten(entry, prefix=""):
+    """timers of one rank entry as {name: mus}, nested ones joined by '.'"""
+    timers = {}
+    for key, value in entry.items():
+        if not isinstance(value, dict):
+            continue
+        name = prefix + key
+        if "mus" in value:
+            timers[name] = float(value["mus"])
+        timers.update(flatten(value, name + "."))
+    return timers
+
+
+def load(fname):
+    with open(fname) as f:
+        ranks = json.load(f)
+    if isinstance(ranks, dict):
+        ranks = [ranks]
+    timers = {}
+    for entry in ranks:
+        for name, mus in flatten(entry).items():
+            timers[name] = max(mus, timers.get(name, 0.0))
+    return timers
+
+
+def main():
+    parser = argparse.ArgumentParser(
+        description="Compare two benchmark JSON files, flag regressions")
+    parser.add_argument("baseline", help="reference results")
+    parser.add_argument("current", help="results to check")
+    parser.add_argument("-t", "--threshold", type=float, default=10.0,
+                        help="allowed slowdown in percent (default 10)")
+    parser.add_argument("-m", "--min-mus", type=float, default=100.0,
+                        help="ignore timers under this many microseconds in "
+                        "both files, they are mostly noise (default 100)")
+    args = parser.parse_args()
+
+    base = load(args.baseline)
+    curr = load(args.current)
+
+    regressions = []
+    width = max([len(n) for n in base] + [len(n) for n in curr] + [5])
+    print("{0:<{w}} {1:>12} {2:>12} {3:>9}".format(
+        "timer", "baseline", "current", "change", w=width))
+    for name in sorted(set(base) | set(curr)):
+        if name not in base or name not in curr:
+            value = base.get(name, curr.get(name))
+            print("{0:<{w}} {1:>12} {2:>12} {3:>9}".format(
+                name, "%.0f" % value if name in base else "-",
+                "%.0f" % value if name in curr else "-", "", w=width))
+            continue
+        b, c = base[name], curr[name]
+        change = (c - b) * 100.0 / b if b > 0 else 0.0
+        flag = ""
+        if change > args.threshold and max(b, c) >= args.min_mus:
+            regressions.append(name)
+            flag = " <<"
+        print("{0:<{w}} {1:>12.0f} {2:>12.0f} {3:>+8.1f}%{4}".format(
+            name, b, c, change, flag, w=width))
+
+    if regressions:
+        print("\n%d timer(s) slower than %.1f%%: %s" %
+              (len(regressions), args.threshold, ", ".join(regressions)))
+        return 1
+    return 0
+
+
+if __name__ == "__main__":
+    sys.exit(main())
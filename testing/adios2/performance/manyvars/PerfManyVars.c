@@ -371,6 +371,7 @@ int read_file()
     reset_readvars();
 
     log("Read and check data in %s\n", FILENAME);
+    tb = MPI_Wtime();
     adios2_engine *engineR = adios2_open(ioR, FILENAME, adios2_mode_read);
     if (engineR == NULL)
     {
@@ -380,6 +381,32 @@ int read_file()
 
     adios2_step_status status;
     adios2_begin_step(engineR, adios2_step_mode_read, -1., &status);
+    MPI_Barrier(comm);
+    te = MPI_Wtime();
+    if (rank == 0)
+    {
+        log("  Time to open and begin first step: %6.3lf seconds\n", te - tb);
+    }
+
+    log("  List available variables... %s\n", FILENAME);
+    tb = MPI_Wtime();
+    size_t nvarsRead = 0;
+    char **names = adios2_available_variables(ioR, &nvarsRead);
+    te = MPI_Wtime();
+    if (rank == 0)
+    {
+        log("  Time to list %zu available variables: %6.3lf seconds\n", nvarsRead, te - tb);
+    }
+    if (nvarsRead != (size_t)NVARS)
+    {
+        printE("Found %zu variables, but expected %d\n", nvarsRead, NVARS);
+        err = 100;
+    }
+    for (i = 0; i < (int)nvarsRead; i++)
+    {
+        free(names[i]);
+    }
+    free(names);
 
     log("  Check variable definitions... %s\n", FILENAME);
     tb = MPI_Wtime();
@@ -0,0 +1,84 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+
+#include <adios2/toolkit/format/bp5/BP5Arena.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace format
+{
+
+TEST(BP5Arena, AllocateIsAligned)
+{
+    BP5Arena a(256);
+    for (size_t size = 1; size < 40; ++size)
+    {
+        void *p = a.Allocate(size);
+        ASSERT_EQ(reinterpret_cast<uintptr_t>(p) % 8, 0);
+        memset(p, 0xff, size);
+    }
+}
+
+TEST(BP5Arena, ReallocateKeepsContent)
+{
+    BP5Arena a(128);
+    size_t *v = nullptr;
+    size_t *other = nullptr;
+    for (size_t n = 1; n <= 1000; ++n)
+    {
+        v = static_cast<size_t *>(a.Reallocate(v, n * sizeof(size_t)));
+        v[n - 1] = n;
+        // interleave another growing array so v is not always the last one
+        other = static_cast<size_t *>(a.Reallocate(other, n * sizeof(size_t)));
+        other[n - 1] = 2 * n;
+    }
+    for (size_t n = 1; n <= 1000; ++n)
+    {
+        ASSERT_EQ(v[n - 1], n);
+        ASSERT_EQ(other[n - 1], 2 * n);
+    }
+}
+
+TEST(BP5Arena, StrDup)
+{
+    BP5Arena a;
+    const char *s = a.StrDup("metadata string");
+    ASSERT_STREQ(s, "metadata string");
+}
+
+TEST(BP5Arena, ResetReusesMemory)
+{
+    BP5Arena a(64);
+    for (int step = 0; step < 3; ++step)
+    {
+        for (int i = 0; i < 100; ++i)
+        {
+            a.Allocate(24);
+        }
+        ASSERT_GE(a.Used(), 100 * 24);
+        a.Reset();
+        ASSERT_EQ(a.Used(), 0);
+    }
+    // after coalescing, a step of the same size fits in the first chunk
+    char *first = static_cast<char *>(a.Allocate(24));
+    for (int i = 1; i < 100; ++i)
+    {
+        char *p = static_cast<char *>(a.Allocate(24));
+        ASSERT_EQ(p - first, i * 32);
+    }
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
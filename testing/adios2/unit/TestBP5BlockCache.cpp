@@ -0,0 +1,123 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdio>
+#include <string>
+#include <vector>
+
+#include <adios2/toolkit/format/bp5/BP5BlockCache.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace format
+{
+
+namespace
+{
+BP5BlockCache::Key RawKey(const size_t step, const size_t offset)
+{
+    return BP5BlockCache::Key{step, 0, offset, BP5BlockCache::Kind::Raw};
+}
+
+std::vector<char> MakeBlock(const size_t size, const char value)
+{
+    return std::vector<char>(size, value);
+}
+}
+
+TEST(BP5BlockCache, HitAndMiss)
+{
+    BP5BlockCache cache(1000);
+    EXPECT_EQ(cache.Get(RawKey(0, 0)), nullptr);
+    cache.Put(RawKey(0, 0), MakeBlock(100, 'a'));
+    auto block = cache.Get(RawKey(0, 0));
+    ASSERT_NE(block, nullptr);
+    EXPECT_EQ(block->size(), 100);
+    EXPECT_EQ((*block)[99], 'a');
+
+    // same location, other kind or step is another block
+    EXPECT_EQ(cache.Get(RawKey(1, 0)), nullptr);
+    EXPECT_EQ(cache.Get(BP5BlockCache::Key{0, 0, 0, BP5BlockCache::Kind::Decompressed}),
+              nullptr);
+    EXPECT_EQ(cache.Hits(), 1);
+    EXPECT_EQ(cache.Misses(), 3);
+    EXPECT_EQ(cache.CachedBytes(), 100);
+}
+
+TEST(BP5BlockCache, LeastRecentlyUsedIsEvicted)
+{
+    BP5BlockCache cache(300);
+    cache.Put(RawKey(0, 0), MakeBlock(100, 'a'));
+    cache.Put(RawKey(0, 100), MakeBlock(100, 'b'));
+    cache.Put(RawKey(0, 200), MakeBlock(100, 'c'));
+    ASSERT_NE(cache.Get(RawKey(0, 0)), nullptr); // now the most recent
+    cache.Put(RawKey(0, 300), MakeBlock(100, 'd'));
+
+    EXPECT_EQ(cache.Get(RawKey(0, 100)), nullptr);
+    EXPECT_NE(cache.Get(RawKey(0, 0)), nullptr);
+    EXPECT_NE(cache.Get(RawKey(0, 300)), nullptr);
+    EXPECT_EQ(cache.CachedBytes(), 300);
+
+    // too large to keep, but still returned
+    auto huge = cache.Put(RawKey(0, 400), MakeBlock(1000, 'e'));
+    EXPECT_EQ(huge->size(), 1000);
+    EXPECT_FALSE(cache.Fits(1000));
+    EXPECT_EQ(cache.Get(RawKey(0, 400)), nullptr);
+    EXPECT_EQ(cache.CachedBytes(), 300);
+}
+
+TEST(BP5BlockCache, BlockOutlivesEviction)
+{
+    BP5BlockCache cache(100);
+    auto block = cache.Put(RawKey(0, 0), MakeBlock(100, 'a'));
+    cache.Put(RawKey(0, 100), MakeBlock(100, 'b'));
+    EXPECT_EQ(cache.Get(RawKey(0, 0)), nullptr);
+    EXPECT_EQ((*block)[0], 'a');
+}
+
+TEST(BP5BlockCache, SpillToDisk)
+{
+    const std::string dir = "BP5BlockCacheSpill";
+    {
+        BP5BlockCache cache(200, dir, 200);
+        cache.Put(RawKey(0, 0), MakeBlock(100, 'a'));
+        cache.Put(RawKey(0, 100), MakeBlock(100, 'b'));
+        cache.Put(RawKey(0, 200), MakeBlock(100, 'c'));
+        cache.Put(RawKey(0, 300), MakeBlock(100, 'd'));
+        EXPECT_EQ(cache.CachedBytes(), 200);
+        EXPECT_EQ(cache.SpilledBytes(), 200);
+
+        // read back from the spill directory, spilling 'c' in turn
+        auto a = cache.Get(RawKey(0, 0));
+        ASSERT_NE(a, nullptr);
+        EXPECT_EQ(a->size(), 100);
+        EXPECT_EQ((*a)[50], 'a');
+        EXPECT_EQ(cache.SpillHits(), 1);
+
+        // spill capacity drops the least recently spilled block
+        cache.Put(RawKey(0, 400), MakeBlock(100, 'e'));
+        EXPECT_EQ(cache.SpilledBytes(), 200);
+        EXPECT_EQ(cache.Get(RawKey(0, 100)), nullptr);
+        auto c = cache.Get(RawKey(0, 200));
+        ASSERT_NE(c, nullptr);
+        EXPECT_EQ((*c)[0], 'c');
+    }
+    // spill files are gone with the cache
+    EXPECT_NE(std::remove(dir.c_str()), -1);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
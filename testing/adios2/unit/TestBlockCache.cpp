@@ -0,0 +1,254 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <atomic>
+#include <chrono>
+#include <cstring>
+#include <future>
+#include <mutex>
+#include <stdexcept>
+#include <thread>
+#include <utility>
+#include <vector>
+
+#include <adios2/toolkit/transport/BlockCache.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace transport
+{
+
+/** In-memory object standing in for a remote one, records every fetch */
+class FakeObject
+{
+public:
+    FakeObject(const size_t size, const int delayMs = 0) : m_Data(size), m_DelayMs(delayMs)
+    {
+        for (size_t i = 0; i < size; ++i)
+        {
+            m_Data[i] = static_cast<char>((i * 13 + i / 253) & 0xff);
+        }
+    }
+
+    BlockCache::FetchFunction Fetch()
+    {
+        return [this](char *buffer, size_t size, size_t start) {
+            const int now = ++m_InFlight;
+            int max = m_MaxInFlight;
+            while (now > max && !m_MaxInFlight.compare_exchange_weak(max, now))
+            {
+            }
+            if (m_DelayMs)
+            {
+                std::this_thread::sleep_for(std::chrono::milliseconds(m_DelayMs));
+            }
+            {
+                std::lock_guard<std::mutex> lock(m_Mutex);
+                m_Fetches.emplace_back(start, size);
+            }
+            std::memcpy(buffer, m_Data.data() + start, size);
+            --m_InFlight;
+        };
+    }
+
+    void Check(BlockCache &cache, const size_t start, const size_t size)
+    {
+        std::vector<char> b(size);
+        cache.Read(b.data(), size, start);
+        ASSERT_EQ(0, std::memcmp(b.data(), m_Data.data() + start, size)) << "at offset " << start;
+    }
+
+    size_t Size() const { return m_Data.size(); }
+    size_t Fetches() const { return m_Fetches.size(); }
+    int MaxInFlight() const { return m_MaxInFlight; }
+
+private:
+    std::vector<char> m_Data;
+    int m_DelayMs;
+    std::mutex m_Mutex;
+    std::vector<std::pair<size_t, size_t>> m_Fetches;
+    std::atomic<int> m_InFlight{0};
+    std::atomic<int> m_MaxInFlight{0};
+};
+
+TEST(BlockCache, ReadsMatchObject)
+{
+    FakeObject obj(10000 + 17);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 4,
+                     0);
+    obj.Check(cache, 0, 1);
+    obj.Check(cache, 999, 2);
+    obj.Check(cache, 1500, 4000);
+    obj.Check(cache, 10000, 17);
+    obj.Check(cache, 0, obj.Size());
+    std::vector<char> b(2);
+    EXPECT_THROW(cache.Read(b.data(), 2, obj.Size() - 1), std::ios_base::failure);
+}
+
+TEST(BlockCache, HitsAndMisses)
+{
+    FakeObject obj(8000);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 4,
+                     0);
+    obj.Check(cache, 100, 1900); // blocks 0,1
+    EXPECT_EQ(cache.Misses(), 2);
+    EXPECT_EQ(cache.Hits(), 0);
+    obj.Check(cache, 1500, 1000); // blocks 1,2
+    EXPECT_EQ(cache.Misses(), 3);
+    EXPECT_EQ(cache.Hits(), 1);
+    obj.Check(cache, 0, 3000); // all cached
+    EXPECT_EQ(cache.Misses(), 3);
+    EXPECT_EQ(cache.Hits(), 4);
+    EXPECT_EQ(obj.Fetches(), 3);
+    EXPECT_EQ(cache.CachedBytes(), 3000);
+}
+
+TEST(BlockCache, ReadAhead)
+{
+    FakeObject obj(10000);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 4,
+                     2);
+    obj.Check(cache, 0, 500); // sequential from 0: block 0 + 2 ahead
+    EXPECT_EQ(cache.Misses(), 3);
+    obj.Check(cache, 500, 2000); // blocks 0-2 cached, 3,4 ahead
+    EXPECT_EQ(cache.Misses(), 5);
+    EXPECT_EQ(cache.Hits(), 3);
+    obj.Check(cache, 8500, 100); // random, no read-ahead
+    EXPECT_EQ(cache.Misses(), 6);
+    obj.Check(cache, 8600, 1400); // sequential, clipped at the end
+    EXPECT_EQ(cache.Misses(), 7);
+}
+
+TEST(BlockCache, ReadAheadInBackground)
+{
+    // read-ahead fetches are held back, the read that starts them must not wait
+    FakeObject obj(4000);
+    std::promise<void> release;
+    std::shared_future<void> released(release.get_future());
+    BlockCache::FetchFunction fetch = obj.Fetch();
+    BlockCache cache(
+        [&](char *buffer, size_t size, size_t start) {
+            if (start > 0)
+            {
+                released.wait();
+            }
+            fetch(buffer, size, start);
+        },
+        obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 4, 2);
+    auto read = std::async(std::launch::async, [&]() { obj.Check(cache, 0, 500); });
+    EXPECT_EQ(read.wait_for(std::chrono::seconds(10)), std::future_status::ready);
+    release.set_value();
+    read.get();
+    EXPECT_EQ(cache.Misses(), 3);
+    EXPECT_EQ(cache.CachedBytes(), 1000);
+
+    // the next read waits for the blocks read ahead instead of fetching them
+    obj.Check(cache, 500, 2000);
+    EXPECT_EQ(cache.Hits(), 3);
+    EXPECT_EQ(cache.Misses(), 4);
+}
+
+TEST(BlockCache, ReadAheadFailure)
+{
+    // only a read of the block itself sees the failure
+    FakeObject obj(4000);
+    BlockCache::FetchFunction fetch = obj.Fetch();
+    BlockCache cache(
+        [&](char *buffer, size_t size, size_t start) {
+            if (start >= 1000)
+            {
+                throw std::runtime_error("GET failed");
+            }
+            fetch(buffer, size, start);
+        },
+        obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 4, 2);
+    obj.Check(cache, 0, 500);
+    std::vector<char> b(1000);
+    EXPECT_THROW(cache.Read(b.data(), 1000, 500), std::runtime_error);
+    EXPECT_EQ(cache.CachedBytes(), 1000);
+}
+
+TEST(BlockCache, EvictLRU)
+{
+    FakeObject obj(10000);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 3000, BlockCache::EvictionPolicy::LRU, 4, 0);
+    obj.Check(cache, 0, 10);    // 0
+    obj.Check(cache, 1000, 10); // 0 1
+    obj.Check(cache, 2000, 10); // 0 1 2
+    obj.Check(cache, 0, 10);    // 1 2 0, hit
+    obj.Check(cache, 3000, 10); // 2 0 3, 1 evicted
+    EXPECT_EQ(cache.CachedBytes(), 3000);
+    EXPECT_EQ(cache.Misses(), 4);
+    obj.Check(cache, 0, 10); // hit
+    EXPECT_EQ(cache.Misses(), 4);
+    obj.Check(cache, 1000, 10); // miss
+    EXPECT_EQ(cache.Misses(), 5);
+}
+
+TEST(BlockCache, EvictFIFO)
+{
+    FakeObject obj(10000);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 3000, BlockCache::EvictionPolicy::FIFO, 4,
+                     0);
+    obj.Check(cache, 0, 10);
+    obj.Check(cache, 1000, 10);
+    obj.Check(cache, 2000, 10);
+    obj.Check(cache, 0, 10);    // hit, does not change the order
+    obj.Check(cache, 3000, 10); // 0 evicted
+    EXPECT_EQ(cache.Misses(), 4);
+    obj.Check(cache, 0, 10); // miss
+    EXPECT_EQ(cache.Misses(), 5);
+}
+
+TEST(BlockCache, ReadLargerThanCapacity)
+{
+    FakeObject obj(10000);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 2000, BlockCache::EvictionPolicy::LRU, 4, 0);
+    obj.Check(cache, 0, 6000);
+    EXPECT_LE(cache.CachedBytes(), 6000);
+    obj.Check(cache, 7000, 10);
+    EXPECT_LE(cache.CachedBytes(), 2000);
+}
+
+TEST(BlockCache, ParallelFetch)
+{
+    FakeObject obj(16000, 50);
+    BlockCache cache(obj.Fetch(), obj.Size(), 1000, 1 << 20, BlockCache::EvictionPolicy::LRU, 8,
+                     0);
+    obj.Check(cache, 0, obj.Size());
+    EXPECT_EQ(obj.Fetches(), 16);
+    EXPECT_GT(obj.MaxInFlight(), 1);
+    EXPECT_LE(obj.MaxInFlight(), 8);
+}
+
+TEST(BlockCache, FetchFailure)
+{
+    BlockCache cache([](char *, size_t, size_t) { throw std::runtime_error("GET failed"); }, 1000,
+                     100, 1000, BlockCache::EvictionPolicy::LRU, 4, 0);
+    std::vector<char> b(500);
+    EXPECT_THROW(cache.Read(b.data(), 500, 0), std::runtime_error);
+    EXPECT_EQ(cache.CachedBytes(), 0);
+}
+
+TEST(BlockCache, Policy)
+{
+    EXPECT_EQ(BlockCache::StringToPolicy("LRU"), BlockCache::EvictionPolicy::LRU);
+    EXPECT_EQ(BlockCache::StringToPolicy("fifo"), BlockCache::EvictionPolicy::FIFO);
+    EXPECT_THROW(BlockCache::StringToPolicy("random"), std::invalid_argument);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
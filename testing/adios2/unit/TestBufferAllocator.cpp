@@ -0,0 +1,157 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cstdint>
+#include <cstring>
+#include <thread>
+
+#include <adios2/common/ADIOSConfig.h>
+#include <adios2/toolkit/format/buffer/BufferAllocator.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace format
+{
+
+TEST(BufferAllocator, PoolReuse)
+{
+    BufferAllocator allocator("none", "none", 1500);
+
+    size_t allocated = 0;
+    void *p = allocator.Allocate(1000, allocated);
+    ASSERT_NE(p, nullptr);
+    ASSERT_EQ(allocated, 1000);
+    allocator.Free(p, allocated);
+    EXPECT_EQ(allocator.PoolBytes(), 1000);
+
+    // the pooled block comes back with its whole size
+    size_t reused = 0;
+    void *q = allocator.Allocate(800, reused);
+    EXPECT_EQ(q, p);
+    EXPECT_EQ(reused, 1000);
+    EXPECT_EQ(allocator.PoolBytes(), 0);
+
+    // the second block does not fit into the pool any more
+    size_t other = 0;
+    void *r = allocator.Allocate(1000, other);
+    allocator.Free(q, reused);
+    allocator.Free(r, other);
+    EXPECT_EQ(allocator.PoolBytes(), 1000);
+}
+
+TEST(BufferAllocator, NotMoreThanHalfWasted)
+{
+    BufferAllocator allocator("none", "none", 4096);
+
+    size_t big = 0, small = 0;
+    void *p = allocator.Allocate(1000, big);
+    void *q = allocator.Allocate(900, small);
+    allocator.Free(p, big);
+    allocator.Free(q, small);
+    EXPECT_EQ(allocator.PoolBytes(), 1900);
+
+    // 400 bytes would waste more than half of either block
+    size_t allocated = 0;
+    void *r = allocator.Allocate(400, allocated);
+    EXPECT_NE(r, p);
+    EXPECT_NE(r, q);
+    EXPECT_EQ(allocated, 400);
+    EXPECT_EQ(allocator.PoolBytes(), 1900);
+    allocator.Free(r, allocated);
+
+    // the smallest block that fits
+    void *s = allocator.Allocate(460, allocated);
+    EXPECT_EQ(s, q);
+    EXPECT_EQ(allocated, 900);
+    void *t = allocator.Allocate(500, allocated);
+    EXPECT_EQ(t, p);
+    EXPECT_EQ(allocated, 1000);
+    allocator.Free(s, 900);
+    allocator.Free(t, 1000);
+}
+
+TEST(BufferAllocator, Reallocate)
+{
+    for (const size_t poolSize : {size_t(0), size_t(1) << 20})
+    {
+        BufferAllocator allocator("none", "none", poolSize);
+
+        size_t allocated = 0;
+        char *p = static_cast<char *>(allocator.Allocate(100, allocated));
+        for (size_t i = 0; i < 100; ++i)
+        {
+            p[i] = static_cast<char>(i);
+        }
+
+        // shrinking keeps the block
+        size_t shrunk = 0;
+        EXPECT_EQ(allocator.Reallocate(p, allocated, 100, 50, shrunk), p);
+        EXPECT_EQ(shrunk, allocated);
+
+        // growing copies the used bytes only
+        size_t grown = 0;
+        char *q = static_cast<char *>(allocator.Reallocate(p, allocated, 60, 5000, grown));
+        ASSERT_NE(q, nullptr);
+        EXPECT_GE(grown, 5000);
+        for (size_t i = 0; i < 60; ++i)
+        {
+            EXPECT_EQ(q[i], static_cast<char>(i));
+        }
+        // with a pool the old block is kept for reuse
+        EXPECT_EQ(allocator.PoolBytes(), poolSize ? allocated : 0);
+        allocator.Free(q, grown);
+    }
+}
+
+TEST(BufferAllocator, NumaNode)
+{
+    // the pool entry has the node of the memory, not of the freeing thread
+    BufferAllocator allocator("none", "local", 1 << 20);
+    size_t allocated = 0;
+    char *p = static_cast<char *>(allocator.Allocate(100000, allocated));
+    ASSERT_NE(p, nullptr);
+    std::memset(p, 1, allocated);
+    std::thread([&]() { allocator.Free(p, allocated); }).join();
+    EXPECT_EQ(allocator.PoolBytes(), allocated);
+
+    size_t reused = 0;
+    void *q = allocator.Allocate(100000, reused);
+    EXPECT_EQ(q, p);
+    EXPECT_EQ(reused, allocated);
+    allocator.Free(q, reused);
+}
+
+#ifdef ADIOS2_HAVE_MEMORY_POLICY
+TEST(BufferAllocator, HugePageSizes)
+{
+    const size_t hugePage = size_t(1) << 21;
+    BufferAllocator allocator("2MB", "none", 0);
+
+    // a small block does not take a huge page
+    size_t allocated = 0;
+    void *p = allocator.Allocate(1000, allocated);
+    ASSERT_NE(p, nullptr);
+    EXPECT_GE(allocated, 1000);
+    EXPECT_LT(allocated, hugePage);
+    allocator.Free(p, allocated);
+
+    // a large one is made of whole, aligned huge pages
+    void *q = allocator.Allocate(3 * hugePage / 2, allocated);
+    ASSERT_NE(q, nullptr);
+    EXPECT_EQ(allocated, 2 * hugePage);
+    EXPECT_EQ(reinterpret_cast<uintptr_t>(q) % hugePage, 0);
+    allocator.Free(q, allocated);
+}
+#endif
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
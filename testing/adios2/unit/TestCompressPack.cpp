@@ -0,0 +1,208 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <adios2/operator/OperatorFactory.h>
+#include <adios2/operator/compress/CompressPack.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace core
+{
+namespace compress
+{
+
+namespace
+{
+/** @return compressed size */
+template <class T>
+size_t RoundTrip(const std::vector<T> &in, const DataType type, const Params &params = {})
+{
+    CompressPack pack(params);
+    const Dims count = {in.size()};
+    std::vector<char> buffer(pack.GetEstimatedSize(in.size(), sizeof(T), 1, count.data()));
+    const size_t size =
+        pack.Operate(reinterpret_cast<const char *>(in.data()), {0}, count, type, buffer.data());
+    EXPECT_GT(size, 0);
+    EXPECT_LE(size, buffer.size());
+
+    // any build can read it, the reader only knows the buffer
+    std::vector<T> out(in.size());
+    const size_t outSize =
+        Decompress(buffer.data(), size, reinterpret_cast<char *>(out.data()), MemorySpace::Host);
+    EXPECT_EQ(outSize, in.size() * sizeof(T));
+    EXPECT_EQ(std::memcmp(out.data(), in.data(), outSize), 0);
+    return size;
+}
+
+std::vector<double> Smooth(const size_t n)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = 300.0 + 20.0 * std::sin(0.0001 * i);
+    }
+    return v;
+}
+}
+
+TEST(CompressPack, Types)
+{
+    // sizes around the 16 words of the vectorized byte planes and around
+    // the chunks of 65536 words
+    for (const size_t n : {0, 1, 7, 17, 65535, 65536, 65537, 150000})
+    {
+        std::vector<double> r64 = Smooth(n);
+        RoundTrip(r64, DataType::Double);
+        std::vector<float> r32(r64.begin(), r64.end());
+        RoundTrip(r32, DataType::Float);
+        std::vector<int64_t> i64(n);
+        std::vector<int16_t> i16(n);
+        std::vector<uint8_t> u8(n);
+        std::vector<std::complex<double>> c64(n);
+        std::vector<long double> ld(n);
+        for (size_t i = 0; i < n; ++i)
+        {
+            i64[i] = static_cast<int64_t>(i * i) - 5000;
+            i16[i] = static_cast<int16_t>(i % 1000);
+            u8[i] = static_cast<uint8_t>(i / 100);
+            c64[i] = {r64[i], -r64[i]};
+            ld[i] = r64[i];
+        }
+        RoundTrip(i64, DataType::Int64);
+        RoundTrip(i16, DataType::Int16);
+        RoundTrip(u8, DataType::UInt8);
+        RoundTrip(c64, DataType::DoubleComplex);
+        RoundTrip(ld, DataType::LongDouble);
+    }
+}
+
+TEST(CompressPack, Predictions)
+{
+    const std::vector<double> r64 = Smooth(50000);
+    for (const std::string predict : {"auto", "xor", "sub", "none"})
+    {
+        RoundTrip(r64, DataType::Double, {{"predict", predict}});
+    }
+    EXPECT_THROW(RoundTrip(r64, DataType::Double, {{"predict", "nope"}}), std::invalid_argument);
+}
+
+TEST(CompressPack, Ratio)
+{
+    const size_t n = 1000000;
+    const std::vector<double> smooth = Smooth(n);
+    EXPECT_LT(RoundTrip(smooth, DataType::Double), n * sizeof(double) * 7 / 10);
+
+    const std::vector<double> constant(n, 3.14);
+    EXPECT_LT(RoundTrip(constant, DataType::Double), n * sizeof(double) / 100);
+
+    // random bits do not compress, the chunks are stored as they are
+    std::mt19937_64 gen(42);
+    std::vector<uint64_t> noise(n);
+    for (auto &v : noise)
+    {
+        v = gen();
+    }
+    CompressPack pack({});
+    EXPECT_LE(RoundTrip(noise, DataType::UInt64),
+              pack.GetEstimatedSize(n, sizeof(uint64_t), 1, &n));
+}
+
+TEST(CompressPack, Entropy)
+{
+    // skewed bytes without repeated sequences are left to the Huffman coder
+    const size_t n = 300000;
+    std::mt19937 gen(7);
+    std::geometric_distribution<int> geometric(0.3);
+    std::vector<uint8_t> skewed(n);
+    for (auto &v : skewed)
+    {
+        v = static_cast<uint8_t>(std::min(geometric(gen), 255));
+    }
+    EXPECT_LT(RoundTrip(skewed, DataType::UInt8, {{"predict", "none"}}), n / 2);
+
+    // probabilities 2^-k need codes longer than the coder allows
+    std::geometric_distribution<int> steepGeometric(0.5);
+    std::vector<uint8_t> steep(n);
+    for (auto &v : steep)
+    {
+        v = static_cast<uint8_t>(std::min(steepGeometric(gen), 255));
+    }
+    EXPECT_LT(RoundTrip(steep, DataType::UInt8, {{"predict", "none"}}), n / 3);
+
+    // the high bytes of noisy integers
+    std::vector<int32_t> noisy(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        noisy[i] = static_cast<int32_t>(i * 7) + static_cast<int32_t>(gen() % 50000);
+    }
+    EXPECT_LT(RoundTrip(noisy, DataType::Int32), n * sizeof(int32_t) * 8 / 10);
+}
+
+TEST(CompressPack, Corrupted)
+{
+    const std::vector<double> in = Smooth(20000);
+    CompressPack pack({});
+    const size_t n = in.size();
+    std::vector<char> buffer(pack.GetEstimatedSize(n, sizeof(double), 1, &n));
+    const size_t size = pack.Operate(reinterpret_cast<const char *>(in.data()), {0}, {n},
+                                     DataType::Double, buffer.data());
+    std::vector<double> out(n);
+    char *dataOut = reinterpret_cast<char *>(out.data());
+    EXPECT_THROW(pack.InverseOperate(buffer.data(), size / 2, dataOut), std::runtime_error);
+
+    // a damaged chunk must not write outside the output
+    std::vector<char> damaged(buffer.begin(), buffer.begin() + size);
+    for (size_t i = pack.GetHeaderSize() + 4; i < damaged.size(); i += 7)
+    {
+        damaged[i] = static_cast<char>(damaged[i] ^ 0x5a);
+    }
+    try
+    {
+        pack.InverseOperate(damaged.data(), damaged.size(), dataOut);
+    }
+    catch (std::runtime_error &)
+    {
+    }
+
+    // nor damaged Huffman coded planes
+    std::mt19937 gen(3);
+    std::vector<uint8_t> skewed(n * sizeof(double));
+    for (auto &v : skewed)
+    {
+        v = static_cast<uint8_t>(gen() % 5 + gen() % 5);
+    }
+    const size_t skewedSize =
+        pack.Operate(reinterpret_cast<const char *>(skewed.data()), {0}, {skewed.size()},
+                     DataType::UInt8, buffer.data());
+    for (size_t i = pack.GetHeaderSize() + 4; i < skewedSize; i += 997)
+    {
+        std::vector<char> flipped(buffer.begin(), buffer.begin() + skewedSize);
+        flipped[i] = static_cast<char>(flipped[i] ^ 0x10);
+        try
+        {
+            pack.InverseOperate(flipped.data(), flipped.size(), dataOut);
+        }
+        catch (std::runtime_error &)
+        {
+        }
+    }
+}
+
+}
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,434 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <atomic>
+#include <cstdint>
+#include <cstdlib>
+#include <cstring>
+
+#include <memory>
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2.h>
+#include <adios2/common/ADIOSTypes.h>
+#include <adios2/helper/adiosCommDummy.h>
+#include <adios2/toolkit/transport/file/FileHTTP.h>
+
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <poll.h>
+#include <sys/socket.h>
+#include <unistd.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace format
+{
+
+/**
+ * HTTP/1.1 server on loopback serving Content for any path, with Range
+ * support. Closes a connection after RequestsPerConnection requests
+ * without announcing it, like a server dropping idle connections.
+ */
+class LoopbackHTTPServer
+{
+public:
+    enum class Behaviour
+    {
+        /** multipart/byteranges responses to multi-range requests */
+        MultiRange,
+        /** the whole file for multi-range requests */
+        WholeFile,
+        /** the original proxy: raw bodies, no answer to HEAD */
+        Legacy,
+        /** Content-Length that is not a number in range responses */
+        InvalidLength
+    };
+
+    LoopbackHTTPServer(const std::vector<char> &content, const int requestsPerConnection = 0,
+                       const Behaviour behaviour = Behaviour::MultiRange)
+    : m_Content(content), m_RequestsPerConnection(requestsPerConnection), m_Behaviour(behaviour)
+    {
+        m_Listen = socket(AF_INET, SOCK_STREAM, 0);
+        int one = 1;
+        setsockopt(m_Listen, SOL_SOCKET, SO_REUSEADDR, &one, sizeof(one));
+        struct sockaddr_in addr;
+        memset(&addr, 0, sizeof(addr));
+        addr.sin_family = AF_INET;
+        addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+        addr.sin_port = 0;
+        bind(m_Listen, (struct sockaddr *)&addr, sizeof(addr));
+        listen(m_Listen, 16);
+        socklen_t len = sizeof(addr);
+        getsockname(m_Listen, (struct sockaddr *)&addr, &len);
+        m_Port = ntohs(addr.sin_port);
+        m_AcceptThread = std::thread(&LoopbackHTTPServer::Accept, this);
+    }
+
+    ~LoopbackHTTPServer()
+    {
+        m_Stop = true;
+        // no new connection threads after this
+        m_AcceptThread.join();
+        for (auto &t : m_Threads)
+        {
+            t.join();
+        }
+        close(m_Listen);
+    }
+
+    int Port() const { return m_Port; }
+    int Connections() const { return m_Connections; }
+    int Requests() const { return m_Requests; }
+
+private:
+    std::vector<char> m_Content;
+    int m_RequestsPerConnection;
+    Behaviour m_Behaviour;
+    int m_Listen;
+    int m_Port;
+    std::atomic<bool> m_Stop{false};
+    std::atomic<int> m_Connections{0};
+    std::atomic<int> m_Requests{0};
+    std::thread m_AcceptThread;
+    std::vector<std::thread> m_Threads;
+
+    // wait for fd to be readable, false if the server is stopping
+    bool WaitReadable(int fd)
+    {
+        struct pollfd p = {fd, POLLIN, 0};
+        while (!m_Stop)
+        {
+            if (poll(&p, 1, 50) > 0)
+            {
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void Accept()
+    {
+        while (WaitReadable(m_Listen))
+        {
+            int fd = accept(m_Listen, nullptr, nullptr);
+            if (fd >= 0)
+            {
+                ++m_Connections;
+                m_Threads.emplace_back(&LoopbackHTTPServer::Serve, this, fd);
+            }
+        }
+    }
+
+    void Serve(int fd)
+    {
+        std::string in;
+        int nRequests = 0;
+        char buf[4096];
+        while (WaitReadable(fd))
+        {
+            ssize_t n = recv(fd, buf, sizeof(buf), 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            in.append(buf, n);
+            size_t end;
+            while ((end = in.find("\r\n\r\n")) != std::string::npos)
+            {
+                ++m_Requests;
+                const bool responded = Respond(fd, in.substr(0, end));
+                in.erase(0, end + 4);
+                if (responded && m_Behaviour == Behaviour::Legacy)
+                {
+                    close(fd);
+                    return;
+                }
+                if (++nRequests == m_RequestsPerConnection)
+                {
+                    close(fd);
+                    return;
+                }
+            }
+        }
+        close(fd);
+    }
+
+    std::string Part(const size_t first, const size_t last)
+    {
+        return std::string(m_Content.data() + first, last - first + 1);
+    }
+
+    std::string ContentRange(const size_t first, const size_t last)
+    {
+        return "Content-Range: bytes " + std::to_string(first) + "-" + std::to_string(last) +
+               "/" + std::to_string(m_Content.size()) + "\r\n";
+    }
+
+    // false if the request is left unanswered
+    bool Respond(int fd, const std::string &header)
+    {
+        std::vector<std::pair<size_t, size_t>> ranges;
+        const size_t r = header.find("Range: bytes=");
+        if (r != std::string::npos)
+        {
+            const char *p = header.c_str() + r + 12;
+            do
+            {
+                char *q;
+                const size_t first = strtoull(p + 1, &q, 10);
+                const size_t last = strtoull(q + 1, &q, 10);
+                ranges.emplace_back(first, last);
+                p = q;
+            } while (*p == ',');
+        }
+
+        std::string out;
+        if (m_Behaviour == Behaviour::Legacy)
+        {
+            if (header.compare(0, 4, "HEAD") == 0)
+            {
+                return false;
+            }
+            if (header.find("Content-Length: bytes") != std::string::npos)
+            {
+                out = std::to_string(m_Content.size());
+            }
+            else
+            {
+                out = Part(ranges[0].first, ranges[0].second);
+            }
+        }
+        else if (header.compare(0, 4, "HEAD") == 0)
+        {
+            out = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(m_Content.size()) +
+                  "\r\n\r\n";
+        }
+        else if (ranges.empty() || (ranges.size() > 1 && m_Behaviour == Behaviour::WholeFile))
+        {
+            out = "HTTP/1.1 200 OK\r\nContent-Length: " + std::to_string(m_Content.size()) +
+                  "\r\n\r\n" + Part(0, m_Content.size() - 1);
+        }
+        else if (ranges.size() == 1)
+        {
+            const size_t first = ranges[0].first;
+            const size_t last = ranges[0].second;
+            out = "HTTP/1.1 206 Partial Content\r\n" + ContentRange(first, last) +
+                  "Content-Length: " + (m_Behaviour == Behaviour::InvalidLength ? "x" : "") +
+                  std::to_string(last - first + 1) + "\r\n\r\n" + Part(first, last);
+        }
+        else
+        {
+            std::string body;
+            for (const auto &range : ranges)
+            {
+                body += "\r\n--RANGES\r\nContent-Type: application/octet-stream\r\n" +
+                        ContentRange(range.first, range.second) + "\r\n" +
+                        Part(range.first, range.second);
+            }
+            body += "\r\n--RANGES--\r\n";
+            out = "HTTP/1.1 206 Partial Content\r\nContent-Type: multipart/byteranges; "
+                  "boundary=RANGES\r\nContent-Length: " +
+                  std::to_string(body.size()) + "\r\n\r\n" + body;
+        }
+        size_t sent = 0;
+        while (sent < out.size())
+        {
+            ssize_t n = send(fd, out.data() + sent, out.size() - sent, 0);
+            if (n <= 0)
+            {
+                break;
+            }
+            sent += n;
+        }
+        return true;
+    }
+};
+
+std::vector<char> MakeContent(const size_t size)
+{
+    std::vector<char> c(size);
+    for (size_t i = 0; i < size; ++i)
+    {
+        c[i] = static_cast<char>((i * 7 + i / 251) & 0xff);
+    }
+    return c;
+}
+
+std::unique_ptr<transport::FileHTTP> OpenHTTP(helper::Comm &comm, const int port,
+                                              const Params &params = Params())
+{
+    std::unique_ptr<transport::FileHTTP> t(new transport::FileHTTP(comm));
+    Params p = params;
+    p["hostname"] = "127.0.0.1";
+    p["port"] = std::to_string(port);
+    t->SetParameters(p);
+    t->Open("/test.bp/data.0", Mode::Read);
+    return t;
+}
+
+void ReadAndCheck(transport::FileHTTP &t, const std::vector<char> &content, const size_t start,
+                  const size_t size)
+{
+    std::vector<char> b(size);
+    t.Read(b.data(), size, start);
+    ASSERT_EQ(0, memcmp(b.data(), content.data() + start, size)) << "at offset " << start;
+}
+
+TEST(HTTPTransport, KeepAlive)
+{
+    const auto content = MakeContent(1024 * 1024);
+    LoopbackHTTPServer server(content);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port());
+
+    EXPECT_EQ(t->GetSize(), content.size());
+    for (size_t i = 0; i < 20; ++i)
+    {
+        ReadAndCheck(*t, content, i * 40000 + i, 1000 + i * 1000);
+    }
+    t->Close();
+    EXPECT_EQ(server.Requests(), 21);
+    EXPECT_EQ(server.Connections(), 1);
+}
+
+TEST(HTTPTransport, ConnectionPool)
+{
+    const auto content = MakeContent(64 * 1024);
+    LoopbackHTTPServer server(content);
+    helper::Comm comm = helper::CommDummy();
+    for (size_t i = 0; i < 4; ++i)
+    {
+        // every file reopens, they share the pooled connection
+        auto t = OpenHTTP(comm, server.Port());
+        ReadAndCheck(*t, content, i * 1000, 5000);
+        t->Close();
+    }
+    EXPECT_EQ(server.Connections(), 1);
+}
+
+TEST(HTTPTransport, ServerClosesConnection)
+{
+    const auto content = MakeContent(64 * 1024);
+    LoopbackHTTPServer server(content, 2);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port());
+    for (size_t i = 0; i < 6; ++i)
+    {
+        ReadAndCheck(*t, content, i * 3000, 2000);
+    }
+    t->Close();
+    EXPECT_EQ(server.Requests(), 6);
+    EXPECT_EQ(server.Connections(), 3);
+}
+
+TEST(HTTPTransport, InvalidHeader)
+{
+    const auto content = MakeContent(64 * 1024);
+    LoopbackHTTPServer server(content, 0, LoopbackHTTPServer::Behaviour::InvalidLength);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port());
+    std::vector<char> b(2000);
+    EXPECT_THROW(t->Read(b.data(), b.size(), 1000), std::ios_base::failure);
+    // the unread body is not taken for the next response
+    EXPECT_EQ(t->GetSize(), content.size());
+    t->Close();
+    auto u = OpenHTTP(comm, server.Port());
+    EXPECT_EQ(u->GetSize(), content.size());
+    u->Close();
+    EXPECT_EQ(server.Connections(), 2);
+}
+
+/** ReadV of count scattered ranges, some touching or overlapping others */
+void ReadVAndCheck(transport::FileHTTP &t, const std::vector<char> &content, const size_t count)
+{
+    std::vector<std::vector<char>> buffers(count);
+    std::vector<Transport::ReadRange> ranges(count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        // reversed order, every 5th range continues the one before it
+        const size_t j = count - 1 - i;
+        const size_t start = (j % 5 == 4) ? j * 997 - 100 : j * 997;
+        buffers[i].resize(100 + (i % 7) * 50);
+        ranges[i] = {buffers[i].data(), buffers[i].size(), start};
+    }
+    t.ReadV(ranges.data(), count);
+    for (size_t i = 0; i < count; ++i)
+    {
+        ASSERT_EQ(0, memcmp(buffers[i].data(), content.data() + ranges[i].start, ranges[i].size))
+            << "range " << i << " at offset " << ranges[i].start;
+    }
+}
+
+TEST(HTTPTransport, MultiRange)
+{
+    const auto content = MakeContent(256 * 1024);
+    LoopbackHTTPServer server(content);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port(), {{"max_ranges", "16"}});
+    ReadVAndCheck(*t, content, 100);
+    t->Close();
+    // 16 ranges per request, pipelined on one connection
+    EXPECT_EQ(server.Requests(), 7);
+    EXPECT_EQ(server.Connections(), 1);
+}
+
+TEST(HTTPTransport, MultiRangeServerClosesConnection)
+{
+    const auto content = MakeContent(256 * 1024);
+    LoopbackHTTPServer server(content, 2);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port(), {{"max_ranges", "8"}, {"pipeline_depth", "4"}});
+    ReadVAndCheck(*t, content, 100);
+    t->Close();
+    // 13 requests, lost pipelined ones are sent again on the next connection
+    EXPECT_GE(server.Requests(), 13);
+    EXPECT_GE(server.Connections(), 7);
+}
+
+TEST(HTTPTransport, MultiRangeWholeFile)
+{
+    const auto content = MakeContent(256 * 1024);
+    LoopbackHTTPServer server(content, 0, LoopbackHTTPServer::Behaviour::WholeFile);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port(), {{"max_ranges", "64"}});
+    ReadVAndCheck(*t, content, 100);
+    t->Close();
+    // the pipelined second request is sent again after the whole file
+    EXPECT_GE(server.Requests(), 2);
+}
+
+TEST(HTTPTransport, LegacyProxy)
+{
+    const auto content = MakeContent(64 * 1024);
+    LoopbackHTTPServer server(content, 0, LoopbackHTTPServer::Behaviour::Legacy);
+    helper::Comm comm = helper::CommDummy();
+    auto t = OpenHTTP(comm, server.Port(), {{"head_timeout", "0.2"}});
+    EXPECT_EQ(t->GetSize(), content.size());
+    // HEAD is not tried again for this server
+    EXPECT_EQ(t->GetSize(), content.size());
+    EXPECT_EQ(server.Requests(), 3);
+    // one request per range
+    ReadVAndCheck(*t, content, 20);
+    ReadAndCheck(*t, content, 1000, 5000);
+    t->Close();
+    EXPECT_EQ(server.Requests(), 24);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}
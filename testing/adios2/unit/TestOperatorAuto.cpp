@@ -0,0 +1,143 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <cstdint>
+#include <cstring>
+#include <random>
+
+#include <adios2/operator/OperatorAuto.h>
+#include <adios2/operator/OperatorFactory.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace core
+{
+
+namespace
+{
+struct Result
+{
+    OperatorAuto::Choice Choice;
+    size_t Index;
+    size_t Size;
+};
+
+template <class T>
+Result RoundTrip(const std::vector<T> &in, const DataType type, const Params &params = {})
+{
+    OperatorAuto op(params);
+    const Dims count = {in.size()};
+    std::vector<char> buffer(op.GetEstimatedSize(in.size(), sizeof(T), 1, count.data()));
+    const size_t size =
+        op.Operate(reinterpret_cast<const char *>(in.data()), {0}, count, type, buffer.data());
+    EXPECT_LE(size, buffer.size());
+
+    // the reader only knows the buffer
+    std::vector<T> out(in.size());
+    const size_t outSize =
+        Decompress(buffer.data(), size, reinterpret_cast<char *>(out.data()), MemorySpace::Host);
+    EXPECT_EQ(outSize, in.size() * sizeof(T));
+    EXPECT_EQ(std::memcmp(out.data(), in.data(), outSize), 0);
+    return {static_cast<OperatorAuto::Choice>(buffer[4]), static_cast<size_t>(buffer[5]), size};
+}
+
+std::vector<double> Smooth(const size_t n)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = 300.0 + 20.0 * std::sin(0.0001 * i);
+    }
+    return v;
+}
+
+std::vector<uint64_t> Noise(const size_t n)
+{
+    std::mt19937_64 gen(42);
+    std::vector<uint64_t> v(n);
+    for (auto &x : v)
+    {
+        x = gen();
+    }
+    return v;
+}
+}
+
+TEST(OperatorAuto, Constant)
+{
+    const size_t n = 1000000;
+    const Result zeros = RoundTrip(std::vector<double>(n, 0.0), DataType::Double);
+    EXPECT_EQ(zeros.Choice, OperatorAuto::Constant);
+    EXPECT_EQ(zeros.Size, OperatorAuto({}).GetHeaderSize() + sizeof(double));
+
+    std::vector<int16_t> values(n + 1, 7);
+    EXPECT_EQ(RoundTrip(values, DataType::Int16).Choice, OperatorAuto::Constant);
+    values.back() = 8;
+    EXPECT_NE(RoundTrip(values, DataType::Int16).Choice, OperatorAuto::Constant);
+
+    EXPECT_EQ(RoundTrip(std::vector<float>(1, 2.f), DataType::Float).Choice,
+              OperatorAuto::Constant);
+    EXPECT_EQ(RoundTrip(std::vector<float>(), DataType::Float).Choice, OperatorAuto::Stored);
+}
+
+TEST(OperatorAuto, Selection)
+{
+    // small blocks are their own sample, large ones are sampled
+    for (const size_t n : {1000, 1000000})
+    {
+        const Result smooth = RoundTrip(Smooth(n), DataType::Double);
+        EXPECT_EQ(smooth.Choice, OperatorAuto::Candidate);
+        EXPECT_LT(smooth.Size, n * sizeof(double));
+
+        const Result noise = RoundTrip(Noise(n), DataType::UInt64);
+        EXPECT_EQ(noise.Choice, OperatorAuto::Stored);
+    }
+
+    // the delta does not help pack on smooth doubles, both are acceptable
+    const Result chain = RoundTrip(Smooth(100000), DataType::Double,
+                                   {{"candidates", "delta+shuffle+pack, pack"}});
+    EXPECT_EQ(chain.Choice, OperatorAuto::Candidate);
+    EXPECT_LT(chain.Index, 2);
+
+    const Result demanding =
+        RoundTrip(Smooth(100000), DataType::Double, {{"min_ratio", "1000"}});
+    EXPECT_EQ(demanding.Choice, OperatorAuto::Stored);
+}
+
+TEST(OperatorAuto, TimeObjective)
+{
+    const std::vector<double> in = Smooth(1000000);
+    // writing is slow, compressing pays off
+    EXPECT_EQ(RoundTrip(in, DataType::Double, {{"objective", "time"}, {"bandwidth", "1"}}).Choice,
+              OperatorAuto::Candidate);
+    // writing is much faster than any compressor
+    EXPECT_EQ(
+        RoundTrip(in, DataType::Double, {{"objective", "time"}, {"bandwidth", "1e9"}}).Choice,
+        OperatorAuto::Stored);
+}
+
+TEST(OperatorAuto, Parameters)
+{
+    const std::vector<double> in = Smooth(1000);
+    // candidate parameters are prefixed with the candidate's type
+    EXPECT_THROW(RoundTrip(in, DataType::Double, {{"pack.predict", "nope"}}),
+                 std::invalid_argument);
+    EXPECT_NO_THROW(RoundTrip(in, DataType::Double, {{"pack.predict", "xor"}}));
+    EXPECT_THROW(RoundTrip(in, DataType::Double, {{"candidates", "nope"}}), std::invalid_argument);
+    EXPECT_THROW(RoundTrip(in, DataType::Double, {{"candidates", "pack,auto"}}),
+                 std::invalid_argument);
+    EXPECT_THROW(RoundTrip(in, DataType::Double, {{"objective", "nope"}}), std::invalid_argument);
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
@@ -0,0 +1,180 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <cmath>
+#include <complex>
+#include <cstdint>
+#include <cstring>
+
+#include <adios2/operator/OperatorChain.h>
+#include <adios2/operator/OperatorFactory.h>
+#include <adios2/operator/compress/CompressNull.h>
+#include <adios2/operator/precondition/PreconditionDelta.h>
+#include <adios2/operator/precondition/PreconditionShuffle.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace core
+{
+
+namespace
+{
+/** an operator that never applies, like blosc on a too small block */
+class NeverApplies : public Operator
+{
+public:
+    NeverApplies() : Operator("never", COMPRESS_NULL, "compress", {}) {}
+
+    size_t Operate(const char *, const Dims &, const Dims &, const DataType, char *) final
+    {
+        return 0;
+    }
+
+    size_t InverseOperate(const char *, const size_t, char *) final
+    {
+        throw std::logic_error("a skipped stage must not be inverted");
+    }
+
+    bool IsDataTypeValid(const DataType) const final { return true; }
+};
+
+std::shared_ptr<Operator> Delta(const std::string &mode = "sub")
+{
+    return std::make_shared<precondition::PreconditionDelta>(Params{{"mode", mode}});
+}
+
+std::shared_ptr<Operator> Shuffle()
+{
+    return std::make_shared<precondition::PreconditionShuffle>(Params{});
+}
+
+std::shared_ptr<Operator> Null() { return std::make_shared<compress::CompressNull>(Params{}); }
+
+std::shared_ptr<Operator> Never() { return std::make_shared<NeverApplies>(); }
+
+template <class T>
+void RoundTrip(const std::vector<std::shared_ptr<Operator>> &stages, const std::vector<T> &in,
+               const DataType type)
+{
+    OperatorChain chain(stages);
+    const Dims count = {in.size()};
+    std::vector<char> buffer(chain.GetEstimatedSize(in.size(), sizeof(T), 1, count.data()));
+    const size_t size =
+        chain.Operate(reinterpret_cast<const char *>(in.data()), {0}, count, type, buffer.data());
+    ASSERT_GT(size, 0);
+    ASSERT_LE(size, buffer.size());
+
+    // the reader only knows the buffer
+    std::vector<T> out(in.size());
+    const size_t outSize =
+        Decompress(buffer.data(), size, reinterpret_cast<char *>(out.data()), MemorySpace::Host);
+    ASSERT_EQ(outSize, in.size() * sizeof(T));
+    EXPECT_EQ(std::memcmp(out.data(), in.data(), outSize), 0);
+}
+
+std::vector<double> Smooth(const size_t n)
+{
+    std::vector<double> v(n);
+    for (size_t i = 0; i < n; ++i)
+    {
+        v[i] = 100.0 + std::sin(0.001 * i);
+    }
+    return v;
+}
+}
+
+TEST(OperatorChain, StagesString)
+{
+    EXPECT_EQ(OperatorChain::StagesString({Delta(), Shuffle(), Null()}), "delta+shuffle+null");
+    EXPECT_THROW(OperatorChain(std::vector<std::shared_ptr<Operator>>()), std::invalid_argument);
+}
+
+TEST(OperatorChain, Preconditioners)
+{
+    const std::vector<double> r64 = Smooth(1001);
+    RoundTrip(std::vector<std::shared_ptr<Operator>>{Delta()}, r64, DataType::Double);
+    RoundTrip({Shuffle()}, r64, DataType::Double);
+    RoundTrip({Delta("xor"), Shuffle()}, r64, DataType::Double);
+    RoundTrip({Delta(), Shuffle(), Null()}, r64, DataType::Double);
+    RoundTrip({Shuffle(), Delta()}, r64, DataType::Double);
+
+    std::vector<int16_t> i16(777);
+    for (size_t i = 0; i < i16.size(); ++i)
+    {
+        i16[i] = static_cast<int16_t>(i * i);
+    }
+    RoundTrip({Delta(), Shuffle(), Null()}, i16, DataType::Int16);
+
+    std::vector<std::complex<float>> c32(500);
+    for (size_t i = 0; i < c32.size(); ++i)
+    {
+        c32[i] = {static_cast<float>(i), -0.5f * i};
+    }
+    RoundTrip({Delta(), Shuffle(), Null()}, c32, DataType::FloatComplex);
+}
+
+TEST(OperatorChain, DeltaOfComplexIsPerPart)
+{
+    // the real parts get the same deltas as an array of just the real parts
+    std::vector<std::complex<double>> c(8);
+    std::vector<double> re(c.size());
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        c[i] = {0.5 * i, 1000.0 * i};
+        re[i] = c[i].real();
+    }
+    precondition::PreconditionDelta delta(Params{{"mode", "sub"}});
+    std::vector<char> bufferC(delta.GetEstimatedSize(c.size(), sizeof(c[0]), 1, nullptr));
+    std::vector<char> bufferRe(delta.GetEstimatedSize(re.size(), sizeof(re[0]), 1, nullptr));
+    delta.Operate(reinterpret_cast<const char *>(c.data()), {0}, {c.size()},
+                  DataType::DoubleComplex, bufferC.data());
+    delta.Operate(reinterpret_cast<const char *>(re.data()), {0}, {re.size()}, DataType::Double,
+                  bufferRe.data());
+    const char *dC = bufferC.data() + delta.GetHeaderSize();
+    const char *dRe = bufferRe.data() + delta.GetHeaderSize();
+    for (size_t i = 0; i < c.size(); ++i)
+    {
+        EXPECT_EQ(std::memcmp(dC + 2 * i * sizeof(double), dRe + i * sizeof(double),
+                              sizeof(double)),
+                  0);
+    }
+}
+
+TEST(OperatorChain, SkippedStages)
+{
+    const std::vector<double> r64 = Smooth(300);
+    RoundTrip({Never(), Delta(), Null()}, r64, DataType::Double);
+    RoundTrip({Delta(), Never(), Shuffle(), Null()}, r64, DataType::Double);
+    RoundTrip({Delta(), Shuffle(), Never()}, r64, DataType::Double);
+    RoundTrip({Null(), Never()}, r64, DataType::Double);
+    RoundTrip({Never(), Never()}, r64, DataType::Double);
+}
+
+TEST(OperatorChain, ReusedAcrossBlocks)
+{
+    // scratch buffers of a larger block must not leak into a smaller one
+    OperatorChain chain({Delta(), Shuffle(), Null()});
+    for (const size_t n : {5000, 10, 2000, 1})
+    {
+        const std::vector<double> in = Smooth(n);
+        std::vector<char> buffer(chain.GetEstimatedSize(n, sizeof(double), 1, &n));
+        const size_t size = chain.Operate(reinterpret_cast<const char *>(in.data()), {0}, {n},
+                                          DataType::Double, buffer.data());
+        std::vector<double> out(n);
+        ASSERT_EQ(chain.InverseOperate(buffer.data(), size, reinterpret_cast<char *>(out.data())),
+                  n * sizeof(double));
+        EXPECT_EQ(out, in);
+    }
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+    ::testing::InitGoogleTest(&argc, argv);
+    return RUN_ALL_TESTS();
+}
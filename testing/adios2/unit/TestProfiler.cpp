@@ -0,0 +1,148 @@
+/*
+ * Distributed under the OSI-approved Apache License, Version 2.0.  See
+ * accompanying file Copyright.txt for details.
+ */
+#include <string>
+#include <thread>
+#include <vector>
+
+#include <adios2/helper/adiosComm.h>
+#include <adios2/helper/adiosCommDummy.h>
+#include <adios2/toolkit/profiling/iochrono/Histogram.h>
+#include <adios2/toolkit/profiling/iochrono/IOChrono.h>
+#include <adios2/toolkit/profiling/iochrono/TraceBuffer.h>
+
+#include <gtest/gtest.h>
+
+namespace adios2
+{
+namespace profiling
+{
+
+TEST(Profiler, HistogramSmallValuesExact)
+{
+    Histogram h;
+    EXPECT_EQ(h.Percentile(0.5), 0);
+    for (int64_t v = 1; v <= 10; ++v)
+    {
+        h.Record(v);
+    }
+    EXPECT_EQ(h.Count(), 10);
+    EXPECT_EQ(h.Max(), 10);
+    EXPECT_EQ(h.Percentile(0.5), 5);
+    EXPECT_EQ(h.Percentile(1.0), 10);
+    h.Record(-3); // counted as 0
+    EXPECT_EQ(h.Percentile(0.0), 0);
+}
+
+TEST(Profiler, HistogramTail)
+{
+    Histogram h;
+    for (int i = 0; i < 990; ++i)
+    {
+        h.Record(100);
+    }
+    for (int i = 0; i < 10; ++i)
+    {
+        h.Record(50000);
+    }
+    h.Record(1000000);
+    EXPECT_EQ(h.Max(), 1000000);
+    const int64_t p50 = h.Percentile(0.5);
+    EXPECT_GE(p50, 100);
+    EXPECT_LE(p50, 100 + 100 / 8);
+    const int64_t p99 = h.Percentile(0.995);
+    EXPECT_GE(p99, 50000);
+    EXPECT_LE(p99, 50000 + 50000 / 8);
+    EXPECT_EQ(h.Percentile(1.0), 1000000);
+
+    Histogram huge;
+    huge.Record(int64_t(1) << 50);
+    EXPECT_EQ(huge.Percentile(0.5), int64_t(1) << 50);
+}
+
+TEST(Profiler, TraceBufferWraps)
+{
+    TraceBuffer buffer(5, 0);
+    EXPECT_EQ(buffer.Capacity(), 8);
+    for (size_t i = 0; i < 20; ++i)
+    {
+        buffer.Push(i, static_cast<int64_t>(i * 10), 1);
+    }
+    std::vector<size_t> ids;
+    buffer.ForEach([&](const TraceEvent &event) { ids.push_back(event.TimerId); });
+    ASSERT_EQ(ids.size(), 8);
+    EXPECT_EQ(ids.front(), 12);
+    EXPECT_EQ(ids.back(), 19);
+    EXPECT_EQ(buffer.Pushed(), 20);
+}
+
+TEST(Profiler, JSONProfilerIds)
+{
+    helper::Comm comm = helper::CommDummy();
+    JSONProfiler profiler(comm);
+    EXPECT_EQ(profiler.AddTimerWatch("ES"), static_cast<size_t>(ProfilerTimer::ES));
+    EXPECT_EQ(profiler.AddTimerWatch("PG"), static_cast<size_t>(ProfilerTimer::PG));
+    const size_t custom = profiler.AddTimerWatch("custom");
+    EXPECT_EQ(profiler.AddTimerWatch("custom"), custom);
+
+    for (int i = 0; i < 3; ++i)
+    {
+        profiler.Start(ProfilerTimer::ES);
+        profiler.Stop(ProfilerTimer::ES);
+    }
+    profiler.Start("custom");
+    profiler.Stop("custom");
+
+    const std::string json = profiler.GetRankProfilingJSON({}, {});
+    EXPECT_NE(json.find("\"ES\":{\"mus\":"), std::string::npos);
+    EXPECT_NE(json.find("\"nCalls\":3, \"p50\":"), std::string::npos);
+    EXPECT_NE(json.find("\"custom\":{"), std::string::npos);
+    EXPECT_EQ(json.find("\"PG\":{"), std::string::npos);
+}
+
+TEST(Profiler, JSONProfilerTrace)
+{
+    helper::Comm comm = helper::CommDummy();
+    JSONProfiler profiler(comm);
+    EXPECT_FALSE(profiler.TraceEnabled());
+    profiler.Start(ProfilerTimer::PP);
+    profiler.Stop(ProfilerTimer::PP);
+    EXPECT_EQ(profiler.GetRankTraceJSON().find("\"ph\":\"X\""), std::string::npos);
+
+    profiler.EnableTrace(16);
+    profiler.Start(ProfilerTimer::ES);
+    profiler.Stop(ProfilerTimer::ES);
+    std::thread other([&profiler]() {
+        profiler.Start(ProfilerTimer::DataRead);
+        profiler.Stop(ProfilerTimer::DataRead);
+    });
+    other.join();
+
+    const std::string trace = profiler.GetRankTraceJSON();
+    EXPECT_NE(trace.find("\"name\":\"process_name\""), std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"ES\", \"cat\":\"adios2\", \"ph\":\"X\""),
+              std::string::npos);
+    EXPECT_NE(trace.find("\"name\":\"DataRead\""), std::string::npos);
+    EXPECT_NE(trace.find("\"tid\":1}"), std::string::npos);
+    EXPECT_EQ(trace.find("\"name\":\"PP\""), std::string::npos);
+
+    // aggregated over ranks this is a JSON array of events
+    const std::vector<char> all = profiler.AggregateProfilingJSON(trace);
+    const std::string allStr(all.begin(), all.end());
+    EXPECT_EQ(allStr.front(), '[');
+    EXPECT_EQ(allStr.substr(allStr.size() - 4), "}\n]\n");
+}
+
+}
+}
+
+int main(int argc, char **argv)
+{
+
+    int result;
+    ::testing::InitGoogleTest(&argc, argv);
+    result = RUN_ALL_TESTS();
+
+    return result;
+}